@@ -30,5 +30,6 @@ typedef enum
   TimeoutError,
   DataReceived,
   InvalidData,
-  ConfigError
+  ConfigError,
+  EndOfStream
 } OrbCode_t;
@@ -0,0 +1,561 @@
+/** @file      headlessCapture.cpp
+ *  @brief     Source file for the headless capture functions.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/01/27
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  scrictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "headlessCapture.h"
+#include "../serial/serialComms.h"
+#include "../serial/inputSource.h"
+#include "../serial/deviceRegistry.h"
+#include "../serial/csvStorage.h"
+#include "../serial/shmPublisher.h"
+#include "../web/webServer.h"
+#include "../processing/processingGraph.h"
+#include "../processing/processingSchedule.h"
+#include "../ui/dataReceptionSettings.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+
+/* Maximum time the capture loop waits for data before checking for a stop */
+#define HEADLESS_POLL_TIMEOUT_MS (100)
+/* Loop period while a lost serial port is being reopened */
+#define HEADLESS_RECONNECT_POLL_MS (50)
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void prv_onStopSignal(int signalNumber)
+{
+  (void)signalNumber;
+  stopRequested = 1;
+}
+
+static void prv_installSignalHandlers(void)
+{
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = prv_onStopSignal;
+  sigemptyset(&action.sa_mask);
+
+  /* No SA_RESTART: poll() must return early with EINTR */
+  sigaction(SIGINT, &action, nullptr);
+  sigaction(SIGTERM, &action, nullptr);
+}
+
+static bool prv_parseUnsigned(const char *pText, unsigned long &value)
+{
+  char *pEnd = nullptr;
+  errno = 0;
+  value = strtoul(pText, &pEnd, 10);
+  return errno == 0 && pEnd != pText && *pEnd == '\0';
+}
+
+bool isHeadlessRequested(int argc, char *argv[])
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    if (strcmp(argv[i], "--headless") == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void printHeadlessUsage(const char *programName)
+{
+  fprintf(stderr,
+          "Usage: %s --headless (--port <device> | --source <spec>) "
+          "--channels <count> [options]\n"
+          "\n"
+          "Records a serial port or another input to CSV without opening a "
+          "window.\n"
+          "\n"
+          "Options:\n"
+          "  --port <device>          Serial device, e.g. ttyUSB0 or "
+          "/dev/ttyACM0,\n"
+          "                           or usb:VID:PID[:SERIAL|@PORT] to find "
+          "it by USB identity\n"
+          "  --source <spec>          Other input: - (stdin), pipe:PATH, "
+          "unix:PATH,\n"
+          "                           file:PATH[@BYTES_PER_SECOND], "
+          "tcp:HOST:PORT,\n"
+          "                           udp:PORT or udp:ADDRESS:PORT\n"
+          "  --baud <rate>            Baud rate (default 115200)\n"
+          "  --channels <count>       Values per received message\n"
+          "  --output <file>          CSV file (default: timestamped name)\n"
+          "  --shm <name>             Also publish the frames to a shared-memory "
+          "ring,\n"
+          "                           e.g. /mscope (see shm/mscopeShm.h)\n"
+          "  --web <address:port>     Serve a live view to browsers, e.g.\n"
+          "                           127.0.0.1:8080\n"
+          "  --stop-bits <1|2>        Stop bits (default 1)\n"
+          "  --parity <none|even|odd> Parity (default none)\n"
+          "  --stats-interval <s>     Seconds between statistics lines "
+          "(default 1)\n"
+          "  --stall-timeout <s>      Reopen the serial port after this long "
+          "without\n"
+          "                           a message (default 5, 0 disables)\n"
+          "  --no-reconnect           Stop instead of reopening a lost serial "
+          "port\n"
+          "  --no-pipeline            Read, parse and record on a single "
+          "thread\n"
+          "  --rt-priority <1-99>     Run the reader with SCHED_FIFO at this "
+          "priority\n"
+          "  --reader-cpu <cpu>       Pin the reader to this CPU, the other "
+          "capture\n"
+          "                           threads avoid it\n"
+          "  --mlock                  Lock the process memory, no page faults "
+          "while\n"
+          "                           reading\n"
+          "  --overload <policy>      Reader policy when the pipeline is full: "
+          "block\n"
+          "                           (default, the port buffers) or "
+          "drop-newest\n"
+          "  --profile <file>         Process the channels with a processing "
+          "graph\n"
+          "                           profile saved from the settings, the "
+          "record\n"
+          "                           outputs are the CSV columns\n"
+          "  --help                   Show this help\n",
+          programName);
+}
+
+OrbCode_t parseHeadlessArguments(int argc, char *argv[],
+                                 HeadlessConfig &config)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    const char *pOption = argv[i];
+    const char *pValue = (i + 1 < argc) ? argv[i + 1] : nullptr;
+    unsigned long number = 0;
+
+    if (strcmp(pOption, "--headless") == 0)
+    {
+      continue;
+    }
+
+    if (strcmp(pOption, "--help") == 0)
+    {
+      return ConfigError;
+    }
+
+    if (strcmp(pOption, "--no-reconnect") == 0)
+    {
+      config.reconnect = false;
+      continue;
+    }
+
+    if (strcmp(pOption, "--no-pipeline") == 0)
+    {
+      config.pipelined = false;
+      continue;
+    }
+
+    if (strcmp(pOption, "--mlock") == 0)
+    {
+      config.lockMemory = true;
+      continue;
+    }
+
+    if (pValue == nullptr)
+    {
+      fprintf(stderr, "Missing value for option %s\n", pOption);
+      return ConfigError;
+    }
+    i++;
+
+    if (strcmp(pOption, "--port") == 0)
+    {
+      config.portName = pValue;
+    }
+    else if (strcmp(pOption, "--source") == 0)
+    {
+      config.sourceSpec = pValue;
+    }
+    else if (strcmp(pOption, "--overload") == 0
+             && strcmp(pValue, "block") == 0)
+    {
+      config.overloadPolicy = OVERLOAD_BLOCK;
+    }
+    else if (strcmp(pOption, "--overload") == 0
+             && strcmp(pValue, "drop-newest") == 0)
+    {
+      config.overloadPolicy = OVERLOAD_DROP_NEWEST;
+    }
+    else if (strcmp(pOption, "--profile") == 0)
+    {
+      config.profileFile = pValue;
+    }
+    else if (strcmp(pOption, "--baud") == 0 && prv_parseUnsigned(pValue, number))
+    {
+      config.baudRate = static_cast<uint32_t>(number);
+    }
+    else if (strcmp(pOption, "--channels") == 0
+             && prv_parseUnsigned(pValue, number) && number > 0)
+    {
+      config.channels = static_cast<int>(number);
+    }
+    else if (strcmp(pOption, "--output") == 0)
+    {
+      config.outputFile = pValue;
+    }
+    else if (strcmp(pOption, "--shm") == 0 && pValue[0] == '/')
+    {
+      config.shmName = pValue;
+    }
+    else if (strcmp(pOption, "--web") == 0 && strrchr(pValue, ':') != nullptr
+             && prv_parseUnsigned(strrchr(pValue, ':') + 1, number)
+             && number > 0 && number <= 65535)
+    {
+      config.webAddress.assign(pValue, strrchr(pValue, ':') - pValue);
+      config.webPort = static_cast<uint16_t>(number);
+    }
+    else if (strcmp(pOption, "--stop-bits") == 0
+             && prv_parseUnsigned(pValue, number) && (number == 1 || number == 2))
+    {
+      config.stopBits = static_cast<uint8_t>(number);
+    }
+    else if (strcmp(pOption, "--parity") == 0 && strcmp(pValue, "none") == 0)
+    {
+      config.parity = 0;
+    }
+    else if (strcmp(pOption, "--parity") == 0 && strcmp(pValue, "even") == 0)
+    {
+      config.parity = 1;
+    }
+    else if (strcmp(pOption, "--parity") == 0 && strcmp(pValue, "odd") == 0)
+    {
+      config.parity = 2;
+    }
+    else if (strcmp(pOption, "--stats-interval") == 0 && atof(pValue) > 0.0)
+    {
+      config.statisticsInterval = atof(pValue);
+    }
+    else if (strcmp(pOption, "--stall-timeout") == 0 && atof(pValue) >= 0.0)
+    {
+      config.stallTimeout = atof(pValue);
+    }
+    else if (strcmp(pOption, "--rt-priority") == 0
+             && prv_parseUnsigned(pValue, number) && number >= 1
+             && number <= 99)
+    {
+      config.realtimePriority = static_cast<int>(number);
+    }
+    else if (strcmp(pOption, "--reader-cpu") == 0
+             && prv_parseUnsigned(pValue, number) && number < 1024)
+    {
+      config.readerCpu = static_cast<int>(number);
+    }
+    else
+    {
+      fprintf(stderr, "Invalid option: %s %s\n", pOption, pValue);
+      return ConfigError;
+    }
+  }
+
+  if (config.portName.empty() == config.sourceSpec.empty()
+      || config.channels <= 0)
+  {
+    fprintf(stderr, "--channels and one of --port or --source are required\n");
+    return ConfigError;
+  }
+
+  if (!config.sourceSpec.empty() && !createInputSource(config.sourceSpec))
+  {
+    fprintf(stderr, "Invalid source: %s\n", config.sourceSpec.c_str());
+    return ConfigError;
+  }
+
+  return Success;
+}
+
+static void prv_printStatistics(double elapsed, double interval,
+                                const SerialStatistics &current,
+                                const SerialStatistics &previous)
+{
+  double byteRate = (current.bytesReceived - previous.bytesReceived) / interval;
+  double frameRate
+      = (current.framesReceived - previous.framesReceived) / interval;
+
+  char driverText[48] = "";
+  if (current.driverCounters)
+  {
+    snprintf(driverText, sizeof(driverText), ", overruns %llu",
+             static_cast<unsigned long long>(current.uartOverruns
+                                             + current.bufferOverruns));
+  }
+
+  printf("[%9.1f s] %8.1f kB/s %9.0f frames/s | frames %llu, dropped %llu, "
+         "invalid bytes %llu, parse errors %llu, read errors %llu%s | "
+         "recorded %zu\n",
+         elapsed, byteRate / 1000.0, frameRate,
+         static_cast<unsigned long long>(current.framesReceived),
+         static_cast<unsigned long long>(current.framesDropped),
+         static_cast<unsigned long long>(current.invalidBytes),
+         static_cast<unsigned long long>(current.parseErrors),
+         static_cast<unsigned long long>(current.readErrors), driverText,
+         getCSVRecordedDataPoints());
+  fflush(stdout);
+}
+
+static void prv_printStages(const std::vector<StageStatistics> &stages)
+{
+  printf("%-14s %-12s %14s %14s %12s\n", "Stage", "Policy", "In", "Out",
+         "Dropped");
+  for (const StageStatistics &stage : stages)
+  {
+    if (!stage.available)
+    {
+      printf("%-14s %-12s %14s\n", stage.name.c_str(),
+             getOverloadPolicyName(stage.policy), "n/a");
+      continue;
+    }
+    printf("%-14s %-12s %14llu %14llu %12llu %s\n", stage.name.c_str(),
+           getOverloadPolicyName(stage.policy),
+           static_cast<unsigned long long>(stage.in),
+           static_cast<unsigned long long>(stage.out),
+           static_cast<unsigned long long>(stage.dropped), stage.pUnit);
+    if (stage.errors > 0)
+    {
+      printf("%-14s %-12s %14s %14s %12llu events\n", "", "", "", "",
+             static_cast<unsigned long long>(stage.errors));
+    }
+  }
+}
+
+int runHeadlessCapture(const HeadlessConfig &config)
+{
+  int exitCode = 0;
+
+  prv_installSignalHandlers();
+
+  /* Nothing is displayed, only the recording consumes the data */
+  setNumberOfChannels(config.channels);
+  setChannelHistoryEnabled(false);
+
+  ReconnectPolicy policy = getSerialReconnectPolicy();
+  policy.enabled = config.reconnect;
+  policy.stallTimeout = config.stallTimeout;
+  setSerialReconnectPolicy(policy);
+
+  /* Applied by this thread, which is the reader, on its first wait */
+  AcquisitionOptions acquisition;
+  acquisition.pipelined = config.pipelined;
+  acquisition.realtimePriority = config.realtimePriority;
+  acquisition.readerCpu = config.readerCpu;
+  acquisition.lockMemory = config.lockMemory;
+  acquisition.overloadPolicy = config.overloadPolicy;
+  setAcquisitionOptions(acquisition);
+
+  std::shared_ptr<const ProcessingSchedule> pSchedule;
+  if (!config.profileFile.empty())
+  {
+    ProcessingGraph graph;
+    OrbCode_t loadCode = graph.load(config.profileFile);
+    if (loadCode != Success)
+    {
+      fprintf(stderr, "%s profile %s\n",
+              loadCode == OpenError ? "Could not open" : "Invalid",
+              config.profileFile.c_str());
+      return 1;
+    }
+
+    std::string error;
+    pSchedule = graph.compile(error);
+    if (!pSchedule)
+    {
+      fprintf(stderr, "Invalid processing graph: %s\n", error.c_str());
+      return 1;
+    }
+    if (pSchedule->recordLabels.empty())
+    {
+      fprintf(stderr, "The processing graph has no record output\n");
+      return 1;
+    }
+    if (pSchedule->inputChannels > static_cast<size_t>(config.channels))
+    {
+      fprintf(stderr, "The processing graph reads channel %zu of %d\n",
+              pSchedule->inputChannels - 1, config.channels);
+      return 1;
+    }
+    setProcessingSchedule(pSchedule);
+  }
+
+  OrbCode_t orbCode = Success;
+  std::string inputName = config.portName;
+  if (config.sourceSpec.empty() && config.portName.compare(0, 4, "usb:") == 0)
+  {
+    g_deviceRegistry.rescan();
+    if (!findSerialDeviceByUsbIdentity(config.portName.substr(4), inputName,
+                                       true))
+    {
+      fprintf(stderr, "No serial device matches %s\n",
+              config.portName.c_str());
+      return 1;
+    }
+    printf("%s is %s\n", config.portName.c_str(), inputName.c_str());
+  }
+
+  if (config.sourceSpec.empty())
+  {
+    orbCode = openCOMPort(inputName, config.baudRate, config.stopBits,
+                          config.parity);
+  }
+  else
+  {
+    inputName = config.sourceSpec;
+    orbCode = openInputSource(createInputSource(config.sourceSpec));
+  }
+
+  if (orbCode != Success)
+  {
+    fprintf(stderr, "Could not open %s\n", inputName.c_str());
+    return 1;
+  }
+
+  if (!config.shmName.empty()
+      && startSharedMemoryPublishing(config.shmName) != Success)
+  {
+    closeCOMPort();
+    return 1;
+  }
+
+  if (config.webPort != 0
+      && startWebServer(config.webAddress, config.webPort) != Success)
+  {
+    stopSharedMemoryPublishing();
+    closeCOMPort();
+    return 1;
+  }
+
+  std::vector<std::string> channelNames;
+  for (int i = 0; i < config.channels; ++i)
+  {
+    channelNames.push_back("Channel_" + std::to_string(i + 1));
+  }
+  if (pSchedule)
+  {
+    channelNames = pSchedule->recordLabels;
+  }
+
+  std::string outputFile = config.outputFile.empty()
+                               ? generateTimestampedFilename("mscope")
+                               : config.outputFile;
+  if (!startCSVRecording(outputFile, channelNames))
+  {
+    stopWebServer();
+    stopSharedMemoryPublishing();
+    closeCOMPort();
+    return 1;
+  }
+
+  printf("Capturing %s, %d channels -> %s (Ctrl+C to stop)\n",
+         inputName.c_str(), config.channels, outputFile.c_str());
+  if (pSchedule)
+  {
+    printf("Processing with %s: %zu steps, %zu recorded outputs\n",
+           config.profileFile.c_str(), pSchedule->steps.size(),
+           channelNames.size());
+  }
+
+  resetChannelsData();
+  resetSerialStatistics();
+
+  auto startTime = std::chrono::steady_clock::now();
+  auto lastReport = startTime;
+  SerialStatistics previous;
+  SerialStatistics current;
+
+  while (!stopRequested)
+  {
+    orbCode = waitForSerialData(HEADLESS_POLL_TIMEOUT_MS);
+    if (orbCode == DataReceived)
+    {
+      orbCode = readSerialData();
+    }
+
+    if (orbCode == EndOfStream)
+    {
+      printf("End of input\n");
+      break;
+    }
+
+    /* A lost serial port is reopened, gaps are marked in the recording */
+    superviseSerialConnection();
+    logAcquisitionLosses();
+    if (isCOMPortReconnecting())
+    {
+      if (orbCode == PortStateError)
+      {
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(HEADLESS_RECONNECT_POLL_MS));
+      }
+    }
+    else if (orbCode == ReadError)
+    {
+      fprintf(stderr, "Serial read error: %s\n", strerror(errno));
+      exitCode = 1;
+      break;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    double sinceReport
+        = std::chrono::duration<double>(now - lastReport).count();
+    if (sinceReport >= config.statisticsInterval)
+    {
+      getSerialStatistics(current);
+      prv_printStatistics(
+          std::chrono::duration<double>(now - startTime).count(), sinceReport,
+          current, previous);
+      previous = current;
+      lastReport = now;
+    }
+  }
+
+  /* Record what the pipeline has read, then flush and close the recording
+   * before releasing the port */
+  PipelineStatistics pipeline;
+  std::vector<StageStatistics> stages;
+  stopAcquisitionPipeline();
+  getAcquisitionPipelineStatistics(pipeline);
+  getAcquisitionStages(stages);
+  stopCSVRecording();
+  stopWebServer();
+  stopSharedMemoryPublishing();
+  closeCOMPort();
+
+  getSerialStatistics(current);
+  printf("Capture stopped: %llu frames received, %llu dropped, "
+         "%u reconnection(s)\n",
+         static_cast<unsigned long long>(current.framesReceived),
+         static_cast<unsigned long long>(current.framesDropped),
+         getCOMPortReconnectCount());
+  if (pipeline.batches > 0)
+  {
+    printf("Pipeline: %llu reads, queue peaks %zu/%zu (parse) %zu/%zu "
+           "(record), %llu reader stall(s)\n",
+           static_cast<unsigned long long>(pipeline.batches),
+           pipeline.parseQueuePeak, pipeline.slots, pipeline.recordQueuePeak,
+           pipeline.slots,
+           static_cast<unsigned long long>(pipeline.readerStalls));
+  }
+  prv_printStages(stages);
+
+  return exitCode;
+}
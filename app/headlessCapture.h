@@ -0,0 +1,80 @@
+#pragma once
+/** @file      headlessCapture.h
+ *  @brief     Header file for the headless capture functions.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/01/27
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  scrictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include <string>
+#include <cstdint>
+#include "../Libraries/lib.h"
+#include "../serial/overloadPolicy.h"
+
+/**
+ * @brief Command line configuration of a headless capture.
+ */
+struct HeadlessConfig
+{
+  std::string portName;
+  std::string sourceSpec; /* Non-serial source, see createInputSource() */
+  uint32_t baudRate = 115200;
+  uint8_t stopBits = 1;
+  uint8_t parity = 0; /* 0 none, 1 even, 2 odd, as openCOMPort() expects */
+  int channels = 0;
+  std::string outputFile; /* Timestamped name when empty */
+  std::string shmName;    /* Shared-memory ring to publish to, if any */
+  std::string webAddress; /* Address of the live web viewer, if any */
+  uint16_t webPort = 0;
+  double statisticsInterval = 1.0; /* Seconds between statistics lines */
+  bool reconnect = true;      /* Reopen a lost serial port */
+  double stallTimeout = 5.0;  /* Seconds without a message, 0 disables */
+  bool pipelined = true;      /* Parse and record on their own threads */
+  int realtimePriority = 0;   /* SCHED_FIFO priority of the reader, 0 none */
+  int readerCpu = -1;         /* CPU the reader is pinned to, -1 any */
+  bool lockMemory = false;    /* mlockall() the capture */
+  OverloadPolicy_t overloadPolicy = OVERLOAD_BLOCK; /* Of the reader */
+  std::string profileFile;    /* Processing graph profile, if any */
+};
+
+/**
+ * @brief Checks whether the application was started with --headless.
+ */
+bool isHeadlessRequested(int argc, char *argv[]);
+
+/**
+ * @brief Parses the headless capture command line options.
+ *
+ * @param argc Argument count from main()
+ * @param argv Argument vector from main()
+ * @param config Parsed configuration
+ * @return Success, or ConfigError when an option is missing or invalid (or
+ *         when --help was requested).
+ */
+OrbCode_t parseHeadlessArguments(int argc, char *argv[],
+                                 HeadlessConfig &config);
+
+/**
+ * @brief Prints the headless capture command line usage.
+ */
+void printHeadlessUsage(const char *programName);
+
+/**
+ * @brief Records a serial port or another input source to CSV without
+ * creating any window or GL/ImGui context.
+ *
+ * Reception statistics are printed periodically. SIGINT and SIGTERM stop the
+ * capture, as does the end of a pipe, socket or file source. The recording is
+ * then flushed and closed before returning.
+ *
+ * @return Process exit code, 0 when the capture was stopped by a signal or
+ *         the end of the input.
+ */
+int runHeadlessCapture(const HeadlessConfig &config);
@@ -0,0 +1,366 @@
+/** @file      numericKernels.cpp
+ *  @brief     Source file for the scalar kernels, the dispatch and the checks.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/09
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "numericKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+/* Longest span checked, a few times the widest vector plus a tail */
+#define VERIFY_MAX_COUNT (67)
+#define VERIFY_MAX_CHANNELS (9)
+
+static const float NOT_A_NUMBER = std::numeric_limits<float>::quiet_NaN();
+
+static void prv_minMaxSum(const float *pValues, size_t count,
+                          SpanStatistics &statistics)
+{
+  float minValue = std::numeric_limits<float>::infinity();
+  float maxValue = -std::numeric_limits<float>::infinity();
+  double sum = 0.0;
+  size_t numbers = 0;
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    float value = pValues[i];
+    if (std::isnan(value))
+    {
+      continue;
+    }
+    minValue = std::min(minValue, value);
+    maxValue = std::max(maxValue, value);
+    sum += value;
+    numbers++;
+  }
+
+  statistics.minValue = (numbers > 0) ? minValue : NOT_A_NUMBER;
+  statistics.maxValue = (numbers > 0) ? maxValue : NOT_A_NUMBER;
+  statistics.sum = sum;
+  statistics.count = numbers;
+}
+
+static void prv_bucketMinMax(const float *pValues, size_t count,
+                             size_t bucketSize, float *pMin, float *pMax,
+                             float *pMean)
+{
+  for (size_t bucket = 0; bucket * bucketSize < count; ++bucket)
+  {
+    size_t first = bucket * bucketSize;
+    SpanStatistics statistics;
+    prv_minMaxSum(pValues + first, std::min(bucketSize, count - first),
+                  statistics);
+    pMin[bucket] = statistics.minValue;
+    pMax[bucket] = statistics.maxValue;
+    if (pMean != nullptr)
+    {
+      pMean[bucket] = (statistics.count > 0)
+                          ? static_cast<float>(statistics.sum / statistics.count)
+                          : NOT_A_NUMBER;
+    }
+  }
+}
+
+static void prv_toPlanar(const float *pFrames, size_t frames, size_t channels,
+                         float *const *ppPlanes)
+{
+  for (size_t frame = 0; frame < frames; ++frame)
+  {
+    for (size_t ch = 0; ch < channels; ++ch)
+    {
+      ppPlanes[ch][frame] = pFrames[frame * channels + ch];
+    }
+  }
+}
+
+static void prv_convertInt16(const int16_t *pInput, size_t count, float scale,
+                             float offset, float *pOutput)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    pOutput[i] = static_cast<float>(pInput[i]) * scale + offset;
+  }
+}
+
+static void prv_convertInt32(const int32_t *pInput, size_t count, float scale,
+                             float offset, float *pOutput)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    pOutput[i] = static_cast<float>(pInput[i]) * scale + offset;
+  }
+}
+
+static void prv_scaleOffset(const float *pInput, size_t count, float scale,
+                            float offset, float *pOutput)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    pOutput[i] = pInput[i] * scale + offset;
+  }
+}
+
+static double prv_dot(const float *pA, const float *pB, size_t count)
+{
+  double sum = 0.0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    sum += static_cast<double>(pA[i]) * pB[i];
+  }
+  return sum;
+}
+
+static const NumericKernels scalarKernels = {
+  "scalar",
+  prv_minMaxSum,
+  prv_bucketMinMax,
+  prv_toPlanar,
+  prv_convertInt16,
+  prv_convertInt32,
+  prv_scaleOffset,
+  prv_dot,
+};
+
+const NumericKernels &getScalarKernels(void)
+{
+  return scalarKernels;
+}
+
+size_t getNumericKernelVariants(const NumericKernels **ppVariants)
+{
+  size_t count = 0;
+  ppVariants[count++] = &scalarKernels;
+
+  const NumericKernels *pCandidates[] = {getSse41Kernels(), getAvx2Kernels(),
+                                         getNeonKernels()};
+  for (const NumericKernels *pCandidate : pCandidates)
+  {
+    if (pCandidate != nullptr)
+    {
+      ppVariants[count++] = pCandidate;
+    }
+  }
+  return count;
+}
+
+const NumericKernels &getNumericKernels(void)
+{
+  /* Variants are listed from the least to the most capable */
+  static const NumericKernels &kernels = []() -> const NumericKernels & {
+    const NumericKernels *pVariants[NUMERIC_KERNEL_VARIANTS_MAX];
+    size_t count = getNumericKernelVariants(pVariants);
+    return *pVariants[count - 1];
+  }();
+  return kernels;
+}
+
+/* Same value, or both NaN, or within the rounding of a reordered sum */
+static bool prv_isClose(double expected, double actual, double magnitude)
+{
+  if (std::isnan(expected) || std::isnan(actual))
+  {
+    return std::isnan(expected) && std::isnan(actual);
+  }
+  return std::fabs(expected - actual) <= 1e-5 * magnitude + 1e-6;
+}
+
+static bool prv_isSame(float expected, float actual)
+{
+  if (std::isnan(expected) || std::isnan(actual))
+  {
+    return std::isnan(expected) && std::isnan(actual);
+  }
+  return expected == actual;
+}
+
+static void prv_fail(std::string &report, const NumericKernels &variant,
+                     const char *pKernel, size_t count)
+{
+  report += std::string(variant.pName) + ": " + pKernel + " differs for "
+            + std::to_string(count) + " values\n";
+}
+
+static bool prv_verifyVariant(const NumericKernels &variant,
+                              std::mt19937 &generator, std::string &report)
+{
+  std::uniform_real_distribution<float> valueDistribution(-1000.0f, 1000.0f);
+  std::uniform_int_distribution<int32_t> int32Distribution(-(1 << 24),
+                                                           1 << 24);
+  std::uniform_int_distribution<int> int16Distribution(-32768, 32767);
+  std::uniform_int_distribution<int> gapDistribution(0, 7);
+  bool passed = true;
+
+  /* One more value: the spans start at the second one */
+  std::vector<float> a(VERIFY_MAX_COUNT * VERIFY_MAX_CHANNELS + 1);
+  std::vector<float> b(a.size());
+  std::vector<int16_t> int16Values(VERIFY_MAX_COUNT);
+  std::vector<int32_t> int32Values(VERIFY_MAX_COUNT);
+  std::vector<float> expected(VERIFY_MAX_COUNT * VERIFY_MAX_CHANNELS);
+  std::vector<float> actual(expected.size());
+
+  for (size_t count = 0; count <= VERIFY_MAX_COUNT; ++count)
+  {
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+      /* Some gaps, and spans made only of gaps when count is small */
+      a[i] = (gapDistribution(generator) == 0) ? NOT_A_NUMBER
+                                               : valueDistribution(generator);
+      b[i] = valueDistribution(generator);
+    }
+    for (size_t i = 0; i < count; ++i)
+    {
+      int16Values[i] = static_cast<int16_t>(int16Distribution(generator));
+      int32Values[i] = int32Distribution(generator);
+    }
+
+    /* Misaligned on purpose: the spans of the callers start anywhere */
+    const float *pA = a.data() + 1;
+
+    SpanStatistics reference;
+    SpanStatistics statistics;
+    scalarKernels.minMaxSum(pA, count, reference);
+    variant.minMaxSum(pA, count, statistics);
+    if (!prv_isSame(reference.minValue, statistics.minValue)
+        || !prv_isSame(reference.maxValue, statistics.maxValue)
+        || reference.count != statistics.count
+        || !prv_isClose(reference.sum, statistics.sum, 1000.0 * count))
+    {
+      prv_fail(report, variant, "minMaxSum", count);
+      passed = false;
+    }
+
+    for (size_t bucketSize = 1; bucketSize <= 9; bucketSize += 4)
+    {
+      size_t buckets = (count + bucketSize - 1) / bucketSize;
+      std::vector<float> expectedBuckets(buckets * 3);
+      std::vector<float> actualBuckets(buckets * 3);
+      float *pExpected = expectedBuckets.data();
+      float *pActual = actualBuckets.data();
+      scalarKernels.bucketMinMax(pA, count, bucketSize, pExpected,
+                                 pExpected + buckets, pExpected + 2 * buckets);
+      variant.bucketMinMax(pA, count, bucketSize, pActual, pActual + buckets,
+                           pActual + 2 * buckets);
+      for (size_t i = 0; i < buckets * 3; ++i)
+      {
+        /* Min and max exactly, the mean up to its rounding */
+        bool same = (i < 2 * buckets)
+                        ? prv_isSame(pExpected[i], pActual[i])
+                        : prv_isClose(pExpected[i], pActual[i], 1000.0);
+        if (!same)
+        {
+          prv_fail(report, variant, "bucketMinMax", count);
+          passed = false;
+          break;
+        }
+      }
+    }
+
+    for (size_t channels = 1; channels <= VERIFY_MAX_CHANNELS; ++channels)
+    {
+      std::vector<float *> expectedPlanes(channels);
+      std::vector<float *> actualPlanes(channels);
+      for (size_t ch = 0; ch < channels; ++ch)
+      {
+        expectedPlanes[ch] = expected.data() + ch * count;
+        actualPlanes[ch] = actual.data() + ch * count;
+      }
+      std::fill(actual.begin(), actual.end(), 0.0f);
+      scalarKernels.toPlanar(pA, count, channels, expectedPlanes.data());
+      variant.toPlanar(pA, count, channels, actualPlanes.data());
+      for (size_t i = 0; i < count * channels; ++i)
+      {
+        if (!prv_isSame(expected[i], actual[i]))
+        {
+          prv_fail(report, variant,
+                   ("toPlanar " + std::to_string(channels) + " channels").c_str(),
+                   count);
+          passed = false;
+          break;
+        }
+      }
+    }
+
+    const char *pConversions[] = {"convertInt16", "convertInt32",
+                                  "scaleOffset"};
+    for (int kernel = 0; kernel < 3; ++kernel)
+    {
+      std::fill(actual.begin(), actual.end(), 0.0f);
+      if (kernel == 0)
+      {
+        scalarKernels.convertInt16(int16Values.data(), count, 0.25f, -3.0f,
+                                   expected.data());
+        variant.convertInt16(int16Values.data(), count, 0.25f, -3.0f,
+                             actual.data());
+      }
+      else if (kernel == 1)
+      {
+        scalarKernels.convertInt32(int32Values.data(), count, 1e-3f, 0.5f,
+                                   expected.data());
+        variant.convertInt32(int32Values.data(), count, 1e-3f, 0.5f,
+                             actual.data());
+      }
+      else
+      {
+        scalarKernels.scaleOffset(pA, count, 1.8f, 32.0f, expected.data());
+        variant.scaleOffset(pA, count, 1.8f, 32.0f, actual.data());
+      }
+      for (size_t i = 0; i < count; ++i)
+      {
+        /* A fused multiply-add may round the last bit differently */
+        if (!prv_isClose(expected[i], actual[i], std::fabs(expected[i])))
+        {
+          prv_fail(report, variant, pConversions[kernel], count);
+          passed = false;
+          break;
+        }
+      }
+    }
+
+    double magnitude = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      magnitude += std::fabs(static_cast<double>(b[i]) * b[i + 1]);
+    }
+    if (!prv_isClose(scalarKernels.dot(b.data(), b.data() + 1, count),
+                     variant.dot(b.data(), b.data() + 1, count), magnitude))
+    {
+      prv_fail(report, variant, "dot", count);
+      passed = false;
+    }
+  }
+  return passed;
+}
+
+bool verifyNumericKernels(std::string &report)
+{
+  const NumericKernels *pVariants[NUMERIC_KERNEL_VARIANTS_MAX];
+  size_t count = getNumericKernelVariants(pVariants);
+  std::mt19937 generator(2025);
+  bool passed = true;
+
+  for (size_t index = 0; index < count; ++index)
+  {
+    if (prv_verifyVariant(*pVariants[index], generator, report))
+    {
+      report += std::string(pVariants[index]->pName) + ": passed\n";
+    }
+    else
+    {
+      passed = false;
+    }
+  }
+  return passed;
+}
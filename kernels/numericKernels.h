@@ -0,0 +1,101 @@
+/** @file      numericKernels.h
+ *  @brief     Header file for the vectorized numeric kernels.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/09
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef NUMERIC_KERNELS_H
+#define NUMERIC_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Minimum, maximum and sum of a span, NaN (gap markers) excluded.
+ *
+ * minValue and maxValue are NaN when the span holds no number.
+ */
+struct SpanStatistics
+{
+  float minValue;
+  float maxValue;
+  double sum;
+  size_t count;
+};
+
+/**
+ * @brief One implementation of every kernel, for one instruction set.
+ *
+ * All variants give the results of the scalar one, except for the order
+ * in which sums are accumulated.
+ */
+struct NumericKernels
+{
+  const char *pName;
+
+  void (*minMaxSum)(const float *pValues, size_t count,
+                    SpanStatistics &statistics);
+
+  /**
+   * Min, max and mean of every bucketSize values, the last bucket may be
+   * shorter. A bucket without numbers gives NaN. pMean may be null.
+   */
+  void (*bucketMinMax)(const float *pValues, size_t count, size_t bucketSize,
+                       float *pMin, float *pMax, float *pMean);
+
+  /* Frames (frame * channels + channel) to one array per channel */
+  void (*toPlanar)(const float *pFrames, size_t frames, size_t channels,
+                   float *const *ppPlanes);
+
+  /* pOutput[i] = pInput[i] * scale + offset */
+  void (*convertInt16)(const int16_t *pInput, size_t count, float scale,
+                       float offset, float *pOutput);
+  void (*convertInt32)(const int32_t *pInput, size_t count, float scale,
+                       float offset, float *pOutput);
+  void (*scaleOffset)(const float *pInput, size_t count, float scale,
+                      float offset, float *pOutput);
+
+  /* Accumulated in double */
+  double (*dot)(const float *pA, const float *pB, size_t count);
+};
+
+/**
+ * @brief Kernels of the best instruction set of this CPU, picked on first
+ * use: AVX2 or SSE4.1 on x86, NEON on 64-bit ARM, scalar otherwise.
+ */
+const NumericKernels &getNumericKernels(void);
+
+/* Scalar reference, also the fallback of every other variant */
+const NumericKernels &getScalarKernels(void);
+
+/**
+ * @brief Kernels this CPU can run, scalar first.
+ * @return Number of variants, at most NUMERIC_KERNEL_VARIANTS_MAX.
+ */
+#define NUMERIC_KERNEL_VARIANTS_MAX (4)
+size_t getNumericKernelVariants(const NumericKernels **ppVariants);
+
+/**
+ * @brief Runs every variant of this CPU against the scalar reference, over
+ * random spans of every length up to a few vector widths.
+ *
+ * @param report One line per variant and kernel that failed, with its name
+ * @return True when every variant matched.
+ */
+bool verifyNumericKernels(std::string &report);
+
+/* Variants of the other translation units, null when not built in */
+const NumericKernels *getSse41Kernels(void);
+const NumericKernels *getAvx2Kernels(void);
+const NumericKernels *getNeonKernels(void);
+
+#endif // NUMERIC_KERNELS_H
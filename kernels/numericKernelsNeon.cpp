@@ -0,0 +1,270 @@
+/** @file      numericKernelsNeon.cpp
+ *  @brief     Source file for the NEON kernels.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/09
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "numericKernels.h"
+
+/* 64-bit ARM only: NEON is always there and has double lanes for the sums.
+ * 32-bit builds use the scalar kernels. */
+#if defined(__aarch64__) && defined(__ARM_NEON)
+
+#include <arm_neon.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+static const float NOT_A_NUMBER = std::numeric_limits<float>::quiet_NaN();
+
+static void prv_neonMinMaxSum(const float *pValues, size_t count,
+                              SpanStatistics &statistics)
+{
+  /* vminnm/vmaxnm return the number when one operand is NaN */
+  float32x4_t minimum = vdupq_n_f32(std::numeric_limits<float>::infinity());
+  float32x4_t maximum = vdupq_n_f32(-std::numeric_limits<float>::infinity());
+  float64x2_t sumLow = vdupq_n_f64(0.0);
+  float64x2_t sumHigh = vdupq_n_f64(0.0);
+  uint32x4_t numbers = vdupq_n_u32(0);
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    float32x4_t values = vld1q_f32(pValues + i);
+    uint32x4_t ordered = vceqq_f32(values, values);
+    minimum = vminnmq_f32(minimum, values);
+    maximum = vmaxnmq_f32(maximum, values);
+
+    float32x4_t kept = vreinterpretq_f32_u32(
+        vandq_u32(vreinterpretq_u32_f32(values), ordered));
+    sumLow = vaddq_f64(sumLow, vcvt_f64_f32(vget_low_f32(kept)));
+    sumHigh = vaddq_f64(sumHigh, vcvt_high_f64_f32(kept));
+    numbers = vsubq_u32(numbers, ordered);
+  }
+
+  float minValue = vminvq_f32(minimum);
+  float maxValue = vmaxvq_f32(maximum);
+  double sum = vaddvq_f64(vaddq_f64(sumLow, sumHigh));
+  size_t total = vaddlvq_u32(numbers);
+
+  for (; i < count; ++i)
+  {
+    float value = pValues[i];
+    if (std::isnan(value))
+    {
+      continue;
+    }
+    minValue = std::min(minValue, value);
+    maxValue = std::max(maxValue, value);
+    sum += value;
+    total++;
+  }
+
+  statistics.minValue = (total > 0) ? minValue : NOT_A_NUMBER;
+  statistics.maxValue = (total > 0) ? maxValue : NOT_A_NUMBER;
+  statistics.sum = sum;
+  statistics.count = total;
+}
+
+static void prv_neonBucketMinMax(const float *pValues, size_t count,
+                                 size_t bucketSize, float *pMin, float *pMax,
+                                 float *pMean)
+{
+  for (size_t bucket = 0; bucket * bucketSize < count; ++bucket)
+  {
+    size_t first = bucket * bucketSize;
+    SpanStatistics statistics;
+    prv_neonMinMaxSum(pValues + first, std::min(bucketSize, count - first),
+                      statistics);
+    pMin[bucket] = statistics.minValue;
+    pMax[bucket] = statistics.maxValue;
+    if (pMean != nullptr)
+    {
+      pMean[bucket] = (statistics.count > 0)
+                          ? static_cast<float>(statistics.sum / statistics.count)
+                          : NOT_A_NUMBER;
+    }
+  }
+}
+
+static void prv_neonToPlanar(const float *pFrames, size_t frames,
+                             size_t channels, float *const *ppPlanes)
+{
+  size_t frame = 0;
+
+  /* Structure loads split up to 3 interleaved channels by themselves */
+  if (channels == 1)
+  {
+    memcpy(ppPlanes[0], pFrames, frames * sizeof(float));
+    return;
+  }
+  else if (channels == 2)
+  {
+    for (; frame + 4 <= frames; frame += 4)
+    {
+      float32x4x2_t values = vld2q_f32(pFrames + frame * 2);
+      vst1q_f32(ppPlanes[0] + frame, values.val[0]);
+      vst1q_f32(ppPlanes[1] + frame, values.val[1]);
+    }
+  }
+  else if (channels == 3)
+  {
+    for (; frame + 4 <= frames; frame += 4)
+    {
+      float32x4x3_t values = vld3q_f32(pFrames + frame * 3);
+      vst1q_f32(ppPlanes[0] + frame, values.val[0]);
+      vst1q_f32(ppPlanes[1] + frame, values.val[1]);
+      vst1q_f32(ppPlanes[2] + frame, values.val[2]);
+    }
+  }
+  else
+  {
+    /* 4 frames by 4 channels at a time, the last channels one by one */
+    for (; frame + 4 <= frames; frame += 4)
+    {
+      const float *pRow = pFrames + frame * channels;
+      size_t ch = 0;
+      for (; ch + 4 <= channels; ch += 4)
+      {
+        float32x4x2_t rows01 = vtrnq_f32(vld1q_f32(pRow + ch),
+                                         vld1q_f32(pRow + channels + ch));
+        float32x4x2_t rows23 = vtrnq_f32(vld1q_f32(pRow + 2 * channels + ch),
+                                         vld1q_f32(pRow + 3 * channels + ch));
+        vst1q_f32(ppPlanes[ch] + frame,
+                  vcombine_f32(vget_low_f32(rows01.val[0]),
+                               vget_low_f32(rows23.val[0])));
+        vst1q_f32(ppPlanes[ch + 1] + frame,
+                  vcombine_f32(vget_low_f32(rows01.val[1]),
+                               vget_low_f32(rows23.val[1])));
+        vst1q_f32(ppPlanes[ch + 2] + frame,
+                  vcombine_f32(vget_high_f32(rows01.val[0]),
+                               vget_high_f32(rows23.val[0])));
+        vst1q_f32(ppPlanes[ch + 3] + frame,
+                  vcombine_f32(vget_high_f32(rows01.val[1]),
+                               vget_high_f32(rows23.val[1])));
+      }
+      for (; ch < channels; ++ch)
+      {
+        for (size_t k = 0; k < 4; ++k)
+        {
+          ppPlanes[ch][frame + k] = pRow[k * channels + ch];
+        }
+      }
+    }
+  }
+
+  for (; frame < frames; ++frame)
+  {
+    for (size_t ch = 0; ch < channels; ++ch)
+    {
+      ppPlanes[ch][frame] = pFrames[frame * channels + ch];
+    }
+  }
+}
+
+static void prv_neonConvertInt16(const int16_t *pInput, size_t count,
+                                 float scale, float offset, float *pOutput)
+{
+  float32x4_t offsets = vdupq_n_f32(offset);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    int16x8_t values = vld1q_s16(pInput + i);
+    float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(values)));
+    float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(values)));
+    vst1q_f32(pOutput + i, vaddq_f32(vmulq_n_f32(low, scale), offsets));
+    vst1q_f32(pOutput + i + 4, vaddq_f32(vmulq_n_f32(high, scale), offsets));
+  }
+  for (; i < count; ++i)
+  {
+    pOutput[i] = static_cast<float>(pInput[i]) * scale + offset;
+  }
+}
+
+static void prv_neonConvertInt32(const int32_t *pInput, size_t count,
+                                 float scale, float offset, float *pOutput)
+{
+  float32x4_t offsets = vdupq_n_f32(offset);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    float32x4_t values = vcvtq_f32_s32(vld1q_s32(pInput + i));
+    vst1q_f32(pOutput + i, vaddq_f32(vmulq_n_f32(values, scale), offsets));
+  }
+  for (; i < count; ++i)
+  {
+    pOutput[i] = static_cast<float>(pInput[i]) * scale + offset;
+  }
+}
+
+static void prv_neonScaleOffset(const float *pInput, size_t count,
+                                float scale, float offset, float *pOutput)
+{
+  float32x4_t offsets = vdupq_n_f32(offset);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    float32x4_t values = vld1q_f32(pInput + i);
+    vst1q_f32(pOutput + i, vaddq_f32(vmulq_n_f32(values, scale), offsets));
+  }
+  for (; i < count; ++i)
+  {
+    pOutput[i] = pInput[i] * scale + offset;
+  }
+}
+
+static double prv_neonDot(const float *pA, const float *pB, size_t count)
+{
+  float64x2_t sumLow = vdupq_n_f64(0.0);
+  float64x2_t sumHigh = vdupq_n_f64(0.0);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    float32x4_t a = vld1q_f32(pA + i);
+    float32x4_t b = vld1q_f32(pB + i);
+    sumLow = vfmaq_f64(sumLow, vcvt_f64_f32(vget_low_f32(a)),
+                       vcvt_f64_f32(vget_low_f32(b)));
+    sumHigh = vfmaq_f64(sumHigh, vcvt_high_f64_f32(a), vcvt_high_f64_f32(b));
+  }
+
+  double sum = vaddvq_f64(vaddq_f64(sumLow, sumHigh));
+  for (; i < count; ++i)
+  {
+    sum += static_cast<double>(pA[i]) * pB[i];
+  }
+  return sum;
+}
+
+static const NumericKernels neonKernels = {
+  "neon",
+  prv_neonMinMaxSum,
+  prv_neonBucketMinMax,
+  prv_neonToPlanar,
+  prv_neonConvertInt16,
+  prv_neonConvertInt32,
+  prv_neonScaleOffset,
+  prv_neonDot,
+};
+
+const NumericKernels *getNeonKernels(void)
+{
+  return &neonKernels;
+}
+
+#else
+
+const NumericKernels *getNeonKernels(void)
+{
+  return nullptr;
+}
+
+#endif
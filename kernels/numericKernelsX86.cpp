@@ -0,0 +1,594 @@
+/** @file      numericKernelsX86.cpp
+ *  @brief     Source file for the SSE4.1 and AVX2 kernels.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/09
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "numericKernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+/* Built with the flags of the rest of the application: only these functions
+ * use the extensions, and they are only called when the CPU has them */
+#define SSE41_TARGET __attribute__((target("sse4.1")))
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+static const float NOT_A_NUMBER = std::numeric_limits<float>::quiet_NaN();
+
+/* Tail of a span and the lanes of the vector loop, merged */
+static void prv_finishMinMaxSum(const float *pValues, size_t count,
+                                const float *pLaneMin, const float *pLaneMax,
+                                size_t lanes, double sum, size_t numbers,
+                                SpanStatistics &statistics)
+{
+  float minValue = std::numeric_limits<float>::infinity();
+  float maxValue = -std::numeric_limits<float>::infinity();
+  for (size_t lane = 0; lane < lanes; ++lane)
+  {
+    minValue = std::min(minValue, pLaneMin[lane]);
+    maxValue = std::max(maxValue, pLaneMax[lane]);
+  }
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    float value = pValues[i];
+    if (std::isnan(value))
+    {
+      continue;
+    }
+    minValue = std::min(minValue, value);
+    maxValue = std::max(maxValue, value);
+    sum += value;
+    numbers++;
+  }
+
+  statistics.minValue = (numbers > 0) ? minValue : NOT_A_NUMBER;
+  statistics.maxValue = (numbers > 0) ? maxValue : NOT_A_NUMBER;
+  statistics.sum = sum;
+  statistics.count = numbers;
+}
+
+static void prv_finishToPlanar(const float *pFrames, size_t frame,
+                               size_t frames, size_t channels,
+                               float *const *ppPlanes)
+{
+  for (; frame < frames; ++frame)
+  {
+    for (size_t ch = 0; ch < channels; ++ch)
+    {
+      ppPlanes[ch][frame] = pFrames[frame * channels + ch];
+    }
+  }
+}
+
+/* SSE4.1
+ * -------------------------------------------------------------------------------
+ */
+
+SSE41_TARGET static void prv_sseMinMaxSum(const float *pValues, size_t count,
+                                          SpanStatistics &statistics)
+{
+  /* min/max return their second operand when the first one is NaN */
+  __m128 minimum = _mm_set1_ps(std::numeric_limits<float>::infinity());
+  __m128 maximum = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+  __m128d sumLow = _mm_setzero_pd();
+  __m128d sumHigh = _mm_setzero_pd();
+  __m128i numbers = _mm_setzero_si128();
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128 values = _mm_loadu_ps(pValues + i);
+    __m128 ordered = _mm_cmpord_ps(values, values);
+    minimum = _mm_min_ps(values, minimum);
+    maximum = _mm_max_ps(values, maximum);
+
+    __m128 kept = _mm_and_ps(values, ordered);
+    sumLow = _mm_add_pd(sumLow, _mm_cvtps_pd(kept));
+    sumHigh = _mm_add_pd(sumHigh, _mm_cvtps_pd(_mm_movehl_ps(kept, kept)));
+    numbers = _mm_sub_epi32(numbers, _mm_castps_si128(ordered));
+  }
+
+  alignas(16) float laneMin[4];
+  alignas(16) float laneMax[4];
+  alignas(16) double laneSum[2];
+  alignas(16) uint32_t laneNumbers[4];
+  _mm_store_ps(laneMin, minimum);
+  _mm_store_ps(laneMax, maximum);
+  _mm_store_pd(laneSum, _mm_add_pd(sumLow, sumHigh));
+  _mm_store_si128(reinterpret_cast<__m128i *>(laneNumbers), numbers);
+
+  size_t total = static_cast<size_t>(laneNumbers[0]) + laneNumbers[1]
+                 + laneNumbers[2] + laneNumbers[3];
+  prv_finishMinMaxSum(pValues + i, count - i, laneMin, laneMax, 4,
+                      laneSum[0] + laneSum[1], total, statistics);
+}
+
+SSE41_TARGET static void prv_sseBucketMinMax(const float *pValues,
+                                             size_t count, size_t bucketSize,
+                                             float *pMin, float *pMax,
+                                             float *pMean)
+{
+  for (size_t bucket = 0; bucket * bucketSize < count; ++bucket)
+  {
+    size_t first = bucket * bucketSize;
+    SpanStatistics statistics;
+    prv_sseMinMaxSum(pValues + first, std::min(bucketSize, count - first),
+                     statistics);
+    pMin[bucket] = statistics.minValue;
+    pMax[bucket] = statistics.maxValue;
+    if (pMean != nullptr)
+    {
+      pMean[bucket] = (statistics.count > 0)
+                          ? static_cast<float>(statistics.sum / statistics.count)
+                          : NOT_A_NUMBER;
+    }
+  }
+}
+
+SSE41_TARGET static void prv_sseToPlanar(const float *pFrames, size_t frames,
+                                         size_t channels,
+                                         float *const *ppPlanes)
+{
+  size_t frame = 0;
+
+  if (channels == 1)
+  {
+    memcpy(ppPlanes[0], pFrames, frames * sizeof(float));
+    return;
+  }
+
+  if (channels == 2)
+  {
+    for (; frame + 4 <= frames; frame += 4)
+    {
+      __m128 low = _mm_loadu_ps(pFrames + frame * 2);
+      __m128 high = _mm_loadu_ps(pFrames + frame * 2 + 4);
+      _mm_storeu_ps(ppPlanes[0] + frame,
+                    _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0)));
+      _mm_storeu_ps(ppPlanes[1] + frame,
+                    _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+  }
+  else if (channels == 3)
+  {
+    /* 4 frames in 3 vectors, each channel blended out of them and put back
+     * in frame order */
+    for (; frame + 4 <= frames; frame += 4)
+    {
+      __m128 first = _mm_loadu_ps(pFrames + frame * 3);
+      __m128 second = _mm_loadu_ps(pFrames + frame * 3 + 4);
+      __m128 third = _mm_loadu_ps(pFrames + frame * 3 + 8);
+
+      __m128 ch0 = _mm_blend_ps(_mm_blend_ps(first, second, 0x4), third, 0x2);
+      __m128 ch1 = _mm_blend_ps(_mm_blend_ps(first, second, 0x9), third, 0x4);
+      __m128 ch2 = _mm_blend_ps(_mm_blend_ps(first, second, 0x2), third, 0x9);
+      _mm_storeu_ps(ppPlanes[0] + frame,
+                    _mm_shuffle_ps(ch0, ch0, _MM_SHUFFLE(1, 2, 3, 0)));
+      _mm_storeu_ps(ppPlanes[1] + frame,
+                    _mm_shuffle_ps(ch1, ch1, _MM_SHUFFLE(2, 3, 0, 1)));
+      _mm_storeu_ps(ppPlanes[2] + frame,
+                    _mm_shuffle_ps(ch2, ch2, _MM_SHUFFLE(3, 0, 1, 2)));
+    }
+  }
+  else
+  {
+    /* 4 frames by 4 channels at a time, the last channels one by one */
+    for (; frame + 4 <= frames; frame += 4)
+    {
+      const float *pRow = pFrames + frame * channels;
+      size_t ch = 0;
+      for (; ch + 4 <= channels; ch += 4)
+      {
+        __m128 row0 = _mm_loadu_ps(pRow + ch);
+        __m128 row1 = _mm_loadu_ps(pRow + channels + ch);
+        __m128 row2 = _mm_loadu_ps(pRow + 2 * channels + ch);
+        __m128 row3 = _mm_loadu_ps(pRow + 3 * channels + ch);
+        _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+        _mm_storeu_ps(ppPlanes[ch] + frame, row0);
+        _mm_storeu_ps(ppPlanes[ch + 1] + frame, row1);
+        _mm_storeu_ps(ppPlanes[ch + 2] + frame, row2);
+        _mm_storeu_ps(ppPlanes[ch + 3] + frame, row3);
+      }
+      for (; ch < channels; ++ch)
+      {
+        for (size_t k = 0; k < 4; ++k)
+        {
+          ppPlanes[ch][frame + k] = pRow[k * channels + ch];
+        }
+      }
+    }
+  }
+
+  prv_finishToPlanar(pFrames, frame, frames, channels, ppPlanes);
+}
+
+SSE41_TARGET static void prv_sseConvertInt16(const int16_t *pInput,
+                                             size_t count, float scale,
+                                             float offset, float *pOutput)
+{
+  __m128 scales = _mm_set1_ps(scale);
+  __m128 offsets = _mm_set1_ps(offset);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128i values
+        = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pInput + i));
+    __m128 low = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(values));
+    __m128 high = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(values, 8)));
+    _mm_storeu_ps(pOutput + i, _mm_add_ps(_mm_mul_ps(low, scales), offsets));
+    _mm_storeu_ps(pOutput + i + 4,
+                  _mm_add_ps(_mm_mul_ps(high, scales), offsets));
+  }
+  for (; i < count; ++i)
+  {
+    pOutput[i] = static_cast<float>(pInput[i]) * scale + offset;
+  }
+}
+
+SSE41_TARGET static void prv_sseConvertInt32(const int32_t *pInput,
+                                             size_t count, float scale,
+                                             float offset, float *pOutput)
+{
+  __m128 scales = _mm_set1_ps(scale);
+  __m128 offsets = _mm_set1_ps(offset);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128 values = _mm_cvtepi32_ps(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(pInput + i)));
+    _mm_storeu_ps(pOutput + i, _mm_add_ps(_mm_mul_ps(values, scales), offsets));
+  }
+  for (; i < count; ++i)
+  {
+    pOutput[i] = static_cast<float>(pInput[i]) * scale + offset;
+  }
+}
+
+SSE41_TARGET static void prv_sseScaleOffset(const float *pInput, size_t count,
+                                            float scale, float offset,
+                                            float *pOutput)
+{
+  __m128 scales = _mm_set1_ps(scale);
+  __m128 offsets = _mm_set1_ps(offset);
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128 values = _mm_loadu_ps(pInput + i);
+    _mm_storeu_ps(pOutput + i, _mm_add_ps(_mm_mul_ps(values, scales), offsets));
+  }
+  for (; i < count; ++i)
+  {
+    pOutput[i] = pInput[i] * scale + offset;
+  }
+}
+
+SSE41_TARGET static double prv_sseDot(const float *pA, const float *pB,
+                                      size_t count)
+{
+  __m128d sumLow = _mm_setzero_pd();
+  __m128d sumHigh = _mm_setzero_pd();
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128 a = _mm_loadu_ps(pA + i);
+    __m128 b = _mm_loadu_ps(pB + i);
+    sumLow = _mm_add_pd(sumLow,
+                        _mm_mul_pd(_mm_cvtps_pd(a), _mm_cvtps_pd(b)));
+    sumHigh = _mm_add_pd(sumHigh,
+                         _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(a, a)),
+                                    _mm_cvtps_pd(_mm_movehl_ps(b, b))));
+  }
+
+  alignas(16) double laneSum[2];
+  _mm_store_pd(laneSum, _mm_add_pd(sumLow, sumHigh));
+  double sum = laneSum[0] + laneSum[1];
+  for (; i < count; ++i)
+  {
+    sum += static_cast<double>(pA[i]) * pB[i];
+  }
+  return sum;
+}
+
+static const NumericKernels sse41Kernels = {
+  "sse4.1",
+  prv_sseMinMaxSum,
+  prv_sseBucketMinMax,
+  prv_sseToPlanar,
+  prv_sseConvertInt16,
+  prv_sseConvertInt32,
+  prv_sseScaleOffset,
+  prv_sseDot,
+};
+
+/* AVX2
+ * -------------------------------------------------------------------------------
+ */
+
+AVX2_TARGET static void prv_avxMinMaxSum(const float *pValues, size_t count,
+                                         SpanStatistics &statistics)
+{
+  __m256 minimum = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+  __m256 maximum = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+  __m256d sumLow = _mm256_setzero_pd();
+  __m256d sumHigh = _mm256_setzero_pd();
+  __m256i numbers = _mm256_setzero_si256();
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256 values = _mm256_loadu_ps(pValues + i);
+    __m256 ordered = _mm256_cmp_ps(values, values, _CMP_ORD_Q);
+    minimum = _mm256_min_ps(values, minimum);
+    maximum = _mm256_max_ps(values, maximum);
+
+    __m256 kept = _mm256_and_ps(values, ordered);
+    sumLow = _mm256_add_pd(sumLow,
+                           _mm256_cvtps_pd(_mm256_castps256_ps128(kept)));
+    sumHigh = _mm256_add_pd(sumHigh,
+                            _mm256_cvtps_pd(_mm256_extractf128_ps(kept, 1)));
+    numbers = _mm256_sub_epi32(numbers, _mm256_castps_si256(ordered));
+  }
+
+  alignas(32) float laneMin[8];
+  alignas(32) float laneMax[8];
+  alignas(32) double laneSum[4];
+  alignas(32) uint32_t laneNumbers[8];
+  _mm256_store_ps(laneMin, minimum);
+  _mm256_store_ps(laneMax, maximum);
+  _mm256_store_pd(laneSum, _mm256_add_pd(sumLow, sumHigh));
+  _mm256_store_si256(reinterpret_cast<__m256i *>(laneNumbers), numbers);
+
+  size_t total = 0;
+  for (uint32_t laneCount : laneNumbers)
+  {
+    total += laneCount;
+  }
+  prv_finishMinMaxSum(pValues + i, count - i, laneMin, laneMax, 8,
+                      laneSum[0] + laneSum[1] + laneSum[2] + laneSum[3], total,
+                      statistics);
+}
+
+AVX2_TARGET static void prv_avxBucketMinMax(const float *pValues,
+                                            size_t count, size_t bucketSize,
+                                            float *pMin, float *pMax,
+                                            float *pMean)
+{
+  for (size_t bucket = 0; bucket * bucketSize < count; ++bucket)
+  {
+    size_t first = bucket * bucketSize;
+    SpanStatistics statistics;
+    prv_avxMinMaxSum(pValues + first, std::min(bucketSize, count - first),
+                     statistics);
+    pMin[bucket] = statistics.minValue;
+    pMax[bucket] = statistics.maxValue;
+    if (pMean != nullptr)
+    {
+      pMean[bucket] = (statistics.count > 0)
+                          ? static_cast<float>(statistics.sum / statistics.count)
+                          : NOT_A_NUMBER;
+    }
+  }
+}
+
+/* Frames k and k + 4 in the low and high halves */
+AVX2_TARGET static inline __m256 prv_avxLoadRows(const float *pLow,
+                                                 const float *pHigh)
+{
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(pLow)),
+                              _mm_loadu_ps(pHigh), 1);
+}
+
+AVX2_TARGET static void prv_avxToPlanar(const float *pFrames, size_t frames,
+                                        size_t channels,
+                                        float *const *ppPlanes)
+{
+  size_t frame = 0;
+
+  if (channels == 1)
+  {
+    memcpy(ppPlanes[0], pFrames, frames * sizeof(float));
+    return;
+  }
+  if (channels == 3)
+  {
+    prv_sseToPlanar(pFrames, frames, channels, ppPlanes);
+    return;
+  }
+
+  if (channels == 2)
+  {
+    for (; frame + 8 <= frames; frame += 8)
+    {
+      __m256 low = _mm256_loadu_ps(pFrames + frame * 2);
+      __m256 high = _mm256_loadu_ps(pFrames + frame * 2 + 8);
+      /* Frames 0 1 4 5 | 2 3 6 7 per lane, then the 64-bit pairs in order */
+      __m256 even = _mm256_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0));
+      __m256 odd = _mm256_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1));
+      _mm256_storeu_ps(ppPlanes[0] + frame,
+                       _mm256_castpd_ps(_mm256_permute4x64_pd(
+                           _mm256_castps_pd(even), _MM_SHUFFLE(3, 1, 2, 0))));
+      _mm256_storeu_ps(ppPlanes[1] + frame,
+                       _mm256_castpd_ps(_mm256_permute4x64_pd(
+                           _mm256_castps_pd(odd), _MM_SHUFFLE(3, 1, 2, 0))));
+    }
+  }
+  else
+  {
+    /* 8 frames by 4 channels: two 4x4 transposes, one per 128-bit lane */
+    for (; frame + 8 <= frames; frame += 8)
+    {
+      const float *pRow = pFrames + frame * channels;
+      const float *pRow4 = pRow + 4 * channels;
+      size_t ch = 0;
+      for (; ch + 4 <= channels; ch += 4)
+      {
+        __m256 row0 = prv_avxLoadRows(pRow + ch, pRow4 + ch);
+        __m256 row1 = prv_avxLoadRows(pRow + channels + ch,
+                                      pRow4 + channels + ch);
+        __m256 row2 = prv_avxLoadRows(pRow + 2 * channels + ch,
+                                      pRow4 + 2 * channels + ch);
+        __m256 row3 = prv_avxLoadRows(pRow + 3 * channels + ch,
+                                      pRow4 + 3 * channels + ch);
+
+        __m256 low01 = _mm256_unpacklo_ps(row0, row1);
+        __m256 low23 = _mm256_unpacklo_ps(row2, row3);
+        __m256 high01 = _mm256_unpackhi_ps(row0, row1);
+        __m256 high23 = _mm256_unpackhi_ps(row2, row3);
+        _mm256_storeu_ps(ppPlanes[ch] + frame,
+                         _mm256_shuffle_ps(low01, low23, 0x44));
+        _mm256_storeu_ps(ppPlanes[ch + 1] + frame,
+                         _mm256_shuffle_ps(low01, low23, 0xEE));
+        _mm256_storeu_ps(ppPlanes[ch + 2] + frame,
+                         _mm256_shuffle_ps(high01, high23, 0x44));
+        _mm256_storeu_ps(ppPlanes[ch + 3] + frame,
+                         _mm256_shuffle_ps(high01, high23, 0xEE));
+      }
+      for (; ch < channels; ++ch)
+      {
+        for (size_t k = 0; k < 8; ++k)
+        {
+          ppPlanes[ch][frame + k] = pRow[k * channels + ch];
+        }
+      }
+    }
+  }
+
+  prv_finishToPlanar(pFrames, frame, frames, channels, ppPlanes);
+}
+
+AVX2_TARGET static void prv_avxConvertInt16(const int16_t *pInput,
+                                            size_t count, float scale,
+                                            float offset, float *pOutput)
+{
+  __m256 scales = _mm256_set1_ps(scale);
+  __m256 offsets = _mm256_set1_ps(offset);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256 values = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(pInput + i))));
+    _mm256_storeu_ps(pOutput + i,
+                     _mm256_add_ps(_mm256_mul_ps(values, scales), offsets));
+  }
+  for (; i < count; ++i)
+  {
+    pOutput[i] = static_cast<float>(pInput[i]) * scale + offset;
+  }
+}
+
+AVX2_TARGET static void prv_avxConvertInt32(const int32_t *pInput,
+                                            size_t count, float scale,
+                                            float offset, float *pOutput)
+{
+  __m256 scales = _mm256_set1_ps(scale);
+  __m256 offsets = _mm256_set1_ps(offset);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256 values = _mm256_cvtepi32_ps(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pInput + i)));
+    _mm256_storeu_ps(pOutput + i,
+                     _mm256_add_ps(_mm256_mul_ps(values, scales), offsets));
+  }
+  for (; i < count; ++i)
+  {
+    pOutput[i] = static_cast<float>(pInput[i]) * scale + offset;
+  }
+}
+
+AVX2_TARGET static void prv_avxScaleOffset(const float *pInput, size_t count,
+                                           float scale, float offset,
+                                           float *pOutput)
+{
+  __m256 scales = _mm256_set1_ps(scale);
+  __m256 offsets = _mm256_set1_ps(offset);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256 values = _mm256_loadu_ps(pInput + i);
+    _mm256_storeu_ps(pOutput + i,
+                     _mm256_add_ps(_mm256_mul_ps(values, scales), offsets));
+  }
+  for (; i < count; ++i)
+  {
+    pOutput[i] = pInput[i] * scale + offset;
+  }
+}
+
+AVX2_TARGET static double prv_avxDot(const float *pA, const float *pB,
+                                     size_t count)
+{
+  __m256d sumLow = _mm256_setzero_pd();
+  __m256d sumHigh = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256 a = _mm256_loadu_ps(pA + i);
+    __m256 b = _mm256_loadu_ps(pB + i);
+    sumLow = _mm256_add_pd(
+        sumLow, _mm256_mul_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(a)),
+                              _mm256_cvtps_pd(_mm256_castps256_ps128(b))));
+    sumHigh = _mm256_add_pd(
+        sumHigh, _mm256_mul_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(a, 1)),
+                               _mm256_cvtps_pd(_mm256_extractf128_ps(b, 1))));
+  }
+
+  alignas(32) double laneSum[4];
+  _mm256_store_pd(laneSum, _mm256_add_pd(sumLow, sumHigh));
+  double sum = laneSum[0] + laneSum[1] + laneSum[2] + laneSum[3];
+  for (; i < count; ++i)
+  {
+    sum += static_cast<double>(pA[i]) * pB[i];
+  }
+  return sum;
+}
+
+static const NumericKernels avx2Kernels = {
+  "avx2",
+  prv_avxMinMaxSum,
+  prv_avxBucketMinMax,
+  prv_avxToPlanar,
+  prv_avxConvertInt16,
+  prv_avxConvertInt32,
+  prv_avxScaleOffset,
+  prv_avxDot,
+};
+
+const NumericKernels *getSse41Kernels(void)
+{
+  return __builtin_cpu_supports("sse4.1") ? &sse41Kernels : nullptr;
+}
+
+const NumericKernels *getAvx2Kernels(void)
+{
+  return __builtin_cpu_supports("avx2") ? &avx2Kernels : nullptr;
+}
+
+#else
+
+const NumericKernels *getSse41Kernels(void)
+{
+  return nullptr;
+}
+
+const NumericKernels *getAvx2Kernels(void)
+{
+  return nullptr;
+}
+
+#endif
@@ -23,8 +23,9 @@
 #include <iostream>
 #include <memory>
 
-/* GL includes - Raspberry Pi uses OpenGL ES directly */
-  #include <GLES2/gl2.h>
+/* GL includes - Raspberry Pi uses OpenGL ES directly, the OpenGL ES 3.0
+ * functions are only called when the context has them */
+  #include <GLES3/gl3.h>
   #include <GLES2/gl2ext.h>
 #include "../dependencies/include/GLFW/glfw3.h"
 #include "../dependencies/include/GLFW/glfw3native.h"
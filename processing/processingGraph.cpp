@@ -0,0 +1,715 @@
+/** @file      processingGraph.cpp
+ *  @brief     Source file for the per-channel processing graph.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/07
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "processingGraph.h"
+#include "processingSchedule.h"
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+
+#define PROFILE_HEADER "# mscope processing profile"
+
+/* Bounds keeping the runner state small */
+#define MAX_INPUT_CHANNEL (1023)
+#define MAX_FILTER_WINDOW (4096)
+#define MAX_DECIMATION_FACTOR (100000)
+
+static const UnitConversion unitConversions[] = {
+    {"mV to V", "V", 0.001f, 0.0f},
+    {"V to mV", "mV", 1000.0f, 0.0f},
+    {"mA to A", "A", 0.001f, 0.0f},
+    {"A to mA", "mA", 1000.0f, 0.0f},
+    {"degC to degF", "degF", 1.8f, 32.0f},
+    {"degF to degC", "degC", 5.0f / 9.0f, -160.0f / 9.0f},
+    {"Pa to kPa", "kPa", 0.001f, 0.0f},
+    {"kPa to psi", "psi", 0.1450377f, 0.0f},
+    {"m/s2 to g", "g", 1.0f / 9.80665f, 0.0f},
+    {"g to m/s2", "m/s2", 9.80665f, 0.0f},
+};
+
+static const char *nodeTypeNames[NODE_TYPE_COUNT] = {
+    "input", "scale", "unit", "filter", "decimate", "math", "display", "record"};
+
+static const char *filterTypeNames[FILTER_TYPE_COUNT] = {
+    "moving-average", "low-pass", "high-pass"};
+
+static const char *mathOperationNames[MATH_OPERATION_COUNT] = {
+    "add", "subtract", "multiply", "divide", "min", "max"};
+
+const UnitConversion *getUnitConversions(size_t &count)
+{
+  count = sizeof(unitConversions) / sizeof(unitConversions[0]);
+  return unitConversions;
+}
+
+const char *getProcessingNodeTypeName(ProcessingNodeType_t type)
+{
+  return (type < NODE_TYPE_COUNT) ? nodeTypeNames[type] : "?";
+}
+
+const char *getFilterTypeName(FilterType_t type)
+{
+  return (type < FILTER_TYPE_COUNT) ? filterTypeNames[type] : "?";
+}
+
+const char *getMathOperationName(MathOperation_t operation)
+{
+  return (operation < MATH_OPERATION_COUNT) ? mathOperationNames[operation]
+                                            : "?";
+}
+
+size_t getProcessingNodeInputCount(ProcessingNodeType_t type)
+{
+  switch (type)
+  {
+  case NODE_INPUT:
+    return 0;
+  case NODE_MATH:
+    return 2;
+  default:
+    return 1;
+  }
+}
+
+template<typename T, size_t N>
+static bool prv_findName(const char *const (&names)[N], const std::string &name,
+                         T &value)
+{
+  for (size_t i = 0; i < N; ++i)
+  {
+    if (name == names[i])
+    {
+      value = static_cast<T>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+ProcessingGraph::ProcessingGraph(void)
+  : nextId_m(1)
+{
+}
+
+ProcessingGraph ProcessingGraph::makeDefault(int channels)
+{
+  ProcessingGraph graph;
+  for (int channel = 0; channel < channels; ++channel)
+  {
+    uint32_t input = graph.addNode(NODE_INPUT);
+    graph.findNode(input)->channel = channel;
+    graph.findNode(input)->name = "Channel_" + std::to_string(channel + 1);
+
+    for (ProcessingNodeType_t type : {NODE_DISPLAY, NODE_RECORD})
+    {
+      ProcessingNode *pOutput = graph.findNode(graph.addNode(type));
+      pOutput->inputs = {input};
+      pOutput->name = "Channel_" + std::to_string(channel + 1);
+    }
+  }
+  return graph;
+}
+
+ProcessingNode *ProcessingGraph::findNode(uint32_t id)
+{
+  for (ProcessingNode &node : nodes_m)
+  {
+    if (node.id == id)
+    {
+      return &node;
+    }
+  }
+  return nullptr;
+}
+
+uint32_t ProcessingGraph::addNode(ProcessingNodeType_t type)
+{
+  ProcessingNode node;
+  node.id = nextId_m++;
+  node.type = type;
+  node.name = std::string(getProcessingNodeTypeName(type)) + "_"
+              + std::to_string(node.id);
+  /* Unconnected until an input is chosen */
+  node.inputs.assign(getProcessingNodeInputCount(type), 0);
+  nodes_m.push_back(node);
+  return node.id;
+}
+
+void ProcessingGraph::removeNode(uint32_t id)
+{
+  nodes_m.erase(std::remove_if(nodes_m.begin(), nodes_m.end(),
+                               [id](const ProcessingNode &node)
+                               { return node.id == id; }),
+                nodes_m.end());
+
+  for (ProcessingNode &node : nodes_m)
+  {
+    std::replace(node.inputs.begin(), node.inputs.end(), id, 0u);
+  }
+}
+
+void ProcessingGraph::clear(void)
+{
+  nodes_m.clear();
+  nextId_m = 1;
+}
+
+static std::string prv_quote(const std::string &text)
+{
+  std::string quoted = "\"";
+  for (char c : text)
+  {
+    /* Quotes and line breaks would break the line format */
+    quoted += (c == '"' || c == '\n' || c == '\r') ? '\'' : c;
+  }
+  return quoted + "\"";
+}
+
+static std::string prv_number(float value)
+{
+  char text[32];
+  snprintf(text, sizeof(text), "%.9g", value);
+  return text;
+}
+
+OrbCode_t ProcessingGraph::save(const std::string &filename) const
+{
+  std::ofstream file(filename);
+  if (!file.is_open())
+  {
+    return OpenError;
+  }
+
+  file << PROFILE_HEADER << "\n";
+  for (const ProcessingNode &node : nodes_m)
+  {
+    file << "node " << node.id << " " << getProcessingNodeTypeName(node.type)
+         << " name=" << prv_quote(node.name);
+
+    if (!node.inputs.empty())
+    {
+      file << " in=";
+      for (size_t i = 0; i < node.inputs.size(); ++i)
+      {
+        file << (i > 0 ? "," : "") << node.inputs[i];
+      }
+    }
+
+    switch (node.type)
+    {
+    case NODE_INPUT:
+      file << " channel=" << node.channel;
+      break;
+    case NODE_SCALE:
+      file << " gain=" << prv_number(node.gain)
+           << " offset=" << prv_number(node.offset)
+           << " unit=" << prv_quote(node.unit);
+      break;
+    case NODE_UNIT:
+    {
+      size_t count = 0;
+      const UnitConversion *pConversions = getUnitConversions(count);
+      file << " conversion="
+           << prv_quote(pConversions[std::min<size_t>(node.conversion,
+                                                      count - 1)]
+                            .pName);
+      break;
+    }
+    case NODE_FILTER:
+      file << " type=" << getFilterTypeName(node.filter)
+           << " window=" << node.window << " alpha=" << prv_number(node.alpha);
+      break;
+    case NODE_DECIMATE:
+      file << " factor=" << node.factor;
+      break;
+    case NODE_MATH:
+      file << " op=" << getMathOperationName(node.operation);
+      break;
+    default:
+      break;
+    }
+    file << "\n";
+  }
+
+  return file.good() ? Success : OpenError;
+}
+
+/* Splits a profile line on spaces, double quotes group spaces in values */
+static std::vector<std::string> prv_tokenize(const std::string &line)
+{
+  std::vector<std::string> tokens;
+  std::string token;
+  bool quoted = false;
+  bool inToken = false;
+
+  for (char c : line)
+  {
+    if (c == '"')
+    {
+      quoted = !quoted;
+      inToken = true;
+    }
+    else if (!quoted && (c == ' ' || c == '\t' || c == '\r'))
+    {
+      if (inToken)
+      {
+        tokens.push_back(token);
+        token.clear();
+        inToken = false;
+      }
+    }
+    else
+    {
+      token += c;
+      inToken = true;
+    }
+  }
+  if (inToken)
+  {
+    tokens.push_back(token);
+  }
+  return tokens;
+}
+
+static bool prv_parseNode(const std::vector<std::string> &tokens,
+                          ProcessingNode &node)
+{
+  if (tokens.size() < 3 || tokens[0] != "node"
+      || !prv_findName(nodeTypeNames, tokens[2], node.type))
+  {
+    return false;
+  }
+
+  char *pEnd = nullptr;
+  node.id = static_cast<uint32_t>(strtoul(tokens[1].c_str(), &pEnd, 10));
+  if (*pEnd != '\0' || node.id == 0)
+  {
+    return false;
+  }
+  node.name = tokens[2] + "_" + tokens[1];
+  node.inputs.assign(getProcessingNodeInputCount(node.type), 0);
+
+  for (size_t i = 3; i < tokens.size(); ++i)
+  {
+    size_t equal = tokens[i].find('=');
+    if (equal == std::string::npos)
+    {
+      return false;
+    }
+    std::string key = tokens[i].substr(0, equal);
+    std::string value = tokens[i].substr(equal + 1);
+
+    if (key == "name")
+    {
+      node.name = value;
+    }
+    else if (key == "in")
+    {
+      node.inputs.clear();
+      std::stringstream inputs(value);
+      std::string input;
+      while (std::getline(inputs, input, ','))
+      {
+        node.inputs.push_back(static_cast<uint32_t>(atol(input.c_str())));
+      }
+    }
+    else if (key == "channel")
+    {
+      node.channel = atoi(value.c_str());
+    }
+    else if (key == "gain")
+    {
+      node.gain = static_cast<float>(atof(value.c_str()));
+    }
+    else if (key == "offset")
+    {
+      node.offset = static_cast<float>(atof(value.c_str()));
+    }
+    else if (key == "unit")
+    {
+      node.unit = value;
+    }
+    else if (key == "conversion")
+    {
+      size_t count = 0;
+      const UnitConversion *pConversions = getUnitConversions(count);
+      node.conversion = -1;
+      for (size_t c = 0; c < count; ++c)
+      {
+        if (value == pConversions[c].pName)
+        {
+          node.conversion = static_cast<int>(c);
+        }
+      }
+      if (node.conversion < 0)
+      {
+        return false;
+      }
+    }
+    else if (key == "type")
+    {
+      if (!prv_findName(filterTypeNames, value, node.filter))
+      {
+        return false;
+      }
+    }
+    else if (key == "window")
+    {
+      node.window = atoi(value.c_str());
+    }
+    else if (key == "alpha")
+    {
+      node.alpha = static_cast<float>(atof(value.c_str()));
+    }
+    else if (key == "factor")
+    {
+      node.factor = atoi(value.c_str());
+    }
+    else if (key == "op")
+    {
+      if (!prv_findName(mathOperationNames, value, node.operation))
+      {
+        return false;
+      }
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+OrbCode_t ProcessingGraph::load(const std::string &filename)
+{
+  std::ifstream file(filename);
+  if (!file.is_open())
+  {
+    return OpenError;
+  }
+
+  std::vector<ProcessingNode> nodes;
+  uint32_t nextId = 1;
+  std::string line;
+  while (std::getline(file, line))
+  {
+    std::vector<std::string> tokens = prv_tokenize(line);
+    if (tokens.empty() || tokens[0][0] == '#')
+    {
+      continue;
+    }
+
+    ProcessingNode node;
+    if (!prv_parseNode(tokens, node))
+    {
+      return InvalidData;
+    }
+    nextId = std::max(nextId, node.id + 1);
+    nodes.push_back(node);
+  }
+
+  nodes_m = std::move(nodes);
+  nextId_m = nextId;
+  return Success;
+}
+
+static std::string prv_nodeLabel(const ProcessingNode &node)
+{
+  return node.name + " (#" + std::to_string(node.id) + ")";
+}
+
+/* Compile-time facts about the buffer a node writes */
+struct CompiledNode
+{
+  uint32_t buffer = 0;
+  size_t level = 0;
+  uint64_t rate = 1; /* Input samples per sample of this node */
+  std::string unit;
+};
+
+static bool prv_checkParameters(const ProcessingNode &node, std::string &error)
+{
+  size_t conversions = 0;
+  getUnitConversions(conversions);
+
+  bool valid = true;
+  switch (node.type)
+  {
+  case NODE_INPUT:
+    valid = node.channel >= 0 && node.channel <= MAX_INPUT_CHANNEL;
+    break;
+  case NODE_UNIT:
+    valid = node.conversion >= 0
+            && static_cast<size_t>(node.conversion) < conversions;
+    break;
+  case NODE_FILTER:
+    valid = (node.filter == FILTER_MOVING_AVERAGE)
+                ? (node.window >= 1 && node.window <= MAX_FILTER_WINDOW)
+                : (node.alpha > 0.0f && node.alpha <= 1.0f);
+    break;
+  case NODE_DECIMATE:
+    valid = node.factor >= 1 && node.factor <= MAX_DECIMATION_FACTOR;
+    break;
+  default:
+    break;
+  }
+
+  if (!valid)
+  {
+    error = "Invalid parameter of " + prv_nodeLabel(node);
+  }
+  return valid;
+}
+
+std::shared_ptr<const ProcessingSchedule>
+ProcessingGraph::compile(std::string &error) const
+{
+  std::unordered_map<uint32_t, size_t> indexOf;
+  for (size_t i = 0; i < nodes_m.size(); ++i)
+  {
+    indexOf[nodes_m[i].id] = i;
+  }
+
+  for (const ProcessingNode &node : nodes_m)
+  {
+    if (node.inputs.size() != getProcessingNodeInputCount(node.type))
+    {
+      error = "Wrong number of inputs for " + prv_nodeLabel(node);
+      return nullptr;
+    }
+    for (uint32_t input : node.inputs)
+    {
+      auto it = indexOf.find(input);
+      if (it == indexOf.end())
+      {
+        error = prv_nodeLabel(node) + " has an unconnected input";
+        return nullptr;
+      }
+      ProcessingNodeType_t inputType = nodes_m[it->second].type;
+      if (inputType == NODE_DISPLAY || inputType == NODE_RECORD)
+      {
+        error = prv_nodeLabel(node) + " reads from an output";
+        return nullptr;
+      }
+    }
+    if (!prv_checkParameters(node, error))
+    {
+      return nullptr;
+    }
+  }
+
+  /* Depth-first from the outputs: topological order of the nodes they need,
+   * the others are left out */
+  std::vector<uint8_t> visit(nodes_m.size(), 0); /* 1 in progress, 2 done */
+  std::vector<size_t> order;
+  std::vector<std::pair<size_t, size_t>> stack; /* node, next input */
+  bool hasOutput = false;
+
+  for (size_t root = 0; root < nodes_m.size(); ++root)
+  {
+    if (nodes_m[root].type != NODE_DISPLAY && nodes_m[root].type != NODE_RECORD)
+    {
+      continue;
+    }
+    hasOutput = true;
+
+    stack.assign(1, {indexOf[nodes_m[root].inputs[0]], 0});
+    while (!stack.empty())
+    {
+      size_t index = stack.back().first;
+      size_t &nextInput = stack.back().second;
+      if (nextInput == 0 && visit[index] == 2)
+      {
+        stack.pop_back();
+        continue;
+      }
+      visit[index] = 1;
+
+      if (nextInput < nodes_m[index].inputs.size())
+      {
+        size_t input = indexOf[nodes_m[index].inputs[nextInput++]];
+        if (visit[input] == 1)
+        {
+          error = "Cycle through " + prv_nodeLabel(nodes_m[input]);
+          return nullptr;
+        }
+        if (visit[input] == 0)
+        {
+          stack.push_back({input, 0});
+        }
+        continue;
+      }
+
+      visit[index] = 2;
+      order.push_back(index);
+      stack.pop_back();
+    }
+  }
+
+  if (!hasOutput)
+  {
+    error = "The graph has no display or record output";
+    return nullptr;
+  }
+
+  auto pSchedule = std::make_shared<ProcessingSchedule>();
+  std::vector<CompiledNode> compiled(nodes_m.size());
+  std::vector<std::vector<ProcessingStep>> levels;
+  size_t conversionCount = 0;
+  const UnitConversion *pConversions = getUnitConversions(conversionCount);
+
+  for (size_t index : order)
+  {
+    const ProcessingNode &node = nodes_m[index];
+    CompiledNode &result = compiled[index];
+    const CompiledNode *pFirst
+        = node.inputs.empty() ? nullptr : &compiled[indexOf[node.inputs[0]]];
+    const CompiledNode *pSecond
+        = (node.inputs.size() < 2) ? nullptr
+                                   : &compiled[indexOf[node.inputs[1]]];
+
+    ProcessingStep step = {};
+    step.output = static_cast<uint32_t>(pSchedule->bufferCount++);
+    if (pFirst)
+    {
+      step.inputA = pFirst->buffer;
+      result.level = pFirst->level + 1;
+      result.rate = pFirst->rate;
+      result.unit = pFirst->unit;
+    }
+
+    switch (node.type)
+    {
+    case NODE_INPUT:
+      step.operation = STEP_INPUT;
+      step.inputA = static_cast<uint32_t>(node.channel);
+      pSchedule->inputChannels = std::max<size_t>(pSchedule->inputChannels,
+                                                  node.channel + 1);
+      break;
+    case NODE_SCALE:
+      step.operation = STEP_AFFINE;
+      step.a = node.gain;
+      step.b = node.offset;
+      if (!node.unit.empty())
+      {
+        result.unit = node.unit;
+      }
+      break;
+    case NODE_UNIT:
+      step.operation = STEP_AFFINE;
+      step.a = pConversions[node.conversion].gain;
+      step.b = pConversions[node.conversion].offset;
+      result.unit = pConversions[node.conversion].pUnit;
+      break;
+    case NODE_FILTER:
+      step.state = static_cast<uint32_t>(pSchedule->stateSize);
+      step.a = node.alpha;
+      if (node.filter == FILTER_MOVING_AVERAGE)
+      {
+        step.operation = STEP_MOVING_AVERAGE;
+        step.size = static_cast<uint32_t>(node.window);
+        pSchedule->stateSize += 3 + step.size; /* sum, index, count, ring */
+      }
+      else
+      {
+        step.operation
+            = (node.filter == FILTER_LOW_PASS) ? STEP_LOW_PASS : STEP_HIGH_PASS;
+        pSchedule->stateSize += 3; /* y, previous x, started */
+      }
+      break;
+    case NODE_DECIMATE:
+      step.operation = STEP_DECIMATE;
+      step.size = static_cast<uint32_t>(node.factor);
+      step.state = static_cast<uint32_t>(pSchedule->stateSize);
+      pSchedule->stateSize += 2; /* sum, count */
+      result.rate *= node.factor;
+      break;
+    case NODE_MATH:
+      if (pSecond->rate != pFirst->rate)
+      {
+        error = prv_nodeLabel(node) + " combines different decimation rates";
+        return nullptr;
+      }
+      step.operation = STEP_MATH;
+      step.inputB = pSecond->buffer;
+      step.mathOperation = node.operation;
+      result.level = std::max(pFirst->level, pSecond->level) + 1;
+      if (node.operation == MATH_MULTIPLY || node.operation == MATH_DIVIDE)
+      {
+        result.unit.clear();
+      }
+      break;
+    default:
+      break;
+    }
+
+    result.buffer = step.output;
+    if (levels.size() <= result.level)
+    {
+      levels.resize(result.level + 1);
+    }
+    levels[result.level].push_back(step);
+  }
+
+  for (const std::vector<ProcessingStep> &level : levels)
+  {
+    pSchedule->steps.insert(pSchedule->steps.end(), level.begin(),
+                            level.end());
+    pSchedule->levelEnds.push_back(pSchedule->steps.size());
+  }
+
+  /* Outputs in the order of the node list, one sink rate each */
+  uint64_t displayRate = 0;
+  uint64_t recordRate = 0;
+  for (const ProcessingNode &node : nodes_m)
+  {
+    if (node.type != NODE_DISPLAY && node.type != NODE_RECORD)
+    {
+      continue;
+    }
+
+    const CompiledNode &source = compiled[indexOf[node.inputs[0]]];
+    uint64_t &sinkRate = (node.type == NODE_DISPLAY) ? displayRate : recordRate;
+    if (sinkRate != 0 && sinkRate != source.rate)
+    {
+      error = "The " + std::string(getProcessingNodeTypeName(node.type))
+              + " outputs have different decimation rates";
+      return nullptr;
+    }
+    sinkRate = source.rate;
+
+    std::string label = node.name;
+    if (!source.unit.empty())
+    {
+      label += " (" + source.unit + ")";
+    }
+
+    if (node.type == NODE_DISPLAY)
+    {
+      pSchedule->displayBuffers.push_back(source.buffer);
+      pSchedule->displayLabels.push_back(label);
+    }
+    else
+    {
+      pSchedule->recordBuffers.push_back(source.buffer);
+      pSchedule->recordLabels.push_back(label);
+    }
+  }
+
+  error.clear();
+  return pSchedule;
+}
@@ -0,0 +1,156 @@
+/** @file      processingGraph.h
+ *  @brief     Header file for the per-channel processing graph.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/07
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef PROCESSING_GRAPH_H
+#define PROCESSING_GRAPH_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "../Libraries/lib.h"
+
+typedef enum
+{
+  NODE_INPUT = 0,    /* One channel of the received frames */
+  NODE_SCALE = 1,    /* gain * x + offset, calibration */
+  NODE_UNIT = 2,     /* Conversion from the unit table */
+  NODE_FILTER = 3,   /* Moving average, low-pass or high-pass */
+  NODE_DECIMATE = 4, /* Mean of every factor samples */
+  NODE_MATH = 5,     /* Two inputs combined sample by sample */
+  NODE_DISPLAY = 6,  /* Output to the plots (channel history) */
+  NODE_RECORD = 7,   /* Output to the recorder, shared memory and web view */
+  NODE_TYPE_COUNT
+} ProcessingNodeType_t;
+
+typedef enum
+{
+  FILTER_MOVING_AVERAGE = 0, /* Over window samples */
+  FILTER_LOW_PASS = 1,       /* y += alpha * (x - y) */
+  FILTER_HIGH_PASS = 2,      /* y = alpha * (y + x - x_previous) */
+  FILTER_TYPE_COUNT
+} FilterType_t;
+
+typedef enum
+{
+  MATH_ADD = 0,
+  MATH_SUBTRACT = 1,
+  MATH_MULTIPLY = 2,
+  MATH_DIVIDE = 3,
+  MATH_MIN = 4,
+  MATH_MAX = 5,
+  MATH_OPERATION_COUNT
+} MathOperation_t;
+
+/**
+ * @brief Affine conversion offered by unit nodes.
+ */
+struct UnitConversion
+{
+  const char *pName; /* Shown in the UI and written to profiles */
+  const char *pUnit; /* Unit of the result */
+  float gain;
+  float offset;
+};
+
+const UnitConversion *getUnitConversions(size_t &count);
+
+const char *getProcessingNodeTypeName(ProcessingNodeType_t type);
+
+const char *getFilterTypeName(FilterType_t type);
+
+const char *getMathOperationName(MathOperation_t operation);
+
+/* Inputs a node of this type takes */
+size_t getProcessingNodeInputCount(ProcessingNodeType_t type);
+
+/**
+ * @brief One node of a ProcessingGraph. Only the fields of its type are used.
+ */
+struct ProcessingNode
+{
+  uint32_t id = 0;
+  ProcessingNodeType_t type = NODE_INPUT;
+  std::string name;          /* Output column / plot label */
+  std::vector<uint32_t> inputs; /* Ids of the nodes feeding this one */
+
+  int channel = 0;       /* NODE_INPUT */
+  float gain = 1.0f;     /* NODE_SCALE */
+  float offset = 0.0f;   /* NODE_SCALE */
+  std::string unit;      /* NODE_SCALE, unit of the calibrated value */
+  int conversion = 0;    /* NODE_UNIT, index in getUnitConversions() */
+  FilterType_t filter = FILTER_MOVING_AVERAGE;
+  int window = 8;        /* FILTER_MOVING_AVERAGE */
+  float alpha = 0.1f;    /* FILTER_LOW_PASS and FILTER_HIGH_PASS */
+  int factor = 10;       /* NODE_DECIMATE */
+  MathOperation_t operation = MATH_ADD;
+};
+
+struct ProcessingSchedule;
+
+/**
+ * @brief Editable description of the processing applied to the channels of
+ * the primary input, saved to and loaded from profile files.
+ *
+ * The graph itself is never run: compile() checks it and flattens it into a
+ * ProcessingSchedule, which is what the acquisition uses.
+ */
+class ProcessingGraph
+{
+public:
+  ProcessingGraph(void);
+
+  /* One input routed to a display and a record output per channel */
+  static ProcessingGraph makeDefault(int channels);
+
+  const std::vector<ProcessingNode> &getNodes(void) const { return nodes_m; }
+
+  ProcessingNode *findNode(uint32_t id);
+
+  /* Adds a node of a type with default parameters, returns its id */
+  uint32_t addNode(ProcessingNodeType_t type);
+
+  /* Also disconnects the nodes it was feeding */
+  void removeNode(uint32_t id);
+
+  void clear(void);
+
+  /**
+   * @brief Writes the graph as a text profile.
+   * @return Success or OpenError.
+   */
+  OrbCode_t save(const std::string &filename) const;
+
+  /**
+   * @brief Replaces the graph by the one of a profile.
+   * @return Success, OpenError or InvalidData (the graph is then unchanged).
+   */
+  OrbCode_t load(const std::string &filename);
+
+  /**
+   * @brief Checks the graph and builds its schedule.
+   *
+   * @param error Reason of the failure: missing input, cycle, outputs of a
+   *              sink at different decimation rates...
+   * @return The schedule, or null when the graph is invalid.
+   */
+  std::shared_ptr<const ProcessingSchedule>
+  compile(std::string &error) const;
+
+private:
+  std::vector<ProcessingNode> nodes_m;
+  uint32_t nextId_m;
+};
+
+#endif // PROCESSING_GRAPH_H
@@ -0,0 +1,321 @@
+/** @file      processingSchedule.cpp
+ *  @brief     Source file for the compiled processing graph and its runner.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/07
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "processingSchedule.h"
+#include "processingGraph.h"
+#include "../tasks/taskPool.h"
+#include "../kernels/numericKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/* Samples of one level below which the pool costs more than it saves */
+#define PARALLEL_LEVEL_SAMPLES (8192)
+
+static const float NOT_A_NUMBER = std::numeric_limits<float>::quiet_NaN();
+
+ProcessingRunner::ProcessingRunner(void)
+  : displayFrames_m(0)
+  , recordFrames_m(0)
+{
+}
+
+void ProcessingRunner::setSchedule(
+    std::shared_ptr<const ProcessingSchedule> pSchedule)
+{
+  pSchedule_m = std::move(pSchedule);
+  buffers_m.clear();
+  lengths_m.clear();
+  state_m.clear();
+  displayFrames_m = 0;
+  recordFrames_m = 0;
+
+  if (pSchedule_m)
+  {
+    buffers_m.resize(pSchedule_m->bufferCount);
+    lengths_m.assign(pSchedule_m->bufferCount, 0);
+    state_m.assign(pSchedule_m->stateSize, 0.0);
+  }
+}
+
+size_t ProcessingRunner::getDisplayChannelCount(void) const
+{
+  return pSchedule_m ? pSchedule_m->displayBuffers.size() : 0;
+}
+
+size_t ProcessingRunner::getRecordChannelCount(void) const
+{
+  return pSchedule_m ? pSchedule_m->recordBuffers.size() : 0;
+}
+
+void ProcessingRunner::reset(void)
+{
+  std::fill(state_m.begin(), state_m.end(), 0.0);
+}
+
+void ProcessingRunner::process(const float *pFrames, size_t frames,
+                               size_t channels)
+{
+  if (!pSchedule_m)
+  {
+    return;
+  }
+
+  prv_splitInputs(pFrames, frames, channels);
+
+  const std::vector<ProcessingStep> &steps = pSchedule_m->steps;
+  size_t begin = 0;
+  for (size_t end : pSchedule_m->levelEnds)
+  {
+    /* Steps of a level write distinct buffers and states */
+    if (end - begin > 1 && frames * (end - begin) >= PARALLEL_LEVEL_SAMPLES)
+    {
+      TaskGroup group(getTaskPool());
+      for (size_t index = begin; index < end; ++index)
+      {
+        const ProcessingStep &step = steps[index];
+        group.run([this, &step, frames, channels]
+                  { prv_runStep(step, frames, channels); });
+      }
+      group.wait();
+    }
+    else
+    {
+      for (size_t index = begin; index < end; ++index)
+      {
+        prv_runStep(steps[index], frames, channels);
+      }
+    }
+    begin = end;
+  }
+
+  displayFrames_m = prv_interleave(pSchedule_m->displayBuffers, display_m);
+  recordFrames_m = prv_interleave(pSchedule_m->recordBuffers, record_m);
+}
+
+void ProcessingRunner::prv_splitInputs(const float *pFrames, size_t frames,
+                                       size_t channels)
+{
+  /* The first input step of a channel gets it in its own buffer, the
+   * channels no step reads all go to the scratch buffer */
+  scratch_m.resize(frames);
+  inputPlanes_m.assign(channels, scratch_m.data());
+  for (const ProcessingStep &step : pSchedule_m->steps)
+  {
+    if (step.operation == STEP_INPUT && step.inputA < channels
+        && inputPlanes_m[step.inputA] == scratch_m.data())
+    {
+      buffers_m[step.output].resize(frames);
+      inputPlanes_m[step.inputA] = buffers_m[step.output].data();
+    }
+  }
+  getNumericKernels().toPlanar(pFrames, frames, channels,
+                               inputPlanes_m.data());
+}
+
+void ProcessingRunner::prv_runStep(const ProcessingStep &step, size_t frames,
+                                   size_t channels)
+{
+  std::vector<float> &output = buffers_m[step.output];
+  /* STEP_INPUT reads a channel, not a buffer */
+  bool fromBuffer = step.operation != STEP_INPUT;
+  const float *pA = fromBuffer ? buffers_m[step.inputA].data() : nullptr;
+  size_t length = fromBuffer ? lengths_m[step.inputA] : frames;
+  double *pState = state_m.data() + step.state;
+
+  switch (step.operation)
+  {
+  case STEP_INPUT:
+  {
+    /* Already split by prv_splitInputs(), copied for a second reader */
+    output.resize(frames);
+    if (step.inputA < channels)
+    {
+      if (inputPlanes_m[step.inputA] != output.data())
+      {
+        std::copy_n(inputPlanes_m[step.inputA], frames, output.begin());
+      }
+    }
+    else
+    {
+      std::fill(output.begin(), output.end(), NOT_A_NUMBER);
+    }
+    break;
+  }
+  case STEP_AFFINE:
+  {
+    output.resize(length);
+    getNumericKernels().scaleOffset(pA, length, step.a, step.b, output.data());
+    break;
+  }
+  case STEP_MOVING_AVERAGE:
+  {
+    /* sum, next ring slot, samples in the ring, ring */
+    output.resize(length);
+    double *pRing = pState + 3;
+    for (size_t i = 0; i < length; ++i)
+    {
+      if (std::isnan(pA[i]))
+      {
+        std::fill(pState, pState + 3 + step.size, 0.0);
+        output[i] = NOT_A_NUMBER;
+        continue;
+      }
+
+      size_t slot = static_cast<size_t>(pState[1]);
+      if (pState[2] >= step.size)
+      {
+        pState[0] -= pRing[slot];
+      }
+      else
+      {
+        pState[2] += 1.0;
+      }
+      pRing[slot] = pA[i];
+      pState[0] += pA[i];
+      pState[1] = static_cast<double>((slot + 1) % step.size);
+      output[i] = static_cast<float>(pState[0] / pState[2]);
+    }
+    break;
+  }
+  case STEP_LOW_PASS:
+  case STEP_HIGH_PASS:
+  {
+    /* y, previous x, started */
+    output.resize(length);
+    bool lowPass = step.operation == STEP_LOW_PASS;
+    for (size_t i = 0; i < length; ++i)
+    {
+      double x = pA[i];
+      if (std::isnan(x))
+      {
+        pState[2] = 0.0;
+        output[i] = NOT_A_NUMBER;
+        continue;
+      }
+
+      if (pState[2] == 0.0)
+      {
+        pState[0] = lowPass ? x : 0.0;
+        pState[2] = 1.0;
+      }
+      else if (lowPass)
+      {
+        pState[0] += step.a * (x - pState[0]);
+      }
+      else
+      {
+        pState[0] = step.a * (pState[0] + x - pState[1]);
+      }
+      pState[1] = x;
+      output[i] = static_cast<float>(pState[0]);
+    }
+    break;
+  }
+  case STEP_DECIMATE:
+  {
+    /* sum, count: a NaN makes its whole block NaN */
+    output.resize(length / step.size + 1);
+    size_t produced = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+      pState[0] += pA[i];
+      pState[1] += 1.0;
+      if (pState[1] >= step.size)
+      {
+        output[produced++] = static_cast<float>(pState[0] / pState[1]);
+        pState[0] = 0.0;
+        pState[1] = 0.0;
+      }
+    }
+    length = produced;
+    break;
+  }
+  case STEP_MATH:
+  {
+    const float *pB = buffers_m[step.inputB].data();
+    length = std::min(length, lengths_m[step.inputB]);
+    output.resize(length);
+    switch (step.mathOperation)
+    {
+    case MATH_ADD:
+      for (size_t i = 0; i < length; ++i)
+      {
+        output[i] = pA[i] + pB[i];
+      }
+      break;
+    case MATH_SUBTRACT:
+      for (size_t i = 0; i < length; ++i)
+      {
+        output[i] = pA[i] - pB[i];
+      }
+      break;
+    case MATH_MULTIPLY:
+      for (size_t i = 0; i < length; ++i)
+      {
+        output[i] = pA[i] * pB[i];
+      }
+      break;
+    case MATH_DIVIDE:
+      for (size_t i = 0; i < length; ++i)
+      {
+        output[i] = (pB[i] != 0.0f) ? pA[i] / pB[i] : NOT_A_NUMBER;
+      }
+      break;
+    case MATH_MIN:
+      for (size_t i = 0; i < length; ++i)
+      {
+        output[i] = std::fmin(pA[i], pB[i]);
+      }
+      break;
+    default:
+      for (size_t i = 0; i < length; ++i)
+      {
+        output[i] = std::fmax(pA[i], pB[i]);
+      }
+      break;
+    }
+    break;
+  }
+  }
+
+  lengths_m[step.output] = length;
+}
+
+size_t ProcessingRunner::prv_interleave(
+    const std::vector<uint32_t> &sinkBuffers, std::vector<float> &output)
+{
+  if (sinkBuffers.empty())
+  {
+    return 0;
+  }
+
+  size_t frames = lengths_m[sinkBuffers[0]];
+  for (uint32_t buffer : sinkBuffers)
+  {
+    frames = std::min(frames, lengths_m[buffer]);
+  }
+
+  size_t channels = sinkBuffers.size();
+  output.resize(frames * channels);
+  for (size_t channel = 0; channel < channels; ++channel)
+  {
+    const float *pSource = buffers_m[sinkBuffers[channel]].data();
+    for (size_t i = 0; i < frames; ++i)
+    {
+      output[i * channels + channel] = pSource[i];
+    }
+  }
+  return frames;
+}
@@ -0,0 +1,132 @@
+/** @file      processingSchedule.h
+ *  @brief     Header file for the compiled processing graph and its runner.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/07
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef PROCESSING_SCHEDULE_H
+#define PROCESSING_SCHEDULE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+typedef enum
+{
+  STEP_INPUT = 0,     /* Column of the received frames */
+  STEP_AFFINE,        /* a * x + b: scale, offset and unit conversions */
+  STEP_MOVING_AVERAGE,
+  STEP_LOW_PASS,
+  STEP_HIGH_PASS,
+  STEP_DECIMATE,
+  STEP_MATH
+} ProcessingOperation_t;
+
+/**
+ * @brief One node of the graph, reduced to what the runner needs.
+ */
+struct ProcessingStep
+{
+  ProcessingOperation_t operation;
+  uint32_t output;    /* Buffer written */
+  uint32_t inputA;    /* Buffer read, or channel for STEP_INPUT */
+  uint32_t inputB;    /* Second buffer of STEP_MATH */
+  uint32_t state;     /* First state slot, for filters and decimation */
+  uint32_t size;      /* Moving average window, decimation factor */
+  uint32_t mathOperation;
+  float a;            /* Gain, or alpha of the IIR filters */
+  float b;            /* Offset */
+};
+
+/**
+ * @brief Graph flattened by ProcessingGraph::compile(), immutable once built
+ * so that it can be swapped under a running acquisition.
+ *
+ * Steps are in topological order and grouped by level: a step only reads
+ * buffers written by steps of lower levels, so the steps of one level are
+ * independent.
+ */
+struct ProcessingSchedule
+{
+  std::vector<ProcessingStep> steps;
+  std::vector<size_t> levelEnds; /* Index past the last step of each level */
+  size_t bufferCount = 0;
+  size_t stateSize = 0;
+  size_t inputChannels = 0; /* Highest input channel + 1 */
+
+  /* Buffers routed to each sink, in output order */
+  std::vector<uint32_t> displayBuffers;
+  std::vector<uint32_t> recordBuffers;
+  std::vector<std::string> displayLabels;
+  std::vector<std::string> recordLabels;
+};
+
+/**
+ * @brief Runs a ProcessingSchedule over blocks of frames.
+ *
+ * Holds the filter and decimation states between blocks and reuses its
+ * buffers, so nothing is allocated once the largest block has been seen.
+ * Every step is one switch per block followed by a plain loop over the
+ * samples of its buffer.
+ */
+class ProcessingRunner
+{
+public:
+  ProcessingRunner(void);
+
+  /* Null disables the processing, the states restart from zero */
+  void setSchedule(std::shared_ptr<const ProcessingSchedule> pSchedule);
+
+  bool isActive(void) const { return pSchedule_m != nullptr; }
+
+  size_t getDisplayChannelCount(void) const;
+
+  size_t getRecordChannelCount(void) const;
+
+  /* Restarts the filters and decimators, e.g. after a gap in the data */
+  void reset(void);
+
+  /**
+   * @brief Processes a block of frames.
+   *
+   * @param pFrames Received values, frame * channels + channel
+   * @param frames Number of frames of the block
+   * @param channels Values per received frame
+   */
+  void process(const float *pFrames, size_t frames, size_t channels);
+
+  /* Results of the last process(), frame * channels + channel */
+  const float *getDisplayFrames(void) const { return display_m.data(); }
+  size_t getDisplayFrameCount(void) const { return displayFrames_m; }
+  const float *getRecordFrames(void) const { return record_m.data(); }
+  size_t getRecordFrameCount(void) const { return recordFrames_m; }
+
+private:
+  void prv_splitInputs(const float *pFrames, size_t frames, size_t channels);
+  void prv_runStep(const ProcessingStep &step, size_t frames,
+                   size_t channels);
+  size_t prv_interleave(const std::vector<uint32_t> &sinkBuffers,
+                        std::vector<float> &output);
+
+  std::shared_ptr<const ProcessingSchedule> pSchedule_m;
+  std::vector<std::vector<float>> buffers_m;
+  std::vector<size_t> lengths_m; /* Samples of each buffer in this block */
+  std::vector<double> state_m;
+  std::vector<float *> inputPlanes_m; /* Where each received channel goes */
+  std::vector<float> scratch_m;       /* Channels no step reads */
+  std::vector<float> display_m;
+  std::vector<float> record_m;
+  size_t displayFrames_m;
+  size_t recordFrames_m;
+};
+
+#endif // PROCESSING_SCHEDULE_H
@@ -13,9 +13,20 @@
  */
 
 #include "openglBufferManagement.h"
+#include "openglContext.h"
 
 namespace nrender
 {
+/* VAOs are not available in OpenGL ES 2.0 */
+static bool prv_hasVertexArrays(void)
+{
+#ifdef PLATFORM_RASPBERRY_PI
+  return OpenGLContext::getCapabilities().vertexArrays;
+#else
+  return true;
+#endif
+}
+
 OpenGLVertexIndexBuffer::OpenGLVertexIndexBuffer()
   : VertexIndexBuffer()
 {
@@ -28,12 +39,24 @@ void OpenGLFrameBuffer::bind(void)
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
+void OpenGLFrameBuffer::resume(void)
+{
+  glBindFramebuffer(GL_FRAMEBUFFER, FBO_m);
+  glViewport(0, 0, width_m, height_m);
+}
+
 void OpenGLFrameBuffer::unbind(void)
 {
   glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
 void OpenGLFrameBuffer::createBuffers(int32_t width, int32_t height)
+{
+  createBuffers(width, height, true);
+}
+
+void OpenGLFrameBuffer::createBuffers(int32_t width, int32_t height,
+                                      bool depthStencil)
 {
   width_m = width;
   height_m = height;
@@ -63,27 +86,30 @@ void OpenGLFrameBuffer::createBuffers(int32_t width, int32_t height)
                          texId_m, 0);
 
   // Generate and bind the depth-stencil texture
-  glGenTextures(1, &depthId_m);
-  glBindTexture(GL_TEXTURE_2D, depthId_m);
+  if (depthStencil)
+  {
+    glGenTextures(1, &depthId_m);
+    glBindTexture(GL_TEXTURE_2D, depthId_m);
 #ifdef PLATFORM_RASPBERRY_PI
-  // OpenGL ES compatible depth texture
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, width_m, height_m, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_SHORT, NULL);
+    // OpenGL ES compatible depth texture
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, width_m, height_m, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_SHORT, NULL);
 #else
-  glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH24_STENCIL8, width_m, height_m);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH24_STENCIL8, width_m, height_m);
 #endif
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 #ifndef PLATFORM_RASPBERRY_PI
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 #endif
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 #ifdef PLATFORM_RASPBERRY_PI
-  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthId_m, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthId_m, 0);
 #else
-  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
-                         GL_TEXTURE_2D, depthId_m, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+                           GL_TEXTURE_2D, depthId_m, 0);
 #endif
+  }
 
 #ifndef PLATFORM_RASPBERRY_PI
   // Specify the list of draw buffers (only one in this case) - not available in OpenGL ES
@@ -131,17 +157,18 @@ void OpenGLVertexIndexBuffer::createBuffers(
     const std::vector<ncomponents::VertexHolder> &vertices,
     const std::vector<unsigned int> &indices)
 {
-#ifndef PLATFORM_RASPBERRY_PI
-  // VAOs are not available in OpenGL ES 2.0
-  glGenVertexArrays(1, &glVAO_m);
-#endif
+  if (prv_hasVertexArrays())
+  {
+    glGenVertexArrays(1, &glVAO_m);
+  }
 
   glGenBuffers(1, &glIBO_m);
   glGenBuffers(1, &glVBO_m);
 
-#ifndef PLATFORM_RASPBERRY_PI
-  glBindVertexArray(glVAO_m);
-#endif
+  if (glVAO_m)
+  {
+    glBindVertexArray(glVAO_m);
+  }
 
   glBindBuffer(GL_ARRAY_BUFFER, glVBO_m);
   glBufferData(GL_ARRAY_BUFFER,
@@ -161,9 +188,10 @@ void OpenGLVertexIndexBuffer::createBuffers(
                         sizeof(ncomponents::VertexHolder),
                         (void *)offsetof(ncomponents::VertexHolder, normal_m));
 
-#ifndef PLATFORM_RASPBERRY_PI
-  glBindVertexArray(0);
-#endif
+  if (glVAO_m)
+  {
+    glBindVertexArray(0);
+  }
 }
 
 void OpenGLVertexIndexBuffer::deleteBuffers()
@@ -174,15 +202,22 @@ void OpenGLVertexIndexBuffer::deleteBuffers()
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
   glDeleteBuffers(1, &glIBO_m);
   glDeleteBuffers(1, &glVBO_m);
-#ifndef PLATFORM_RASPBERRY_PI
-  glDeleteVertexArrays(1, &glVAO_m);
-#endif
+  if (glVAO_m)
+  {
+    glDeleteVertexArrays(1, &glVAO_m);
+    glVAO_m = 0;
+  }
 }
 
 void OpenGLVertexIndexBuffer::bind()
 {
-#ifdef PLATFORM_RASPBERRY_PI
-  // For OpenGL ES, manually bind buffers and set up vertex attributes
+  if (glVAO_m)
+  {
+    glBindVertexArray(glVAO_m);
+    return;
+  }
+
+  // For OpenGL ES 2.0, manually bind buffers and set up vertex attributes
   glBindBuffer(GL_ARRAY_BUFFER, glVBO_m);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, glIBO_m);
   
@@ -195,21 +230,20 @@ void OpenGLVertexIndexBuffer::bind()
   glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE,
                         sizeof(ncomponents::VertexHolder),
                         (void *)offsetof(ncomponents::VertexHolder, normal_m));
-#else
-  glBindVertexArray(glVAO_m);
-#endif
 }
 
 void OpenGLVertexIndexBuffer::unbind()
 {
-#ifdef PLATFORM_RASPBERRY_PI
+  if (glVAO_m)
+  {
+    glBindVertexArray(0);
+    return;
+  }
+
   glDisableVertexAttribArray(0);
   glDisableVertexAttribArray(1);
   glBindBuffer(GL_ARRAY_BUFFER, 0);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-#else
-  glBindVertexArray(0);
-#endif
 }
 
 void OpenGLVertexIndexBuffer::draw(int indexCount)
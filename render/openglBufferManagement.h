@@ -23,10 +23,16 @@ class OpenGLFrameBuffer : public FrameBuffer
 public:
   void createBuffers(int32_t width, int32_t height) override;
 
+  /* Without the depth-stencil texture when depthStencil is false */
+  void createBuffers(int32_t width, int32_t height, bool depthStencil);
+
   void deleteBuffers(void) override;
 
   void bind(void) override;
 
+  /* Binds the buffer keeping its content, to draw over what it holds */
+  void resume(void);
+
   void unbind(void) override;
 
   uint32_t getTexture(void) override;
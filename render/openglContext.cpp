@@ -19,6 +19,11 @@ namespace nrender
 {
 static uint16_t usWindowWidth_m;
 static uint16_t usWindowHeight_m;
+static GLCapabilities capabilities_m;
+
+/* Highest OpenGL ES version requested first; MSCOPE_GLES_VERSION=2 forces the
+ * OpenGL ES 2.0 path on a driver that has more */
+static const int contextVersions[][2] = {{3, 0}, {2, 0}};
 
 static void vOnWindowCloseCallback(GLFWwindow *pGLWindow)
 {
@@ -58,6 +63,48 @@ void OpenGLContext::getWindowSize(uint16_t &ucWidth, uint16_t &ucHeight)
   ucHeight = usWindowHeight_m;
 }
 
+const GLCapabilities &OpenGLContext::getCapabilities(void)
+{
+  return capabilities_m;
+}
+
+/* Major version set by MSCOPE_GLES_VERSION, 0 without limit */
+static int prv_versionLimit(void)
+{
+  const char *pLimit = getenv("MSCOPE_GLES_VERSION");
+  return pLimit != nullptr ? atoi(pLimit) : 0;
+}
+
+/* Reads the version of the current context, "OpenGL ES 3.1 Mesa ..." */
+static void prv_detectCapabilities(void)
+{
+  capabilities_m = GLCapabilities();
+  const char *pVersion
+      = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+  int major = 0;
+  int minor = 0;
+  if (pVersion != nullptr
+      && sscanf(pVersion, "OpenGL ES %d.%d", &major, &minor) == 2)
+  {
+    capabilities_m.majorVersion = major;
+    capabilities_m.minorVersion = minor;
+  }
+
+  /* Drivers may answer a request for 2.0 with a later version */
+  int limit = prv_versionLimit();
+  if (limit > 0 && capabilities_m.majorVersion > limit)
+  {
+    capabilities_m.majorVersion = limit;
+    capabilities_m.minorVersion = 0;
+  }
+
+  /* The OpenGL ES 2.0 extensions for them are left aside, their entry points
+   * would have to be loaded */
+  bool gles3 = capabilities_m.majorVersion >= 3;
+  capabilities_m.vertexArrays = gles3;
+  capabilities_m.mapBufferRange = gles3;
+}
+
 OrbCode_t OpenGLContext::init(nwindow::IWindow *pWindow)
 {
   RenderContext::init(pWindow);
@@ -69,9 +116,8 @@ OrbCode_t OpenGLContext::init(nwindow::IWindow *pWindow)
     return InitError;
   }
   
-  /* configure GLFW for Raspberry Pi - Use OpenGL ES 2.0 */
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+  /* configure GLFW for Raspberry Pi - Use OpenGL ES, 3.0 when the driver has
+   * it (VideoCore VI and later, Mesa), 2.0 otherwise */
   glfwWindowHint(GLFW_CLIENT_API, GLFW_OPENGL_ES_API);
 
   /* Create a window object and store it as a window pointer
@@ -80,9 +126,24 @@ OrbCode_t OpenGLContext::init(nwindow::IWindow *pWindow)
   usWindowWidth_m = pWindow->width_m;
   usWindowHeight_m = pWindow->height_m;
 
-  auto *pGLWindow
-      = glfwCreateWindow(pWindow->width_m, pWindow->height_m,
-                         pWindow->windowTitle_m.c_str(), nullptr, nullptr);
+  GLFWwindow *pGLWindow = nullptr;
+  int limit = prv_versionLimit();
+  for (const auto &version : contextVersions)
+  {
+    if (limit > 0 && version[0] > limit && version[0] > 2)
+    {
+      continue;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, version[0]);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, version[1]);
+    pGLWindow
+        = glfwCreateWindow(pWindow->width_m, pWindow->height_m,
+                           pWindow->windowTitle_m.c_str(), nullptr, nullptr);
+    if (pGLWindow)
+    {
+      break;
+    }
+  }
 
   pWindow->setNativeWindow(pGLWindow);
 
@@ -103,7 +164,8 @@ OrbCode_t OpenGLContext::init(nwindow::IWindow *pWindow)
 
   /* For Raspberry Pi with OpenGL ES, we don't need GLEW */
   /* OpenGL ES functions are available directly */
-  fprintf(stderr, "Using OpenGL ES 2.0 on Raspberry Pi\n");
+  prv_detectCapabilities();
+  fprintf(stderr, "Using %s on Raspberry Pi\n", glGetString(GL_VERSION));
 
   /* Enable blending for transparency */
   glEnable(GL_BLEND);
@@ -17,6 +17,15 @@
 
 namespace nrender
 {
+/* Features of the GL context, known once it is created */
+struct GLCapabilities
+{
+  int32_t majorVersion = 2;
+  int32_t minorVersion = 0;
+  bool vertexArrays = false;   /* Vertex array objects */
+  bool mapBufferRange = false; /* glMapBufferRange for streamed buffers */
+};
+
 class OpenGLContext : public RenderContext
 {
 public:
@@ -29,5 +38,7 @@ public:
   void end(void) override;
 
   static void getWindowSize(uint16_t &ucWidth, uint16_t &ucHeight);
+
+  static const GLCapabilities &getCapabilities(void);
 };
 } // namespace nrender
@@ -0,0 +1,312 @@
+/** @file      phosphorDisplay.cpp
+ *  @brief     Source file for the persistent (phosphor) display.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/14
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "phosphorDisplay.h"
+
+namespace nrender
+{
+/* Two triangles covering the texture */
+static const float fullQuad[] = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f,
+                                 1.0f,  1.0f};
+
+/* Vertices of the first stream buffer, doubled when a frame needs more */
+#define PHOSPHOR_STREAM_VERTICES (64 * 1024)
+
+PhosphorDisplay::PhosphorDisplay()
+  : glVBO_m(0)
+  , glVAO_m(0)
+  , viewport_m{0, 0, 0, 0}
+  , streamed_m(false)
+  , glStreamVBO_m(0)
+  , glStreamVAO_m(0)
+  , colorAttribute_m(-1)
+  , pStream_m(nullptr)
+  , streamCapacity_m(0)
+  , streamCount_m(0)
+{
+  GLint position = -1;
+#ifdef PLATFORM_RASPBERRY_PI
+  const GLCapabilities &capabilities = OpenGLContext::getCapabilities();
+  streamed_m = capabilities.vertexArrays && capabilities.mapBufferRange;
+  if (streamed_m)
+  {
+    shader_m.load("shader/phosphorvs_es3.shader",
+                  "shader/phosphorfs_es3.shader");
+    GLuint program = shader_m.ulGetProgramId();
+    if (program)
+    {
+      position = glGetAttribLocation(program, "pos");
+      colorAttribute_m = glGetAttribLocation(program, "vertexColor");
+    }
+    /* Without both attributes the stream can't be laid out, the ES 2.0
+     * program draws each sweep on its own instead */
+    if (position < 0 || colorAttribute_m < 0)
+    {
+      shader_m.unload();
+      streamed_m = false;
+      colorAttribute_m = -1;
+    }
+  }
+  if (streamed_m)
+  {
+    glGenVertexArrays(1, &glVAO_m);
+  }
+  else
+  {
+    shader_m.load("shader/phosphorvs_rpi.shader",
+                  "shader/phosphorfs_rpi.shader");
+  }
+#else
+  shader_m.load("shader/phosphorvs.shader", "shader/phosphorfs.shader");
+  // VAOs are not available in OpenGL ES 2.0
+  glGenVertexArrays(1, &glVAO_m);
+#endif
+  glGenBuffers(1, &glVBO_m);
+
+  if (streamed_m)
+  {
+    /* The layout of the stream is set once, in its own VAO */
+    glGenBuffers(1, &glStreamVBO_m);
+    glGenVertexArrays(1, &glStreamVAO_m);
+    glBindVertexArray(glStreamVAO_m);
+    glBindBuffer(GL_ARRAY_BUFFER, glStreamVBO_m);
+    glEnableVertexAttribArray(position);
+    glVertexAttribPointer(position, 2, GL_FLOAT, GL_FALSE,
+                          sizeof(SweepVertex),
+                          (void *)offsetof(SweepVertex, x));
+    glEnableVertexAttribArray(colorAttribute_m);
+    glVertexAttribPointer(colorAttribute_m, 4, GL_FLOAT, GL_FALSE,
+                          sizeof(SweepVertex),
+                          (void *)offsetof(SweepVertex, color));
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+  }
+}
+
+PhosphorDisplay::~PhosphorDisplay()
+{
+  frameBuffer_m.deleteBuffers();
+  glDeleteBuffers(1, &glVBO_m);
+  if (glVAO_m)
+  {
+    glDeleteVertexArrays(1, &glVAO_m);
+  }
+  if (streamed_m)
+  {
+    glDeleteBuffers(1, &glStreamVBO_m);
+    glDeleteVertexArrays(1, &glStreamVAO_m);
+  }
+  shader_m.unload();
+}
+
+void PhosphorDisplay::resize(int32_t width, int32_t height)
+{
+  if (width == frameBuffer_m.getWidth() && height == frameBuffer_m.getHeight())
+  {
+    return;
+  }
+  frameBuffer_m.createBuffers(width, height);
+  clear();
+}
+
+void PhosphorDisplay::begin(void)
+{
+  glGetIntegerv(GL_VIEWPORT, viewport_m);
+  frameBuffer_m.resume();
+  shader_m.use();
+}
+
+void PhosphorDisplay::end(void)
+{
+  prv_flushStream();
+  frameBuffer_m.unbind();
+  glViewport(viewport_m[0], viewport_m[1], viewport_m[2], viewport_m[3]);
+  glBlendEquation(GL_FUNC_ADD);
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void PhosphorDisplay::clear(void)
+{
+  GLint viewport[4];
+  glGetIntegerv(GL_VIEWPORT, viewport);
+
+  /* The context clears the window with its own color every frame */
+  glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+  frameBuffer_m.bind();
+  frameBuffer_m.unbind();
+  glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+void PhosphorDisplay::decay(float persistence)
+{
+  /* Sweeps added before fade with the older ones */
+  prv_flushStream();
+
+  /* destination * persistence */
+  glBlendEquation(GL_FUNC_ADD);
+  glBlendFunc(GL_ZERO, GL_SRC_ALPHA);
+  prv_setColor(glm::vec4(0.0f, 0.0f, 0.0f, persistence));
+  prv_drawPoints(fullQuad, 4, GL_TRIANGLE_STRIP);
+
+  /* destination - 1/255: the product alone rounds back to the same level */
+  glBlendEquation(GL_FUNC_REVERSE_SUBTRACT);
+  glBlendFunc(GL_ONE, GL_ONE);
+  float level = 1.0f / 255.0f;
+  prv_setColor(glm::vec4(level, level, level, 0.0f));
+  prv_drawPoints(fullQuad, 4, GL_TRIANGLE_STRIP);
+  glBlendEquation(GL_FUNC_ADD);
+}
+
+void PhosphorDisplay::drawSweep(const float *pPoints, size_t count,
+                                const glm::vec4 &color)
+{
+  if (streamed_m)
+  {
+    prv_streamSweep(pPoints, count, color);
+    return;
+  }
+
+  glBlendEquation(GL_FUNC_ADD);
+  glBlendFunc(GL_ONE, GL_ONE);
+  prv_setColor(color);
+  prv_drawPoints(pPoints, count, GL_LINE_STRIP);
+}
+
+void PhosphorDisplay::prv_setColor(const glm::vec4 &color)
+{
+  if (streamed_m)
+  {
+    /* Value of the attribute for the VAO of the quad, without array */
+    glVertexAttrib4fv(colorAttribute_m, glm::value_ptr(color));
+  }
+  else
+  {
+    shader_m.set_vec4(color, "color");
+  }
+}
+
+void PhosphorDisplay::prv_drawPoints(const float *pPoints, size_t count,
+                                     GLenum mode)
+{
+  if (count == 0)
+  {
+    return;
+  }
+
+  GLint position = glGetAttribLocation(shader_m.ulGetProgramId(), "pos");
+  if (glVAO_m)
+  {
+    glBindVertexArray(glVAO_m);
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, glVBO_m);
+  glBufferData(GL_ARRAY_BUFFER, count * 2 * sizeof(float), pPoints,
+               GL_STREAM_DRAW);
+  glEnableVertexAttribArray(position);
+  glVertexAttribPointer(position, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float),
+                        (void *)0);
+
+  glDrawArrays(mode, 0, static_cast<GLsizei>(count));
+
+  glDisableVertexAttribArray(position);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  if (glVAO_m)
+  {
+    glBindVertexArray(0);
+  }
+}
+
+void PhosphorDisplay::prv_streamSweep(const float *pPoints, size_t count,
+                                      const glm::vec4 &color)
+{
+  if (count < 2)
+  {
+    return;
+  }
+
+  /* The strip as separate lines, so that sweeps follow each other in one
+   * draw */
+  size_t vertices = (count - 1) * 2;
+  if (pStream_m == nullptr || streamCount_m + vertices > streamCapacity_m)
+  {
+    prv_flushStream();
+    size_t capacity = std::max<size_t>(streamCapacity_m,
+                                       PHOSPHOR_STREAM_VERTICES);
+    while (capacity < vertices)
+    {
+      capacity *= 2;
+    }
+    if (!prv_mapStream(capacity))
+    {
+      return;
+    }
+  }
+
+  SweepVertex *pVertex = pStream_m + streamCount_m;
+  for (size_t point = 1; point < count; ++point)
+  {
+    pVertex[0].x = pPoints[point * 2 - 2];
+    pVertex[0].y = pPoints[point * 2 - 1];
+    pVertex[0].color = color;
+    pVertex[1].x = pPoints[point * 2];
+    pVertex[1].y = pPoints[point * 2 + 1];
+    pVertex[1].color = color;
+    pVertex += 2;
+  }
+  streamCount_m += vertices;
+}
+
+bool PhosphorDisplay::prv_mapStream(size_t capacity)
+{
+  glBindBuffer(GL_ARRAY_BUFFER, glStreamVBO_m);
+  if (capacity != streamCapacity_m)
+  {
+    glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(SweepVertex), nullptr,
+                 GL_STREAM_DRAW);
+    streamCapacity_m = capacity;
+  }
+
+  /* Invalidated, the driver hands over new storage while the previous lines
+   * are drawn */
+  pStream_m = static_cast<SweepVertex *>(glMapBufferRange(
+      GL_ARRAY_BUFFER, 0, capacity * sizeof(SweepVertex),
+      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  streamCount_m = 0;
+  return pStream_m != nullptr;
+}
+
+void PhosphorDisplay::prv_flushStream(void)
+{
+  if (pStream_m == nullptr)
+  {
+    return;
+  }
+
+  glBindBuffer(GL_ARRAY_BUFFER, glStreamVBO_m);
+  bool valid = glUnmapBuffer(GL_ARRAY_BUFFER) == GL_TRUE;
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  pStream_m = nullptr;
+  if (!valid || streamCount_m == 0)
+  {
+    return;
+  }
+
+  glBlendEquation(GL_FUNC_ADD);
+  glBlendFunc(GL_ONE, GL_ONE);
+  glBindVertexArray(glStreamVAO_m);
+  glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(streamCount_m));
+  glBindVertexArray(0);
+  streamCount_m = 0;
+}
+} // namespace nrender
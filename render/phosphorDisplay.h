@@ -0,0 +1,105 @@
+#pragma once
+/** @file      phosphorDisplay.h
+ *  @brief     Header file for the persistent (phosphor) display.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/14
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "../pch/pch.h"
+#include "openglBufferManagement.h"
+#include "openglContext.h"
+#include "../shader/shaderUtil.h"
+
+namespace nrender
+{
+/**
+ * @brief Texture accumulating sweeps like the screen of an analog scope.
+ *
+ * Sweeps are drawn additively into an OpenGLFrameBuffer that is kept from one
+ * frame to the next and faded by decay(), so that thousands of overlaid
+ * sweeps cost only the drawing of the newest ones. Must be used on the thread
+ * of the GL context, between the frames or while ImGui builds one: the GL
+ * state the UI relies on (framebuffer, viewport, blending) is restored by
+ * end().
+ *
+ * With OpenGL ES 3.0 the sweeps are written as lines, with their color, into
+ * a mapped stream buffer and drawn together at end(); with OpenGL ES 2.0 each
+ * sweep is uploaded and drawn on its own.
+ */
+class PhosphorDisplay
+{
+public:
+  PhosphorDisplay();
+
+  ~PhosphorDisplay();
+
+  /* Size of the texture in pixels, clears it when it changes */
+  void resize(int32_t width, int32_t height);
+
+  /* Binds the texture to draw into it */
+  void begin(void);
+
+  void end(void);
+
+  void clear(void);
+
+  /* Multiplies every pixel by persistence, and takes at least one level off
+   * so that the 8-bit texture fades out completely */
+  void decay(float persistence);
+
+  /**
+   * @brief Draws one sweep as a line added to the texture.
+   * @param pPoints count x, y pairs in [-1, 1], the texture spans the square
+   */
+  void drawSweep(const float *pPoints, size_t count, const glm::vec4 &color);
+
+  uint32_t getTexture(void) { return frameBuffer_m.getTexture(); }
+
+  int32_t getWidth(void) const { return frameBuffer_m.getWidth(); }
+
+  int32_t getHeight(void) const { return frameBuffer_m.getHeight(); }
+
+private:
+  /* Vertex of the stream buffer */
+  struct SweepVertex
+  {
+    float x;
+    float y;
+    glm::vec4 color;
+  };
+
+  void prv_setColor(const glm::vec4 &color);
+
+  void prv_drawPoints(const float *pPoints, size_t count, GLenum mode);
+
+  void prv_streamSweep(const float *pPoints, size_t count,
+                       const glm::vec4 &color);
+
+  bool prv_mapStream(size_t capacity);
+
+  void prv_flushStream(void);
+
+  OpenGLFrameBuffer frameBuffer_m;
+  nshaders::Shader shader_m;
+  GLuint glVBO_m;
+  GLuint glVAO_m;
+  GLint viewport_m[4]; /* Of the UI, restored by end() */
+
+  /* OpenGL ES 3.0 stream of the sweeps drawn since the last flush */
+  bool streamed_m;
+  GLuint glStreamVBO_m;
+  GLuint glStreamVAO_m;
+  GLint colorAttribute_m;
+  SweepVertex *pStream_m;  /* Mapped, null when the buffer is not */
+  size_t streamCapacity_m; /* In vertices */
+  size_t streamCount_m;
+};
+} // namespace nrender
@@ -61,6 +61,10 @@ public:
 
   virtual uint32_t getTexture(void) = 0;
 
+  int32_t getWidth(void) const { return width_m; }
+
+  int32_t getHeight(void) const { return height_m; }
+
 protected:
   uint32_t FBO_m = 0;
   uint32_t texId_m = 0;
@@ -14,6 +14,7 @@
 
 #include "../pch/pch.h"
 #include "uiContext.h"
+#include "openglContext.h"
 #include "../backends/imgui.h"
 #include "../backends/imgui_impl_glfw.h"
 #include "../backends/imgui_impl_opengl3.h"
@@ -66,7 +67,12 @@ OrbCode_t UIContext::init(nwindow::IWindow *pWindow)
 
   /* GL 3.0 + GLSL 130 */
 #ifdef PLATFORM_RASPBERRY_PI
-  const char *pGlslVersion = "#version 100";  // OpenGL ES 2.0
+  /* The backend is built for OpenGL ES 2.0, which runs on both; only its
+   * shaders follow the context */
+  const char *pGlslVersion
+      = OpenGLContext::getCapabilities().majorVersion >= 3
+            ? "#version 300 es"  // OpenGL ES 3.0
+            : "#version 100";    // OpenGL ES 2.0
 #else
   const char *pGlslVersion = "#version 410";  // Desktop OpenGL
 #endif
@@ -0,0 +1,480 @@
+/** @file      acquisitionPipeline.cpp
+ *  @brief     Source file for the pipelined acquisition threads.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/03
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "acquisitionPipeline.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+
+/* Longest wait of the reader for a free slot */
+#define PIPELINE_STALL_WAIT_MS (5)
+
+/* Longest sleep of an idle stage before it checks for a stop */
+#define PIPELINE_IDLE_WAIT_MS (50)
+
+static void prv_updatePeak(std::atomic<size_t> &peak, size_t value)
+{
+  size_t current = peak.load(std::memory_order_relaxed);
+  while (value > current
+         && !peak.compare_exchange_weak(current, value,
+                                        std::memory_order_relaxed))
+  {
+  }
+}
+
+/* Affinity the process was started with, e.g. by taskset */
+static const cpu_set_t &prv_defaultCpus(void)
+{
+  static cpu_set_t defaultCpus = []
+  {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    if (sched_getaffinity(0, sizeof(cpus), &cpus) != 0)
+    {
+      long cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+      for (long cpu = 0; cpu < cpuCount && cpu < CPU_SETSIZE; ++cpu)
+      {
+        CPU_SET(cpu, &cpus);
+      }
+    }
+    return cpus;
+  }();
+  return defaultCpus;
+}
+
+static OrbCode_t prv_lockMemory(bool lock)
+{
+  static bool memoryLocked = false;
+  if (lock == memoryLocked)
+  {
+    return Success;
+  }
+
+  if (!lock)
+  {
+    munlockall();
+    memoryLocked = false;
+    return Success;
+  }
+
+  /* MCL_FUTURE makes any allocation past RLIMIT_MEMLOCK fail, it is only
+   * used when there is no such limit */
+  struct rlimit limit;
+  bool unlimited = geteuid() == 0
+                   || (getrlimit(RLIMIT_MEMLOCK, &limit) == 0
+                       && limit.rlim_cur == RLIM_INFINITY);
+  int flags = unlimited ? (MCL_CURRENT | MCL_FUTURE) : MCL_CURRENT;
+  if (mlockall(flags) != 0)
+  {
+    std::cerr << "Could not lock the process memory: " << strerror(errno)
+              << std::endl;
+    return ConfigError;
+  }
+  if (!unlimited)
+  {
+    std::cerr << "RLIMIT_MEMLOCK is limited, memory allocated from now on is "
+                 "not locked"
+              << std::endl;
+  }
+
+  memoryLocked = true;
+  return Success;
+}
+
+OrbCode_t applyReaderThreadOptions(const AcquisitionOptions &options)
+{
+  OrbCode_t orbCode = Success;
+
+  struct sched_param parameters;
+  memset(&parameters, 0, sizeof(parameters));
+  int policy = SCHED_OTHER;
+  if (options.realtimePriority > 0)
+  {
+    policy = SCHED_FIFO;
+    parameters.sched_priority
+        = std::clamp(options.realtimePriority, sched_get_priority_min(policy),
+                     sched_get_priority_max(policy));
+  }
+  int error = pthread_setschedparam(pthread_self(), policy, &parameters);
+  if (error != 0)
+  {
+    std::cerr << "Could not set the reader scheduling: " << strerror(error)
+              << std::endl;
+    orbCode = ConfigError;
+  }
+
+  cpu_set_t cpus = prv_defaultCpus();
+  long cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+  if (options.readerCpu >= 0)
+  {
+    if (options.readerCpu < cpuCount && options.readerCpu < CPU_SETSIZE)
+    {
+      CPU_ZERO(&cpus);
+      CPU_SET(options.readerCpu, &cpus);
+    }
+    else
+    {
+      std::cerr << "No CPU " << options.readerCpu << " for the reader"
+                << std::endl;
+      orbCode = ConfigError;
+    }
+  }
+  error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+  if (error != 0)
+  {
+    std::cerr << "Could not set the reader CPU: " << strerror(error)
+              << std::endl;
+    orbCode = ConfigError;
+  }
+
+  if (prv_lockMemory(options.lockMemory) != Success)
+  {
+    orbCode = ConfigError;
+  }
+
+  return orbCode;
+}
+
+AcquisitionPipeline::AcquisitionPipeline(SerialDevice &device)
+  : device_m(device)
+  , parseQueue_m(PIPELINE_SLOTS)
+  , recordQueue_m(PIPELINE_SLOTS)
+  , freeQueue_m(PIPELINE_SLOTS)
+  , heldSlot_m(0)
+  , holding_m(false)
+  , gapPending_m(false)
+  , gapTime_m(0.0)
+  , overloadPolicy_m(OVERLOAD_BLOCK)
+  , running_m(false)
+  , stopParser_m(false)
+  , stopConsumer_m(false)
+  , batches_m(0)
+  , readerStalls_m(0)
+  , parseQueuePeak_m(0)
+  , recordQueuePeak_m(0)
+  , bytesQueued_m(0)
+  , bytesParsed_m(0)
+  , bytesDropped_m(0)
+  , framesQueued_m(0)
+  , framesDispatched_m(0)
+{
+}
+
+AcquisitionPipeline::~AcquisitionPipeline()
+{
+  stop();
+}
+
+void AcquisitionPipeline::start(const AcquisitionOptions &options)
+{
+  std::lock_guard<std::mutex> lock(threadMutex_m);
+  if (running_m)
+  {
+    return;
+  }
+
+  /* Allocated on the first start only, the slots are then reused */
+  if (slots_m.empty())
+  {
+    slots_m.resize(PIPELINE_SLOTS);
+    for (Slot &slot : slots_m)
+    {
+      slot.bytes.resize(device_m.getReadSize());
+    }
+    discard_m.resize(device_m.getReadSize());
+  }
+
+  uint32_t index = 0;
+  while (freeQueue_m.pop(index))
+  {
+  }
+  for (index = 0; index < slots_m.size(); ++index)
+  {
+    freeQueue_m.push(index);
+  }
+  holding_m = false;
+  gapPending_m = false;
+  overloadPolicy_m = options.overloadPolicy;
+
+  batches_m = 0;
+  readerStalls_m = 0;
+  parseQueuePeak_m = 0;
+  recordQueuePeak_m = 0;
+  bytesQueued_m = 0;
+  bytesParsed_m = 0;
+  bytesDropped_m = 0;
+  framesQueued_m = 0;
+  framesDispatched_m = 0;
+
+  stopParser_m = false;
+  stopConsumer_m = false;
+  parser_m = std::thread(&AcquisitionPipeline::prv_parserThread, this);
+  consumer_m = std::thread(&AcquisitionPipeline::prv_consumerThread, this);
+  prv_setWorkerAffinity(options.readerCpu);
+  running_m = true;
+}
+
+void AcquisitionPipeline::stop(void)
+{
+  std::lock_guard<std::mutex> lock(threadMutex_m);
+  if (!running_m)
+  {
+    return;
+  }
+
+  /* Upstream first, each stage empties its queue before leaving */
+  stopParser_m = true;
+  parseQueue_m.wake();
+  parser_m.join();
+
+  stopConsumer_m = true;
+  recordQueue_m.wake();
+  consumer_m.join();
+
+  running_m = false;
+}
+
+void AcquisitionPipeline::setOptions(const AcquisitionOptions &options)
+{
+  std::lock_guard<std::mutex> lock(threadMutex_m);
+  overloadPolicy_m = options.overloadPolicy;
+  if (running_m)
+  {
+    prv_setWorkerAffinity(options.readerCpu);
+  }
+}
+
+void AcquisitionPipeline::prv_setWorkerAffinity(int readerCpu)
+{
+  cpu_set_t cpus = prv_defaultCpus();
+  if (readerCpu >= 0 && readerCpu < CPU_SETSIZE && CPU_COUNT(&cpus) > 1)
+  {
+    CPU_CLR(readerCpu, &cpus);
+  }
+
+  pthread_setaffinity_np(parser_m.native_handle(), sizeof(cpus), &cpus);
+  pthread_setaffinity_np(consumer_m.native_handle(), sizeof(cpus), &cpus);
+}
+
+bool AcquisitionPipeline::prv_acquireSlot(int timeoutMs)
+{
+  if (holding_m)
+  {
+    return true;
+  }
+
+  if (!freeQueue_m.pop(heldSlot_m))
+  {
+    readerStalls_m.fetch_add(1, std::memory_order_relaxed);
+    if (timeoutMs <= 0 || !freeQueue_m.waitForData(timeoutMs)
+        || !freeQueue_m.pop(heldSlot_m))
+    {
+      return false;
+    }
+  }
+
+  holding_m = true;
+  return true;
+}
+
+void AcquisitionPipeline::prv_queueSlot(void)
+{
+  prv_updatePeak(parseQueuePeak_m, parseQueue_m.size() + 1);
+
+  /* Cannot fail, every queue can hold all the slots */
+  parseQueue_m.push(heldSlot_m);
+  holding_m = false;
+  batches_m.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AcquisitionPipeline::prv_queueGap(double time)
+{
+  Slot &slot = slots_m[heldSlot_m];
+  slot.time = time;
+  slot.length = 0;
+  slot.gap = true;
+  prv_queueSlot();
+}
+
+OrbCode_t AcquisitionPipeline::prv_discardRead(void)
+{
+  /* Empties the port so that the driver does not overflow, the loss is
+   * counted here instead of disappearing in the kernel */
+  size_t received = 0;
+  double time = 0.0;
+  OrbCode_t readCode
+      = device_m.readBytes(discard_m.data(), discard_m.size(), received, time);
+  if (received > 0)
+  {
+    bytesDropped_m.fetch_add(received, std::memory_order_relaxed);
+    if (!gapPending_m)
+    {
+      gapPending_m = true;
+      gapTime_m = time;
+    }
+  }
+  return readCode;
+}
+
+OrbCode_t AcquisitionPipeline::read(void)
+{
+  bool dropNewest = overloadPolicy_m.load(std::memory_order_relaxed)
+                    == OVERLOAD_DROP_NEWEST;
+
+  /* Marks where bytes were discarded, before the bytes read after them */
+  if (gapPending_m && prv_acquireSlot(0))
+  {
+    gapPending_m = false;
+    prv_queueGap(gapTime_m);
+  }
+
+  if (!prv_acquireSlot(dropNewest ? 0 : PIPELINE_STALL_WAIT_MS))
+  {
+    return dropNewest ? prv_discardRead() : TimeoutError;
+  }
+
+  Slot &slot = slots_m[heldSlot_m];
+  size_t received = 0;
+  OrbCode_t readCode = device_m.readBytes(slot.bytes.data(),
+                                          slot.bytes.size(), received,
+                                          slot.time);
+  if (readCode != Success || received == 0)
+  {
+    /* The slot is kept for the next read */
+    return readCode;
+  }
+
+  slot.length = received;
+  slot.gap = false;
+  bytesQueued_m.fetch_add(received, std::memory_order_relaxed);
+  prv_queueSlot();
+  return Success;
+}
+
+void AcquisitionPipeline::insertGap(double time)
+{
+  /* The other stages always free slots eventually */
+  while (!prv_acquireSlot(PIPELINE_STALL_WAIT_MS))
+  {
+    if (!running_m)
+    {
+      device_m.insertGap(time);
+      return;
+    }
+  }
+
+  /* Also covers the bytes discarded before it */
+  gapPending_m = false;
+  prv_queueGap(time);
+}
+
+void AcquisitionPipeline::prv_parserThread(void)
+{
+  pthread_setname_np(pthread_self(), "mscope-parse");
+
+  uint32_t index = 0;
+  while (true)
+  {
+    if (parseQueue_m.pop(index))
+    {
+      Slot &slot = slots_m[index];
+      if (slot.gap)
+      {
+        device_m.insertGap(slot.time, &slot.batch);
+      }
+      else
+      {
+        device_m.processBytes(slot.bytes.data(), slot.length, slot.time,
+                              &slot.batch);
+        bytesParsed_m.fetch_add(slot.length, std::memory_order_relaxed);
+      }
+      framesQueued_m.fetch_add(slot.batch.frames, std::memory_order_relaxed);
+
+      prv_updatePeak(recordQueuePeak_m, recordQueue_m.size() + 1);
+      recordQueue_m.push(index);
+      continue;
+    }
+
+    /* Anything pushed before the stop request is seen by pop() by now */
+    if (stopParser_m)
+    {
+      if (parseQueue_m.empty())
+      {
+        break;
+      }
+      continue;
+    }
+    parseQueue_m.waitForData(PIPELINE_IDLE_WAIT_MS);
+  }
+}
+
+void AcquisitionPipeline::prv_consumerThread(void)
+{
+  pthread_setname_np(pthread_self(), "mscope-record");
+
+  uint32_t index = 0;
+  while (true)
+  {
+    if (recordQueue_m.pop(index))
+    {
+      Slot &slot = slots_m[index];
+      if (slot.batch.frames > 0)
+      {
+        device_m.dispatchFrames(slot.batch);
+        framesDispatched_m.fetch_add(slot.batch.frames,
+                                     std::memory_order_relaxed);
+      }
+      freeQueue_m.push(index);
+      continue;
+    }
+
+    if (stopConsumer_m)
+    {
+      if (recordQueue_m.empty())
+      {
+        break;
+      }
+      continue;
+    }
+    recordQueue_m.waitForData(PIPELINE_IDLE_WAIT_MS);
+  }
+}
+
+void AcquisitionPipeline::getStatistics(PipelineStatistics &statistics) const
+{
+  statistics.batches = batches_m.load(std::memory_order_relaxed);
+  statistics.readerStalls = readerStalls_m.load(std::memory_order_relaxed);
+  statistics.parseQueuePeak = parseQueuePeak_m.load(std::memory_order_relaxed);
+  statistics.recordQueuePeak
+      = recordQueuePeak_m.load(std::memory_order_relaxed);
+  /* Sizes read while the other threads move the queues, bounded anyway */
+  statistics.parseQueueDepth
+      = std::min<size_t>(parseQueue_m.size(), PIPELINE_SLOTS);
+  statistics.recordQueueDepth
+      = std::min<size_t>(recordQueue_m.size(), PIPELINE_SLOTS);
+  statistics.slots = PIPELINE_SLOTS;
+
+  statistics.overloadPolicy = overloadPolicy_m.load(std::memory_order_relaxed);
+  statistics.bytesQueued = bytesQueued_m.load(std::memory_order_relaxed);
+  statistics.bytesParsed = bytesParsed_m.load(std::memory_order_relaxed);
+  statistics.bytesDropped = bytesDropped_m.load(std::memory_order_relaxed);
+  statistics.framesQueued = framesQueued_m.load(std::memory_order_relaxed);
+  statistics.framesDispatched
+      = framesDispatched_m.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,192 @@
+/** @file      acquisitionPipeline.h
+ *  @brief     Header file for the pipelined acquisition threads.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/03
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef ACQUISITION_PIPELINE_H
+#define ACQUISITION_PIPELINE_H
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include "../Libraries/lib.h"
+#include "serialDevice.h"
+#include "spscQueue.h"
+#include "overloadPolicy.h"
+
+/* Reads in flight between the reader and the consumers */
+#define PIPELINE_SLOTS (32)
+
+/**
+ * @brief How the acquisition threads are run.
+ */
+struct AcquisitionOptions
+{
+  bool pipelined = true;    /* Parse and record on their own threads */
+  int realtimePriority = 0; /* SCHED_FIFO priority of the reader, 0 for none */
+  int readerCpu = -1;       /* CPU the reader is pinned to, -1 for any */
+  bool lockMemory = false;  /* mlockall(), the reader never page-faults */
+
+  /* What the reader does when every slot is in use: OVERLOAD_BLOCK leaves
+   * the bytes in the port until a slot is free (the driver loses them if it
+   * overflows meanwhile), OVERLOAD_DROP_NEWEST reads and discards them */
+  OverloadPolicy_t overloadPolicy = OVERLOAD_BLOCK;
+};
+
+/**
+ * @brief Counters of an AcquisitionPipeline since start().
+ */
+struct PipelineStatistics
+{
+  uint64_t batches = 0;      /* Reads handed to the parser */
+  uint64_t readerStalls = 0; /* Reads delayed because every slot was in use */
+  size_t parseQueuePeak = 0; /* Most reads waiting for the parser */
+  size_t recordQueuePeak = 0; /* Most batches waiting for the consumers */
+  size_t parseQueueDepth = 0;
+  size_t recordQueueDepth = 0;
+  size_t slots = 0;
+
+  OverloadPolicy_t overloadPolicy = OVERLOAD_BLOCK;
+  uint64_t bytesQueued = 0;  /* Read into a slot */
+  uint64_t bytesParsed = 0;
+  uint64_t bytesDropped = 0; /* Read and discarded by OVERLOAD_DROP_NEWEST */
+  uint64_t framesQueued = 0; /* Parsed and handed to the consumer thread */
+  uint64_t framesDispatched = 0;
+};
+
+/**
+ * @brief Applies the scheduling, affinity and memory options to the calling
+ * thread, which should be the reader.
+ *
+ * Failures (usually EPERM without CAP_SYS_NICE or CAP_IPC_LOCK) are reported
+ * on stderr and leave the thread with the default behaviour.
+ *
+ * @return Success, or ConfigError when an option could not be applied.
+ */
+OrbCode_t applyReaderThreadOptions(const AcquisitionOptions &options);
+
+/**
+ * @brief Splits the acquisition of a SerialDevice in three stages linked by
+ * bounded lock-free queues.
+ *
+ *  - reader: the caller of read(), only waits for and reads the bytes;
+ *  - parser: parses them and appends the messages to the device history;
+ *  - consumers: hands them to the frame callback (recording, shared memory,
+ *    live web view).
+ *
+ * Every read goes into one of a fixed set of preallocated slots, which travel
+ * reader -> parser -> consumers -> reader, so nothing is allocated once the
+ * pipeline has warmed up. A slow SD card write or a busy parser only fills
+ * slots: the reader keeps emptying the port until all of them are in use.
+ *
+ * When all the slots are in use the reader follows
+ * AcquisitionOptions::overloadPolicy. Bytes it discards are replaced by a gap
+ * marker queued as soon as a slot is free again.
+ *
+ * With AcquisitionOptions::readerCpu set, the parser and consumer threads
+ * are kept off the reader CPU. Booting with isolcpus=<cpu> keeps the rest of
+ * the system off it too, giving the reader a dedicated core.
+ */
+class AcquisitionPipeline
+{
+public:
+  explicit AcquisitionPipeline(SerialDevice &device);
+
+  ~AcquisitionPipeline();
+
+  AcquisitionPipeline(const AcquisitionPipeline &) = delete;
+  AcquisitionPipeline &operator=(const AcquisitionPipeline &) = delete;
+
+  /* Starts the parser and consumer threads */
+  void start(const AcquisitionOptions &options);
+
+  /* Processes everything already read, then stops the threads */
+  void stop(void);
+
+  bool isRunning(void) const { return running_m; }
+
+  /* Moves the parser and consumer threads off the new reader CPU, changes
+   * the overload policy */
+  void setOptions(const AcquisitionOptions &options);
+
+  /**
+   * @brief Reader stage, reads the available bytes and queues them.
+   *
+   * With OVERLOAD_BLOCK, waits up to a few milliseconds for a free slot when
+   * the other stages are behind. With OVERLOAD_DROP_NEWEST, reads and
+   * discards the bytes right away instead.
+   *
+   * @return Success once the bytes are queued (the messages they hold are
+   *         parsed later) or discarded, TimeoutError when no slot got free,
+   *         or the error of SerialDevice::readBytes().
+   */
+  OrbCode_t read(void);
+
+  /**
+   * @brief Reader stage, queues a gap marker behind the bytes already read.
+   * @see SerialDevice::insertGap()
+   */
+  void insertGap(double time);
+
+  void getStatistics(PipelineStatistics &statistics) const;
+
+private:
+  struct Slot
+  {
+    double time = 0.0;
+    size_t length = 0;
+    bool gap = false;
+    std::vector<char> bytes;
+    FrameBatch batch;
+  };
+
+  bool prv_acquireSlot(int timeoutMs);
+  void prv_queueSlot(void);
+  void prv_queueGap(double time);
+  OrbCode_t prv_discardRead(void);
+  void prv_parserThread(void);
+  void prv_consumerThread(void);
+  void prv_setWorkerAffinity(int readerCpu);
+
+  SerialDevice &device_m;
+  std::vector<Slot> slots_m;
+  SpscQueue<uint32_t> parseQueue_m;  /* reader -> parser */
+  SpscQueue<uint32_t> recordQueue_m; /* parser -> consumers */
+  SpscQueue<uint32_t> freeQueue_m;   /* consumers -> reader */
+  uint32_t heldSlot_m;               /* Taken by the reader, not yet queued */
+  bool holding_m;
+  std::vector<char> discard_m;       /* Bytes read without a free slot */
+  bool gapPending_m;                 /* Bytes were discarded since gapTime_m */
+  double gapTime_m;
+  std::atomic<OverloadPolicy_t> overloadPolicy_m;
+
+  std::mutex threadMutex_m; /* start(), stop() and setOptions() */
+  std::thread parser_m;
+  std::thread consumer_m;
+  std::atomic<bool> running_m;
+  std::atomic<bool> stopParser_m;
+  std::atomic<bool> stopConsumer_m;
+
+  std::atomic<uint64_t> batches_m;
+  std::atomic<uint64_t> readerStalls_m;
+  std::atomic<size_t> parseQueuePeak_m;
+  std::atomic<size_t> recordQueuePeak_m;
+  std::atomic<uint64_t> bytesQueued_m;
+  std::atomic<uint64_t> bytesParsed_m;
+  std::atomic<uint64_t> bytesDropped_m;
+  std::atomic<uint64_t> framesQueued_m;
+  std::atomic<uint64_t> framesDispatched_m;
+};
+
+#endif // ACQUISITION_PIPELINE_H
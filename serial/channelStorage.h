@@ -0,0 +1,316 @@
+/** @file      channelStorage.h
+ *  @brief     Header file for the per-channel history storage types.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/10
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef CHANNEL_STORAGE_H
+#define CHANNEL_STORAGE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include "../kernels/numericKernels.h"
+
+/**
+ * @brief Type a channel is kept as in the history.
+ *
+ * Integer types are meant for ADC counts: received values are rounded and
+ * clamped, and the smallest value of the type marks the gaps (NaN). The
+ * parser and the processing produce float, so there is no wider type.
+ */
+typedef enum
+{
+  STORAGE_FLOAT32 = 0,
+  STORAGE_INT8 = 1,
+  STORAGE_INT16 = 2,
+  STORAGE_INT32 = 3,
+  STORAGE_TYPE_COUNT
+} StorageType_t;
+
+/**
+ * @brief Storage of one channel. The history keeps the received values in
+ * their type; scale and offset turn them into the displayed values when they
+ * are read, so changing them applies to the whole history at once.
+ */
+struct ChannelStorage
+{
+  StorageType_t type = STORAGE_FLOAT32;
+  float scale = 1.0f;
+  float offset = 0.0f;
+
+  bool isIdentity(void) const { return scale == 1.0f && offset == 0.0f; }
+};
+
+/**
+ * @brief How the history keeps the time of the rows.
+ */
+typedef enum
+{
+  TIME_AXIS_TIMESTAMPS = 0, /* One time per row */
+  TIME_AXIS_MEASURED = 1,   /* Uniform, period measured from the arrivals */
+  TIME_AXIS_FIXED_RATE = 2, /* Uniform, period from the sample rate */
+  TIME_AXIS_MODE_COUNT
+} TimeAxisMode_t;
+
+/**
+ * @brief Time axis of the history. In the uniform modes a chunk stores a
+ * start time and a period instead of a time per row; a new start is only
+ * taken when the arrivals drift away from the period (reconnection, pause).
+ */
+struct TimeAxisStorage
+{
+  TimeAxisMode_t mode = TIME_AXIS_TIMESTAMPS;
+  double sampleRate = 1000.0; /* Hz, TIME_AXIS_FIXED_RATE */
+};
+
+/* Rows of a level reduced to one row of the next tier */
+#define HISTORY_TIER_FACTOR (10)
+
+/* Decimated tiers kept after the full-rate rows: 10x and 100x */
+#define HISTORY_TIER_COUNT (2)
+
+/* Available system memory, as a share of the total, below which the tiers
+ * shrink to a quarter of their budget */
+#define HISTORY_LOW_MEMORY_FRACTION (0.1)
+
+/**
+ * @brief Long-term retention of a HistoryStore. When enabled, the rows
+ * evicted from the full-rate history are reduced to the min, max and mean of
+ * every HISTORY_TIER_FACTOR rows in a first tier, whose evicted rows are
+ * reduced again in the next one.
+ */
+struct HistoryRetention
+{
+  bool enabled = false;
+  size_t budgetBytes = size_t(64) << 20; /* All the tiers together */
+  bool watchMemory = true; /* Shrink the tiers when the system runs low */
+  bool compress = false;   /* Pack every chunk once sealed, full rate too */
+};
+
+inline const char *getTimeAxisModeName(TimeAxisMode_t mode)
+{
+  switch (mode)
+  {
+  case TIME_AXIS_TIMESTAMPS:
+    return "Timestamp per sample";
+  case TIME_AXIS_MEASURED:
+    return "Uniform, measured rate";
+  case TIME_AXIS_FIXED_RATE:
+    return "Uniform, fixed rate";
+  default:
+    return "?";
+  }
+}
+
+inline const char *getStorageTypeName(StorageType_t type)
+{
+  switch (type)
+  {
+  case STORAGE_FLOAT32:
+    return "float32";
+  case STORAGE_INT8:
+    return "int8";
+  case STORAGE_INT16:
+    return "int16";
+  case STORAGE_INT32:
+    return "int32";
+  default:
+    return "?";
+  }
+}
+
+inline size_t getStorageTypeSize(StorageType_t type)
+{
+  switch (type)
+  {
+  case STORAGE_INT8:
+    return sizeof(int8_t);
+  case STORAGE_INT16:
+    return sizeof(int16_t);
+  default:
+    return sizeof(float); /* float32 and int32 */
+  }
+}
+
+/**
+ * @brief Calls function with a value of the C++ type of a storage type, so
+ * that a generic lambda is instantiated once per type:
+ *
+ *   visitStorageType(type, [&](auto tag) { using T = decltype(tag); ... });
+ */
+template <typename Function>
+void visitStorageType(StorageType_t type, Function &&function)
+{
+  switch (type)
+  {
+  case STORAGE_INT8:
+    function(int8_t());
+    break;
+  case STORAGE_INT16:
+    function(int16_t());
+    break;
+  case STORAGE_INT32:
+    function(int32_t());
+    break;
+  default:
+    function(float());
+    break;
+  }
+}
+
+template <typename T>
+inline bool isStorageGap(T value)
+{
+  if constexpr (std::is_floating_point<T>::value)
+  {
+    return std::isnan(value);
+  }
+  else
+  {
+    return value == std::numeric_limits<T>::min();
+  }
+}
+
+template <typename T>
+inline T encodeStorageValue(float value)
+{
+  if constexpr (std::is_floating_point<T>::value)
+  {
+    return static_cast<T>(value);
+  }
+  else
+  {
+    if (std::isnan(value))
+    {
+      return std::numeric_limits<T>::min();
+    }
+    double lowest = std::numeric_limits<T>::min() + 1.0;
+    double highest = std::numeric_limits<T>::max();
+    return static_cast<T>(
+        std::clamp(std::round(static_cast<double>(value)), lowest, highest));
+  }
+}
+
+/* Received values to a column of the history */
+template <typename T>
+void encodeColumn(const float *pInput, size_t count, T *pOutput)
+{
+  if constexpr (std::is_same<T, float>::value)
+  {
+    memcpy(pOutput, pInput, count * sizeof(float));
+  }
+  else
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      pOutput[i] = encodeStorageValue<T>(pInput[i]);
+    }
+  }
+}
+
+/* Column of the history to displayed values, gaps back to NaN */
+template <typename T>
+void decodeColumn(const T *pInput, size_t count, const ChannelStorage &storage,
+                  float *pOutput)
+{
+  const NumericKernels &kernels = getNumericKernels();
+
+  if constexpr (std::is_same<T, float>::value)
+  {
+    kernels.scaleOffset(pInput, count, storage.scale, storage.offset, pOutput);
+    return;
+  }
+  else if constexpr (std::is_same<T, int16_t>::value)
+  {
+    kernels.convertInt16(pInput, count, storage.scale, storage.offset,
+                         pOutput);
+  }
+  else if constexpr (std::is_same<T, int32_t>::value)
+  {
+    kernels.convertInt32(pInput, count, storage.scale, storage.offset,
+                         pOutput);
+  }
+  else
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      pOutput[i] = static_cast<float>(pInput[i]) * storage.scale
+                   + storage.offset;
+    }
+  }
+
+  if constexpr (!std::is_floating_point<T>::value)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (isStorageGap(pInput[i]))
+      {
+        pOutput[i] = std::numeric_limits<float>::quiet_NaN();
+      }
+    }
+  }
+}
+
+/* Statistics of the stored values, before scale and offset */
+template <typename T>
+void columnStatistics(const T *pValues, size_t count, SpanStatistics &statistics)
+{
+  if constexpr (std::is_same<T, float>::value)
+  {
+    getNumericKernels().minMaxSum(pValues, count, statistics);
+  }
+  else
+  {
+    T minValue = std::numeric_limits<T>::max();
+    T maxValue = std::numeric_limits<T>::lowest();
+    double sum = 0.0;
+    size_t numbers = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+      T value = pValues[i];
+      if (isStorageGap(value))
+      {
+        continue;
+      }
+      minValue = std::min(minValue, value);
+      maxValue = std::max(maxValue, value);
+      sum += value;
+      numbers++;
+    }
+
+    float notANumber = std::numeric_limits<float>::quiet_NaN();
+    statistics.minValue
+        = (numbers > 0) ? static_cast<float>(minValue) : notANumber;
+    statistics.maxValue
+        = (numbers > 0) ? static_cast<float>(maxValue) : notANumber;
+    statistics.sum = sum;
+    statistics.count = numbers;
+  }
+}
+
+/* Statistics of stored values to statistics of displayed values */
+inline void scaleStatistics(const ChannelStorage &storage,
+                            SpanStatistics &statistics)
+{
+  float low = statistics.minValue * storage.scale + storage.offset;
+  float high = statistics.maxValue * storage.scale + storage.offset;
+  statistics.minValue = std::min(low, high);
+  statistics.maxValue = std::max(low, high);
+  statistics.sum = statistics.sum * storage.scale
+                   + static_cast<double>(statistics.count) * storage.offset;
+}
+
+#endif // CHANNEL_STORAGE_H
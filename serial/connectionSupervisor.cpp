@@ -0,0 +1,233 @@
+/** @file      connectionSupervisor.cpp
+ *  @brief     Source file for the automatic serial port reconnection.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/28
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "connectionSupervisor.h"
+#include "deviceRegistry.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+static double prv_now(void)
+{
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/* Current device list, scanned on demand when the registry is not running */
+static std::shared_ptr<const SerialDeviceList> prv_currentDevices(void)
+{
+  if (!g_deviceRegistry.isRunning())
+  {
+    g_deviceRegistry.rescan();
+  }
+  return getSerialDevices();
+}
+
+ConnectionSupervisor::ConnectionSupervisor(SerialDevice &device)
+  : device_m(device)
+  , baudRate_m(0)
+  , stopBits_m(1)
+  , parity_m(0)
+  , state_m(CONNECTION_CLOSED)
+  , attempts_m(0)
+  , reconnects_m(0)
+  , lastProgress_m(0.0)
+  , lastFrameTime_m(0.0)
+  , nextAttempt_m(0.0)
+  , backoff_m(0.0)
+{
+}
+
+OrbCode_t ConnectionSupervisor::open(const std::string &portName,
+                                     uint32_t baudRate, uint8_t stopBits,
+                                     uint8_t parity)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+
+  OrbCode_t orbCode = device_m.open(portName, baudRate, stopBits, parity);
+  if (orbCode != Success)
+  {
+    return orbCode;
+  }
+
+  portName_m = portName;
+  if (portName_m.compare(0, 5, "/dev/") == 0)
+  {
+    portName_m.erase(0, 5);
+  }
+  baudRate_m = baudRate;
+  stopBits_m = stopBits;
+  parity_m = parity;
+
+  usbIdentity_m.clear();
+  for (const SerialDeviceInfo &info : *prv_currentDevices())
+  {
+    if (info.name == portName_m)
+    {
+      usbIdentity_m = info.getUsbIdentity();
+      break;
+    }
+  }
+
+  attempts_m = 0;
+  reconnects_m = 0;
+  lastProgress_m = prv_now();
+  lastFrameTime_m = device_m.getLastFrameTime();
+  state_m = CONNECTION_CONNECTED;
+
+  return Success;
+}
+
+void ConnectionSupervisor::close(void)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+  state_m = CONNECTION_CLOSED;
+  device_m.close();
+}
+
+void ConnectionSupervisor::setPolicy(const ReconnectPolicy &policy)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+  policy_m = policy;
+}
+
+ReconnectPolicy ConnectionSupervisor::getPolicy(void)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+  return policy_m;
+}
+
+void ConnectionSupervisor::setGapHandler(GapHandler handler)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+  gapHandler_m = std::move(handler);
+}
+
+void ConnectionSupervisor::reportResult(OrbCode_t orbCode)
+{
+  if (orbCode != ReadError || state_m != CONNECTION_CONNECTED)
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_m);
+  if (state_m == CONNECTION_CONNECTED)
+  {
+    prv_connectionLost("read error");
+  }
+}
+
+void ConnectionSupervisor::supervise(void)
+{
+  if (state_m == CONNECTION_CLOSED)
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_m);
+  double now = prv_now();
+
+  if (state_m == CONNECTION_RECONNECTING)
+  {
+    if (now >= nextAttempt_m)
+    {
+      prv_tryReconnect(now);
+    }
+    return;
+  }
+
+  if (state_m != CONNECTION_CONNECTED)
+  {
+    return;
+  }
+
+  /* Progress is any new message, whatever the capture time base does */
+  double lastFrameTime = device_m.getLastFrameTime();
+  if (lastFrameTime != lastFrameTime_m)
+  {
+    lastFrameTime_m = lastFrameTime;
+    lastProgress_m = now;
+    return;
+  }
+
+  if (policy_m.stallTimeout > 0.0
+      && now - lastProgress_m > policy_m.stallTimeout)
+  {
+    prv_connectionLost("no data");
+  }
+}
+
+void ConnectionSupervisor::prv_connectionLost(const char *pReason)
+{
+  /* The marker goes at the detection time, on the running time base */
+  if (gapHandler_m)
+  {
+    gapHandler_m(getCaptureTime());
+  }
+  else
+  {
+    device_m.insertGap(getCaptureTime());
+  }
+  device_m.close();
+
+  if (!policy_m.enabled)
+  {
+    std::cerr << "Lost " << portName_m << " (" << pReason << ")" << std::endl;
+    state_m = CONNECTION_CLOSED;
+    return;
+  }
+
+  std::cerr << "Lost " << portName_m << " (" << pReason << "), reconnecting"
+            << std::endl;
+  attempts_m = 0;
+  backoff_m = policy_m.initialBackoff;
+  nextAttempt_m = prv_now() + backoff_m;
+  state_m = CONNECTION_RECONNECTING;
+}
+
+void ConnectionSupervisor::prv_tryReconnect(double now)
+{
+  attempts_m++;
+
+  std::string name = portName_m;
+  bool found = true;
+  if (!usbIdentity_m.empty())
+  {
+    /* A sibling adapter of the same model may be held by another port */
+    prv_currentDevices();
+    found = findSerialDeviceByUsbIdentity(usbIdentity_m, name, true);
+  }
+
+  if (found
+      && device_m.open(name, baudRate_m, stopBits_m, parity_m) == Success)
+  {
+    if (name != portName_m)
+    {
+      std::cerr << portName_m << " is now " << name << std::endl;
+    }
+    std::cerr << "Reconnected " << name << " after " << attempts_m
+              << " attempt(s)" << std::endl;
+    portName_m = name;
+    reconnects_m++;
+    attempts_m = 0;
+    lastProgress_m = now;
+    lastFrameTime_m = device_m.getLastFrameTime();
+    state_m = CONNECTION_CONNECTED;
+    return;
+  }
+
+  backoff_m = std::min(backoff_m * 2.0, policy_m.maxBackoff);
+  nextAttempt_m = now + backoff_m;
+}
@@ -0,0 +1,127 @@
+/** @file      connectionSupervisor.h
+ *  @brief     Header file for the automatic serial port reconnection.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/28
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef CONNECTION_SUPERVISOR_H
+#define CONNECTION_SUPERVISOR_H
+
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include "serialDevice.h"
+#include "../Libraries/lib.h"
+
+/**
+ * @brief When and how often a lost port is reopened.
+ */
+struct ReconnectPolicy
+{
+  bool enabled = true;
+  double stallTimeout = 5.0;   /* Seconds without a message, 0 disables */
+  double initialBackoff = 0.5; /* Seconds before the first attempt */
+  double maxBackoff = 10.0;    /* Longest delay between two attempts */
+};
+
+typedef enum
+{
+  CONNECTION_CLOSED = 0,
+  CONNECTION_CONNECTED = 1,
+  CONNECTION_RECONNECTING = 2
+} ConnectionState_t;
+
+/**
+ * @brief Keeps a serial port open through unplugs, adapter resets and stalls.
+ *
+ * A read error (EIO/ENODEV, hang-up) or a stall (no message for the stall
+ * timeout) closes the port, inserts one gap marker in the device history and
+ * recording, and reopens the port with an exponential backoff. A USB adapter
+ * is looked up again by VID:PID:serial, so it is found even when it comes
+ * back under another node name. The capture time base is never reset, data
+ * after the gap keeps its real timestamps.
+ */
+class ConnectionSupervisor
+{
+public:
+  using GapHandler = std::function<void(double time)>;
+
+  explicit ConnectionSupervisor(SerialDevice &device);
+
+  /**
+   * @brief Opens a serial port and supervises it until close().
+   * @return The result of SerialDevice::open().
+   */
+  OrbCode_t open(const std::string &portName, uint32_t baudRate,
+                 uint8_t stopBits, uint8_t parity);
+
+  /* Stops supervising and closes the port */
+  void close(void);
+
+  void setPolicy(const ReconnectPolicy &policy);
+
+  ReconnectPolicy getPolicy(void);
+
+  /**
+   * @brief Replaces SerialDevice::insertGap() for the gap marker, e.g. to
+   * queue it behind the data an AcquisitionPipeline has not processed yet.
+   * An empty handler restores the default.
+   */
+  void setGapHandler(GapHandler handler);
+
+  /**
+   * @brief Reports the result of a wait() or read() of the device.
+   *
+   * A ReadError while connected starts a reconnection.
+   */
+  void reportResult(OrbCode_t orbCode);
+
+  /**
+   * @brief Checks for a stall and runs the reconnection attempts when due.
+   * Called by the reader loop after every wait/read cycle.
+   */
+  void supervise(void);
+
+  ConnectionState_t getState(void) const { return state_m; }
+
+  /* Attempts of the current reconnection */
+  uint32_t getAttemptCount(void) const { return attempts_m; }
+
+  /* Reconnections completed since open() */
+  uint32_t getReconnectCount(void) const { return reconnects_m; }
+
+private:
+  void prv_connectionLost(const char *pReason);
+  void prv_tryReconnect(double now);
+
+  SerialDevice &device_m;
+  std::mutex mutex_m;
+  ReconnectPolicy policy_m;
+  GapHandler gapHandler_m;
+
+  std::string portName_m;
+  std::string usbIdentity_m; /* Empty when the port is not a USB adapter */
+  uint32_t baudRate_m;
+  uint8_t stopBits_m;
+  uint8_t parity_m;
+
+  std::atomic<ConnectionState_t> state_m;
+  std::atomic<uint32_t> attempts_m;
+  std::atomic<uint32_t> reconnects_m;
+  double lastProgress_m;  /* Steady time of the last new message */
+  double lastFrameTime_m; /* Device last frame time seen at that moment */
+  double nextAttempt_m;
+  double backoff_m;
+};
+
+#endif // CONNECTION_SUPERVISOR_H
@@ -13,16 +13,22 @@
  */
 
 #include "csvStorage.h"
+#include "historyStore.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <filesystem>
+#include <cmath>
+
+// Rows are buffered and written to disk at most this often
+#define CSV_FLUSH_INTERVAL_MS (1000)
+#define CSV_FILE_BUFFER_SIZE (64 * 1024)
 
 // Global instance
 CSVStorage g_csvStorage;
 
 CSVStorage::CSVStorage() 
-    : recording(false), dataPointsRecorded(0)
+    : recording(false), dataPointsRecorded(0), dataPointsFailed(0)
 {
 }
 
@@ -51,7 +57,9 @@ bool CSVStorage::startRecording(const std::string& filename, const std::vector<s
         return false;
     }
 
-    // Open the CSV file
+    // Open the CSV file with a large buffer, rows are flushed periodically
+    fileBuffer.resize(CSV_FILE_BUFFER_SIZE);
+    csvFile.rdbuf()->pubsetbuf(fileBuffer.data(), fileBuffer.size());
     csvFile.open(filename);
     if (!csvFile.is_open())
     {
@@ -62,7 +70,9 @@ bool CSVStorage::startRecording(const std::string& filename, const std::vector<s
     currentFilename = filename;
     recording = true;
     dataPointsRecorded = 0;
+    dataPointsFailed = 0;
     recordingStartTime = std::chrono::steady_clock::now();
+    lastFlushTime = recordingStartTime;
 
     // Write the header
     writeHeader(channelNames);
@@ -103,16 +113,35 @@ bool CSVStorage::writeDataRow(double timestamp, const std::vector<float>& data)
     try
     {
         // Write timestamp first
-        csvFile << formatTimestamp(timestamp);
+        csvFile << std::fixed << std::setprecision(6) << timestamp;
         
         // Write data values
+        // Missing values (NaN) are written as empty fields
         for (size_t i = 0; i < data.size(); ++i)
         {
-            csvFile << "," << std::fixed << std::setprecision(6) << data[i];
+            csvFile << ",";
+            if (!std::isnan(data[i]))
+            {
+                csvFile << data[i];
+            }
         }
         
-        csvFile << std::endl;
+        csvFile << '\n';
+        if (!csvFile)
+        {
+            // The stream stays failed, every following row is lost too
+            dataPointsFailed++;
+            return false;
+        }
         dataPointsRecorded++;
+
+        // Flush periodically instead of on every row
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastFlushTime >= std::chrono::milliseconds(CSV_FLUSH_INTERVAL_MS))
+        {
+            csvFile.flush();
+            lastFlushTime = now;
+        }
         
         return true;
     }
@@ -138,6 +167,11 @@ size_t CSVStorage::getRecordedDataPoints() const
     return dataPointsRecorded;
 }
 
+size_t CSVStorage::getFailedDataPoints() const
+{
+    return dataPointsFailed;
+}
+
 void CSVStorage::writeHeader(const std::vector<std::string>& channelNames)
 {
     csvFile << "Timestamp";
@@ -186,6 +220,11 @@ size_t getCSVRecordedDataPoints()
     return g_csvStorage.getRecordedDataPoints();
 }
 
+size_t getCSVFailedDataPoints()
+{
+    return g_csvStorage.getFailedDataPoints();
+}
+
 std::string generateTimestampedFilename(const std::string& baseName)
 {
     auto now = std::chrono::system_clock::now();
@@ -198,4 +237,42 @@ std::string generateTimestampedFilename(const std::string& baseName)
         << ".csv";
     
     return oss.str();
-} 
\ No newline at end of file
+} 
+bool exportHistoryCSV(const std::string& filename, const std::vector<std::string>& channelNames,
+                      const HistorySnapshot& history)
+{
+    CSVStorage storage;
+    if (!storage.startRecording(filename, channelNames))
+    {
+        return false;
+    }
+
+    // One segment at a time, every channel converted before its rows are written
+    size_t channels = history.getChannelCount();
+    std::vector<double> times;
+    std::vector<std::vector<float>> buffers(channels);
+    std::vector<const float*> columns(channels);
+    std::vector<float> row(channels);
+    bool written = true;
+    for (size_t segment = 0; segment < history.getSegmentCount(); ++segment)
+    {
+        history.getSegmentTimes(segment, times);
+        for (size_t channel = 0; channel < channels; ++channel)
+        {
+            columns[channel] = history.getSegmentValues(segment, channel, buffers[channel]);
+        }
+
+        // The first row of a segment repeats the last one of the previous segment
+        for (size_t i = history.getSegmentOverlap(segment); i < times.size(); ++i)
+        {
+            for (size_t channel = 0; channel < channels; ++channel)
+            {
+                row[channel] = columns[channel][i];
+            }
+            written = storage.writeDataRow(times[i], row) && written;
+        }
+    }
+
+    storage.stopRecording();
+    return written;
+}
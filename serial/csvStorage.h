@@ -22,6 +22,8 @@
 #include <chrono>
 #include "../Libraries/lib.h"
 
+class HistorySnapshot;
+
 class CSVStorage
 {
 public:
@@ -67,13 +69,23 @@ public:
      */
     size_t getRecordedDataPoints() const;
 
+    /**
+     * @brief Gets the number of rows lost because the file could not be
+     * written (disk full, storage removed) since the recording started
+     * @return Number of rows lost
+     */
+    size_t getFailedDataPoints() const;
+
 private:
     std::ofstream csvFile;
     std::string currentFilename;
     bool recording;
     size_t dataPointsRecorded;
+    size_t dataPointsFailed;
     std::mutex fileMutex;
     std::chrono::steady_clock::time_point recordingStartTime;
+    std::chrono::steady_clock::time_point lastFlushTime;
+    std::vector<char> fileBuffer;
 
     /**
      * @brief Writes the CSV header with timestamp and channel names
@@ -99,6 +111,7 @@ bool writeCSVDataRow(double timestamp, const std::vector<float>& data);
 bool isCSVRecording();
 std::string getCSVCurrentFilename();
 size_t getCSVRecordedDataPoints();
+size_t getCSVFailedDataPoints();
 
 /**
  * @brief Generates a timestamped filename for CSV recording
@@ -107,4 +120,16 @@ size_t getCSVRecordedDataPoints();
  */
 std::string generateTimestampedFilename(const std::string& baseName = "mscope");
 
+/**
+ * @brief Writes every row of a history snapshot to a CSV file, in the format
+ * of the recordings. The snapshot is not affected by the acquisition, the
+ * export can run on any thread.
+ * @param filename The name of the CSV file to create
+ * @param channelNames Vector of channel names for CSV headers
+ * @param history The rows to write
+ * @return true if every row was written, false otherwise
+ */
+bool exportHistoryCSV(const std::string& filename, const std::vector<std::string>& channelNames,
+                      const HistorySnapshot& history);
+
 #endif // CSV_STORAGE_H 
\ No newline at end of file
@@ -0,0 +1,377 @@
+/** @file      deviceRegistry.cpp
+ *  @brief     Source file for the serial device discovery cache.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/26
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "deviceRegistry.h"
+#include "serialPortSource.h"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <dirent.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+
+#define REGISTRY_DEV_DIR "/dev"
+#define REGISTRY_SYSFS_TTY_DIR "/sys/class/tty/"
+#define REGISTRY_SYSFS_DEVICES_DIR "/sys/devices"
+#define REGISTRY_DEBOUNCE_MS (100)     /* Coalesces the events of a hotplug */
+#define REGISTRY_FALLBACK_SCAN_MS (3000) /* Rescan period without inotify */
+
+// Global instance
+DeviceRegistry g_deviceRegistry;
+
+std::string SerialDeviceInfo::getUsbIdentity(void) const
+{
+  if (!isUsb())
+  {
+    return std::string();
+  }
+  std::string identity = vendorId + ":" + productId;
+  if (!serialNumber.empty())
+  {
+    identity += ":" + serialNumber;
+  }
+  else if (!usbPort.empty())
+  {
+    identity += "@" + usbPort;
+  }
+  return identity;
+}
+
+static std::string prv_readAttribute(const std::string &path)
+{
+  std::ifstream file(path);
+  std::string value;
+  std::getline(file, value);
+  while (!value.empty() && std::isspace(static_cast<unsigned char>(value.back())))
+  {
+    value.pop_back();
+  }
+  return value;
+}
+
+/* Fills the sysfs part of a device description */
+static void prv_readSysfsInfo(SerialDeviceInfo &info)
+{
+  std::string link = REGISTRY_SYSFS_TTY_DIR + info.name + "/device";
+  char resolved[PATH_MAX];
+  if (realpath(link.c_str(), resolved) == nullptr)
+  {
+    return;
+  }
+  info.hardware = true;
+
+  /* The USB device owning the interface is the first parent with ids */
+  std::string path = resolved;
+  while (path.size() > strlen(REGISTRY_SYSFS_DEVICES_DIR)
+         && path.compare(0, strlen(REGISTRY_SYSFS_DEVICES_DIR),
+                         REGISTRY_SYSFS_DEVICES_DIR)
+                == 0)
+  {
+    std::string vendorId = prv_readAttribute(path + "/idVendor");
+    if (!vendorId.empty())
+    {
+      info.vendorId = vendorId;
+      info.productId = prv_readAttribute(path + "/idProduct");
+      info.serialNumber = prv_readAttribute(path + "/serial");
+      info.usbPort = path.substr(path.rfind('/') + 1);
+      std::string manufacturer = prv_readAttribute(path + "/manufacturer");
+      std::string product = prv_readAttribute(path + "/product");
+      info.description = manufacturer;
+      if (!product.empty())
+      {
+        info.description += (info.description.empty() ? "" : " ") + product;
+      }
+      return;
+    }
+    path.erase(path.rfind('/'));
+  }
+}
+
+static bool prv_isTtyName(const char *pName)
+{
+  return strncmp(pName, "tty", 3) == 0;
+}
+
+static bool prv_sameDevices(const SerialDeviceList &a, const SerialDeviceList &b)
+{
+  if (a.size() != b.size())
+  {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); ++i)
+  {
+    if (a[i].name != b[i].name || a[i].vendorId != b[i].vendorId
+        || a[i].productId != b[i].productId
+        || a[i].serialNumber != b[i].serialNumber
+        || a[i].usbPort != b[i].usbPort)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+DeviceRegistry::DeviceRegistry()
+  : pDevices_m(std::make_shared<const SerialDeviceList>())
+  , generation_m(0)
+  , running_m(false)
+  , inotifyFd_m(-1)
+  , wakeFd_m(-1)
+{
+}
+
+DeviceRegistry::~DeviceRegistry()
+{
+  stop();
+}
+
+OrbCode_t DeviceRegistry::start(void)
+{
+  if (running_m)
+  {
+    return PortStateError;
+  }
+
+  /* Without inotify the thread falls back to a slow periodic scan */
+  inotifyFd_m = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotifyFd_m >= 0
+      && inotify_add_watch(inotifyFd_m, REGISTRY_DEV_DIR,
+                           IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO)
+             < 0)
+  {
+    std::cerr << "Cannot watch " << REGISTRY_DEV_DIR << ": " << strerror(errno)
+              << std::endl;
+    ::close(inotifyFd_m);
+    inotifyFd_m = -1;
+  }
+  wakeFd_m = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+  /* The watch is set first so that no device can appear unnoticed */
+  rescan();
+
+  running_m = true;
+  thread_m = std::thread(&DeviceRegistry::prv_watchThread, this);
+
+  return Success;
+}
+
+void DeviceRegistry::stop(void)
+{
+  if (!running_m)
+  {
+    return;
+  }
+
+  running_m = false;
+  if (wakeFd_m >= 0)
+  {
+    uint64_t one = 1;
+    (void)!write(wakeFd_m, &one, sizeof(one));
+  }
+  if (thread_m.joinable())
+  {
+    thread_m.join();
+  }
+  if (inotifyFd_m >= 0)
+  {
+    ::close(inotifyFd_m);
+    inotifyFd_m = -1;
+  }
+  if (wakeFd_m >= 0)
+  {
+    ::close(wakeFd_m);
+    wakeFd_m = -1;
+  }
+}
+
+std::shared_ptr<const SerialDeviceList> DeviceRegistry::getDevices(void) const
+{
+  return std::atomic_load(&pDevices_m);
+}
+
+void DeviceRegistry::rescan(void)
+{
+  auto pDevices = std::make_shared<SerialDeviceList>();
+
+  DIR *pDir = opendir(REGISTRY_DEV_DIR);
+  if (pDir == nullptr)
+  {
+    std::cerr << "Error opening directory: " << REGISTRY_DEV_DIR << std::endl;
+    return;
+  }
+
+  struct dirent *pEntry;
+  while ((pEntry = readdir(pDir)) != nullptr)
+  {
+    if (!prv_isTtyName(pEntry->d_name))
+    {
+      continue;
+    }
+
+    std::string path = std::string(REGISTRY_DEV_DIR "/") + pEntry->d_name;
+    struct stat fileStat;
+    if (stat(path.c_str(), &fileStat) != 0 || !S_ISCHR(fileStat.st_mode))
+    {
+      continue;
+    }
+
+    SerialDeviceInfo info;
+    info.name = pEntry->d_name;
+    prv_readSysfsInfo(info);
+    pDevices->push_back(std::move(info));
+  }
+  closedir(pDir);
+
+  /* Real ports first so that they are the default selection */
+  std::sort(pDevices->begin(), pDevices->end(),
+            [](const SerialDeviceInfo &a, const SerialDeviceInfo &b)
+            {
+              if (a.hardware != b.hardware)
+              {
+                return a.hardware;
+              }
+              return a.name < b.name;
+            });
+
+  if (!prv_sameDevices(*pDevices, *getDevices()))
+  {
+    std::atomic_store(&pDevices_m,
+                      std::shared_ptr<const SerialDeviceList>(pDevices));
+    generation_m++;
+  }
+}
+
+void DeviceRegistry::prv_watchThread(void)
+{
+  alignas(struct inotify_event) char buffer[4096];
+  bool pending = false;
+
+  while (running_m)
+  {
+    struct pollfd descriptors[2] = {{wakeFd_m, POLLIN, 0},
+                                    {inotifyFd_m, POLLIN, 0}};
+    int timeout = (inotifyFd_m < 0) ? REGISTRY_FALLBACK_SCAN_MS
+                  : pending         ? REGISTRY_DEBOUNCE_MS
+                                    : -1;
+    int ready = poll(descriptors, (inotifyFd_m < 0) ? 1 : 2, timeout);
+    if (!running_m)
+    {
+      break;
+    }
+    if (ready < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      break;
+    }
+
+    /* Scan once the burst of events of a plug or unplug is over */
+    if (ready == 0)
+    {
+      rescan();
+      pending = false;
+      continue;
+    }
+
+    if (inotifyFd_m >= 0 && (descriptors[1].revents & POLLIN))
+    {
+      ssize_t length;
+      while ((length = read(inotifyFd_m, buffer, sizeof(buffer))) > 0)
+      {
+        for (char *pEvent = buffer; pEvent < buffer + length;)
+        {
+          const struct inotify_event *pInfo
+              = reinterpret_cast<const struct inotify_event *>(pEvent);
+          if ((pInfo->mask & IN_Q_OVERFLOW)
+              || (pInfo->len > 0 && prv_isTtyName(pInfo->name)))
+          {
+            pending = true;
+          }
+          pEvent += sizeof(struct inotify_event) + pInfo->len;
+        }
+      }
+    }
+  }
+}
+
+OrbCode_t startSerialDeviceRegistry(void)
+{
+  return g_deviceRegistry.start();
+}
+
+void stopSerialDeviceRegistry(void)
+{
+  g_deviceRegistry.stop();
+}
+
+std::shared_ptr<const SerialDeviceList> getSerialDevices(void)
+{
+  return g_deviceRegistry.getDevices();
+}
+
+uint64_t getSerialDeviceGeneration(void)
+{
+  return g_deviceRegistry.getGeneration();
+}
+
+bool findSerialDeviceByUsbIdentity(const std::string &identity,
+                                   std::string &name, bool skipOpen)
+{
+  auto toLower = [](std::string text)
+  {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return text;
+  };
+
+  std::string wanted = toLower(identity);
+  std::string first;
+  for (const SerialDeviceInfo &info : *getSerialDevices())
+  {
+    if (!info.isUsb() || (skipOpen && isSerialPortOpen(info.name)))
+    {
+      continue;
+    }
+    std::string ids = toLower(info.vendorId + ":" + info.productId);
+    std::string full = toLower(info.getUsbIdentity());
+    if (wanted != ids && wanted != full)
+    {
+      continue;
+    }
+    if (info.name == name)
+    {
+      return true;
+    }
+    if (first.empty())
+    {
+      first = info.name;
+    }
+  }
+  if (first.empty())
+  {
+    return false;
+  }
+  name = first;
+  return true;
+}
@@ -0,0 +1,120 @@
+/** @file      deviceRegistry.h
+ *  @brief     Header file for the serial device discovery cache.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/26
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef DEVICE_REGISTRY_H
+#define DEVICE_REGISTRY_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include "../Libraries/lib.h"
+
+/**
+ * @brief A tty character device of /dev, with its USB identity when it has
+ * one.
+ */
+struct SerialDeviceInfo
+{
+  std::string name;         /* Node name without "/dev/", e.g. ttyUSB0 */
+  std::string vendorId;     /* USB idVendor, e.g. 0403, empty if not USB */
+  std::string productId;    /* USB idProduct */
+  std::string serialNumber; /* USB iSerial, may be empty */
+  std::string usbPort;      /* Hub port path of the USB device, e.g. 1-1.2 */
+  std::string description;  /* USB manufacturer and product strings */
+  bool hardware = false;    /* Backed by a device (not a virtual console) */
+
+  bool isUsb(void) const { return !vendorId.empty(); }
+
+  /* "VID:PID:SERIAL", "VID:PID@PORT" for adapters without a serial number,
+   * or an empty string when not USB */
+  std::string getUsbIdentity(void) const;
+};
+
+using SerialDeviceList = std::vector<SerialDeviceInfo>;
+
+/**
+ * @brief Keeps the list of serial devices without scanning /dev per frame.
+ *
+ * /dev is scanned once when started and again only when inotify reports that
+ * a tty node was created, removed or renamed (or every few seconds when
+ * inotify is not available). Each scan publishes a new immutable list, with
+ * hardware ports first, so readers only copy a shared pointer.
+ */
+class DeviceRegistry
+{
+public:
+  DeviceRegistry();
+  ~DeviceRegistry();
+
+  /**
+   * @brief Scans /dev and starts watching it.
+   * @return Success or PortStateError when already started.
+   */
+  OrbCode_t start(void);
+
+  void stop(void);
+
+  bool isRunning(void) const { return running_m; }
+
+  /* Current list, never null, empty before the first scan */
+  std::shared_ptr<const SerialDeviceList> getDevices(void) const;
+
+  /* Incremented each time the published list changes */
+  uint64_t getGeneration(void) const { return generation_m; }
+
+  /**
+   * @brief Scans /dev now, for callers that need a list before start().
+   */
+  void rescan(void);
+
+private:
+  void prv_watchThread(void);
+
+  std::shared_ptr<const SerialDeviceList> pDevices_m;
+  std::atomic<uint64_t> generation_m;
+  std::atomic<bool> running_m;
+  int inotifyFd_m;
+  int wakeFd_m;
+  std::thread thread_m;
+};
+
+// Global instance
+extern DeviceRegistry g_deviceRegistry;
+
+// Global functions for easy access
+OrbCode_t startSerialDeviceRegistry(void);
+void stopSerialDeviceRegistry(void);
+std::shared_ptr<const SerialDeviceList> getSerialDevices(void);
+uint64_t getSerialDeviceGeneration(void);
+
+/**
+ * @brief Finds the device of a USB identity in the current list.
+ *
+ * Adapters of one model without serial numbers share their "VID:PID", so a
+ * full identity also names the USB port, and a multi-port adapter has one
+ * node per interface: the node already in name wins among the matches.
+ *
+ * @param identity "VID:PID", "VID:PID:SERIAL" or "VID:PID@PORT",
+ *        hexadecimal ids in any case
+ * @param name Preferred node name, then the node of the matching device
+ * @param skipOpen Whether ports open in this process are left out
+ * @return true when a device matches.
+ */
+bool findSerialDeviceByUsbIdentity(const std::string &identity,
+                                   std::string &name, bool skipOpen = false);
+
+#endif // DEVICE_REGISTRY_H
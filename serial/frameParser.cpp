@@ -0,0 +1,140 @@
+/** @file      frameParser.cpp
+ *  @brief     Source file for the parser of the received message stream.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/10
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "frameParser.h"
+#include <charconv>
+
+FrameParser::FrameParser()
+  : channelCount_m(0)
+  , startFlag_m(false)
+  , tokenLength_m(0)
+  , tokenOverflow_m(false)
+  , valueCount_m(0)
+{
+}
+
+void FrameParser::setChannelCount(int channels)
+{
+  if (channels != channelCount_m)
+  {
+    channelCount_m = channels;
+    values_m.resize(channels > 0 ? channels : 0);
+    reset();
+  }
+}
+
+void FrameParser::reset(void)
+{
+  startFlag_m = false;
+  tokenLength_m = 0;
+  tokenOverflow_m = false;
+  valueCount_m = 0;
+}
+
+void FrameParser::prv_endValue(void)
+{
+  float value = 0.0f;
+  bool valid = tokenLength_m > 0 && !tokenOverflow_m;
+  if (valid)
+  {
+    std::from_chars_result result = std::from_chars(
+        token_m, token_m + tokenLength_m, value, std::chars_format::fixed);
+    valid = result.ec == std::errc();
+  }
+
+  if (!valid)
+  {
+    statistics_m.parseErrors++;
+  }
+  else
+  {
+    /* Extra values are only counted, the message is dropped anyway */
+    if (valueCount_m < values_m.size())
+    {
+      values_m[valueCount_m] = value;
+    }
+    valueCount_m++;
+  }
+
+  tokenLength_m = 0;
+  tokenOverflow_m = false;
+}
+
+size_t FrameParser::parse(const char *pData, size_t length,
+                          std::vector<float> &frames)
+{
+  size_t framesParsed = 0;
+
+  for (size_t i = 0; i < length; ++i)
+  {
+    char currentChar = pData[i];
+
+    /* Check if the character is a valid ASCII character */
+    if (currentChar <= 0)
+    {
+      statistics_m.invalidBytes++;
+      continue;
+    }
+
+    if (!startFlag_m)
+    {
+      if (currentChar == '\n')
+      {
+        startFlag_m = true;
+        tokenLength_m = 0;
+        tokenOverflow_m = false;
+        valueCount_m = 0;
+      }
+      continue;
+    }
+
+    /* Check if the character is a digit, dot, or minus sign */
+    if ((currentChar >= '0' && currentChar <= '9') || currentChar == '.'
+        || currentChar == '-')
+    {
+      /* Append it to the current value, an overflow is a parse error */
+      if (tokenLength_m < FRAME_PARSER_TOKEN_SIZE)
+      {
+        token_m[tokenLength_m++] = currentChar;
+      }
+      else
+      {
+        tokenOverflow_m = true;
+      }
+    }
+    else if (currentChar == ',')
+    {
+      prv_endValue();
+    }
+    else if (currentChar == '\r')
+    {
+      /* End of message, store it when it has one value per channel */
+      prv_endValue();
+      startFlag_m = false;
+
+      if (channelCount_m > 0 && valueCount_m == (size_t)channelCount_m)
+      {
+        frames.insert(frames.end(), values_m.begin(), values_m.end());
+        statistics_m.framesReceived++;
+        framesParsed++;
+      }
+      else
+      {
+        statistics_m.framesDropped++;
+      }
+    }
+  }
+
+  return framesParsed;
+}
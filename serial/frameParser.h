@@ -0,0 +1,83 @@
+/** @file      frameParser.h
+ *  @brief     Header file for the parser of the received message stream.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/10
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef FRAME_PARSER_H
+#define FRAME_PARSER_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/* Longest value accepted, longer ones are counted as parse errors */
+#define FRAME_PARSER_TOKEN_SIZE (64)
+
+/**
+ * @brief Counters of the parsed stream.
+ */
+struct ParserStatistics
+{
+  uint64_t framesReceived = 0; /* Messages with the configured channel count */
+  uint64_t framesDropped = 0;  /* Messages with a wrong number of values */
+  uint64_t invalidBytes = 0;   /* Non-ASCII bytes discarded */
+  uint64_t parseErrors = 0;    /* Values that could not be converted */
+};
+
+/**
+ * @brief Splits a byte stream into "\n v1,v2,...\r" messages.
+ *
+ * The parser is independent of the transport: any span of bytes can be fed,
+ * messages split across spans are completed by the next call. Only digits,
+ * '.' and '-' are kept inside a value, other characters are ignored.
+ */
+class FrameParser
+{
+public:
+  FrameParser();
+
+  void setChannelCount(int channels);
+
+  int getChannelCount(void) const { return channelCount_m; }
+
+  /* Drops a partially received message */
+  void reset(void);
+
+  /**
+   * @brief Parses a span of received bytes.
+   *
+   * @param pData Received bytes
+   * @param length Number of received bytes
+   * @param frames Every complete message is appended as getChannelCount()
+   *        consecutive values
+   * @return Number of complete messages appended
+   */
+  size_t parse(const char *pData, size_t length, std::vector<float> &frames);
+
+  const ParserStatistics &getStatistics(void) const { return statistics_m; }
+
+  void resetStatistics(void) { statistics_m = ParserStatistics(); }
+
+private:
+  void prv_endValue(void);
+
+  int channelCount_m;
+  bool startFlag_m;
+  char token_m[FRAME_PARSER_TOKEN_SIZE];
+  size_t tokenLength_m; /* Up to FRAME_PARSER_TOKEN_SIZE */
+  bool tokenOverflow_m; /* Characters of the value were dropped */
+  std::vector<float> values_m;
+  size_t valueCount_m; /* Values of the current message, may exceed values_m */
+  ParserStatistics statistics_m;
+};
+
+#endif // FRAME_PARSER_H
@@ -0,0 +1,369 @@
+/** @file      historyCodec.cpp
+ *  @brief     Source file for the compression of sealed history columns.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/12
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "historyCodec.h"
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+/* Writes bit fields most significant bit first */
+class BitWriter
+{
+public:
+  explicit BitWriter(std::vector<uint8_t> &packed)
+    : packed_m(packed)
+    , window_m(0)
+    , used_m(0)
+  {
+  }
+
+  /* count up to 64 */
+  void write(uint64_t value, unsigned count)
+  {
+    if (count < 64)
+    {
+      value &= (uint64_t(1) << count) - 1;
+    }
+    unsigned space = 64 - used_m;
+    if (count <= space)
+    {
+      window_m = (count == 64) ? value : (window_m << count) | value;
+      used_m += count;
+      if (used_m == 64)
+      {
+        prv_store(8);
+      }
+      return;
+    }
+
+    /* The high bits complete the window, the others start the next one */
+    unsigned rest = count - space;
+    window_m = (window_m << space) | (value >> rest);
+    prv_store(8);
+    window_m = value & ((uint64_t(1) << rest) - 1);
+    used_m = rest;
+  }
+
+  void flush(void)
+  {
+    if (used_m > 0)
+    {
+      unsigned bytes = (used_m + 7) / 8;
+      window_m <<= bytes * 8 - used_m;
+      prv_store(bytes);
+    }
+  }
+
+private:
+  void prv_store(unsigned bytes)
+  {
+    for (unsigned i = bytes; i > 0; --i)
+    {
+      packed_m.push_back(static_cast<uint8_t>(window_m >> ((i - 1) * 8)));
+    }
+    window_m = 0;
+    used_m = 0;
+  }
+
+  std::vector<uint8_t> &packed_m;
+  uint64_t window_m;
+  unsigned used_m;
+};
+
+/* Reads what BitWriter wrote, zeros past the end */
+class BitReader
+{
+public:
+  BitReader(const uint8_t *pPacked, size_t size)
+    : pPacked_m(pPacked)
+    , size_m(size)
+    , position_m(0)
+    , window_m(0)
+    , left_m(0)
+  {
+  }
+
+  /* count up to 64 */
+  uint64_t read(unsigned count)
+  {
+    uint64_t value = 0;
+    while (count > 0)
+    {
+      if (left_m == 0)
+      {
+        prv_refill();
+      }
+      unsigned take = std::min(count, left_m);
+      left_m -= take;
+      count -= take;
+      uint64_t bits = window_m >> left_m;
+      if (take < 64)
+      {
+        bits &= (uint64_t(1) << take) - 1;
+        value = (value << take) | bits;
+      }
+      else
+      {
+        value = bits;
+      }
+    }
+    return value;
+  }
+
+private:
+  /* Eight bytes at a time while they are there */
+  void prv_refill(void)
+  {
+    if (position_m + 8 <= size_m)
+    {
+      window_m = 0;
+      for (unsigned i = 0; i < 8; ++i)
+      {
+        window_m = (window_m << 8) | pPacked_m[position_m + i];
+      }
+      position_m += 8;
+      left_m = 64;
+    }
+    else
+    {
+      window_m = (position_m < size_m) ? pPacked_m[position_m++] : 0;
+      left_m = 8;
+    }
+  }
+
+  const uint8_t *pPacked_m;
+  size_t size_m;
+  size_t position_m;
+  uint64_t window_m;
+  unsigned left_m;
+};
+
+template <typename U>
+static unsigned prv_leadingZeros(U bits)
+{
+  if constexpr (sizeof(U) == 8)
+  {
+    return static_cast<unsigned>(__builtin_clzll(bits));
+  }
+  else
+  {
+    return static_cast<unsigned>(__builtin_clz(bits));
+  }
+}
+
+template <typename U>
+static unsigned prv_trailingZeros(U bits)
+{
+  if constexpr (sizeof(U) == 8)
+  {
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+  }
+  else
+  {
+    return static_cast<unsigned>(__builtin_ctz(bits));
+  }
+}
+
+/* Gorilla: '0' same value, '10' changed bits within the previous window,
+ * '11' new window (leading zeros, length - 1) then the changed bits */
+template <typename F>
+static void prv_packFloat(const F *pValues, size_t count,
+                          std::vector<uint8_t> &packed)
+{
+  using U = typename std::conditional<sizeof(F) == 8, uint64_t, uint32_t>::type;
+  const unsigned width = sizeof(U) * 8;
+  const unsigned fieldBits = (sizeof(U) == 8) ? 6 : 5;
+
+  BitWriter writer(packed);
+  U previous = 0;
+  bool window = false;
+  unsigned windowLeading = 0;
+  unsigned windowTrailing = 0;
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    U bits;
+    memcpy(&bits, &pValues[i], sizeof(bits));
+    if (i == 0)
+    {
+      writer.write(bits, width);
+      previous = bits;
+      continue;
+    }
+
+    U changed = bits ^ previous;
+    previous = bits;
+    if (changed == 0)
+    {
+      writer.write(0, 1);
+      continue;
+    }
+
+    unsigned leading = prv_leadingZeros(changed);
+    unsigned trailing = prv_trailingZeros(changed);
+    if (window && leading >= windowLeading && trailing >= windowTrailing)
+    {
+      writer.write(2, 2);
+      writer.write(changed >> windowTrailing,
+                   width - windowLeading - windowTrailing);
+    }
+    else
+    {
+      unsigned length = width - leading - trailing;
+      writer.write(3, 2);
+      writer.write(leading, fieldBits);
+      writer.write(length - 1, fieldBits);
+      writer.write(changed >> trailing, length);
+      window = true;
+      windowLeading = leading;
+      windowTrailing = trailing;
+    }
+  }
+  writer.flush();
+}
+
+template <typename F>
+static void prv_unpackFloat(const uint8_t *pPacked, size_t size, size_t count,
+                            F *pValues)
+{
+  using U = typename std::conditional<sizeof(F) == 8, uint64_t, uint32_t>::type;
+  const unsigned width = sizeof(U) * 8;
+  const unsigned fieldBits = (sizeof(U) == 8) ? 6 : 5;
+
+  BitReader reader(pPacked, size);
+  U previous = 0;
+  unsigned windowLeading = 0;
+  unsigned windowTrailing = 0;
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (i == 0)
+    {
+      previous = static_cast<U>(reader.read(width));
+    }
+    else if (reader.read(1) != 0)
+    {
+      if (reader.read(1) != 0)
+      {
+        windowLeading = static_cast<unsigned>(reader.read(fieldBits));
+        windowTrailing
+            = width - windowLeading
+              - (static_cast<unsigned>(reader.read(fieldBits)) + 1);
+      }
+      unsigned length = width - windowLeading - windowTrailing;
+      previous ^= static_cast<U>(reader.read(length)) << windowTrailing;
+    }
+    memcpy(&pValues[i], &previous, sizeof(previous));
+  }
+}
+
+/* Values per group of the integer encoding, which share one bit width */
+#define CODEC_GROUP_VALUES (32)
+
+/* Difference to the previous value, zigzag so that small negative steps stay
+ * small, packed on the bit width of the largest one of its group */
+template <typename I>
+static void prv_packInteger(const I *pValues, size_t count,
+                            std::vector<uint8_t> &packed)
+{
+  BitWriter writer(packed);
+  uint64_t zigzags[CODEC_GROUP_VALUES];
+  int64_t previous = 0;
+
+  for (size_t first = 0; first < count; first += CODEC_GROUP_VALUES)
+  {
+    size_t values = std::min<size_t>(CODEC_GROUP_VALUES, count - first);
+    uint64_t all = 0;
+    for (size_t i = 0; i < values; ++i)
+    {
+      int64_t delta = static_cast<int64_t>(pValues[first + i]) - previous;
+      previous = pValues[first + i];
+      zigzags[i] = (static_cast<uint64_t>(delta) << 1)
+                   ^ static_cast<uint64_t>(delta >> 63);
+      all |= zigzags[i];
+    }
+
+    unsigned width = (all == 0) ? 0 : 64 - prv_leadingZeros(all);
+    writer.write(width, 6);
+    for (size_t i = 0; width > 0 && i < values; ++i)
+    {
+      writer.write(zigzags[i], width);
+    }
+  }
+  writer.flush();
+}
+
+template <typename I>
+static void prv_unpackInteger(const uint8_t *pPacked, size_t size,
+                              size_t count, I *pValues)
+{
+  BitReader reader(pPacked, size);
+  int64_t previous = 0;
+
+  for (size_t first = 0; first < count; first += CODEC_GROUP_VALUES)
+  {
+    size_t values = std::min<size_t>(CODEC_GROUP_VALUES, count - first);
+    unsigned width = static_cast<unsigned>(reader.read(6));
+    for (size_t i = 0; i < values; ++i)
+    {
+      uint64_t zigzag = (width > 0) ? reader.read(width) : 0;
+      int64_t delta = static_cast<int64_t>(zigzag >> 1)
+                      ^ -static_cast<int64_t>(zigzag & 1);
+      previous += delta;
+      pValues[first + i] = static_cast<I>(previous);
+    }
+  }
+}
+
+template <typename T>
+void packColumn(const T *pValues, size_t count, std::vector<uint8_t> &packed)
+{
+  if constexpr (std::is_floating_point<T>::value)
+  {
+    prv_packFloat(pValues, count, packed);
+  }
+  else
+  {
+    prv_packInteger(pValues, count, packed);
+  }
+}
+
+template <typename T>
+void unpackColumn(const uint8_t *pPacked, size_t size, size_t count,
+                  T *pValues)
+{
+  if constexpr (std::is_floating_point<T>::value)
+  {
+    prv_unpackFloat(pPacked, size, count, pValues);
+  }
+  else
+  {
+    prv_unpackInteger(pPacked, size, count, pValues);
+  }
+}
+
+template void packColumn<float>(const float *, size_t, std::vector<uint8_t> &);
+template void packColumn<int8_t>(const int8_t *, size_t,
+                                 std::vector<uint8_t> &);
+template void packColumn<int16_t>(const int16_t *, size_t,
+                                  std::vector<uint8_t> &);
+template void packColumn<int32_t>(const int32_t *, size_t,
+                                  std::vector<uint8_t> &);
+
+template void unpackColumn<float>(const uint8_t *, size_t, size_t, float *);
+template void unpackColumn<int8_t>(const uint8_t *, size_t, size_t, int8_t *);
+template void unpackColumn<int16_t>(const uint8_t *, size_t, size_t,
+                                    int16_t *);
+template void unpackColumn<int32_t>(const uint8_t *, size_t, size_t,
+                                    int32_t *);
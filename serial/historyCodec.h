@@ -0,0 +1,45 @@
+/** @file      historyCodec.h
+ *  @brief     Header file for the compression of sealed history columns.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/12
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef HISTORY_CODEC_H
+#define HISTORY_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Lossless compression of one column of history values.
+ *
+ * Floating-point columns use the XOR encoding of Gorilla: a value equal to
+ * the previous one takes one bit, a slowly varying one only its changed
+ * middle bits. Integer columns store the zigzag of the difference to the
+ * previous value, 32 at a time on the bit width of the largest: 2 bits per
+ * value for ADC counts moving by +/-1. Columns are decoded whole, from the
+ * first value.
+ *
+ * Defined for float, int8_t, int16_t and int32_t.
+ */
+template <typename T>
+void packColumn(const T *pValues, size_t count, std::vector<uint8_t> &packed);
+
+/**
+ * @param pPacked Bytes appended by packColumn() for count values
+ * @param size    Number of those bytes, never read beyond
+ */
+template <typename T>
+void unpackColumn(const uint8_t *pPacked, size_t size, size_t count,
+                  T *pValues);
+
+#endif // HISTORY_CODEC_H
@@ -0,0 +1,1041 @@
+/** @file      historyStore.cpp
+ *  @brief     Source file for the chunked channel history.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/03
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "historyStore.h"
+#include "historyCodec.h"
+#include "../kernels/numericKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+static const std::shared_ptr<const HistoryChunkList> emptyChunkList
+    = std::make_shared<const HistoryChunkList>();
+
+static const ChannelStorage defaultStorage;
+
+/* Linux: MemAvailable below HISTORY_LOW_MEMORY_FRACTION of MemTotal */
+static bool prv_isMemoryLow(void)
+{
+  std::ifstream file("/proc/meminfo");
+  std::string line;
+  double total = 0.0;
+  double available = 0.0;
+  while (std::getline(file, line))
+  {
+    std::istringstream fields(line);
+    std::string name;
+    double kilobytes = 0.0;
+    fields >> name >> kilobytes;
+    if (name == "MemTotal:")
+    {
+      total = kilobytes;
+    }
+    else if (name == "MemAvailable:")
+    {
+      available = kilobytes;
+    }
+  }
+  return total > 0.0 && available > 0.0
+         && available < total * HISTORY_LOW_MEMORY_FRACTION;
+}
+
+HistoryChunk::HistoryChunk(const std::vector<StorageType_t> &channelTypes,
+                           size_t rowCapacity, bool uniformTime)
+  : channels(channelTypes.size())
+  , capacity(rowCapacity)
+  , overlap(0)
+  , rows(0)
+  , uniform(uniformTime)
+  , start(0.0)
+  , step(0.0)
+  , types(channelTypes)
+  , offsets(channelTypes.size())
+  , time(uniformTime ? 0 : rowCapacity)
+  , compressed(false)
+  , endOffset(0.0f)
+{
+  /* Every column starts on 8 bytes */
+  size_t size = 0;
+  for (size_t ch = 0; ch < channels; ++ch)
+  {
+    offsets[ch] = size;
+    size += (getStorageTypeSize(types[ch]) * capacity + 7) & ~size_t(7);
+  }
+  data.resize(size);
+}
+
+size_t HistoryChunk::getMemoryBytes(void) const
+{
+  return data.capacity() + time.capacity() * sizeof(float)
+         + packed.capacity() + summary.capacity() * sizeof(SpanStatistics);
+}
+
+/* Stored values of a column, unpacked for a compressed chunk into a buffer
+ * of the calling thread, valid until its next call */
+template <typename T>
+static const T *prv_columnValues(const HistoryChunk &chunk, size_t column)
+{
+  if (!chunk.compressed)
+  {
+    return static_cast<const T *>(chunk.getColumn(column));
+  }
+
+  thread_local std::vector<uint64_t> unpacked;
+  unpacked.resize((chunk.rows * sizeof(T) + 7) / 8);
+  T *pValues = reinterpret_cast<T *>(unpacked.data());
+  unpackColumn(chunk.getStream(column), chunk.getStreamSize(column),
+               chunk.rows, pValues);
+  return pValues;
+}
+
+/* Sealed chunk to a compressed chunk with the same rows */
+static std::shared_ptr<const HistoryChunk>
+prv_compressChunk(const HistoryChunk &chunk)
+{
+  auto pPacked = std::make_shared<HistoryChunk>(chunk.types, 0, true);
+  pPacked->capacity = chunk.rows;
+  pPacked->overlap = chunk.overlap;
+  pPacked->rows = chunk.rows;
+  pPacked->uniform = chunk.uniform;
+  pPacked->start = chunk.start;
+  pPacked->step = chunk.step;
+  pPacked->compressed = true;
+  pPacked->summary.resize(chunk.channels);
+
+  for (size_t ch = 0; ch < chunk.channels; ++ch)
+  {
+    pPacked->streams.push_back(pPacked->packed.size());
+    visitStorageType(chunk.types[ch], [&](auto tag) {
+      using T = decltype(tag);
+      const T *pValues = static_cast<const T *>(chunk.getColumn(ch));
+      packColumn(pValues, chunk.rows, pPacked->packed);
+      columnStatistics(pValues + chunk.overlap, chunk.rows - chunk.overlap,
+                       pPacked->summary[ch]);
+    });
+  }
+  pPacked->streams.push_back(pPacked->packed.size());
+  if (!chunk.uniform && chunk.rows > 0)
+  {
+    packColumn(chunk.time.data(), chunk.rows, pPacked->packed);
+    pPacked->endOffset = chunk.time[chunk.rows - 1];
+  }
+  pPacked->streams.push_back(pPacked->packed.size());
+  pPacked->packed.shrink_to_fit();
+  return pPacked;
+}
+
+HistorySnapshot::HistorySnapshot()
+  : pSealed_m(emptyChunkList)
+  , tailRows_m(0)
+  , tailStart_m(0.0)
+  , tailStep_m(0.0)
+  , firstChunk_m(0)
+  , firstRow_m(0)
+  , segmentCount_m(0)
+  , rowCount_m(0)
+  , channels_m(0)
+{
+}
+
+const HistoryChunk *HistorySnapshot::prv_chunk(size_t segment) const
+{
+  size_t index = firstChunk_m + segment;
+  return (index < pSealed_m->size()) ? (*pSealed_m)[index].get()
+                                     : pTail_m.get();
+}
+
+size_t HistorySnapshot::prv_begin(size_t segment) const
+{
+  return (segment == 0) ? firstRow_m : 0;
+}
+
+size_t HistorySnapshot::prv_end(size_t segment) const
+{
+  const HistoryChunk *pChunk = prv_chunk(segment);
+  return (pChunk == pTail_m.get()) ? tailRows_m : pChunk->rows;
+}
+
+size_t HistorySnapshot::getSegmentRows(size_t segment) const
+{
+  return prv_end(segment) - prv_begin(segment);
+}
+
+size_t HistorySnapshot::getSegmentOverlap(size_t segment) const
+{
+  return (segment == 0) ? 0 : prv_chunk(segment)->overlap;
+}
+
+const float *HistorySnapshot::getSegmentOffsets(size_t segment,
+                                                std::vector<float> &buffer) const
+{
+  const HistoryChunk *pChunk = prv_chunk(segment);
+  if (pChunk->uniform)
+  {
+    return nullptr;
+  }
+  if (!pChunk->compressed)
+  {
+    return pChunk->getTimeOffsets() + prv_begin(segment);
+  }
+
+  buffer.resize(pChunk->rows);
+  unpackColumn(pChunk->getStream(pChunk->channels),
+               pChunk->getStreamSize(pChunk->channels), pChunk->rows,
+               buffer.data());
+  return buffer.data() + prv_begin(segment);
+}
+
+double HistorySnapshot::getSegmentOrigin(size_t segment) const
+{
+  const HistoryChunk *pChunk = prv_chunk(segment);
+  return (pChunk == pTail_m.get()) ? tailStart_m : pChunk->start;
+}
+
+bool HistorySnapshot::isSegmentUniform(size_t segment) const
+{
+  return prv_chunk(segment)->uniform;
+}
+
+double HistorySnapshot::getSegmentStart(size_t segment) const
+{
+  return prv_rowTime(segment, prv_begin(segment));
+}
+
+double HistorySnapshot::getSegmentStep(size_t segment) const
+{
+  const HistoryChunk *pChunk = prv_chunk(segment);
+  return (pChunk == pTail_m.get()) ? tailStep_m : pChunk->step;
+}
+
+double HistorySnapshot::getSegmentEnd(size_t segment) const
+{
+  return prv_rowTime(segment, prv_end(segment) - 1);
+}
+
+void HistorySnapshot::getSegmentTimes(size_t segment,
+                                      std::vector<double> &times) const
+{
+  size_t rows = getSegmentRows(segment);
+  times.resize(rows);
+  if (isSegmentUniform(segment))
+  {
+    double start = getSegmentStart(segment);
+    double step = getSegmentStep(segment);
+    for (size_t row = 0; row < rows; ++row)
+    {
+      times[row] = start + static_cast<double>(row) * step;
+    }
+    return;
+  }
+
+  thread_local std::vector<float> offsets;
+  double origin = getSegmentOrigin(segment);
+  const float *pOffsets = getSegmentOffsets(segment, offsets);
+  for (size_t row = 0; row < rows; ++row)
+  {
+    times[row] = origin + pOffsets[row];
+  }
+}
+
+double HistorySnapshot::prv_rowTime(size_t segment, size_t row) const
+{
+  const HistoryChunk *pChunk = prv_chunk(segment);
+  if (!pChunk->uniform && !pChunk->compressed)
+  {
+    return getSegmentOrigin(segment) + pChunk->time[row];
+  }
+  if (!pChunk->uniform)
+  {
+    /* Row 0 is the start, the last row is kept aside */
+    if (row == 0 || row + 1 == pChunk->rows)
+    {
+      return pChunk->start + ((row == 0) ? 0.0f : pChunk->endOffset);
+    }
+    std::vector<float> offsets;
+    return pChunk->start + getSegmentOffsets(segment, offsets)[row - prv_begin(segment)];
+  }
+  return getSegmentOrigin(segment)
+         + static_cast<double>(row) * getSegmentStep(segment);
+}
+
+const ChannelStorage &HistorySnapshot::getChannelStorage(size_t channel) const
+{
+  if (!pStorage_m || channel >= pStorage_m->size())
+  {
+    return defaultStorage;
+  }
+  return (*pStorage_m)[channel];
+}
+
+const float *HistorySnapshot::getSegmentValues(size_t segment, size_t channel,
+                                               std::vector<float> &buffer) const
+{
+  const HistoryChunk *pChunk = prv_chunk(segment);
+  const ChannelStorage &storage = getChannelStorage(channel);
+  StorageType_t type = pChunk->types[channel];
+  size_t begin = prv_begin(segment);
+
+  if (type == STORAGE_FLOAT32 && storage.isIdentity() && !pChunk->compressed)
+  {
+    return static_cast<const float *>(pChunk->getColumn(channel)) + begin;
+  }
+
+  size_t rows = getSegmentRows(segment);
+  buffer.resize(rows);
+  visitStorageType(type, [&](auto tag) {
+    using T = decltype(tag);
+    decodeColumn(prv_columnValues<T>(*pChunk, channel) + begin, rows, storage,
+                 buffer.data());
+  });
+  return buffer.data();
+}
+
+void HistorySnapshot::getSegmentStatistics(size_t segment, size_t channel,
+                                           SpanStatistics &statistics) const
+{
+  /* Without the repeated row, as kept for the compressed chunks */
+  const HistoryChunk *pChunk = prv_chunk(segment);
+  size_t begin = std::max(prv_begin(segment), pChunk->overlap);
+  size_t end = prv_end(segment);
+  if (pChunk->compressed && begin == pChunk->overlap)
+  {
+    statistics = pChunk->summary[channel];
+  }
+  else
+  {
+    visitStorageType(pChunk->types[channel], [&](auto tag) {
+      using T = decltype(tag);
+      columnStatistics(prv_columnValues<T>(*pChunk, channel) + begin,
+                       end - begin, statistics);
+    });
+  }
+  scaleStatistics(getChannelStorage(channel), statistics);
+}
+
+void HistorySnapshot::getChannelStatistics(size_t channel,
+                                           SpanStatistics &statistics) const
+{
+  statistics.minValue = std::numeric_limits<float>::quiet_NaN();
+  statistics.maxValue = std::numeric_limits<float>::quiet_NaN();
+  statistics.sum = 0.0;
+  statistics.count = 0;
+  if (empty() || channel >= channels_m)
+  {
+    return;
+  }
+
+  /* Stored values, one instantiation per type, scaled once at the end */
+  visitStorageType(prv_chunk(0)->types[channel], [&](auto tag) {
+    using T = decltype(tag);
+    for (size_t segment = 0; segment < segmentCount_m; ++segment)
+    {
+      size_t begin = prv_begin(segment) + getSegmentOverlap(segment);
+      size_t end = prv_end(segment);
+      if (end <= begin)
+      {
+        continue;
+      }
+
+      const HistoryChunk &chunk = *prv_chunk(segment);
+      SpanStatistics span;
+      if (chunk.compressed && begin == chunk.overlap)
+      {
+        span = chunk.summary[channel];
+      }
+      else
+      {
+        columnStatistics(prv_columnValues<T>(chunk, channel) + begin,
+                         end - begin, span);
+      }
+      if (span.count == 0)
+      {
+        continue;
+      }
+      if (statistics.count == 0 || span.minValue < statistics.minValue)
+      {
+        statistics.minValue = span.minValue;
+      }
+      if (statistics.count == 0 || span.maxValue > statistics.maxValue)
+      {
+        statistics.maxValue = span.maxValue;
+      }
+      statistics.sum += span.sum;
+      statistics.count += span.count;
+    }
+  });
+
+  scaleStatistics(getChannelStorage(channel), statistics);
+}
+
+double HistorySnapshot::getFirstTime(void) const
+{
+  return empty() ? 0.0 : prv_rowTime(0, prv_begin(0));
+}
+
+double HistorySnapshot::getLastTime(void) const
+{
+  if (empty())
+  {
+    return 0.0;
+  }
+  size_t last = segmentCount_m - 1;
+  return prv_rowTime(last, prv_end(last) - 1);
+}
+
+bool HistorySnapshot::getLastValues(std::vector<float> &values) const
+{
+  if (empty())
+  {
+    return false;
+  }
+  const HistoryChunk *pChunk = prv_chunk(segmentCount_m - 1);
+  size_t row = prv_end(segmentCount_m - 1) - 1;
+  values.resize(channels_m);
+  for (size_t ch = 0; ch < channels_m; ++ch)
+  {
+    visitStorageType(pChunk->types[ch], [&](auto tag) {
+      using T = decltype(tag);
+      decodeColumn(prv_columnValues<T>(*pChunk, ch) + row, 1,
+                   getChannelStorage(ch), &values[ch]);
+    });
+  }
+  return true;
+}
+
+HistoryStore::HistoryStore(size_t chunkRows)
+  : chunkRows_m(std::max<size_t>(chunkRows, 2))
+  , limit_m(std::numeric_limits<size_t>::max())
+  , channels_m(0)
+  , rowsAppended_m(0)
+  , pSealed_m(emptyChunkList)
+  , sealedRows_m(0)
+  , sealedBytes_m(0)
+  , pStorage_m(std::make_shared<const std::vector<ChannelStorage>>())
+  , floatOnly_m(true)
+  , step_m(0.0)
+  , syncedRows_m(0)
+  , measuring_m(false)
+  , measureTime_m(0.0)
+  , measureRow_m(0)
+  , tailAnchored_m(false)
+  , tailAnchorTime_m(0.0)
+  , tailAnchorRow_m(0)
+  , level_m(0)
+  , memoryLow_m(false)
+{
+}
+
+void HistoryStore::setLimit(size_t rows)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+  limit_m = rows;
+}
+
+void HistoryStore::setStorage(const std::vector<ChannelStorage> &storage)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+
+  bool same = storage.size() == requested_m.size();
+  for (size_t ch = 0; same && ch < storage.size(); ++ch)
+  {
+    same = storage[ch].type == requested_m[ch].type
+           && storage[ch].scale == requested_m[ch].scale
+           && storage[ch].offset == requested_m[ch].offset;
+  }
+  if (same)
+  {
+    return;
+  }
+
+  requested_m = storage;
+  if (prv_applyStorage())
+  {
+    prv_reset();
+  }
+}
+
+void HistoryStore::setTimeAxis(const TimeAxisStorage &timeAxis)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+
+  bool fixedRate = timeAxis.mode == TIME_AXIS_FIXED_RATE;
+  if (timeAxis.mode == timeAxis_m.mode
+      && (!fixedRate || timeAxis.sampleRate == timeAxis_m.sampleRate))
+  {
+    return;
+  }
+
+  timeAxis_m = timeAxis;
+  prv_reset();
+}
+
+void HistoryStore::setRetention(const HistoryRetention &retention)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+
+  if (retention.enabled && !pTier_m)
+  {
+    /* Not yet reachable by any other thread: no lock on the new levels */
+    HistoryStore *pLevel = this;
+    for (size_t level = 1; level <= HISTORY_TIER_COUNT; ++level)
+    {
+      pLevel->pTier_m = std::make_unique<HistoryStore>(chunkRows_m);
+      pLevel = pLevel->pTier_m.get();
+      pLevel->level_m = level;
+      pLevel->retention_m.enabled = true;
+    }
+  }
+  if (!retention.enabled && pTier_m)
+  {
+    pTier_m->clear();
+  }
+  for (HistoryStore *pLevel = pTier_m.get(); pLevel != nullptr;
+       pLevel = pLevel->pTier_m.get())
+  {
+    std::lock_guard<std::mutex> levelLock(pLevel->mutex_m);
+    pLevel->retention_m.compress = retention.compress;
+  }
+
+  retention_m = retention;
+  memoryChecked_m = std::chrono::steady_clock::time_point();
+}
+
+void HistoryStore::append(double time, const float *pFrames, size_t frames,
+                          size_t channels, double span)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+
+  if (channels != channels_m)
+  {
+    channels_m = channels;
+    prv_applyStorage();
+    prv_reset();
+  }
+  if (channels_m == 0)
+  {
+    return;
+  }
+  if (!pTail_m)
+  {
+    prv_startChunk(false);
+  }
+
+  bool uniform = pTail_m->uniform;
+  if (uniform)
+  {
+    prv_syncTime(time, frames);
+  }
+
+  /* As many frames as the tail holds at a time, split into its float32
+   * columns or into the scratch columns converted to the other types */
+  const NumericKernels &kernels = getNumericKernels();
+  planes_m.resize(channels_m);
+  if (!floatOnly_m)
+  {
+    scratch_m.resize(channels_m * chunkRows_m);
+  }
+  /* Frame f arrived at time - (frames - 1 - f) * period */
+  double period = frames > 0 ? span / static_cast<double>(frames) : 0.0;
+  auto frameTime = [&](size_t frame)
+  { return time - static_cast<double>(frames - 1 - frame) * period; };
+
+  for (size_t frame = 0; frame < frames;)
+  {
+    /* Timestamp chunks also end when their offsets would lose precision */
+    bool full = pTail_m->rows == pTail_m->capacity;
+    bool late = !uniform && pTail_m->rows > 0
+                && frameTime(frame) - pTail_m->start > HISTORY_CHUNK_SECONDS;
+    if (full || late)
+    {
+      prv_sealTail(true);
+    }
+
+    HistoryChunk &chunk = *pTail_m;
+    size_t row = chunk.rows;
+    size_t count = std::min(frames - frame, chunk.capacity - row);
+    if (!uniform)
+    {
+      if (row == 0)
+      {
+        chunk.start = frameTime(frame);
+      }
+      for (size_t index = 0; index < count; ++index)
+      {
+        chunk.time[row + index]
+            = static_cast<float>(frameTime(frame + index) - chunk.start);
+      }
+    }
+    for (size_t ch = 0; ch < channels_m; ++ch)
+    {
+      planes_m[ch] = (types_m[ch] == STORAGE_FLOAT32)
+                         ? chunk.getColumn<float>(ch) + row
+                         : scratch_m.data() + ch * chunkRows_m;
+    }
+    kernels.toPlanar(pFrames + frame * channels_m, count, channels_m,
+                     planes_m.data());
+    for (size_t ch = 0; !floatOnly_m && ch < channels_m; ++ch)
+    {
+      if (types_m[ch] == STORAGE_FLOAT32)
+      {
+        continue;
+      }
+      visitStorageType(types_m[ch], [&](auto tag) {
+        using T = decltype(tag);
+        encodeColumn(planes_m[ch], count, chunk.getColumn<T>(ch) + row);
+      });
+    }
+    chunk.rows = row + count;
+    frame += count;
+  }
+  rowsAppended_m += frames;
+  syncedRows_m += frames;
+
+  if (uniform && frames > 0)
+  {
+    prv_measureTime(time);
+  }
+  prv_trim();
+}
+
+void HistoryStore::clear(void)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+  prv_reset();
+}
+
+void HistoryStore::getStatistics(HistoryStatistics &statistics) const
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+
+  size_t total = sealedRows_m;
+  if (pTail_m)
+  {
+    total += pTail_m->rows - pTail_m->overlap;
+  }
+  statistics.rows = prv_keepsAllRows() ? total : std::min(total, limit_m);
+  statistics.bytes = sealedBytes_m + (pTail_m ? pTail_m->getMemoryBytes() : 0);
+  statistics.limit = limit_m;
+  statistics.rowsAppended = rowsAppended_m;
+  statistics.rowsEvicted = rowsAppended_m - statistics.rows;
+}
+
+HistorySnapshot HistoryStore::snapshot(void) const
+{
+  HistorySnapshot snapshot;
+  std::lock_guard<std::mutex> lock(mutex_m);
+
+  if (!pTail_m)
+  {
+    return snapshot;
+  }
+
+  snapshot.pSealed_m = pSealed_m;
+  snapshot.pTail_m = pTail_m;
+  snapshot.pStorage_m = pStorage_m;
+  snapshot.tailRows_m = pTail_m->rows;
+  snapshot.tailStart_m = pTail_m->start;
+  snapshot.tailStep_m = pTail_m->step;
+  snapshot.channels_m = channels_m;
+
+  size_t tailLogical = pTail_m->rows - pTail_m->overlap;
+  size_t total = sealedRows_m + tailLogical;
+  size_t skip = (total > limit_m && !prv_keepsAllRows()) ? total - limit_m : 0;
+  snapshot.rowCount_m = total - skip;
+
+  /* Locate the oldest row within the limit, at most a few chunks away */
+  size_t chunk = 0;
+  for (; chunk < pSealed_m->size(); ++chunk)
+  {
+    const HistoryChunk &sealed = *(*pSealed_m)[chunk];
+    size_t logical = sealed.rows - sealed.overlap;
+    if (skip < logical)
+    {
+      break;
+    }
+    skip -= logical;
+  }
+  snapshot.firstChunk_m = chunk;
+
+  if (chunk < pSealed_m->size())
+  {
+    snapshot.firstRow_m = (*pSealed_m)[chunk]->overlap + skip;
+    snapshot.segmentCount_m
+        = pSealed_m->size() - chunk + ((tailLogical > 0) ? 1 : 0);
+  }
+  else
+  {
+    snapshot.firstRow_m = pTail_m->overlap + skip;
+    snapshot.segmentCount_m = (snapshot.rowCount_m > 0) ? 1 : 0;
+  }
+
+  return snapshot;
+}
+
+HistorySnapshot HistoryStore::tierSnapshot(size_t level) const
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+  if (!retention_m.enabled || level == 0)
+  {
+    return HistorySnapshot();
+  }
+
+  /* The chain of levels never changes once created */
+  const HistoryStore *pLevel = this;
+  for (size_t i = 0; i < level && pLevel != nullptr; ++i)
+  {
+    pLevel = pLevel->pTier_m.get();
+  }
+  return (pLevel != nullptr) ? pLevel->snapshot() : HistorySnapshot();
+}
+
+bool HistoryStore::prv_applyStorage(void)
+{
+  auto pStorage = std::make_shared<std::vector<ChannelStorage>>(channels_m);
+  std::vector<StorageType_t> types(channels_m);
+  bool floatOnly = true;
+  for (size_t ch = 0; ch < channels_m; ++ch)
+  {
+    if (ch < requested_m.size())
+    {
+      (*pStorage)[ch] = requested_m[ch];
+    }
+    types[ch] = (*pStorage)[ch].type;
+    floatOnly = floatOnly && types[ch] == STORAGE_FLOAT32;
+  }
+
+  bool changed = types != types_m;
+  types_m = std::move(types);
+  floatOnly_m = floatOnly;
+  pStorage_m = std::move(pStorage);
+  return changed;
+}
+
+void HistoryStore::prv_reset(void)
+{
+  /* Snapshots keep the chunks they reference */
+  pSealed_m = emptyChunkList;
+  sealedRows_m = 0;
+  sealedBytes_m = 0;
+  pTail_m.reset();
+  rowsAppended_m = 0;
+  if (pTier_m)
+  {
+    pTier_m->clear();
+  }
+
+  bool fixedRate = timeAxis_m.mode == TIME_AXIS_FIXED_RATE
+                   && timeAxis_m.sampleRate > 0.0;
+  step_m = fixedRate ? 1.0 / timeAxis_m.sampleRate : 0.0;
+  syncedRows_m = 0;
+  measuring_m = false;
+  tailAnchored_m = false;
+}
+
+void HistoryStore::prv_startChunk(bool continuous)
+{
+  auto pChunk = std::make_shared<HistoryChunk>(
+      types_m, chunkRows_m, timeAxis_m.mode != TIME_AXIS_TIMESTAMPS);
+  pChunk->step = step_m;
+  tailAnchored_m = false;
+
+  /* Repeat the last row so that segments drawn one by one stay connected */
+  if (continuous && pTail_m && pTail_m->rows > 0)
+  {
+    size_t last = pTail_m->rows - 1;
+    if (pChunk->uniform)
+    {
+      /* The new chunk goes on from where the previous one ended */
+      pChunk->start = pTail_m->start + static_cast<double>(last) * pTail_m->step;
+      tailAnchored_m = true;
+      tailAnchorTime_m = pChunk->start;
+      tailAnchorRow_m = 0;
+    }
+    else
+    {
+      pChunk->start = pTail_m->start + pTail_m->time[last];
+      pChunk->time[0] = 0.0f;
+    }
+    for (size_t ch = 0; ch < channels_m; ++ch)
+    {
+      size_t size = getStorageTypeSize(types_m[ch]);
+      memcpy(pChunk->data.data() + pChunk->offsets[ch],
+             pTail_m->data.data() + pTail_m->offsets[ch] + last * size, size);
+    }
+    pChunk->rows = 1;
+    pChunk->overlap = 1;
+  }
+
+  pTail_m = std::move(pChunk);
+}
+
+void HistoryStore::prv_sealTail(bool continuous)
+{
+  std::shared_ptr<const HistoryChunk> pChunk = pTail_m;
+  if (retention_m.compress)
+  {
+    /* Snapshots holding the tail keep it as it is */
+    pChunk = prv_compressChunk(*pTail_m);
+  }
+
+  auto pSealed = std::make_shared<HistoryChunkList>(*pSealed_m);
+  pSealed->push_back(pChunk);
+  sealedRows_m += pChunk->rows - pChunk->overlap;
+  sealedBytes_m += pChunk->getMemoryBytes();
+  pSealed_m = std::move(pSealed);
+
+  prv_startChunk(continuous);
+}
+
+void HistoryStore::prv_syncTime(double time, size_t frames)
+{
+  /* A measured period is only trusted once it spans enough arrivals */
+  if (!tailAnchored_m || pTail_m->step <= 0.0 || pTail_m->rows == 0)
+  {
+    return;
+  }
+  if (timeAxis_m.mode == TIME_AXIS_MEASURED
+      && (!measuring_m || time - measureTime_m < HISTORY_MEASURE_SECONDS))
+  {
+    return;
+  }
+
+  double expected = pTail_m->start
+                    + static_cast<double>(pTail_m->rows - 1 + frames)
+                          * pTail_m->step;
+  if (std::fabs(time - expected) <= HISTORY_RESYNC_SECONDS)
+  {
+    return;
+  }
+
+  /* Discontinuity: the rows so far keep their times, the new ones start a
+   * chunk of their own, not joined to the previous one */
+  if (pTail_m->rows > pTail_m->overlap)
+  {
+    prv_sealTail(false);
+  }
+  else
+  {
+    prv_startChunk(false);
+  }
+  measuring_m = false;
+}
+
+void HistoryStore::prv_measureTime(double time)
+{
+  /* The time of a batch is the arrival of its last frame */
+  uint64_t lastRow = syncedRows_m - 1;
+  if (timeAxis_m.mode == TIME_AXIS_MEASURED)
+  {
+    if (!measuring_m)
+    {
+      measuring_m = true;
+      measureTime_m = time;
+      measureRow_m = lastRow;
+    }
+    else if (lastRow > measureRow_m && time > measureTime_m)
+    {
+      step_m = (time - measureTime_m)
+               / static_cast<double>(lastRow - measureRow_m);
+    }
+  }
+
+  if (!tailAnchored_m)
+  {
+    tailAnchored_m = true;
+    tailAnchorTime_m = time;
+    tailAnchorRow_m = pTail_m->rows - 1;
+  }
+  pTail_m->step = step_m;
+  pTail_m->start
+      = tailAnchorTime_m - static_cast<double>(tailAnchorRow_m) * step_m;
+}
+
+void HistoryStore::prv_trim(void)
+{
+  size_t tailLogical = pTail_m->rows - pTail_m->overlap;
+  size_t drop = 0;
+  size_t rows = sealedRows_m;
+
+  /* Whole chunks only, the snapshots hide the extra rows */
+  while (drop < pSealed_m->size())
+  {
+    const HistoryChunk &oldest = *(*pSealed_m)[drop];
+    size_t logical = oldest.rows - oldest.overlap;
+    if (rows - logical + tailLogical < limit_m)
+    {
+      break;
+    }
+    rows -= logical;
+    sealedBytes_m -= oldest.getMemoryBytes();
+    drop++;
+  }
+
+  if (drop > 0)
+  {
+    if (prv_keepsAllRows())
+    {
+      prv_updateTierLimits();
+      for (size_t chunk = 0; chunk < drop; ++chunk)
+      {
+        prv_decimate(*(*pSealed_m)[chunk]);
+      }
+    }
+    pSealed_m = std::make_shared<const HistoryChunkList>(
+        pSealed_m->begin() + drop, pSealed_m->end());
+    sealedRows_m = rows;
+  }
+}
+
+bool HistoryStore::prv_keepsAllRows(void) const
+{
+  return retention_m.enabled && pTier_m != nullptr;
+}
+
+void HistoryStore::prv_updateTierLimits(void)
+{
+  /* The full-rate store sizes every level, the tiers only pass rows on */
+  if (level_m != 0)
+  {
+    return;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  if (now - memoryChecked_m >= std::chrono::seconds(1))
+  {
+    memoryChecked_m = now;
+    memoryLow_m = retention_m.watchMemory && prv_isMemoryLow();
+  }
+
+  size_t budget = memoryLow_m ? retention_m.budgetBytes / 4
+                              : retention_m.budgetBytes;
+  for (HistoryStore *pLevel = pTier_m.get(); pLevel != nullptr;
+       pLevel = pLevel->pTier_m.get())
+  {
+    /* Compressed chunks: the bytes per row measured so far */
+    HistoryStatistics statistics;
+    pLevel->getStatistics(statistics);
+    double rowBytes = sizeof(float) * (1 + 3 * channels_m);
+    if (statistics.rows > 0 && statistics.bytes > 0)
+    {
+      rowBytes = static_cast<double>(statistics.bytes) / statistics.rows;
+    }
+    pLevel->setLimit(
+        static_cast<size_t>(budget / HISTORY_TIER_COUNT / rowBytes));
+  }
+}
+
+const float *HistoryStore::prv_decodeColumn(const HistoryChunk &chunk,
+                                            size_t column)
+{
+  /* Stored values, the tiers apply the scale and offset of the channel */
+  size_t first = chunk.overlap;
+  size_t rows = chunk.rows - first;
+  if (chunk.types[column] == STORAGE_FLOAT32 && !chunk.compressed)
+  {
+    return static_cast<const float *>(chunk.getColumn(column)) + first;
+  }
+
+  decoded_m.resize(rows);
+  visitStorageType(chunk.types[column], [&](auto tag) {
+    using T = decltype(tag);
+    decodeColumn(prv_columnValues<T>(chunk, column) + first, rows,
+                 defaultStorage, decoded_m.data());
+  });
+  return decoded_m.data();
+}
+
+void HistoryStore::prv_decimate(const HistoryChunk &chunk)
+{
+  size_t first = chunk.overlap;
+  if (chunk.rows <= first || channels_m == 0)
+  {
+    return;
+  }
+
+  /* Buckets start over at every chunk, the last one of a chunk may be
+   * shorter */
+  const NumericKernels &kernels = getNumericKernels();
+  size_t rows = chunk.rows - first;
+  size_t buckets = (rows + HISTORY_TIER_FACTOR - 1) / HISTORY_TIER_FACTOR;
+  size_t sources = (level_m == 0) ? channels_m : channels_m / 3;
+  size_t width = 3 * sources;
+
+  tierFrames_m.resize(buckets * width);
+  tierColumns_m.resize(5 * buckets);
+  float *pMin = tierColumns_m.data();
+  float *pMax = pMin + buckets;
+  float *pMean = pMax + buckets;
+  float *pUnused = pMean + buckets;
+
+  for (size_t ch = 0; ch < sources; ++ch)
+  {
+    if (level_m == 0)
+    {
+      kernels.bucketMinMax(prv_decodeColumn(chunk, ch), rows,
+                           HISTORY_TIER_FACTOR, pMin, pMax, pMean);
+    }
+    else
+    {
+      /* Min of the mins, max of the maxes, mean of the means */
+      kernels.bucketMinMax(prv_decodeColumn(chunk, ch), rows,
+                           HISTORY_TIER_FACTOR, pMin, pUnused, nullptr);
+      kernels.bucketMinMax(prv_decodeColumn(chunk, sources + ch), rows,
+                           HISTORY_TIER_FACTOR, pUnused, pMax, nullptr);
+      kernels.bucketMinMax(prv_decodeColumn(chunk, 2 * sources + ch), rows,
+                           HISTORY_TIER_FACTOR, pUnused, pUnused + buckets,
+                           pMean);
+    }
+    for (size_t bucket = 0; bucket < buckets; ++bucket)
+    {
+      float *pFrame = tierFrames_m.data() + bucket * width;
+      pFrame[ch] = pMin[bucket];
+      pFrame[sources + ch] = pMax[bucket];
+      pFrame[2 * sources + ch] = pMean[bucket];
+    }
+  }
+
+  /* The three columns of a channel share its scale and offset */
+  tierStorage_m.resize(width);
+  for (size_t column = 0; column < width; ++column)
+  {
+    const ChannelStorage &storage = (*pStorage_m)[column % sources];
+    tierStorage_m[column].type = STORAGE_FLOAT32;
+    tierStorage_m[column].scale = storage.scale;
+    tierStorage_m[column].offset = storage.offset;
+  }
+  pTier_m->setStorage(tierStorage_m);
+
+  /* A bucket is placed at its first row */
+  const float *pOffsets = chunk.time.data();
+  if (chunk.compressed && !chunk.uniform)
+  {
+    decoded_m.resize(chunk.rows);
+    unpackColumn(chunk.getStream(chunk.channels),
+                 chunk.getStreamSize(chunk.channels), chunk.rows,
+                 decoded_m.data());
+    pOffsets = decoded_m.data();
+  }
+  for (size_t bucket = 0; bucket < buckets; ++bucket)
+  {
+    size_t row = first + bucket * HISTORY_TIER_FACTOR;
+    double time = chunk.uniform
+                      ? chunk.start + static_cast<double>(row) * chunk.step
+                      : chunk.start + pOffsets[row];
+    pTier_m->append(time, tierFrames_m.data() + bucket * width, 1, width);
+  }
+}
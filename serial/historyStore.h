@@ -0,0 +1,340 @@
+/** @file      historyStore.h
+ *  @brief     Header file for the chunked channel history.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/03
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef HISTORY_STORE_H
+#define HISTORY_STORE_H
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "channelStorage.h"
+
+/* Rows per chunk, a chunk is never reallocated once created */
+#define HISTORY_CHUNK_ROWS (1024)
+
+/* Longest time a chunk spans: its float time offsets stay within 8 us */
+#define HISTORY_CHUNK_SECONDS (64.0)
+
+/* Distance between an arrival and its uniform time that starts a new chunk */
+#define HISTORY_RESYNC_SECONDS (0.1)
+
+/* Arrivals a measured period must span before it is trusted for resyncs */
+#define HISTORY_MEASURE_SECONDS (0.5)
+
+/**
+ * @brief Fixed-capacity block of history rows, column-major so that every
+ * channel can be plotted straight from it. Each column holds the values of
+ * its channel in the storage type of the channel. Times are kept as a double
+ * start plus a float offset per row, so that they stay precise on captures of
+ * several days without a double per row. Uniform chunks have no offsets: row
+ * r is at start + r * step.
+ *
+ * A compressed chunk is a sealed chunk whose columns and offsets are packed
+ * (see historyCodec.h) instead of stored in data and time, with the
+ * statistics of each column kept aside so that it can be drawn from them
+ * when it is too small on screen to unpack.
+ *
+ * Rows are only ever appended: the rows visible through a snapshot are never
+ * written again, even while the store keeps appending to the chunk.
+ */
+struct HistoryChunk
+{
+  HistoryChunk(const std::vector<StorageType_t> &channelTypes,
+               size_t rowCapacity, bool uniformTime);
+
+  const float *getTimeOffsets(void) const { return time.data(); }
+
+  /* Packed stream of a column, or of the time offsets at index channels */
+  const uint8_t *getStream(size_t index) const
+  {
+    return packed.data() + streams[index];
+  }
+  size_t getStreamSize(size_t index) const
+  {
+    return streams[index + 1] - streams[index];
+  }
+
+  size_t getMemoryBytes(void) const;
+
+  /* Stored values of a channel, of the type types[channel] */
+  const void *getColumn(size_t channel) const
+  {
+    return data.data() + offsets[channel];
+  }
+
+  template <typename T>
+  T *getColumn(size_t channel)
+  {
+    return reinterpret_cast<T *>(data.data() + offsets[channel]);
+  }
+
+  size_t channels;
+  size_t capacity;
+  size_t overlap; /* 1 when row 0 repeats the last row of the previous chunk */
+  size_t rows;    /* Written rows, overlap included */
+  bool uniform;
+  double start; /* Time of row 0, refined by uniform tails, see snapshot() */
+  double step;
+  std::vector<StorageType_t> types;
+  std::vector<size_t> offsets; /* Byte offset of each column in data */
+  std::vector<float> time; /* Offset of each row from start, seconds */
+  std::vector<uint8_t> data;
+
+  bool compressed;
+  float endOffset; /* Offset of the last row, for the compressed ones */
+  std::vector<size_t> streams; /* channels + 2 positions in packed */
+  std::vector<uint8_t> packed;
+  std::vector<SpanStatistics> summary; /* Stored values, overlap excluded */
+};
+
+using HistoryChunkList = std::vector<std::shared_ptr<const HistoryChunk>>;
+
+/**
+ * @brief Read-only view of a HistoryStore at one instant.
+ *
+ * Taking it copies two shared pointers and a few counters, never the data: it
+ * references the immutable chunks, which stay alive as long as the snapshot
+ * does even after the store dropped them. The rows are exposed as segments,
+ * one per chunk, each starting with the last row of the previous segment so
+ * that lines drawn segment by segment join up.
+ */
+class HistorySnapshot
+{
+public:
+  HistorySnapshot();
+
+  size_t getChannelCount(void) const { return channels_m; }
+
+  /* Rows of the snapshot, without the repeated ones */
+  size_t getRowCount(void) const { return rowCount_m; }
+
+  bool empty(void) const { return rowCount_m == 0; }
+
+  size_t getSegmentCount(void) const { return segmentCount_m; }
+
+  /* Drawable rows of a segment, starting with its leading repeated row */
+  size_t getSegmentRows(size_t segment) const;
+
+  /* 1 when the first row of the segment repeats the previous segment */
+  size_t getSegmentOverlap(size_t segment) const;
+
+  /**
+   * @brief Time of every row of a segment as an offset from
+   * getSegmentOrigin(), null for a uniform segment. Offsets are floats within
+   * a segment only; add them to the origin in double.
+   *
+   * @param buffer Receives the offsets of a compressed segment
+   */
+  const float *getSegmentOffsets(size_t segment,
+                                 std::vector<float> &buffer) const;
+  double getSegmentOrigin(size_t segment) const;
+
+  /* Rows of a uniform segment are at start + row * step */
+  bool isSegmentUniform(size_t segment) const;
+  double getSegmentStart(size_t segment) const;
+  double getSegmentStep(size_t segment) const;
+
+  /* Time of the last row of a segment */
+  double getSegmentEnd(size_t segment) const;
+
+  /* Time of every drawable row of a segment, for readers walking the rows */
+  void getSegmentTimes(size_t segment, std::vector<double> &times) const;
+
+  /**
+   * @brief Range of the displayed values of a channel over a segment,
+   * without its leading repeated row. Compressed segments answer from their
+   * kept statistics, without being unpacked.
+   */
+  void getSegmentStatistics(size_t segment, size_t channel,
+                            SpanStatistics &statistics) const;
+  const ChannelStorage &getChannelStorage(size_t channel) const;
+
+  /**
+   * @brief Displayed values of a channel over a segment.
+   *
+   * @param buffer Receives the values when they have to be converted; a
+   *               float32 channel without scale nor offset is returned as
+   *               stored, without copy.
+   * @return getSegmentRows(segment) values.
+   */
+  const float *getSegmentValues(size_t segment, size_t channel,
+                                std::vector<float> &buffer) const;
+
+  /* Statistics of the displayed values of a channel, gaps excluded */
+  void getChannelStatistics(size_t channel, SpanStatistics &statistics) const;
+
+  double getFirstTime(void) const;
+
+  double getLastTime(void) const;
+
+  /* Values of the newest row, false when empty */
+  bool getLastValues(std::vector<float> &values) const;
+
+private:
+  friend class HistoryStore;
+
+  const HistoryChunk *prv_chunk(size_t segment) const;
+  size_t prv_begin(size_t segment) const;
+  size_t prv_end(size_t segment) const;
+  double prv_rowTime(size_t segment, size_t row) const;
+
+  std::shared_ptr<const HistoryChunkList> pSealed_m;
+  std::shared_ptr<const HistoryChunk> pTail_m;
+  std::shared_ptr<const std::vector<ChannelStorage>> pStorage_m;
+  size_t tailRows_m;
+  double tailStart_m; /* The store refines these while the tail fills */
+  double tailStep_m;
+  size_t firstChunk_m;  /* First sealed chunk in the snapshot */
+  size_t firstRow_m;    /* First row of that chunk in the snapshot */
+  size_t segmentCount_m;
+  size_t rowCount_m;
+  size_t channels_m;
+};
+
+/**
+ * @brief Counters of a HistoryStore since it was last cleared. The store
+ * drops its oldest rows when full, the rows evicted are the ones appended
+ * that are no longer visible.
+ */
+struct HistoryStatistics
+{
+  uint64_t rowsAppended = 0;
+  uint64_t rowsEvicted = 0;
+  size_t rows = 0; /* Visible through a snapshot */
+  size_t limit = 0;
+  size_t bytes = 0; /* Memory of the chunks, the tail included */
+};
+
+/**
+ * @brief Bounded channel history made of immutable chunks.
+ *
+ * Written by one reader thread, read by the UI through snapshots. Appending a
+ * batch takes the mutex once; when the tail chunk is full it is sealed into a
+ * new chunk list (copy of a few pointers) and the oldest chunks beyond the
+ * limit are dropped from the list, not erased element by element.
+ */
+class HistoryStore
+{
+public:
+  explicit HistoryStore(size_t chunkRows = HISTORY_CHUNK_ROWS);
+
+  /* Number of most recent rows visible through snapshots */
+  void setLimit(size_t rows);
+
+  /**
+   * @brief Sets how each channel is stored, channels beyond the vector are
+   * float32.
+   *
+   * A change of type clears the history. Scale and offset only apply when
+   * the history is read, the stored rows are kept.
+   */
+  void setStorage(const std::vector<ChannelStorage> &storage);
+
+  /* A change of mode, or of rate in fixed-rate mode, clears the history */
+  void setTimeAxis(const TimeAxisStorage &timeAxis);
+
+  /**
+   * @brief Sets the long-term tiers. While they are enabled, snapshots show
+   * every full-rate row kept, which can exceed the limit by up to a chunk, so
+   * that the first tier starts where they end.
+   */
+  void setRetention(const HistoryRetention &retention);
+
+  /**
+   * @brief Appends frames received over (time - span, time].
+   *
+   * @param time Arrival of the last frame
+   * @param pFrames frames * channels values, frame-major as parsed
+   * @param channels A change of channel count clears the history
+   * @param span The frames are evenly spread over it, ending at time; 0
+   *             stamps them all with time
+   */
+  void append(double time, const float *pFrames, size_t frames,
+              size_t channels, double span = 0.0);
+
+  void clear(void);
+
+  HistorySnapshot snapshot(void) const;
+
+  /**
+   * @brief Snapshot of a tier, level 1 being the finest. Each row holds the
+   * min, max and mean of every channel, in the columns channel,
+   * channels + channel and 2 * channels + channel.
+   * @return An empty snapshot when the tiers are disabled.
+   */
+  HistorySnapshot tierSnapshot(size_t level) const;
+
+  void getStatistics(HistoryStatistics &statistics) const;
+
+private:
+  bool prv_applyStorage(void);
+  void prv_reset(void);
+  void prv_startChunk(bool continuous);
+  void prv_sealTail(bool continuous);
+  void prv_syncTime(double time, size_t frames);
+  void prv_measureTime(double time);
+  void prv_trim(void);
+  bool prv_keepsAllRows(void) const;
+  void prv_updateTierLimits(void);
+  void prv_decimate(const HistoryChunk &chunk);
+  const float *prv_decodeColumn(const HistoryChunk &chunk, size_t column);
+
+  mutable std::mutex mutex_m;
+  size_t chunkRows_m;
+  size_t limit_m;
+  size_t channels_m;
+  uint64_t rowsAppended_m;
+
+  std::shared_ptr<const HistoryChunkList> pSealed_m;
+  size_t sealedRows_m; /* Rows of the sealed chunks, without overlaps */
+  size_t sealedBytes_m;
+  std::shared_ptr<HistoryChunk> pTail_m;
+
+  std::vector<ChannelStorage> requested_m; /* As set, any channel count */
+  std::shared_ptr<const std::vector<ChannelStorage>> pStorage_m;
+  std::vector<StorageType_t> types_m; /* Of the chunks, one per channel */
+  bool floatOnly_m;
+
+  /* Uniform time: rows since the last new start are measured together, the
+   * tail is placed from one row of known time */
+  TimeAxisStorage timeAxis_m;
+  double step_m;
+  uint64_t syncedRows_m;
+  bool measuring_m;
+  double measureTime_m; /* Arrival of row measureRow_m */
+  uint64_t measureRow_m;
+  bool tailAnchored_m;
+  double tailAnchorTime_m;
+  size_t tailAnchorRow_m;
+
+  std::vector<float *> planes_m; /* Where append() splits the frames */
+  std::vector<float> scratch_m;  /* Columns converted before being stored */
+
+  /* Long-term tiers: each level owns the next one. The levels are created
+   * once, when first enabled, and never replaced. */
+  HistoryRetention retention_m;
+  size_t level_m; /* 0 for the full-rate store */
+  std::unique_ptr<HistoryStore> pTier_m;
+  std::chrono::steady_clock::time_point memoryChecked_m;
+  bool memoryLow_m;
+  std::vector<ChannelStorage> tierStorage_m;
+  std::vector<float> tierFrames_m;  /* Rows for the next tier, frame-major */
+  std::vector<float> tierColumns_m; /* Min, max and mean of one column */
+  std::vector<float> decoded_m;
+};
+
+#endif // HISTORY_STORE_H
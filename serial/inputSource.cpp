@@ -0,0 +1,194 @@
+/** @file      inputSource.cpp
+ *  @brief     Source file for the byte stream sources feeding the parser.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/10
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "inputSource.h"
+#include "localInputSources.h"
+#include "networkInputSources.h"
+#include <cerrno>
+#include <cstdlib>
+
+#include <poll.h>
+#include <unistd.h>
+
+FileDescriptorSource::FileDescriptorSource(bool endOnZeroRead,
+                                           bool ownsDescriptor)
+  : fd_m(-1)
+  , endOnZeroRead_m(endOnZeroRead)
+  , ownsDescriptor_m(ownsDescriptor)
+{
+}
+
+FileDescriptorSource::~FileDescriptorSource()
+{
+  FileDescriptorSource::close();
+}
+
+void FileDescriptorSource::close(void)
+{
+  if (fd_m >= 0 && ownsDescriptor_m)
+  {
+    ::close(fd_m);
+  }
+  fd_m = -1;
+}
+
+OrbCode_t FileDescriptorSource::wait(int timeoutMs)
+{
+  struct pollfd pollDescriptor;
+  pollDescriptor.fd = fd_m;
+  pollDescriptor.events = POLLIN;
+  pollDescriptor.revents = 0;
+
+  if (fd_m < 0)
+  {
+    return PortStateError;
+  }
+
+  int ready = poll(&pollDescriptor, 1, timeoutMs);
+  if (ready < 0)
+  {
+    /* Interrupted by a signal, let the caller check its stop condition */
+    return (errno == EINTR) ? TimeoutError : ReadError;
+  }
+
+  if (ready == 0)
+  {
+    return TimeoutError;
+  }
+
+  if (pollDescriptor.revents & (POLLERR | POLLNVAL))
+  {
+    return ReadError;
+  }
+
+  /* A hung up pipe or socket may still hold data, read() reports the end */
+  if ((pollDescriptor.revents & POLLHUP) && !endOnZeroRead_m
+      && !(pollDescriptor.revents & POLLIN))
+  {
+    return ReadError;
+  }
+
+  return DataReceived;
+}
+
+OrbCode_t FileDescriptorSource::read(char *pData, size_t capacity,
+                                     size_t &received)
+{
+  received = 0;
+
+  if (fd_m < 0)
+  {
+    return PortStateError;
+  }
+
+  ssize_t bytesRead = ::read(fd_m, pData, capacity);
+  if (bytesRead < 0)
+  {
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+    {
+      return Success;
+    }
+    statistics_m.readErrors++;
+    return ReadError;
+  }
+
+  if (bytesRead == 0)
+  {
+    return endOnZeroRead_m ? EndOfStream : Success;
+  }
+
+  received = static_cast<size_t>(bytesRead);
+  statistics_m.bytesReceived += received;
+  statistics_m.readCalls++;
+  return Success;
+}
+
+static bool prv_parsePort(const std::string &text, uint16_t &port)
+{
+  char *pEnd = nullptr;
+  unsigned long value = strtoul(text.c_str(), &pEnd, 10);
+  if (text.empty() || *pEnd != '\0' || value == 0 || value > 65535)
+  {
+    return false;
+  }
+  port = static_cast<uint16_t>(value);
+  return true;
+}
+
+std::unique_ptr<InputSource> createInputSource(const std::string &spec)
+{
+  if (spec == "-" || spec == "stdin")
+  {
+    return std::make_unique<PipeSource>("");
+  }
+
+  size_t separator = spec.find(':');
+  if (separator == std::string::npos || separator + 1 == spec.size())
+  {
+    return nullptr;
+  }
+
+  std::string kind = spec.substr(0, separator);
+  std::string target = spec.substr(separator + 1);
+
+  if (kind == "pipe")
+  {
+    return std::make_unique<PipeSource>(target);
+  }
+
+  if (kind == "unix")
+  {
+    return std::make_unique<UnixSocketSource>(target);
+  }
+
+  if (kind == "file")
+  {
+    double bytesPerSecond = 0.0;
+    size_t rate = target.rfind('@');
+    if (rate != std::string::npos)
+    {
+      char *pEnd = nullptr;
+      bytesPerSecond = strtod(target.c_str() + rate + 1, &pEnd);
+      if (pEnd == target.c_str() + rate + 1 || *pEnd != '\0'
+          || bytesPerSecond < 0.0)
+      {
+        return nullptr;
+      }
+      target.resize(rate);
+    }
+    return std::make_unique<FileReplaySource>(target, bytesPerSecond);
+  }
+
+  if (kind == "tcp" || kind == "udp")
+  {
+    /* The port follows the last colon, the host is optional for UDP */
+    size_t colon = target.rfind(':');
+    std::string host
+        = (colon == std::string::npos) ? std::string() : target.substr(0, colon);
+    uint16_t port = 0;
+    if (!prv_parsePort(target.substr(colon + 1), port))
+    {
+      return nullptr;
+    }
+
+    if (kind == "tcp")
+    {
+      return host.empty() ? nullptr
+                          : std::make_unique<TcpClientSource>(host, port);
+    }
+    return std::make_unique<UdpSource>(host, port);
+  }
+
+  return nullptr;
+}
@@ -0,0 +1,163 @@
+/** @file      inputSource.h
+ *  @brief     Header file for the byte stream sources feeding the parser.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/10
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef INPUT_SOURCE_H
+#define INPUT_SOURCE_H
+
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include "../Libraries/lib.h"
+
+/**
+ * @brief Counters of a source, independent of what the bytes contain.
+ */
+struct InputStatistics
+{
+  uint64_t bytesReceived = 0; /* Bytes returned by read() */
+  uint64_t readCalls = 0;     /* read() calls that returned data */
+  uint64_t readErrors = 0;    /* Failed read() calls */
+};
+
+/**
+ * @brief Receive errors counted by a UART driver since the source was
+ * opened. Characters lost here never reach read().
+ */
+struct DriverCounters
+{
+  uint64_t overruns = 0;       /* Lost by the UART FIFO, read too late */
+  uint64_t bufferOverruns = 0; /* Lost by the full tty flip buffer */
+  uint64_t framingErrors = 0;
+  uint64_t parityErrors = 0;
+  uint64_t breaks = 0;
+};
+
+/**
+ * @brief Transport delivering the "\n v1,v2,...\r" byte stream.
+ *
+ * A source only moves bytes, the framing and parsing is done by the
+ * FrameParser of the device reading it. Sources are not thread-safe, a single
+ * reader uses them.
+ */
+class InputSource
+{
+public:
+  virtual ~InputSource() = default;
+
+  /**
+   * @brief Opens the transport.
+   * @return Success, or OpenError / PortStateError / WrongBaudRate
+   */
+  virtual OrbCode_t open(void) = 0;
+
+  virtual void close(void) = 0;
+
+  virtual bool isOpen(void) const = 0;
+
+  /**
+   * @brief Waits until the source has data to read.
+   *
+   * @return DataReceived, TimeoutError (also when interrupted by a signal),
+   *         ReadError or PortStateError when the source is not open.
+   */
+  virtual OrbCode_t wait(int timeoutMs) = 0;
+
+  /**
+   * @brief Reads the available bytes without blocking.
+   *
+   * @param pData Destination span
+   * @param capacity Size of the destination span
+   * @param received Number of bytes stored in the span
+   * @return Success (possibly with no bytes), EndOfStream when the writer is
+   *         gone and everything was read, or ReadError.
+   */
+  virtual OrbCode_t read(char *pData, size_t capacity, size_t &received) = 0;
+
+  /* Human readable name, used as the channel group prefix */
+  const std::string &getName(void) const { return name_m; }
+
+  void getStatistics(InputStatistics &statistics) const
+  {
+    statistics = statistics_m;
+  }
+
+  void resetStatistics(void) { statistics_m = InputStatistics(); }
+
+  /**
+   * @brief Gets the driver receive error counters, for serial ports whose
+   * driver implements TIOCGICOUNT.
+   * @return false when the source has no such counters.
+   */
+  virtual bool getDriverCounters(DriverCounters &counters) const
+  {
+    (void)counters;
+    return false;
+  }
+
+protected:
+  std::string name_m;
+  InputStatistics statistics_m;
+};
+
+/**
+ * @brief Source reading a pollable file descriptor.
+ */
+class FileDescriptorSource : public InputSource
+{
+public:
+  ~FileDescriptorSource() override;
+
+  void close(void) override;
+
+  bool isOpen(void) const override { return fd_m >= 0; }
+
+  OrbCode_t wait(int timeoutMs) override;
+
+  OrbCode_t read(char *pData, size_t capacity, size_t &received) override;
+
+protected:
+  /**
+   * @param endOnZeroRead Whether a read() returning 0 means the writer is gone
+   *        (pipes, sockets, files) rather than no data yet (serial ports)
+   * @param ownsDescriptor Whether close() closes the descriptor (not stdin)
+   */
+  FileDescriptorSource(bool endOnZeroRead, bool ownsDescriptor = true);
+
+  int fd_m;
+
+private:
+  bool endOnZeroRead_m;
+  bool ownsDescriptor_m;
+};
+
+/**
+ * @brief Creates a source from a textual specification.
+ *
+ * Supported specifications:
+ * - "-" or "stdin": standard input
+ * - "pipe:PATH": named pipe (FIFO)
+ * - "unix:PATH": Unix domain stream socket
+ * - "file:PATH[@BYTES_PER_SECOND]": replay of a raw capture, unpaced when no
+ *   rate is given
+ * - "tcp:HOST:PORT": TCP client
+ * - "udp:PORT" or "udp:ADDRESS:PORT": UDP datagrams received on a local port
+ *
+ * Serial ports are created with their line settings by SerialPortSource.
+ *
+ * @return The unopened source, or nullptr when the specification is invalid.
+ */
+std::unique_ptr<InputSource> createInputSource(const std::string &spec);
+
+#endif // INPUT_SOURCE_H
@@ -0,0 +1,203 @@
+/** @file      localInputSources.cpp
+ *  @brief     Source file for the sources fed by local processes and files.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/10
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "localInputSources.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+PipeSource::PipeSource(const std::string &path)
+  : FileDescriptorSource(true, !path.empty())
+  , path_m(path)
+{
+  name_m = path.empty() ? "stdin" : path;
+}
+
+OrbCode_t PipeSource::open(void)
+{
+  if (fd_m >= 0)
+  {
+    return PortStateError;
+  }
+
+  if (path_m.empty())
+  {
+    fd_m = STDIN_FILENO;
+  }
+  else
+  {
+    fd_m = ::open(path_m.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd_m < 0)
+    {
+      std::cerr << "Error opening pipe " << path_m << ": " << strerror(errno)
+                << std::endl;
+      return OpenError;
+    }
+  }
+
+  return Success;
+}
+
+OrbCode_t PipeSource::read(char *pData, size_t capacity, size_t &received)
+{
+  received = 0;
+  if (fd_m == STDIN_FILENO)
+  {
+    /* A quiet standard input would block the reader and its stop */
+    struct pollfd pollDescriptor = {fd_m, POLLIN, 0};
+    if (poll(&pollDescriptor, 1, 0) <= 0)
+    {
+      return Success;
+    }
+  }
+  return FileDescriptorSource::read(pData, capacity, received);
+}
+
+UnixSocketSource::UnixSocketSource(const std::string &path)
+  : FileDescriptorSource(true)
+  , path_m(path)
+{
+  name_m = "unix:" + path;
+}
+
+OrbCode_t UnixSocketSource::open(void)
+{
+  struct sockaddr_un address;
+
+  if (fd_m >= 0)
+  {
+    return PortStateError;
+  }
+
+  if (path_m.size() >= sizeof(address.sun_path))
+  {
+    return OpenError;
+  }
+
+  fd_m = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd_m < 0)
+  {
+    return OpenError;
+  }
+
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  memcpy(address.sun_path, path_m.c_str(), path_m.size());
+
+  if (connect(fd_m, reinterpret_cast<struct sockaddr *>(&address),
+              sizeof(address))
+      != 0)
+  {
+    std::cerr << "Error connecting to " << path_m << ": " << strerror(errno)
+              << std::endl;
+    close();
+    return OpenError;
+  }
+
+  fcntl(fd_m, F_SETFL, fcntl(fd_m, F_GETFL) | O_NONBLOCK);
+
+  return Success;
+}
+
+FileReplaySource::FileReplaySource(const std::string &path,
+                                   double bytesPerSecond)
+  : FileDescriptorSource(true)
+  , path_m(path)
+  , bytesPerSecond_m(bytesPerSecond)
+  , bytesReplayed_m(0)
+{
+  name_m = path;
+}
+
+OrbCode_t FileReplaySource::open(void)
+{
+  if (fd_m >= 0)
+  {
+    return PortStateError;
+  }
+
+  fd_m = ::open(path_m.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd_m < 0)
+  {
+    std::cerr << "Error opening replay file " << path_m << ": "
+              << strerror(errno) << std::endl;
+    return OpenError;
+  }
+
+  posix_fadvise(fd_m, 0, 0, POSIX_FADV_SEQUENTIAL);
+  startTime_m = std::chrono::steady_clock::now();
+  bytesReplayed_m = 0;
+
+  return Success;
+}
+
+size_t FileReplaySource::prv_allowance(void) const
+{
+  double elapsed = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - startTime_m)
+                       .count();
+  double allowed = elapsed * bytesPerSecond_m - bytesReplayed_m;
+  return allowed > 0.0 ? static_cast<size_t>(allowed) : 0;
+}
+
+OrbCode_t FileReplaySource::wait(int timeoutMs)
+{
+  if (fd_m < 0)
+  {
+    return PortStateError;
+  }
+
+  /* Wake up at most once per millisecond of data, not for every byte */
+  size_t chunk = std::max<size_t>(1, bytesPerSecond_m / 1000.0);
+  if (bytesPerSecond_m <= 0.0 || prv_allowance() >= chunk)
+  {
+    return DataReceived;
+  }
+
+  /* Sleep until the next chunk is due, or the timeout */
+  double due = (bytesReplayed_m + chunk) / bytesPerSecond_m;
+  auto dueTime = startTime_m
+                 + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                     std::chrono::duration<double>(due));
+  auto timeoutTime
+      = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+  std::this_thread::sleep_until(std::min(dueTime, timeoutTime));
+
+  return prv_allowance() >= chunk ? DataReceived : TimeoutError;
+}
+
+OrbCode_t FileReplaySource::read(char *pData, size_t capacity,
+                                 size_t &received)
+{
+  if (bytesPerSecond_m > 0.0)
+  {
+    capacity = std::min(capacity, prv_allowance());
+    if (capacity == 0)
+    {
+      received = 0;
+      return Success;
+    }
+  }
+
+  OrbCode_t orbCode = FileDescriptorSource::read(pData, capacity, received);
+  bytesReplayed_m += received;
+  return orbCode;
+}
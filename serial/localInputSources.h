@@ -0,0 +1,83 @@
+/** @file      localInputSources.h
+ *  @brief     Header file for the sources fed by local processes and files.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/10
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef LOCAL_INPUT_SOURCES_H
+#define LOCAL_INPUT_SOURCES_H
+
+#include <chrono>
+#include "inputSource.h"
+
+/**
+ * @brief Standard input or a named pipe.
+ *
+ * Named pipes are opened read-write so that the source keeps waiting when a
+ * writer closes and another one connects. Standard input ends with its writer.
+ * Named pipes are non-blocking; standard input is shared with the parent
+ * process, so it is polled before each read instead of being made
+ * non-blocking.
+ */
+class PipeSource : public FileDescriptorSource
+{
+public:
+  /* Empty path for standard input */
+  explicit PipeSource(const std::string &path);
+
+  OrbCode_t open(void) override;
+
+  OrbCode_t read(char *pData, size_t capacity, size_t &received) override;
+
+private:
+  std::string path_m;
+};
+
+/**
+ * @brief Client of a Unix domain stream socket.
+ */
+class UnixSocketSource : public FileDescriptorSource
+{
+public:
+  explicit UnixSocketSource(const std::string &path);
+
+  OrbCode_t open(void) override;
+
+private:
+  std::string path_m;
+};
+
+/**
+ * @brief Replay of a raw capture file, optionally paced to a byte rate.
+ */
+class FileReplaySource : public FileDescriptorSource
+{
+public:
+  /* A rate of 0 replays the file as fast as it is consumed */
+  FileReplaySource(const std::string &path, double bytesPerSecond);
+
+  OrbCode_t open(void) override;
+
+  OrbCode_t wait(int timeoutMs) override;
+
+  OrbCode_t read(char *pData, size_t capacity, size_t &received) override;
+
+private:
+  /* Bytes the pacing allows to read now */
+  size_t prv_allowance(void) const;
+
+  std::string path_m;
+  double bytesPerSecond_m;
+  std::chrono::steady_clock::time_point startTime_m;
+  uint64_t bytesReplayed_m;
+};
+
+#endif // LOCAL_INPUT_SOURCES_H
@@ -0,0 +1,248 @@
+/** @file      multiPortCapture.cpp
+ *  @brief     Source file for the capture of several serial ports at once.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/03
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "multiPortCapture.h"
+#include "timeAlignedMerger.h"
+#include "connectionSupervisor.h"
+#include "csvStorage.h"
+#include "shmPublisher.h"
+#include "../web/webServer.h"
+#include "../ui/viewerSettings.h"
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#define CAPTURE_POLL_TIMEOUT_MS (100)
+#define CAPTURE_RECONNECT_POLL_MS (50)
+
+struct CapturePort
+{
+  SerialDevice device;
+  ConnectionSupervisor supervisor{device};
+  std::thread reader;
+  std::atomic<bool> running{false};
+  int group = 0;
+};
+
+static std::vector<std::unique_ptr<CapturePort>> capturePorts;
+static int nextCaptureGroup = PRIMARY_CAPTURE_GROUP + 1;
+/* Also read by the primary reader thread */
+static std::atomic<size_t> capturePortCount{0};
+
+/* Merged recording, mergerColumns maps a group to its merger index */
+static TimeAlignedMerger captureMerger;
+static std::mutex mergerMutex;
+static std::unordered_map<int, size_t> mergerColumns;
+static std::atomic<bool> mergerRecording{false};
+static bool resamplingEnabled = false;
+static double resamplingPeriod = 0.001;
+
+static void prv_readerThread(CapturePort *pPort)
+{
+  while (pPort->running)
+  {
+    OrbCode_t orbCode = pPort->device.wait(CAPTURE_POLL_TIMEOUT_MS);
+    pPort->supervisor.reportResult(orbCode);
+
+    if (orbCode == DataReceived)
+    {
+      pPort->device.setHistoryLimit(viewerDataSize());
+      orbCode = pPort->device.read();
+      pPort->supervisor.reportResult(orbCode);
+      if (orbCode == EndOfStream)
+      {
+        pPort->supervisor.close();
+      }
+    }
+
+    pPort->supervisor.supervise();
+
+    /* Unplugged for good, the port stays listed with its statistics */
+    ConnectionState_t state = pPort->supervisor.getState();
+    if (state == CONNECTION_CLOSED)
+    {
+      break;
+    }
+    if (state == CONNECTION_RECONNECTING || orbCode == ReadError)
+    {
+      std::this_thread::sleep_for(
+          std::chrono::milliseconds(CAPTURE_RECONNECT_POLL_MS));
+    }
+  }
+}
+
+OrbCode_t addCapturePort(const std::string &portName, uint32_t baudRate,
+                         uint8_t stopBits, uint8_t parity, int channels)
+{
+  for (const std::unique_ptr<CapturePort> &pPort : capturePorts)
+  {
+    if (pPort->device.getPortName() == portName)
+    {
+      return NotAvailable;
+    }
+  }
+
+  std::unique_ptr<CapturePort> pPort = std::make_unique<CapturePort>();
+  OrbCode_t orbCode
+      = pPort->supervisor.open(portName, baudRate, stopBits, parity);
+  if (orbCode != Success)
+  {
+    return orbCode;
+  }
+
+  pPort->group = nextCaptureGroup++;
+  pPort->device.setChannelCount(channels);
+  pPort->device.setHistoryLimit(viewerDataSize());
+
+  int group = pPort->group;
+  pPort->device.setFrameCallback(
+      [group](double time, const std::vector<float> &values)
+      { recordCaptureFrame(group, time, values); });
+
+  pPort->running = true;
+  pPort->reader = std::thread(prv_readerThread, pPort.get());
+  capturePorts.push_back(std::move(pPort));
+  capturePortCount = capturePorts.size();
+
+  return Success;
+}
+
+void removeCapturePort(size_t index)
+{
+  if (index >= capturePorts.size())
+  {
+    return;
+  }
+
+  CapturePort *pPort = capturePorts[index].get();
+  pPort->running = false;
+  if (pPort->reader.joinable())
+  {
+    pPort->reader.join();
+  }
+  pPort->supervisor.close();
+
+  capturePorts.erase(capturePorts.begin() + index);
+  capturePortCount = capturePorts.size();
+}
+
+size_t getCapturePortCount(void)
+{
+  return capturePortCount;
+}
+
+SerialDevice *getCapturePort(size_t index)
+{
+  return index < capturePorts.size() ? &capturePorts[index]->device : nullptr;
+}
+
+ConnectionState_t getCapturePortState(size_t index)
+{
+  return index < capturePorts.size() ? capturePorts[index]->supervisor.getState()
+                                     : CONNECTION_CLOSED;
+}
+
+int getCapturePortGroup(size_t index)
+{
+  return index < capturePorts.size() ? capturePorts[index]->group : -1;
+}
+
+void recordCaptureFrame(int group, double time,
+                        const std::vector<float> &values)
+{
+  /* Live consumers get every frame, recording or not */
+  publishWebFrame(group, time, values);
+  publishSharedMemoryFrame(group, time, values);
+
+  if (mergerRecording)
+  {
+    size_t column;
+    {
+      std::lock_guard<std::mutex> lock(mergerMutex);
+      auto it = mergerColumns.find(group);
+      if (it == mergerColumns.end())
+      {
+        /* Port added after the recording was started */
+        return;
+      }
+      column = it->second;
+    }
+    captureMerger.push(column, time, values);
+  }
+  else if (group == PRIMARY_CAPTURE_GROUP && isCSVRecording())
+  {
+    writeCSVDataRow(time, values);
+  }
+}
+
+void setCaptureResampling(bool enabled, double period)
+{
+  resamplingEnabled = enabled;
+  resamplingPeriod = period;
+}
+
+bool startCaptureRecording(const std::string &filename,
+                           const std::vector<std::string> &primaryNames)
+{
+  std::vector<std::string> names = primaryNames;
+  std::vector<int> groupChannels;
+  std::unordered_map<int, size_t> columns;
+
+  groupChannels.push_back(static_cast<int>(primaryNames.size()));
+  columns[PRIMARY_CAPTURE_GROUP] = 0;
+
+  for (const std::unique_ptr<CapturePort> &pPort : capturePorts)
+  {
+    int channels = pPort->device.getChannelCount();
+    for (int i = 0; i < channels; ++i)
+    {
+      names.push_back(pPort->device.getPortName() + ":Channel_"
+                      + std::to_string(i + 1));
+    }
+    columns[pPort->group] = groupChannels.size();
+    groupChannels.push_back(channels);
+  }
+
+  /* A single port without a grid needs no merge */
+  if (capturePorts.empty() && !resamplingEnabled)
+  {
+    return startCSVRecording(filename, names);
+  }
+
+  if (!startCSVRecording(filename, names))
+  {
+    return false;
+  }
+
+  captureMerger.configure(groupChannels,
+                          resamplingEnabled ? resamplingPeriod : 0.0,
+                          [](double time, const std::vector<float> &row)
+                          { writeCSVDataRow(time, row); });
+  {
+    std::lock_guard<std::mutex> lock(mergerMutex);
+    mergerColumns = columns;
+  }
+  mergerRecording = true;
+
+  return true;
+}
+
+void stopCaptureRecording(void)
+{
+  mergerRecording = false;
+  stopCSVRecording();
+}
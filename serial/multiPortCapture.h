@@ -0,0 +1,104 @@
+/** @file      multiPortCapture.h
+ *  @brief     Header file for the capture of several serial ports at once.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/03
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef MULTI_PORT_CAPTURE_H
+#define MULTI_PORT_CAPTURE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "serialDevice.h"
+#include "connectionSupervisor.h"
+#include "../Libraries/lib.h"
+
+/* Channel group of the port opened from the serial settings */
+#define PRIMARY_CAPTURE_GROUP (0)
+
+/**
+ * @brief Opens an additional port with its own reader thread and channel
+ * group, on top of the primary port.
+ *
+ * @param channels Number of values of every message of this port
+ * @return Success, NotAvailable if the port is already captured, or the
+ *         error of SerialDevice::open(). The port is reopened automatically
+ *         after a disconnect, like the primary port.
+ */
+OrbCode_t addCapturePort(const std::string &portName, uint32_t baudRate,
+                         uint8_t stopBits, uint8_t parity, int channels);
+
+/**
+ * @brief Stops the reader thread of an additional port and closes it.
+ *
+ * @param index Index of the port, from 0 to getCapturePortCount() - 1
+ */
+void removeCapturePort(size_t index);
+
+/**
+ * @brief Gets the number of additional ports.
+ *
+ * The additional ports are only added and removed from the UI thread, so the
+ * UI can iterate over them without further locking.
+ */
+size_t getCapturePortCount(void);
+
+/**
+ * @brief Gets an additional port. Its history is read through snapshots of
+ * SerialDevice::getHistory().
+ */
+SerialDevice *getCapturePort(size_t index);
+
+/**
+ * @brief Gets whether an additional port is connected, being reopened after a
+ * disconnect, or closed.
+ */
+ConnectionState_t getCapturePortState(size_t index);
+
+/**
+ * @brief Gets the channel group of an additional port. Groups are never
+ * reused, so a group identifies a port for as long as the application runs.
+ */
+int getCapturePortGroup(size_t index);
+
+/**
+ * @brief Hands a frame of a channel group to the active recording and to the
+ * shared-memory publication.
+ *
+ * Without a multi-port recording the frame goes directly to the CSV
+ * recording, so a single port is recorded exactly as before.
+ */
+void recordCaptureFrame(int group, double time,
+                        const std::vector<float> &values);
+
+/**
+ * @brief Sets the common grid used by the next recording.
+ *
+ * @param enabled Resample all groups to the grid instead of writing one row
+ *        per received frame
+ * @param period Grid period in seconds
+ */
+void setCaptureResampling(bool enabled, double period);
+
+/**
+ * @brief Starts a CSV recording of the primary port and all additional ports,
+ * merged on the shared capture time base.
+ *
+ * @param primaryNames Column names of the primary port channels
+ * @return true if the recording was started
+ */
+bool startCaptureRecording(const std::string &filename,
+                           const std::vector<std::string> &primaryNames);
+
+void stopCaptureRecording(void);
+
+#endif // MULTI_PORT_CAPTURE_H
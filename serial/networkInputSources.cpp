@@ -0,0 +1,242 @@
+/** @file      networkInputSources.cpp
+ *  @brief     Source file for the TCP and UDP input sources.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/12
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "networkInputSources.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+/* Large kernel buffers absorb bursts while the reader is busy */
+#define NETWORK_RECEIVE_BUFFER_SIZE (4 * 1024 * 1024)
+#define TCP_CONNECT_TIMEOUT_MS (2000)
+
+/* Datagrams received by a single recvmmsg() call, at most */
+#define UDP_BATCH_SIZE (32)
+/* Largest datagram expected from a network (jumbo frame) or on loopback */
+#define UDP_MAX_DATAGRAM (9 * 1024)
+#define UDP_MAX_LOOPBACK_DATAGRAM (65507)
+
+static void prv_setReceiveBuffer(int fd)
+{
+  int size = NETWORK_RECEIVE_BUFFER_SIZE;
+
+  /* Only privileged processes can exceed net.core.rmem_max */
+  if (setsockopt(fd, SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof(size)) != 0)
+  {
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+  }
+}
+
+TcpClientSource::TcpClientSource(const std::string &host, uint16_t port)
+  : FileDescriptorSource(true)
+  , host_m(host)
+  , port_m(port)
+{
+  name_m = "tcp:" + host + ":" + std::to_string(port);
+}
+
+OrbCode_t TcpClientSource::open(void)
+{
+  struct addrinfo hints;
+  struct addrinfo *pResults = nullptr;
+
+  if (fd_m >= 0)
+  {
+    return PortStateError;
+  }
+
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+
+  std::string service = std::to_string(port_m);
+  int error = getaddrinfo(host_m.c_str(), service.c_str(), &hints, &pResults);
+  if (error != 0)
+  {
+    std::cerr << "Cannot resolve " << host_m << ": " << gai_strerror(error)
+              << std::endl;
+    return OpenError;
+  }
+
+  for (struct addrinfo *pAddress = pResults; pAddress != nullptr;
+       pAddress = pAddress->ai_next)
+  {
+    fd_m = socket(pAddress->ai_family,
+                  pAddress->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                  pAddress->ai_protocol);
+    if (fd_m < 0)
+    {
+      continue;
+    }
+
+    prv_setReceiveBuffer(fd_m);
+
+    if (connect(fd_m, pAddress->ai_addr, pAddress->ai_addrlen) == 0)
+    {
+      break;
+    }
+
+    if (errno == EINPROGRESS)
+    {
+      /* Wait for the connection with a bounded timeout */
+      struct pollfd pollDescriptor = {fd_m, POLLOUT, 0};
+      int socketError = 0;
+      socklen_t length = sizeof(socketError);
+      if (poll(&pollDescriptor, 1, TCP_CONNECT_TIMEOUT_MS) == 1
+          && getsockopt(fd_m, SOL_SOCKET, SO_ERROR, &socketError, &length) == 0
+          && socketError == 0)
+      {
+        break;
+      }
+    }
+
+    close();
+  }
+
+  freeaddrinfo(pResults);
+
+  if (fd_m < 0)
+  {
+    std::cerr << "Cannot connect to " << host_m << ":" << port_m << std::endl;
+    return OpenError;
+  }
+
+  return Success;
+}
+
+UdpSource::UdpSource(const std::string &address, uint16_t port)
+  : FileDescriptorSource(false)
+  , address_m(address)
+  , port_m(port)
+  , loopback_m(false)
+{
+  name_m = "udp:" + (address.empty() ? std::string("*") : address) + ":"
+           + std::to_string(port);
+}
+
+OrbCode_t UdpSource::open(void)
+{
+  struct sockaddr_in local;
+
+  if (fd_m >= 0)
+  {
+    return PortStateError;
+  }
+
+  memset(&local, 0, sizeof(local));
+  local.sin_family = AF_INET;
+  local.sin_port = htons(port_m);
+  local.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (!address_m.empty() && inet_pton(AF_INET, address_m.c_str(), &local.sin_addr) != 1)
+  {
+    std::cerr << "Invalid UDP address: " << address_m << std::endl;
+    return OpenError;
+  }
+  loopback_m = (ntohl(local.sin_addr.s_addr) >> 24) == 127;
+
+  fd_m = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd_m < 0)
+  {
+    return OpenError;
+  }
+
+  prv_setReceiveBuffer(fd_m);
+
+  if (bind(fd_m, reinterpret_cast<struct sockaddr *>(&local), sizeof(local))
+      != 0)
+  {
+    std::cerr << "Cannot bind UDP port " << port_m << ": " << strerror(errno)
+              << std::endl;
+    close();
+    return OpenError;
+  }
+
+  return Success;
+}
+
+OrbCode_t UdpSource::read(char *pData, size_t capacity, size_t &received)
+{
+  struct mmsghdr messages[UDP_BATCH_SIZE];
+  struct iovec vectors[UDP_BATCH_SIZE];
+
+  received = 0;
+
+  if (fd_m < 0)
+  {
+    return PortStateError;
+  }
+
+  /* Every datagram gets an equal slot of the span, large enough for the
+   * biggest one expected, then they are packed */
+  size_t largest = loopback_m ? UDP_MAX_LOOPBACK_DATAGRAM : UDP_MAX_DATAGRAM;
+  size_t slot = std::min(capacity, std::max(capacity / UDP_BATCH_SIZE, largest));
+  if (slot == 0)
+  {
+    return Success;
+  }
+  int batch = static_cast<int>(std::min<size_t>(UDP_BATCH_SIZE, capacity / slot));
+  memset(messages, 0, sizeof(messages));
+  for (int i = 0; i < batch; ++i)
+  {
+    vectors[i].iov_base = pData + i * slot;
+    vectors[i].iov_len = slot;
+    messages[i].msg_hdr.msg_iov = &vectors[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  int count = recvmmsg(fd_m, messages, batch, MSG_DONTWAIT, nullptr);
+  if (count < 0)
+  {
+    if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+    {
+      return Success;
+    }
+    statistics_m.readErrors++;
+    return ReadError;
+  }
+
+  for (int i = 0; i < count; ++i)
+  {
+    size_t length = std::min<size_t>(messages[i].msg_len, slot);
+    bool truncated = (messages[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+    if (truncated || length == slot)
+    {
+      /* Possibly cut: its last message ends at its last '\r', the rest would
+       * be joined to the start of the next datagram by the parser */
+      const char *pDatagram = pData + i * slot;
+      while (length > 0 && pDatagram[length - 1] != '\r')
+      {
+        length--;
+      }
+    }
+    if (truncated)
+    {
+      statistics_m.readErrors++;
+    }
+    memmove(pData + received, pData + i * slot, length);
+    received += length;
+  }
+
+  statistics_m.bytesReceived += received;
+  statistics_m.readCalls++;
+  return Success;
+}
@@ -0,0 +1,64 @@
+/** @file      networkInputSources.h
+ *  @brief     Header file for the TCP and UDP input sources.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/12
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef NETWORK_INPUT_SOURCES_H
+#define NETWORK_INPUT_SOURCES_H
+
+#include "inputSource.h"
+
+/**
+ * @brief Client of a TCP stream, e.g. ser2net or a Wi-Fi bridge.
+ */
+class TcpClientSource : public FileDescriptorSource
+{
+public:
+  TcpClientSource(const std::string &host, uint16_t port);
+
+  /**
+   * @brief Connects with a bounded timeout so the caller is never stuck.
+   * @return Success or OpenError
+   */
+  OrbCode_t open(void) override;
+
+private:
+  std::string host_m;
+  uint16_t port_m;
+};
+
+/**
+ * @brief Receiver of UDP datagrams bound to a local port.
+ *
+ * Datagrams are received in batches with recvmmsg() and concatenated, so they
+ * must contain whole messages. Each gets a slot of the read buffer of 9 KB
+ * (jumbo frames), or of the largest UDP payload when bound to a loopback
+ * address, so fewer are received per call. A lost datagram only drops the
+ * messages it carried; one too long for its slot loses the message it cuts.
+ */
+class UdpSource : public FileDescriptorSource
+{
+public:
+  /* Empty address to listen on every interface */
+  UdpSource(const std::string &address, uint16_t port);
+
+  OrbCode_t open(void) override;
+
+  OrbCode_t read(char *pData, size_t capacity, size_t &received) override;
+
+private:
+  std::string address_m;
+  uint16_t port_m;
+  bool loopback_m; /* Bound to 127.0.0.0/8, local senders only */
+};
+
+#endif // NETWORK_INPUT_SOURCES_H
@@ -0,0 +1,941 @@
+/** @file      offlineRecording.cpp
+ *  @brief     Source file for the out-of-core recording reader.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/01/20
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "offlineRecording.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+// Raspberry Pi (Linux) includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Rows summarized by one entry of the block index */
+#define OFFLINE_BLOCK_ROWS (256)
+/* Entries of a summary level merged into one entry of the next level */
+#define OFFLINE_PYRAMID_FANOUT (8)
+/* Size of the file window mapped at once while indexing */
+#define OFFLINE_MAP_WINDOW (32ULL * 1024ULL * 1024ULL)
+/* Parsed blocks kept in memory (~512k rows) */
+#define OFFLINE_CACHE_BLOCKS (2048)
+/* Raw rows per horizontal pixel below which raw data is plotted */
+#define OFFLINE_DETAIL_ROWS_PER_PIXEL (64)
+/* How far above the detail threshold blocks are already prefetched */
+#define OFFLINE_PREFETCH_ZOOM_FACTOR (4)
+
+#define OFFLINE_INDEX_EXTENSION ".mscidx"
+#define OFFLINE_INDEX_VERSION (1)
+
+static const char offlineIndexMagic[8] = {'M', 'S', 'C', 'I', 'D', 'X', '0', '1'};
+
+struct OfflineIndexHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t channels;
+  uint64_t fileSize;
+  int64_t fileMtime;
+  uint64_t dataOffset;
+  uint64_t blockCount;
+  uint32_t blockRows;
+  uint32_t reserved;
+};
+
+namespace
+{
+/**
+ * @brief Read-only mapping of an arbitrary byte range of a file.
+ *
+ * Only the requested window is mapped, so recordings larger than the address
+ * space of a 32-bit Raspberry Pi OS can still be paged through.
+ */
+class MappedRange
+{
+public:
+  MappedRange(int fd, uint64_t offset, uint64_t length, int advice)
+    : pMap_m(nullptr)
+    , pData_m(nullptr)
+    , mapLength_m(0)
+  {
+    static const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    uint64_t alignedOffset = offset & ~(pageSize - 1);
+
+    if (length == 0)
+    {
+      return;
+    }
+
+    mapLength_m = static_cast<size_t>(length + (offset - alignedOffset));
+    void *pMap = mmap(nullptr, mapLength_m, PROT_READ, MAP_PRIVATE, fd,
+                      static_cast<off_t>(alignedOffset));
+    if (pMap == MAP_FAILED)
+    {
+      return;
+    }
+
+    madvise(pMap, mapLength_m, advice);
+    pMap_m = pMap;
+    pData_m = static_cast<const char *>(pMap) + (offset - alignedOffset);
+  }
+
+  ~MappedRange()
+  {
+    if (pMap_m)
+    {
+      munmap(pMap_m, mapLength_m);
+    }
+  }
+
+  MappedRange(const MappedRange &) = delete;
+  MappedRange &operator=(const MappedRange &) = delete;
+
+  bool isValid(void) const { return pData_m != nullptr; }
+
+  const char *data(void) const { return pData_m; }
+
+private:
+  void *pMap_m;
+  const char *pData_m;
+  size_t mapLength_m;
+};
+} // namespace
+
+/**
+ * @brief Parses one recording row ("time,v1,v2,...") without copying it.
+ *
+ * Missing or malformed fields are returned as NaN so that partially filled
+ * rows still plot the channels they contain.
+ *
+ * @return false for comments, empty lines and lines without a timestamp.
+ */
+static bool prv_parseRow(const char *p, const char *end, size_t channels,
+                         double &time, float *values)
+{
+  if (p < end && end[-1] == '\r')
+  {
+    --end;
+  }
+
+  if (p == end || *p == '#')
+  {
+    return false;
+  }
+
+  std::from_chars_result result = std::from_chars(p, end, time);
+  if (result.ec != std::errc())
+  {
+    return false;
+  }
+  p = result.ptr;
+
+  for (size_t ch = 0; ch < channels; ++ch)
+  {
+    values[ch] = std::numeric_limits<float>::quiet_NaN();
+
+    if (p >= end || *p != ',')
+    {
+      continue;
+    }
+    ++p;
+
+    result = std::from_chars(p, end, values[ch]);
+    if (result.ec == std::errc())
+    {
+      p = result.ptr;
+    }
+
+    /* Skip whatever is left of a malformed field */
+    while (p < end && *p != ',')
+    {
+      ++p;
+    }
+  }
+
+  return true;
+}
+
+OfflineRecording::OfflineRecording()
+  : fd_m(-1)
+  , fileSize_m(0)
+  , fileMtime_m(0)
+  , dataOffset_m(0)
+  , channels_m(0)
+  , rowCount_m(0)
+  , indexReady_m(false)
+  , indexProgress_m(0.0f)
+  , stopWorker_m(false)
+  , wantedFirst_m(0)
+  , wantedLast_m(0)
+  , prefetchPending_m(false)
+  , prefetchRequested_m(false)
+{
+}
+
+OfflineRecording::~OfflineRecording()
+{
+  close();
+}
+
+OrbCode_t OfflineRecording::open(const std::string &filename)
+{
+  close();
+
+  /* The header is tiny, read it with regular buffered I/O */
+  std::ifstream headerFile(filename);
+  if (!headerFile.is_open())
+  {
+    std::cerr << "Failed to open recording: " << filename << std::endl;
+    return OpenError;
+  }
+
+  std::string headerLine;
+  if (!std::getline(headerFile, headerLine))
+  {
+    return InvalidData;
+  }
+  uint64_t dataOffset = headerLine.size() + 1;
+  if (!headerLine.empty() && headerLine.back() == '\r')
+  {
+    headerLine.pop_back();
+  }
+
+  std::vector<std::string> names;
+  std::stringstream headerStream(headerLine);
+  std::string column;
+  while (std::getline(headerStream, column, ','))
+  {
+    names.push_back(column);
+  }
+
+  if (names.size() < 2 || names.front() != "Timestamp")
+  {
+    std::cerr << "Not an mscope recording: " << filename << std::endl;
+    return InvalidData;
+  }
+  names.erase(names.begin());
+
+  int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  struct stat fileStat;
+  if (fd < 0 || fstat(fd, &fileStat) != 0)
+  {
+    std::cerr << "Error opening recording: " << strerror(errno) << std::endl;
+    if (fd >= 0)
+    {
+      ::close(fd);
+    }
+    return OpenError;
+  }
+
+  filename_m = filename;
+  fd_m = fd;
+  fileSize_m = static_cast<uint64_t>(fileStat.st_size);
+  fileMtime_m = static_cast<int64_t>(fileStat.st_mtime);
+  dataOffset_m = std::min<uint64_t>(dataOffset, fileSize_m);
+  channelNames_m = names;
+  channels_m = names.size();
+
+  blocks_m.clear();
+  levels_m.clear();
+  rowCount_m = 0;
+  indexProgress_m = 0.0f;
+  indexReady_m = false;
+  stopWorker_m = false;
+  prefetchPending_m = false;
+  prefetchRequested_m = false;
+
+  worker_m = std::thread(&OfflineRecording::prv_workerThread, this);
+
+  return Success;
+}
+
+void OfflineRecording::close(void)
+{
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex_m);
+    stopWorker_m = true;
+  }
+  cacheCondition_m.notify_all();
+
+  if (worker_m.joinable())
+  {
+    worker_m.join();
+  }
+
+  cache_m.clear();
+  cacheOrder_m.clear();
+  indexReady_m = false;
+
+  if (fd_m >= 0)
+  {
+    ::close(fd_m);
+    fd_m = -1;
+  }
+}
+
+double OfflineRecording::getStartTime(void) const
+{
+  return blocks_m.empty() ? 0.0 : blocks_m.front().tStart;
+}
+
+double OfflineRecording::getEndTime(void) const
+{
+  return blocks_m.empty() ? 0.0 : blocks_m.back().tEnd;
+}
+
+void OfflineRecording::prv_workerThread(void)
+{
+  if (!prv_loadIndexFile())
+  {
+    if (!prv_buildIndex())
+    {
+      return; /* Cancelled by close() */
+    }
+    prv_saveIndexFile();
+  }
+
+  prv_buildPyramid();
+  indexProgress_m = 1.0f;
+  indexReady_m = true;
+
+  while (true)
+  {
+    size_t first;
+    size_t last;
+    {
+      std::unique_lock<std::mutex> lock(cacheMutex_m);
+      cacheCondition_m.wait(
+          lock, [this] { return stopWorker_m || prefetchPending_m; });
+      if (stopWorker_m)
+      {
+        break;
+      }
+      first = wantedFirst_m;
+      last = wantedLast_m;
+      prefetchPending_m = false;
+    }
+
+    /* Visible blocks first, then half a screen of margin on each side so
+     * that panning finds its data already parsed */
+    size_t margin = (last - first + 1) / 2;
+    prv_prefetch(first, last);
+    prv_prefetch(first - std::min(first, margin), first);
+    prv_prefetch(last, std::min(last + margin, blocks_m.size() - 1));
+  }
+}
+
+bool OfflineRecording::prv_buildIndex(void)
+{
+  std::vector<float> rowValues(channels_m);
+  std::vector<float> blockMin(channels_m);
+  std::vector<float> blockMax(channels_m);
+  SummaryLevel level;
+  Block block = {};
+  uint64_t pos = dataOffset_m;
+
+  auto resetBlock = [&](uint64_t offset) {
+    block = {};
+    block.offset = offset;
+    std::fill(blockMin.begin(), blockMin.end(),
+              std::numeric_limits<float>::infinity());
+    std::fill(blockMax.begin(), blockMax.end(),
+              -std::numeric_limits<float>::infinity());
+  };
+
+  auto closeBlock = [&](uint64_t endOffset) {
+    if (block.rows == 0)
+    {
+      return;
+    }
+    block.length = endOffset - block.offset;
+    blocks_m.push_back(block);
+    level.tStart.push_back(block.tStart);
+    level.tEnd.push_back(block.tEnd);
+    level.minValues.insert(level.minValues.end(), blockMin.begin(),
+                           blockMin.end());
+    level.maxValues.insert(level.maxValues.end(), blockMax.begin(),
+                           blockMax.end());
+    rowCount_m += block.rows;
+  };
+
+  resetBlock(pos);
+
+  while (pos < fileSize_m)
+  {
+    if (stopWorker_m)
+    {
+      return false;
+    }
+
+    uint64_t windowEnd = std::min<uint64_t>(fileSize_m, pos + OFFLINE_MAP_WINDOW);
+    MappedRange window(fd_m, pos, windowEnd - pos, MADV_SEQUENTIAL);
+    if (!window.isValid())
+    {
+      std::cerr << "Error mapping recording: " << strerror(errno) << std::endl;
+      break;
+    }
+
+    const char *pBegin = window.data();
+    const char *p = pBegin;
+    const char *pEnd = pBegin + (windowEnd - pos);
+
+    while (p < pEnd)
+    {
+      const char *pLineEnd
+          = static_cast<const char *>(memchr(p, '\n', pEnd - p));
+      if (pLineEnd == nullptr)
+      {
+        if (windowEnd < fileSize_m && p != pBegin)
+        {
+          break; /* Incomplete line, continue it in the next window */
+        }
+        pLineEnd = pEnd;
+      }
+
+      double time;
+      if (prv_parseRow(p, pLineEnd, channels_m, time, rowValues.data()))
+      {
+        if (block.rows == 0)
+        {
+          block.tStart = time;
+        }
+        block.tEnd = time;
+        block.rows++;
+
+        for (size_t ch = 0; ch < channels_m; ++ch)
+        {
+          /* NaN comparisons are false, so missing values are ignored */
+          if (rowValues[ch] < blockMin[ch])
+          {
+            blockMin[ch] = rowValues[ch];
+          }
+          if (rowValues[ch] > blockMax[ch])
+          {
+            blockMax[ch] = rowValues[ch];
+          }
+        }
+      }
+
+      p = (pLineEnd < pEnd) ? pLineEnd + 1 : pEnd;
+
+      if (block.rows == OFFLINE_BLOCK_ROWS)
+      {
+        uint64_t offset = pos + static_cast<uint64_t>(p - pBegin);
+        closeBlock(offset);
+        resetBlock(offset);
+      }
+    }
+
+    pos += static_cast<uint64_t>(p - pBegin);
+    indexProgress_m = static_cast<float>(pos) / static_cast<float>(fileSize_m);
+  }
+
+  closeBlock(pos);
+  levels_m.clear();
+  levels_m.push_back(std::move(level));
+
+  return true;
+}
+
+std::string OfflineRecording::prv_indexFilename(void) const
+{
+  return filename_m + OFFLINE_INDEX_EXTENSION;
+}
+
+bool OfflineRecording::prv_loadIndexFile(void)
+{
+  std::ifstream indexFile(prv_indexFilename(),
+                          std::ios::binary | std::ios::ate);
+  if (!indexFile.is_open())
+  {
+    return false;
+  }
+  uint64_t indexSize = static_cast<uint64_t>(indexFile.tellg());
+  indexFile.seekg(0);
+
+  OfflineIndexHeader header;
+  indexFile.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!indexFile
+      || memcmp(header.magic, offlineIndexMagic, sizeof(offlineIndexMagic)) != 0
+      || header.version != OFFLINE_INDEX_VERSION
+      || header.channels != channels_m || header.fileSize != fileSize_m
+      || header.fileMtime != fileMtime_m || header.dataOffset != dataOffset_m
+      || header.blockRows != OFFLINE_BLOCK_ROWS)
+  {
+    return false; /* Stale or foreign index, rebuild it */
+  }
+
+  /* A corrupt count would allocate without bounds */
+  uint64_t entrySize = sizeof(Block) + 2 * channels_m * sizeof(float);
+  if (indexSize < sizeof(header)
+      || header.blockCount != (indexSize - sizeof(header)) / entrySize
+      || (indexSize - sizeof(header)) % entrySize != 0)
+  {
+    return false;
+  }
+
+  size_t blockCount = static_cast<size_t>(header.blockCount);
+  SummaryLevel level;
+  blocks_m.resize(blockCount);
+  level.minValues.resize(blockCount * channels_m);
+  level.maxValues.resize(blockCount * channels_m);
+
+  indexFile.read(reinterpret_cast<char *>(blocks_m.data()),
+                 blockCount * sizeof(Block));
+  indexFile.read(reinterpret_cast<char *>(level.minValues.data()),
+                 level.minValues.size() * sizeof(float));
+  indexFile.read(reinterpret_cast<char *>(level.maxValues.data()),
+                 level.maxValues.size() * sizeof(float));
+  if (!indexFile)
+  {
+    blocks_m.clear();
+    return false;
+  }
+
+  /* The blocks are mapped and parsed, one past the end of the recording
+   * would fault (SIGBUS) */
+  for (const Block &block : blocks_m)
+  {
+    if (block.offset < dataOffset_m || block.offset > fileSize_m
+        || block.length > fileSize_m - block.offset
+        || block.rows > OFFLINE_BLOCK_ROWS)
+    {
+      blocks_m.clear();
+      return false;
+    }
+  }
+
+  rowCount_m = 0;
+  for (const Block &block : blocks_m)
+  {
+    level.tStart.push_back(block.tStart);
+    level.tEnd.push_back(block.tEnd);
+    rowCount_m += block.rows;
+  }
+
+  levels_m.clear();
+  levels_m.push_back(std::move(level));
+
+  return true;
+}
+
+void OfflineRecording::prv_saveIndexFile(void) const
+{
+  std::ofstream indexFile(prv_indexFilename(),
+                          std::ios::binary | std::ios::trunc);
+  if (!indexFile.is_open())
+  {
+    std::cerr << "Could not write recording index: " << prv_indexFilename()
+              << std::endl;
+    return;
+  }
+
+  const SummaryLevel &level = levels_m.front();
+  OfflineIndexHeader header = {};
+  memcpy(header.magic, offlineIndexMagic, sizeof(offlineIndexMagic));
+  header.version = OFFLINE_INDEX_VERSION;
+  header.channels = static_cast<uint32_t>(channels_m);
+  header.fileSize = fileSize_m;
+  header.fileMtime = fileMtime_m;
+  header.dataOffset = dataOffset_m;
+  header.blockCount = blocks_m.size();
+  header.blockRows = OFFLINE_BLOCK_ROWS;
+
+  indexFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  indexFile.write(reinterpret_cast<const char *>(blocks_m.data()),
+                  blocks_m.size() * sizeof(Block));
+  indexFile.write(reinterpret_cast<const char *>(level.minValues.data()),
+                  level.minValues.size() * sizeof(float));
+  indexFile.write(reinterpret_cast<const char *>(level.maxValues.data()),
+                  level.maxValues.size() * sizeof(float));
+}
+
+void OfflineRecording::prv_buildPyramid(void)
+{
+  while (levels_m.back().tStart.size() > 1)
+  {
+    const SummaryLevel &lower = levels_m.back();
+    size_t lowerCount = lower.tStart.size();
+    size_t count = (lowerCount + OFFLINE_PYRAMID_FANOUT - 1)
+                   / OFFLINE_PYRAMID_FANOUT;
+    SummaryLevel upper;
+
+    upper.tStart.resize(count);
+    upper.tEnd.resize(count);
+    upper.minValues.assign(count * channels_m,
+                           std::numeric_limits<float>::infinity());
+    upper.maxValues.assign(count * channels_m,
+                           -std::numeric_limits<float>::infinity());
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      size_t first = i * OFFLINE_PYRAMID_FANOUT;
+      size_t last = std::min(first + OFFLINE_PYRAMID_FANOUT, lowerCount) - 1;
+      upper.tStart[i] = lower.tStart[first];
+      upper.tEnd[i] = lower.tEnd[last];
+
+      for (size_t j = first; j <= last; ++j)
+      {
+        for (size_t ch = 0; ch < channels_m; ++ch)
+        {
+          float &minValue = upper.minValues[i * channels_m + ch];
+          float &maxValue = upper.maxValues[i * channels_m + ch];
+          minValue = std::min(minValue, lower.minValues[j * channels_m + ch]);
+          maxValue = std::max(maxValue, lower.maxValues[j * channels_m + ch]);
+        }
+      }
+    }
+
+    levels_m.push_back(std::move(upper));
+  }
+}
+
+std::shared_ptr<const OfflineRecording::ParsedBlock>
+OfflineRecording::prv_parseBlock(size_t blockIndex) const
+{
+  const Block &block = blocks_m[blockIndex];
+  auto parsed = std::make_shared<ParsedBlock>();
+  std::vector<float> rowValues(channels_m);
+
+  MappedRange range(fd_m, block.offset, block.length, MADV_WILLNEED);
+  if (!range.isValid())
+  {
+    return parsed;
+  }
+
+  parsed->time.reserve(block.rows);
+  parsed->values.reserve(static_cast<size_t>(block.rows) * channels_m);
+
+  const char *p = range.data();
+  const char *pEnd = p + block.length;
+  while (p < pEnd)
+  {
+    const char *pLineEnd
+        = static_cast<const char *>(memchr(p, '\n', pEnd - p));
+    if (pLineEnd == nullptr)
+    {
+      pLineEnd = pEnd;
+    }
+
+    double time;
+    if (prv_parseRow(p, pLineEnd, channels_m, time, rowValues.data()))
+    {
+      parsed->time.push_back(time);
+      parsed->values.insert(parsed->values.end(), rowValues.begin(),
+                            rowValues.end());
+    }
+
+    p = (pLineEnd < pEnd) ? pLineEnd + 1 : pEnd;
+  }
+
+  return parsed;
+}
+
+void OfflineRecording::prv_prefetch(size_t first, size_t last)
+{
+  if (blocks_m.empty() || first > last)
+  {
+    return;
+  }
+
+  /* Let the kernel start reading the whole range while we parse */
+  const Block &firstBlock = blocks_m[first];
+  const Block &lastBlock = blocks_m[last];
+  posix_fadvise(fd_m, static_cast<off_t>(firstBlock.offset),
+                static_cast<off_t>(lastBlock.offset + lastBlock.length
+                                   - firstBlock.offset),
+                POSIX_FADV_WILLNEED);
+
+  for (size_t i = first; i <= last; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lock(cacheMutex_m);
+      if (stopWorker_m || prefetchPending_m)
+      {
+        return; /* A newer request supersedes this one */
+      }
+      auto it = cache_m.find(i);
+      if (it != cache_m.end())
+      {
+        cacheOrder_m.splice(cacheOrder_m.begin(), cacheOrder_m,
+                            it->second.order);
+        continue;
+      }
+    }
+
+    std::shared_ptr<const ParsedBlock> parsed = prv_parseBlock(i);
+
+    std::lock_guard<std::mutex> lock(cacheMutex_m);
+    cacheOrder_m.push_front(i);
+    cache_m[i] = CacheEntry{parsed, cacheOrder_m.begin()};
+
+    while (cache_m.size() > OFFLINE_CACHE_BLOCKS)
+    {
+      cache_m.erase(cacheOrder_m.back());
+      cacheOrder_m.pop_back();
+    }
+  }
+}
+
+void OfflineRecording::prv_requestPrefetch(size_t first, size_t last)
+{
+  /* Never ask for more than the cache can hold alongside its margins */
+  size_t maxBlocks = OFFLINE_CACHE_BLOCKS / 2;
+  if (last - first + 1 > maxBlocks)
+  {
+    size_t center = first + (last - first) / 2;
+    first = center - maxBlocks / 2;
+    last = first + maxBlocks - 1;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex_m);
+    if (prefetchRequested_m && wantedFirst_m == first && wantedLast_m == last)
+    {
+      return;
+    }
+    wantedFirst_m = first;
+    wantedLast_m = last;
+    prefetchRequested_m = true;
+    prefetchPending_m = true;
+  }
+  cacheCondition_m.notify_one();
+}
+
+void OfflineRecording::query(double tBegin, double tEnd, int pixelWidth,
+                             OfflineView &view)
+{
+  view.channels.resize(channels_m);
+  for (OfflineTrace &trace : view.channels)
+  {
+    trace.time.clear();
+    trace.value.clear();
+  }
+  view.detailed = false;
+
+  if (!indexReady_m || blocks_m.empty() || !(tEnd > tBegin))
+  {
+    return;
+  }
+  pixelWidth = std::max(pixelWidth, 1);
+
+  /* Blocks overlapping [tBegin, tEnd], timestamps are monotonic */
+  auto firstIt = std::lower_bound(
+      blocks_m.begin(), blocks_m.end(), tBegin,
+      [](const Block &block, double t) { return block.tEnd < t; });
+  auto lastIt = std::upper_bound(
+      blocks_m.begin(), blocks_m.end(), tEnd,
+      [](double t, const Block &block) { return t < block.tStart; });
+  if (firstIt == blocks_m.end() || lastIt == blocks_m.begin()
+      || firstIt >= lastIt)
+  {
+    return;
+  }
+
+  size_t first = static_cast<size_t>(firstIt - blocks_m.begin());
+  size_t last = static_cast<size_t>(lastIt - blocks_m.begin()) - 1;
+  uint64_t rows = static_cast<uint64_t>(last - first + 1) * OFFLINE_BLOCK_ROWS;
+  uint64_t detailRows
+      = static_cast<uint64_t>(pixelWidth) * OFFLINE_DETAIL_ROWS_PER_PIXEL;
+
+  if (rows <= detailRows)
+  {
+    std::vector<std::shared_ptr<const ParsedBlock>> parsed;
+    parsed.reserve(last - first + 1);
+    {
+      std::lock_guard<std::mutex> lock(cacheMutex_m);
+      for (size_t i = first; i <= last; ++i)
+      {
+        auto it = cache_m.find(i);
+        if (it == cache_m.end())
+        {
+          break;
+        }
+        parsed.push_back(it->second.block);
+      }
+    }
+
+    prv_requestPrefetch(first, last);
+
+    if (parsed.size() == last - first + 1)
+    {
+      prv_queryDetail(parsed, tBegin, tEnd, pixelWidth, view);
+      view.detailed = true;
+      return;
+    }
+  }
+  else if (rows <= detailRows * OFFLINE_PREFETCH_ZOOM_FACTOR)
+  {
+    /* Close to the detail threshold, page the blocks in ahead of the zoom */
+    prv_requestPrefetch(first, last);
+  }
+
+  prv_querySummary(first, last, tBegin, tEnd, pixelWidth, view);
+}
+
+void OfflineRecording::prv_querySummary(size_t firstBlock, size_t lastBlock,
+                                        double tBegin, double tEnd,
+                                        int pixelWidth,
+                                        OfflineView &view) const
+{
+  /* Pick the coarsest level that still has a point per pixel */
+  size_t levelIndex = 0;
+  size_t first = firstBlock;
+  size_t last = lastBlock;
+  while (levelIndex + 1 < levels_m.size())
+  {
+    size_t upperFirst = first / OFFLINE_PYRAMID_FANOUT;
+    size_t upperLast = last / OFFLINE_PYRAMID_FANOUT;
+    if (upperLast - upperFirst + 1 < static_cast<size_t>(pixelWidth))
+    {
+      break;
+    }
+    first = upperFirst;
+    last = upperLast;
+    levelIndex++;
+  }
+
+  /* Coarser entries reach past the blocks asked for, only the ones within
+   * the window are kept */
+  const SummaryLevel &level = levels_m[levelIndex];
+  for (size_t ch = 0; ch < channels_m; ++ch)
+  {
+    OfflineTrace &trace = view.channels[ch];
+    trace.time.reserve(2 * (last - first + 1));
+    trace.value.reserve(2 * (last - first + 1));
+
+    for (size_t i = first; i <= last; ++i)
+    {
+      if (level.tEnd[i] < tBegin || level.tStart[i] > tEnd)
+      {
+        continue;
+      }
+      float minValue = level.minValues[i * channels_m + ch];
+      float maxValue = level.maxValues[i * channels_m + ch];
+      if (!(minValue <= maxValue))
+      {
+        continue; /* No value for this channel in the entry */
+      }
+
+      /* At the middle of the part of the entry within the window */
+      double time = 0.5
+                    * (std::max(level.tStart[i], tBegin)
+                       + std::min(level.tEnd[i], tEnd));
+      trace.time.push_back(time);
+      trace.value.push_back(minValue);
+      trace.time.push_back(time);
+      trace.value.push_back(maxValue);
+    }
+  }
+}
+
+void OfflineRecording::prv_queryDetail(
+    const std::vector<std::shared_ptr<const ParsedBlock>> &parsed,
+    double tBegin, double tEnd, int pixelWidth, OfflineView &view) const
+{
+  size_t totalRows = 0;
+  for (const auto &block : parsed)
+  {
+    totalRows += block->time.size();
+  }
+
+  /* Few enough rows to plot them all */
+  if (totalRows <= 2 * static_cast<size_t>(pixelWidth))
+  {
+    for (size_t ch = 0; ch < channels_m; ++ch)
+    {
+      OfflineTrace &trace = view.channels[ch];
+      for (const auto &block : parsed)
+      {
+        for (size_t row = 0; row < block->time.size(); ++row)
+        {
+          trace.time.push_back(block->time[row]);
+          trace.value.push_back(block->values[row * channels_m + ch]);
+        }
+      }
+    }
+    return;
+  }
+
+  /* Otherwise keep the min and max of every pixel column, in time order */
+  double bucketWidth = (tEnd - tBegin) / pixelWidth;
+  for (size_t ch = 0; ch < channels_m; ++ch)
+  {
+    OfflineTrace &trace = view.channels[ch];
+    long currentBucket = -1;
+    double minTime = 0.0;
+    double maxTime = 0.0;
+    float minValue = 0.0f;
+    float maxValue = 0.0f;
+    bool hasValue = false;
+
+    auto flush = [&]() {
+      if (!hasValue)
+      {
+        return;
+      }
+      bool minFirst = minTime <= maxTime;
+      trace.time.push_back(minFirst ? minTime : maxTime);
+      trace.value.push_back(minFirst ? minValue : maxValue);
+      trace.time.push_back(minFirst ? maxTime : minTime);
+      trace.value.push_back(minFirst ? maxValue : minValue);
+      hasValue = false;
+    };
+
+    for (const auto &block : parsed)
+    {
+      for (size_t row = 0; row < block->time.size(); ++row)
+      {
+        double time = block->time[row];
+        float value = block->values[row * channels_m + ch];
+        if (std::isnan(value))
+        {
+          continue;
+        }
+
+        long bucket = static_cast<long>((time - tBegin) / bucketWidth);
+        bucket = std::clamp(bucket, 0L, static_cast<long>(pixelWidth) - 1);
+        if (bucket != currentBucket)
+        {
+          flush();
+          currentBucket = bucket;
+        }
+
+        if (!hasValue)
+        {
+          minTime = maxTime = time;
+          minValue = maxValue = value;
+          hasValue = true;
+        }
+        else if (value < minValue)
+        {
+          minValue = value;
+          minTime = time;
+        }
+        else if (value > maxValue)
+        {
+          maxValue = value;
+          maxTime = time;
+        }
+      }
+    }
+    flush();
+  }
+}
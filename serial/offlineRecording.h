@@ -0,0 +1,194 @@
+/** @file      offlineRecording.h
+ *  @brief     Header file for the out-of-core recording reader.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/01/20
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef OFFLINE_RECORDING_H
+#define OFFLINE_RECORDING_H
+
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include "../Libraries/lib.h"
+
+/**
+ * @brief Plot-ready trace of a single channel for a visible time range.
+ *
+ * Points are either raw rows (when zoomed in far enough) or min/max pairs per
+ * pixel bucket, always ordered by time.
+ */
+struct OfflineTrace
+{
+  std::vector<double> time;
+  std::vector<double> value;
+};
+
+/**
+ * @brief Result of a range query on an offline recording.
+ */
+struct OfflineView
+{
+  std::vector<OfflineTrace> channels;
+  bool detailed = false; /* Built from raw rows instead of the summary index */
+};
+
+/**
+ * @brief Read-only view over a CSV recording that never loads it whole.
+ *
+ * The recording is split into blocks of a fixed number of rows. A block-level
+ * min/max summary index is built once (or read back from a sidecar file) and
+ * arranged as a pyramid so that any visible range can be served with a number
+ * of points proportional to the plot width, not to the file size. Raw rows are
+ * only parsed, through windowed mmap, for the blocks around the visible range
+ * by a background prefetch thread and kept in a bounded LRU cache.
+ */
+class OfflineRecording
+{
+public:
+  OfflineRecording();
+  ~OfflineRecording();
+
+  /**
+   * @brief Opens a recording and starts indexing it in the background.
+   * @param filename Path of the CSV recording
+   * @return Success, OpenError if the file cannot be read or InvalidData if
+   *         the header is not an mscope recording header.
+   */
+  OrbCode_t open(const std::string &filename);
+
+  /**
+   * @brief Stops the background thread and releases the file.
+   */
+  void close(void);
+
+  bool isOpen(void) const { return fd_m >= 0; }
+
+  /**
+   * @brief Checks whether the summary index is available for queries.
+   */
+  bool isIndexReady(void) const { return indexReady_m.load(); }
+
+  /**
+   * @brief Gets the indexing progress in the [0, 1] range.
+   */
+  float getIndexProgress(void) const { return indexProgress_m.load(); }
+
+  const std::string &getFilename(void) const { return filename_m; }
+
+  const std::vector<std::string> &getChannelNames(void) const
+  {
+    return channelNames_m;
+  }
+
+  uint64_t getFileSize(void) const { return fileSize_m; }
+
+  /* The following getters are only meaningful once the index is ready */
+  uint64_t getRowCount(void) const { return rowCount_m; }
+  double getStartTime(void) const;
+  double getEndTime(void) const;
+
+  /**
+   * @brief Builds the plot data for a visible time range.
+   *
+   * Never blocks on file I/O: when the raw blocks of the range are not cached
+   * yet they are requested from the prefetch thread and the summary index is
+   * used for this frame.
+   *
+   * @param tBegin Start of the visible range in seconds
+   * @param tEnd End of the visible range in seconds
+   * @param pixelWidth Width of the plot area in pixels
+   * @param view Output traces, reused between calls to avoid allocations
+   */
+  void query(double tBegin, double tEnd, int pixelWidth, OfflineView &view);
+
+private:
+  struct Block
+  {
+    uint64_t offset; /* Byte offset of the first row */
+    uint64_t length; /* Byte length of all rows of the block */
+    uint32_t rows;
+    uint32_t reserved;
+    double tStart;
+    double tEnd;
+  };
+
+  struct SummaryLevel
+  {
+    std::vector<double> tStart;
+    std::vector<double> tEnd;
+    std::vector<float> minValues; /* entry * channels + channel */
+    std::vector<float> maxValues;
+  };
+
+  struct ParsedBlock
+  {
+    std::vector<double> time;
+    std::vector<float> values; /* row * channels + channel */
+  };
+
+  struct CacheEntry
+  {
+    std::shared_ptr<const ParsedBlock> block;
+    std::list<size_t>::iterator order;
+  };
+
+  void prv_workerThread(void);
+  bool prv_buildIndex(void);
+  bool prv_loadIndexFile(void);
+  void prv_saveIndexFile(void) const;
+  void prv_buildPyramid(void);
+  std::shared_ptr<const ParsedBlock> prv_parseBlock(size_t blockIndex) const;
+  void prv_prefetch(size_t first, size_t last);
+  void prv_querySummary(size_t firstBlock, size_t lastBlock, double tBegin,
+                        double tEnd, int pixelWidth, OfflineView &view) const;
+  void prv_queryDetail(
+      const std::vector<std::shared_ptr<const ParsedBlock>> &parsed,
+      double tBegin, double tEnd, int pixelWidth, OfflineView &view) const;
+  void prv_requestPrefetch(size_t first, size_t last);
+  std::string prv_indexFilename(void) const;
+
+  std::string filename_m;
+  int fd_m;
+  uint64_t fileSize_m;
+  int64_t fileMtime_m;
+  uint64_t dataOffset_m; /* First byte after the header line */
+  size_t channels_m;
+  std::vector<std::string> channelNames_m;
+
+  /* Written by the worker before indexReady_m is published */
+  std::vector<Block> blocks_m;
+  std::vector<SummaryLevel> levels_m;
+  uint64_t rowCount_m;
+  std::atomic<bool> indexReady_m;
+  std::atomic<float> indexProgress_m;
+
+  /* Prefetch state and raw block cache, guarded by cacheMutex_m */
+  std::thread worker_m;
+  std::atomic<bool> stopWorker_m;
+  std::mutex cacheMutex_m;
+  std::condition_variable cacheCondition_m;
+  std::unordered_map<size_t, CacheEntry> cache_m;
+  std::list<size_t> cacheOrder_m; /* Most recently used first */
+  size_t wantedFirst_m;
+  size_t wantedLast_m;
+  bool prefetchPending_m;
+  bool prefetchRequested_m; /* wantedFirst_m/wantedLast_m hold a request */
+};
+
+#endif // OFFLINE_RECORDING_H
@@ -0,0 +1,75 @@
+/** @file      overloadPolicy.h
+ *  @brief     Header file for the overload policies and loss counters of the
+ *             acquisition stages.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/10
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef OVERLOAD_POLICY_H
+#define OVERLOAD_POLICY_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief What a stage does with new data when the next one is behind.
+ */
+typedef enum
+{
+  OVERLOAD_BLOCK = 0,       /* Waits, the stage before it backs up */
+  OVERLOAD_DROP_OLDEST = 1, /* Overwrites the oldest queued data */
+  OVERLOAD_DROP_NEWEST = 2, /* Discards the incoming data */
+  OVERLOAD_DECIMATE = 3,    /* Keeps a reduced version of the data */
+  OVERLOAD_POLICY_COUNT
+} OverloadPolicy_t;
+
+inline const char *getOverloadPolicyName(OverloadPolicy_t policy)
+{
+  switch (policy)
+  {
+  case OVERLOAD_BLOCK:
+    return "block";
+  case OVERLOAD_DROP_OLDEST:
+    return "drop-oldest";
+  case OVERLOAD_DROP_NEWEST:
+    return "drop-newest";
+  case OVERLOAD_DECIMATE:
+    return "decimate";
+  default:
+    return "?";
+  }
+}
+
+/**
+ * @brief Counters of one stage between the port and the consumers, in the
+ * unit the stage handles (bytes, frames or rows).
+ *
+ * in counts what reached the stage, out what it passed on and dropped what
+ * it lost to its overload policy (or, for the parser, to malformed
+ * messages). A stage that only stores data has no out. errors counts loss
+ * events the stage cannot size in its unit, such as UART overruns.
+ */
+struct StageStatistics
+{
+  std::string name;
+  const char *pUnit = "";
+  OverloadPolicy_t policy = OVERLOAD_BLOCK;
+  uint64_t in = 0;
+  uint64_t out = 0;
+  uint64_t dropped = 0;
+  uint64_t errors = 0; /* Events, not in pUnit */
+  size_t depth = 0;    /* Currently queued, when the stage has a queue */
+  size_t capacity = 0; /* 0 when the stage has no bounded queue */
+  bool available = true; /* False when the counters cannot be read */
+};
+
+#endif // OVERLOAD_POLICY_H
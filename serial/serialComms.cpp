@@ -13,8 +13,12 @@
  */
 
 #include "serialComms.h"
-#include "circularBuffer.h"
+#include "multiPortCapture.h"
+#include "connectionSupervisor.h"
+#include "acquisitionPipeline.h"
 #include "csvStorage.h"
+#include "shmPublisher.h"
+#include "../web/webServer.h"
 #include "../ui/serialSettings.h"
 #include "../ui/viewerSettings.h"
 #include "../ui/dataReceptionSettings.h"
@@ -23,324 +27,386 @@
 #include <mutex>
 #include "../ui/settings.h"
 #include <chrono>
-#include "../ui/serialTerminal.h"
+#include <iostream>
 
-// Raspberry Pi (Linux) includes
-#include <fcntl.h>
-#include <termios.h>
-#include <unistd.h>
-#include <dirent.h>  // Include for directory functions
-#include <algorithm> // Include for std::find
-static int hSerial;
+/* Longest wait for data before the thread checks for a stop */
+#define SERIAL_THREAD_POLL_MS (10)
+/* Period of the data loss log */
+#define LOSS_LOG_INTERVAL_S (1.0)
 
-#define NUMBERS_TO_RECEIVE (256)
-
-std::chrono::steady_clock::time_point startTime1
-    = std::chrono::steady_clock::now();
 std::atomic<bool> threadRunning{false};
-std::mutex bufferMutex;
-
-/* Strings to store received data */
-std::string g_receivedData = "0";
-std::string g_previousReceivedData = "0";
-CircularBuffer<char> circularBuffer(NUMBERS_TO_RECEIVE);
-std::vector<float> floatData;
 
-std::vector<std::vector<float>> channelsData;
-std::vector<float> xValues;
+/* Port opened from the serial settings */
+static SerialDevice primaryDevice;
+static ConnectionSupervisor primarySupervisor(primaryDevice);
+static bool primaryCallbackSet = false;
+static AcquisitionPipeline primaryPipeline(primaryDevice);
 
-/**
- * @brief Adds a new value to the end of the float vector, ensuring it does not
- * exceed a maximum size.
- *
- * If adding the new value exceeds the maximum size of the vector, the oldest
- * elements are removed from the beginning.
- *
- * @param floatVector Reference to the vector of floats.
- * @param newValue The new float value to add to the vector.
- */
-void prv_addToVector(std::vector<float> &floatVector, float newValue)
-{
-  /* Add new value to the end of the vector */
-  floatVector.push_back(newValue);
+/* Set from any thread, applied by the reader thread */
+static std::mutex acquisitionOptionsMutex;
+static AcquisitionOptions acquisitionOptions;
+static std::atomic<uint32_t> acquisitionOptionsGeneration{1};
+static uint32_t appliedOptionsGeneration = 0; /* Reader thread only */
 
-  /* Check if vector size exceeds maxSize */
-  if (floatVector.size() > viewerDataSize())
-  {
-    /* Calculate how many elements to erase (this will be the excess elements)
-     */
-    size_t elementsToRemove = floatVector.size() - viewerDataSize();
+/* Processing of the primary port, kept for the labels of its outputs */
+static std::mutex processingMutex;
+static std::shared_ptr<const ProcessingSchedule> pProcessingSchedule;
 
-    /* Erase the oldest elements from the beginning of the vector */
-    floatVector.erase(floatVector.begin(),
-                      floatVector.begin() + elementsToRemove);
-  }
-}
+/* Storage of the history channels, reader thread only */
+static std::vector<ChannelStorage> channelStorage;
+static TimeAxisStorage timeAxis;
+static HistoryRetention retention;
 
-void initializeChannelData(int numberOfChannels)
+void resetChannelsData()
 {
-  channelsData.clear();
-  if (numberOfChannels > 0)
+  /* Additional ports keep running on the same time base */
+  if (getCapturePortCount() == 0)
   {
-  channelsData.resize(numberOfChannels);
+    resetCaptureEpoch();
   }
+  primaryDevice.resetHistory();
 }
 
-void resetChannelsData()
+static void prv_setPrimaryCallback(void)
 {
-  startTime1 = std::chrono::steady_clock::now();
-  for (auto &channel : channelsData)
+  if (!primaryCallbackSet)
   {
-    channel.clear();
+    primaryDevice.setFrameCallback(
+        [](double time, const std::vector<float> &values)
+        { recordCaptureFrame(PRIMARY_CAPTURE_GROUP, time, values); });
+    primaryCallbackSet = true;
   }
-  xValues.clear();
 }
 
-// Raspberry Pi (Linux) implementation
-
-
-
 OrbCode_t openCOMPort(const std::string &comPortName, uint32_t baudRate,
                       uint8_t stopBits, uint8_t parity)
 {
-  // Ensure the comPortName is prefixed with /dev/
-  std::string devicePath = comPortName;
-  if (devicePath.find("/dev/") != 0)
-  {
-    devicePath = "/dev/" + devicePath;
-  }
-
-  // Open the serial port
-  hSerial = open(devicePath.c_str(), O_RDWR | O_NOCTTY | O_SYNC);
-  if (hSerial < 0)
-  {
-    std::cerr << "Error opening serial port: " << strerror(errno) << std::endl;
-    return OpenError;
-  }
+  prv_setPrimaryCallback();
+  return primarySupervisor.open(comPortName, baudRate, stopBits, parity);
+}
 
-  // Get current terminal attributes
-  struct termios tty;
-  if (tcgetattr(hSerial, &tty) != 0)
-  {
-    std::cerr << "Error getting serial port attributes: " << strerror(errno)
-              << std::endl;
-    close(hSerial);
-    return PortStateError;
-  }
+OrbCode_t openInputSource(std::unique_ptr<InputSource> pSource)
+{
+  prv_setPrimaryCallback();
+  return primaryDevice.open(std::move(pSource));
+}
 
-  // Clear struct for new port settings
-  memset(&tty, 0, sizeof(tty));
+void closeCOMPort(void)
+{
+  /* Also stops a reconnection in progress */
+  primarySupervisor.close();
+}
 
-  // Set Baud Rate
-  speed_t speed;
-  switch (baudRate)
+/* Applies the acquisition options changed since the last call, from the
+ * reader thread */
+static void prv_updateAcquisition(void)
+{
+  uint32_t generation = acquisitionOptionsGeneration.load();
+  if (generation == appliedOptionsGeneration)
   {
-    case 9600:
-      speed = B9600;
-      break;
-    case 19200:
-      speed = B19200;
-      break;
-    case 38400:
-      speed = B38400;
-      break;
-    case 57600:
-      speed = B57600;
-      break;
-    case 115200:
-      speed = B115200;
-      break;
-    default:
-      std::cerr << "Unsupported baud rate!" << std::endl;
-      close(hSerial);
-      return OpenError;
+    return;
   }
-  cfsetospeed(&tty, speed);
-  cfsetispeed(&tty, speed);
+  appliedOptionsGeneration = generation;
 
-  // Set the number of data bits
-  tty.c_cflag &= ~CSIZE;
-  tty.c_cflag |= CS8; // 8 data bits
+  AcquisitionOptions options = getAcquisitionOptions();
+  applyReaderThreadOptions(options);
 
-  // Set parity
-  if (parity == 0)
+  if (options.pipelined && !primaryPipeline.isRunning())
   {
-    tty.c_cflag &= ~PARENB; // No parity
+    primaryPipeline.start(options);
+    /* Queued behind the data read before the port was lost */
+    primarySupervisor.setGapHandler([](double time)
+                                    { primaryPipeline.insertGap(time); });
   }
-  else if (parity == 1)
+  else if (!options.pipelined && primaryPipeline.isRunning())
   {
-    tty.c_cflag |= PARENB;  // Enable parity
-    tty.c_cflag &= ~PARODD; // Even parity
+    primarySupervisor.setGapHandler(nullptr);
+    primaryPipeline.stop();
   }
-  else if (parity == 2)
+  else
   {
-    tty.c_cflag |= (PARENB | PARODD); // Odd parity
+    primaryPipeline.setOptions(options);
   }
+}
 
-  // Set stop bits
-  if (stopBits == 1)
-  {
-    tty.c_cflag &= ~CSTOPB; // 1 stop bit
-  }
-  else if (stopBits == 2)
-  {
-    tty.c_cflag |= CSTOPB; // 2 stop bits
-  }
+void setAcquisitionOptions(const AcquisitionOptions &options)
+{
+  std::lock_guard<std::mutex> lock(acquisitionOptionsMutex);
+  acquisitionOptions = options;
+  acquisitionOptionsGeneration++;
+}
 
-  tty.c_cflag
-      |= CREAD | CLOCAL; // Enable receiver and ignore modem control lines
+AcquisitionOptions getAcquisitionOptions(void)
+{
+  std::lock_guard<std::mutex> lock(acquisitionOptionsMutex);
+  return acquisitionOptions;
+}
 
-  // Set the timeout options
-  tty.c_cc[VTIME] = 0; // No timeout
-  tty.c_cc[VMIN] = 0;  // Non-blocking read
+void stopAcquisitionPipeline(void)
+{
+  primarySupervisor.setGapHandler(nullptr);
+  primaryPipeline.stop();
+  /* Started again, with the current options, by the next read */
+  appliedOptionsGeneration = 0;
+}
 
-  // Apply the configuration
-  if (tcsetattr(hSerial, TCSANOW, &tty) != 0)
-  {
-    std::cerr << "Error setting serial port attributes: " << strerror(errno)
-              << std::endl;
-    close(hSerial);
-    return PortStateError;
-  }
+bool isAcquisitionPipelineRunning(void)
+{
+  return primaryPipeline.isRunning();
+}
 
-  return Success;
+void getAcquisitionPipelineStatistics(PipelineStatistics &statistics)
+{
+  primaryPipeline.getStatistics(statistics);
 }
 
-void closeCOMPort(void)
+void setProcessingSchedule(std::shared_ptr<const ProcessingSchedule> pSchedule)
 {
-  close(hSerial);
+  std::lock_guard<std::mutex> lock(processingMutex);
+  pProcessingSchedule = pSchedule;
+  primaryDevice.setProcessing(std::move(pSchedule));
 }
 
-OrbCode_t readSerialData(void)
+std::shared_ptr<const ProcessingSchedule> getProcessingSchedule(void)
+{
+  std::lock_guard<std::mutex> lock(processingMutex);
+  return pProcessingSchedule;
+}
+
+static StageStatistics prv_stage(const char *pName, const char *pUnit,
+                                 OverloadPolicy_t policy, uint64_t in,
+                                 uint64_t out, uint64_t dropped)
+{
+  StageStatistics stage;
+  stage.name = pName;
+  stage.pUnit = pUnit;
+  stage.policy = policy;
+  stage.in = in;
+  stage.out = out;
+  stage.dropped = dropped;
+  return stage;
+}
+
+void getAcquisitionStages(std::vector<StageStatistics> &stages)
 {
-  char buffer[64];
-  ssize_t bytesRead;
-  char currentChar;
-  static bool startFlag = false;
-  int numberOfChannels = 0;
-  std::lock_guard<std::mutex> lock(bufferMutex);
+  stages.clear();
+
+  SerialStatistics serial;
+  primaryDevice.getStatistics(serial);
+
+  /* The UART keeps the bytes it has room for, it loses the incoming ones.
+   * The driver counts overrun events, not the bytes each one lost. */
+  stages.push_back(prv_stage("Driver (tty)", "bytes", OVERLOAD_DROP_NEWEST,
+                             serial.bytesReceived, serial.bytesReceived, 0));
+  stages.back().errors = serial.uartOverruns + serial.bufferOverruns;
+  stages.back().available = serial.driverCounters;
+
+  /* Kept after a stop, for a final report */
+  PipelineStatistics pipeline;
+  primaryPipeline.getStatistics(pipeline);
+  bool pipelined = primaryPipeline.isRunning() || pipeline.batches > 0;
+  if (pipelined)
+  {
+    stages.push_back(prv_stage("Read queue", "bytes", pipeline.overloadPolicy,
+                               pipeline.bytesQueued + pipeline.bytesDropped,
+                               pipeline.bytesParsed, pipeline.bytesDropped));
+    stages.back().depth = pipeline.parseQueueDepth;
+    stages.back().capacity = pipeline.slots;
+  }
+
+  /* Parsed on the reader (or parser) thread, malformed messages dropped */
+  stages.push_back(prv_stage("Parser", "frames", OVERLOAD_BLOCK,
+                             serial.framesReceived + serial.framesDropped,
+                             serial.framesReceived, serial.framesDropped));
 
-  numberOfChannels = getNumberOfChannels();
+  HistoryStatistics history;
+  primaryDevice.getHistory().getStatistics(history);
+  stages.push_back(prv_stage("History", "rows", OVERLOAD_DROP_OLDEST,
+                             history.rowsAppended, 0, history.rowsEvicted));
+  stages.back().depth = history.rows;
+  stages.back().capacity = history.limit;
 
-  // Initialize channelData if it hasn't been done or if the number of channels
-  // has changed
-  if (channelsData.size() != numberOfChannels)
+  if (pipelined)
   {
-    initializeChannelData(numberOfChannels);
+    stages.push_back(prv_stage("Record queue", "frames", OVERLOAD_BLOCK,
+                               pipeline.framesQueued,
+                               pipeline.framesDispatched, 0));
+    stages.back().depth = pipeline.recordQueueDepth;
+    stages.back().capacity = pipeline.slots;
   }
 
-  /* Read data from the serial port */
-  if (isSerialPortOpened())
+  /* Written by the consumer, a slow card backs the queues up */
+  uint64_t recorded = getCSVRecordedDataPoints();
+  uint64_t failed = getCSVFailedDataPoints();
+  stages.push_back(prv_stage("CSV writer", "rows", OVERLOAD_BLOCK,
+                             recorded + failed, recorded, failed));
+  stages.back().available = isCSVRecording();
+
+  /* Readers that lag behind the ring lose its oldest frames, on their side */
+  uint64_t shared = getSharedMemoryPublishedFrames();
+  stages.push_back(prv_stage("Shared memory", "frames", OVERLOAD_DROP_OLDEST,
+                             shared, shared, 0));
+  stages.back().available = isSharedMemoryPublishing();
+
+  stages.push_back(prv_stage("Web view", "frames", OVERLOAD_DECIMATE,
+                             getWebPublishedFrames(), 0, 0));
+  stages.back().available = isWebServerRunning();
+}
+
+void logAcquisitionLosses(void)
+{
+  /* Reader threads only */
+  static std::mutex logMutex;
+  static auto lastLog = std::chrono::steady_clock::now();
+  static std::vector<StageStatistics> previous;
+
+  std::lock_guard<std::mutex> lock(logMutex);
+  auto now = std::chrono::steady_clock::now();
+  if (std::chrono::duration<double>(now - lastLog).count()
+      < LOSS_LOG_INTERVAL_S)
+  {
+    return;
+  }
+  lastLog = now;
+
+  std::vector<StageStatistics> stages;
+  getAcquisitionStages(stages);
+  for (const StageStatistics &stage : stages)
   {
-    bytesRead = read(hSerial, buffer, sizeof(buffer));
-    if (bytesRead > 0)
+    if (stage.policy == OVERLOAD_DROP_OLDEST)
+    {
+      continue;
+    }
+
+    uint64_t before = 0;
+    uint64_t errorsBefore = 0;
+    for (const StageStatistics &old : previous)
     {
-      /* Push data into circular buffer */
-      for (ssize_t i = 0; i < bytesRead; ++i)
+      if (old.name == stage.name)
       {
-        currentChar = buffer[i];
-
-        /* Check if the character is a numerical digit */
-        if (currentChar > 0)
-        {
-          /* Push each character into the circular buffer */
-          circularBuffer.push(currentChar);
-        }
-        else
-        {
-          return InvalidData;
-        }
+        before = old.dropped;
+        errorsBefore = old.errors;
       }
     }
-    else if (bytesRead < 0)
+    /* Counters restart with the statistics or a new recording */
+    if (stage.dropped > before)
     {
-      // Handle read error
-      return ReadError;
+      std::cerr << "Data lost in " << stage.name << ": "
+                << stage.dropped - before << " " << stage.pUnit << " ("
+                << getOverloadPolicyName(stage.policy) << ")" << std::endl;
     }
-
-    /* Process data from circular buffer */
-    while (!circularBuffer.isEmpty())
+    if (stage.errors > errorsBefore)
     {
-      /* Pop character from circular buffer */
-      currentChar = circularBuffer.pop();
-      if (!startFlag && currentChar == '\n')
-      {
-        startFlag = true;
-        g_receivedData.clear(); /* Clear the buffer for the next data */
-        floatData.clear();
-      }
-
-      if (startFlag && currentChar == '\r')
-      {
-        /* End of line, store the received data */
-        float newData = std::stof(g_receivedData);
-        floatData.push_back(newData);
-        startFlag = false;
-
-        if (floatData.size() == numberOfChannels && numberOfChannels > 0)
-        {
-          for (int currentChannel = 0; currentChannel < numberOfChannels;
-               currentChannel++)
-          {
-            if (currentChannel < channelsData.size())
-          {
-            prv_addToVector(channelsData[currentChannel],
-                            floatData[currentChannel]);
-            }
-          }
-
-          std::chrono::steady_clock::time_point now
-              = std::chrono::steady_clock::now();
-          double elapsedTime
-              = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    now - startTime1)
-                    .count()
-                / 1000.0; // Convert to seconds
-          prv_addToVector(xValues, static_cast<float>(elapsedTime));
-
-          // Write data to CSV if recording is active
-          if (isCSVRecording())
-          {
-            writeCSVDataRow(elapsedTime, floatData);
-          }
-        }
-
-        return DataReceived;
-      }
-
-      if (startFlag && currentChar == ',')
-      {
-        try
-        {
-          float newData = std::stof(g_receivedData);
-          floatData.push_back(newData);
-        }
-        catch (const std::invalid_argument &e)
-        {
-          // Handle error: Received data contains non-numeric characters
-        }
-        catch (const std::out_of_range &e)
-        {
-          // Handle error: The value represented by the string is out of range
-        }
-        g_receivedData.clear(); /* Clear the buffer for the next data */
-      }
+      std::cerr << "Data lost in " << stage.name << ": "
+                << stage.errors - errorsBefore << " overrun events ("
+                << getOverloadPolicyName(stage.policy) << ")" << std::endl;
+    }
+  }
+  previous = std::move(stages);
+}
 
-      /* Check if the character is a digit, dot, or minus sign */
-      if (startFlag
-          && (isdigit(currentChar) || currentChar == '.' || currentChar == '-'))
-      {
-        /* Append the digit to the received data string */
-        g_receivedData += currentChar;
-      }
+OrbCode_t readSerialData(void)
+{
+  prv_updateAcquisition();
+
+  primaryDevice.setChannelCount(getNumberOfChannels());
+  primaryDevice.setHistoryLimit(viewerDataSize());
+  getChannelStorage(channelStorage);
+  primaryDevice.setHistoryStorage(channelStorage);
+  getTimeAxis(timeAxis);
+  primaryDevice.setHistoryTimeAxis(timeAxis);
+  getHistoryRetention(retention);
+  primaryDevice.setHistoryRetention(retention);
+
+  if (!primaryDevice.isOpen())
+  {
+    /* The history continues after the gap once the port is back */
+    if (primarySupervisor.getState() != CONNECTION_RECONNECTING)
+    {
+      resetChannelsData();
     }
+    return Success;
   }
-  else
+
+  OrbCode_t readCode = primaryPipeline.isRunning() ? primaryPipeline.read()
+                                                   : primaryDevice.read();
+  if (readCode == EndOfStream)
   {
-    resetChannelsData();
+    /* The writer is gone, the settings see the source as closed */
+    primaryDevice.close();
   }
+  primarySupervisor.reportResult(readCode);
+
+  return readCode;
+}
+
+OrbCode_t waitForSerialData(int timeoutMs)
+{
+  prv_updateAcquisition();
+
+  OrbCode_t waitCode = primaryDevice.wait(timeoutMs);
+  primarySupervisor.reportResult(waitCode);
+  return waitCode;
+}
+
+void superviseSerialConnection(void)
+{
+  primarySupervisor.supervise();
+}
+
+HistorySnapshot getChannelHistory(void)
+{
+  return primaryDevice.getHistory().snapshot();
+}
+
+HistorySnapshot getChannelHistoryTier(size_t level)
+{
+  return primaryDevice.getHistory().tierSnapshot(level);
+}
+
+bool isCOMPortOpen(void)
+{
+  return primaryDevice.isOpen();
+}
+
+bool isCOMPortReconnecting(void)
+{
+  return primarySupervisor.getState() == CONNECTION_RECONNECTING;
+}
+
+uint32_t getCOMPortReconnectAttempts(void)
+{
+  return primarySupervisor.getAttemptCount();
+}
+
+uint32_t getCOMPortReconnectCount(void)
+{
+  return primarySupervisor.getReconnectCount();
+}
 
-  return Success;
+void setSerialReconnectPolicy(const ReconnectPolicy &policy)
+{
+  primarySupervisor.setPolicy(policy);
+}
+
+ReconnectPolicy getSerialReconnectPolicy(void)
+{
+  return primarySupervisor.getPolicy();
+}
+
+void setChannelHistoryEnabled(bool enabled)
+{
+  primaryDevice.setHistoryEnabled(enabled);
+}
+
+void getSerialStatistics(SerialStatistics &statistics)
+{
+  primaryDevice.getStatistics(statistics);
+}
+
+void resetSerialStatistics(void)
+{
+  primaryDevice.resetStatistics();
 }
 
 void startSerialThread(void)
@@ -348,14 +414,24 @@ void startSerialThread(void)
   threadRunning = true;
   while (threadRunning)
   {
-    if (!isDataReceptionPaused())
+    /* Woken up as soon as data arrives, network sources can be much faster
+     * than a fixed polling rate */
+    OrbCode_t waitCode = waitForSerialData(SERIAL_THREAD_POLL_MS);
+
+    /* Always read, freezing the display never stops the acquisition */
+    readSerialData();
+    superviseSerialConnection();
+    logAcquisitionLosses();
+
+    // Sleep when nothing is waited on to prevent excessive CPU usage
+    if (waitCode == PortStateError || waitCode == ReadError)
     {
-      readSerialData();
+      std::this_thread::sleep_for(
+          std::chrono::milliseconds(SERIAL_THREAD_POLL_MS));
     }
-    
-    // Add sleep to prevent excessive CPU usage
-    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // 10ms sleep = 100Hz polling
   }
+
+  stopAcquisitionPipeline();
 }
 
 void endSerialThread(void)
@@ -19,17 +19,171 @@
 #include "../Libraries/lib.h"
 #include <string>
 #include <cstdint>
+#include "serialDevice.h"
+#include "connectionSupervisor.h"
+#include "acquisitionPipeline.h"
+#include "overloadPolicy.h"
 
-extern std::vector<std::vector<float>> channelsData;
-extern std::vector<float> xValues;
-
+/**
+ * @brief Opens and configures a serial port. The port is then reopened
+ * automatically after a disconnect or a stall (see ConnectionSupervisor) until
+ * closeCOMPort() is called.
+ *
+ * @param comPortName Device name, with or without the "/dev/" prefix
+ * @param baudRate Baud rate, from 9600 up to 2000000
+ * @param stopBits Number of stop bits (1 or 2)
+ * @param parity 0 for none, 1 for even and 2 for odd parity
+ * @return Success, OpenError, PortStateError or WrongBaudRate
+ */
 OrbCode_t openCOMPort(const std::string &comPortName, uint32_t baudRate,
                       uint8_t stopBits, uint8_t parity);
 
+/**
+ * @brief Opens any input source (pipe, socket, file replay...) in place of
+ * the serial port. It is then read exactly like a serial port.
+ *
+ * @return Success, or the error of InputSource::open().
+ */
+OrbCode_t openInputSource(std::unique_ptr<InputSource> pSource);
+
 void closeCOMPort(void);
 
 /**
- * @brief Starts a thread that continuously reads serial data until stopped.
+ * @brief Checks whether a serial port handle is currently open.
+ *
+ * @return true if openCOMPort() succeeded and closeCOMPort() was not called.
+ */
+bool isCOMPortOpen(void);
+
+/**
+ * @brief Checks whether the primary port was lost and is being reopened.
+ * isCOMPortOpen() is false meanwhile.
+ */
+bool isCOMPortReconnecting(void);
+
+/* Attempts of the reconnection in progress */
+uint32_t getCOMPortReconnectAttempts(void);
+
+/* Reconnections since the port was opened */
+uint32_t getCOMPortReconnectCount(void);
+
+void setSerialReconnectPolicy(const ReconnectPolicy &policy);
+
+ReconnectPolicy getSerialReconnectPolicy(void);
+
+/**
+ * @brief Sets how the primary port is acquired: pipelined or not, reader
+ * scheduling priority, CPU and memory locking.
+ *
+ * Can be called from any thread, the options are applied by the reader
+ * thread on its next waitForSerialData() or readSerialData().
+ */
+void setAcquisitionOptions(const AcquisitionOptions &options);
+
+AcquisitionOptions getAcquisitionOptions(void);
+
+/**
+ * @brief Processes and records everything the pipeline has already read,
+ * then stops its threads.
+ *
+ * Called by the reader thread when it stops reading. The pipeline restarts
+ * on the next read if the options still ask for it.
+ */
+void stopAcquisitionPipeline(void);
+
+bool isAcquisitionPipelineRunning(void);
+
+void getAcquisitionPipelineStatistics(PipelineStatistics &statistics);
+
+/**
+ * @brief Gets the counters of every stage the primary input goes through,
+ * from the UART driver to the live consumers, in data flow order.
+ *
+ * Each stage declares its overload policy and counts what it received,
+ * passed on and dropped, so that a loss under load can be located.
+ */
+void getAcquisitionStages(std::vector<StageStatistics> &stages);
+
+/**
+ * @brief Logs the data lost by each stage since the previous log, at most
+ * once per second. Called by the reader loops.
+ *
+ * The channel history, which keeps a bounded window by design, is not
+ * logged.
+ */
+void logAcquisitionLosses(void);
+
+/**
+ * @brief Sets the processing graph applied to the primary port, compiled with
+ * ProcessingGraph::compile(). Null turns the processing off.
+ *
+ * Takes effect with the next batch read. The channel history restarts when
+ * the number of displayed channels changes. Additional capture ports are
+ * never processed.
+ */
+void setProcessingSchedule(std::shared_ptr<const ProcessingSchedule> pSchedule);
+
+/* Schedule applied to the primary port, null when processing is off */
+std::shared_ptr<const ProcessingSchedule> getProcessingSchedule(void);
+
+/**
+ * @brief Detects a stalled or lost primary port and reopens it when due.
+ *
+ * Called by the reader loop after every wait/read cycle.
+ */
+void superviseSerialConnection(void);
+
+/**
+ * @brief Takes a snapshot of the primary port history for display.
+ *
+ * The snapshot references the stored chunks without copying them and stays
+ * valid, unchanged, while the acquisition continues.
+ */
+HistorySnapshot getChannelHistory(void);
+
+/**
+ * @brief Takes a snapshot of a long-term tier of the primary port history,
+ * level 1 being the finest. Empty when the tiers are disabled.
+ */
+HistorySnapshot getChannelHistoryTier(size_t level);
+
+/**
+ * @brief Waits until the serial port has data to read.
+ *
+ * @param timeoutMs Maximum time to wait in milliseconds
+ * @return DataReceived when data is available, TimeoutError when the timeout
+ *         expired or the wait was interrupted by a signal, ReadError when the
+ *         device reported an error and PortStateError when no port is open.
+ */
+OrbCode_t waitForSerialData(int timeoutMs);
+
+/**
+ * @brief Clears the channel history and restarts the time base, unless
+ * additional capture ports are running on it.
+ */
+void resetChannelsData(void);
+
+/**
+ * @brief Enables or disables the in-memory channel history used for plotting.
+ *
+ * Recording is not affected. The headless capture disables the history since
+ * nothing is ever displayed.
+ */
+void setChannelHistoryEnabled(bool enabled);
+
+/**
+ * @brief Gets a copy of the serial reception counters.
+ */
+void getSerialStatistics(SerialStatistics &statistics);
+
+/**
+ * @brief Resets all serial reception counters to zero.
+ */
+void resetSerialStatistics(void);
+
+/**
+ * @brief Starts a thread that continuously reads the primary port until
+ * stopped. Additional ports have their own reader threads.
  *
  * Sets a flag to indicate that the serial thread is running and enters a loop
  * to continuously read serial data until the thread is stopped.
@@ -50,12 +204,20 @@ void endSerialThread(void);
  * This function reads serial data from the serial port and processes it.
  * The received data is expected to be in a specific format where each message
  * starts with a '\r\n' sequence and ends with another '\r\n' sequence. The
- * function parses each received message and updates the provided string with
- * the parsed data.
+ * function parses every complete message received and stores it in the
+ * channel history and, when active, in the CSV recording.
+ *
+ * When the acquisition is pipelined (see setAcquisitionOptions()) it only
+ * reads: parsing and recording happen on the pipeline threads, and the
+ * result is Success as soon as the bytes are queued.
  *
  * @return An OrbCode value indicating the outcome of the operation:
  *         - Success: Operation completed successfully.
+ *         - DataReceived: At least one complete message was stored.
+ *         - InvalidData: Non-ASCII bytes were received and discarded.
+ *         - TimeoutError: Every pipeline slot is still in use, nothing read.
  *         - ReadError: An error occurred while reading serial data.
+ *         - EndOfStream: A pipe, socket or file source has no more data.
  *
  */
 OrbCode_t readSerialData(void);
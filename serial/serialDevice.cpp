@@ -0,0 +1,441 @@
+/** @file      serialDevice.cpp
+ *  @brief     Source file for the serial device reader.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/03
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "serialDevice.h"
+#include "serialPortSource.h"
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+/* Bytes read from the source at once, large enough for a batch of UDP
+ * datagrams */
+#define NUMBERS_TO_RECEIVE (64 * 1024)
+
+#define DEFAULT_HISTORY_LIMIT (1000)
+
+/* Longest interval the messages of one read are spread over: after a pause
+ * they arrived shortly before the read, not since the previous one */
+#define FRAME_SPREAD_MAX_SECONDS (0.1)
+
+/* Shared by all devices so that their frames can be correlated */
+static std::atomic<std::chrono::steady_clock::rep> captureEpoch{
+    std::chrono::steady_clock::now().time_since_epoch().count()};
+
+double getCaptureTime(void)
+{
+  std::chrono::steady_clock::duration elapsed
+      = std::chrono::steady_clock::now().time_since_epoch()
+        - std::chrono::steady_clock::duration(captureEpoch.load());
+  return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()
+         / 1000000.0; // Convert to seconds
+}
+
+void resetCaptureEpoch(void)
+{
+  captureEpoch = std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+SerialDevice::SerialDevice(void)
+  : open_m(false)
+  , lastFrameTime_m(0.0)
+  , driverCounters_m(false)
+  , readBuffer_m(NUMBERS_TO_RECEIVE)
+  , historyEnabled_m(true)
+  , previousTime_m(std::numeric_limits<double>::quiet_NaN())
+{
+  history_m.setLimit(DEFAULT_HISTORY_LIMIT);
+}
+
+SerialDevice::~SerialDevice()
+{
+  close();
+}
+
+OrbCode_t SerialDevice::open(const std::string &portName, uint32_t baudRate,
+                             uint8_t stopBits, uint8_t parity)
+{
+  return open(std::make_unique<SerialPortSource>(portName, baudRate, stopBits,
+                                                 parity));
+}
+
+OrbCode_t SerialDevice::open(std::unique_ptr<InputSource> pSource)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+
+  if (pSource_m)
+  {
+    return PortStateError;
+  }
+
+  OrbCode_t orbCode = pSource->isOpen() ? Success : pSource->open();
+  if (orbCode != Success)
+  {
+    return orbCode;
+  }
+
+  pSource_m = std::move(pSource);
+  portName_m = pSource_m->getName();
+  {
+    std::lock_guard<std::mutex> parserLock(parserMutex_m);
+    parser_m.reset();
+    previousTime_m = std::numeric_limits<double>::quiet_NaN();
+  }
+  open_m = true;
+
+  return Success;
+}
+
+void SerialDevice::close(void)
+{
+  /* Serialized with read() so the reader never uses a stale handle */
+  std::lock_guard<std::mutex> lock(mutex_m);
+  if (pSource_m)
+  {
+    InputStatistics sourceStatistics;
+    pSource_m->getStatistics(sourceStatistics);
+    closedStatistics_m.bytesReceived += sourceStatistics.bytesReceived;
+    closedStatistics_m.readCalls += sourceStatistics.readCalls;
+    closedStatistics_m.readErrors += sourceStatistics.readErrors;
+    prv_addDriverCounters(closedDriverCounters_m);
+    sourceDriverBase_m = DriverCounters();
+
+    /* Closed by its destructor, once a concurrent wait() has returned */
+    pSource_m.reset();
+  }
+  open_m = false;
+}
+
+OrbCode_t SerialDevice::wait(int timeoutMs)
+{
+  /* The wait itself is not under the mutex, the source is kept alive by this
+   * reference if it is closed meanwhile */
+  std::shared_ptr<InputSource> pSource;
+  {
+    std::lock_guard<std::mutex> lock(mutex_m);
+    pSource = pSource_m;
+  }
+
+  if (!pSource)
+  {
+    return PortStateError;
+  }
+  return pSource->wait(timeoutMs);
+}
+
+void SerialDevice::insertGap(double time, FrameBatch *pDeferred)
+{
+  std::lock_guard<std::mutex> lock(parserMutex_m);
+  if (pDeferred)
+  {
+    pDeferred->frames = 0;
+  }
+
+  /* The bytes before the gap never get the end of their last message */
+  parser_m.reset();
+  previousTime_m = time;
+
+  size_t historyChannels = parser_m.getChannelCount();
+  size_t recordChannels = historyChannels;
+  if (runner_m.isActive())
+  {
+    /* The filters restart after the gap instead of smoothing across it */
+    runner_m.reset();
+    historyChannels = runner_m.getDisplayChannelCount();
+    recordChannels = runner_m.getRecordChannelCount();
+  }
+
+  frames_m.assign(std::max(historyChannels, recordChannels),
+                  std::numeric_limits<float>::quiet_NaN());
+  if (historyEnabled_m && historyChannels > 0)
+  {
+    history_m.append(time, frames_m.data(), 1, historyChannels);
+  }
+
+  if (recordChannels == 0)
+  {
+    return;
+  }
+
+  if (pDeferred)
+  {
+    pDeferred->time = time;
+    pDeferred->span = 0.0;
+    pDeferred->channels = recordChannels;
+    pDeferred->frames = 1;
+    pDeferred->values.assign(frames_m.begin(),
+                             frames_m.begin() + recordChannels);
+  }
+  else
+  {
+    prv_dispatch(time, 0.0, frames_m.data(), 1, recordChannels);
+  }
+}
+
+void SerialDevice::prv_storeFrames(double time, double span, size_t frames,
+                                   FrameBatch *pDeferred)
+{
+  size_t channelCount = parser_m.getChannelCount();
+  lastFrameTime_m.store(time, std::memory_order_relaxed);
+
+  /* Without processing both outputs are the parsed messages */
+  const float *pHistory = frames_m.data();
+  size_t historyFrames = frames;
+  size_t historyChannels = channelCount;
+  const float *pRecord = frames_m.data();
+  size_t recordFrames = frames;
+  size_t recordChannels = channelCount;
+
+  if (runner_m.isActive())
+  {
+    runner_m.process(frames_m.data(), frames, channelCount);
+    pHistory = runner_m.getDisplayFrames();
+    historyFrames = runner_m.getDisplayFrameCount();
+    historyChannels = runner_m.getDisplayChannelCount();
+    pRecord = runner_m.getRecordFrames();
+    recordFrames = runner_m.getRecordFrameCount();
+    recordChannels = runner_m.getRecordChannelCount();
+  }
+
+  /* One lock and at most one chunk allocation per batch */
+  if (historyEnabled_m && historyFrames > 0)
+  {
+    history_m.append(time, pHistory, historyFrames, historyChannels, span);
+  }
+
+  if (pDeferred)
+  {
+    /* Within the capacity left by the previous batches, no allocation once
+     * the pipeline has warmed up */
+    pDeferred->time = time;
+    pDeferred->span = span;
+    pDeferred->channels = recordChannels;
+    pDeferred->frames = recordFrames;
+    pDeferred->values.assign(pRecord, pRecord + recordFrames * recordChannels);
+  }
+  else
+  {
+    prv_dispatch(time, span, pRecord, recordFrames, recordChannels);
+  }
+}
+
+void SerialDevice::prv_dispatch(double time, double span,
+                                const float *pValues, size_t frames,
+                                size_t channels)
+{
+  std::lock_guard<std::mutex> lock(callbackMutex_m);
+  if (!frameCallback_m)
+  {
+    return;
+  }
+
+  /* Same times as the history, see HistoryStore::append() */
+  double period = frames > 0 ? span / static_cast<double>(frames) : 0.0;
+  for (size_t frame = 0; frame < frames; ++frame)
+  {
+    frame_m.assign(pValues + frame * channels,
+                   pValues + (frame + 1) * channels);
+    frameCallback_m(time - static_cast<double>(frames - 1 - frame) * period,
+                    frame_m);
+  }
+}
+
+void SerialDevice::dispatchFrames(const FrameBatch &batch)
+{
+  prv_dispatch(batch.time, batch.span, batch.values.data(), batch.frames,
+               batch.channels);
+}
+
+OrbCode_t SerialDevice::readBytes(char *pBuffer, size_t capacity,
+                                  size_t &received, double &time)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+  received = 0;
+
+  if (!pSource_m)
+  {
+    return PortStateError;
+  }
+
+  OrbCode_t readCode = pSource_m->read(pBuffer, capacity, received);
+  time = getCaptureTime();
+  return readCode;
+}
+
+OrbCode_t SerialDevice::processBytes(const char *pData, size_t length,
+                                     double time, FrameBatch *pDeferred)
+{
+  std::lock_guard<std::mutex> lock(parserMutex_m);
+  OrbCode_t orbCode = Success;
+
+  if (pDeferred)
+  {
+    pDeferred->frames = 0;
+  }
+
+  uint64_t invalidBytes = parser_m.getStatistics().invalidBytes;
+
+  /* The messages completed since the previous read */
+  double span = 0.0;
+  if (!std::isnan(previousTime_m))
+  {
+    span = std::clamp(time - previousTime_m, 0.0, FRAME_SPREAD_MAX_SECONDS);
+  }
+  previousTime_m = time;
+
+  frames_m.clear();
+  size_t frames = parser_m.parse(pData, length, frames_m);
+  if (frames > 0)
+  {
+    prv_storeFrames(time, span, frames, pDeferred);
+    orbCode = DataReceived;
+  }
+
+  if (parser_m.getStatistics().invalidBytes != invalidBytes)
+  {
+    orbCode = InvalidData;
+  }
+
+  return orbCode;
+}
+
+OrbCode_t SerialDevice::read(void)
+{
+  size_t received = 0;
+  double time = 0.0;
+  OrbCode_t readCode
+      = readBytes(readBuffer_m.data(), readBuffer_m.size(), received, time);
+  if (readCode != Success)
+  {
+    return readCode;
+  }
+
+  return processBytes(readBuffer_m.data(), received, time);
+}
+
+void SerialDevice::setChannelCount(int channels)
+{
+  std::lock_guard<std::mutex> lock(parserMutex_m);
+  parser_m.setChannelCount(channels);
+}
+
+void SerialDevice::setProcessing(
+    std::shared_ptr<const ProcessingSchedule> pSchedule)
+{
+  std::lock_guard<std::mutex> lock(parserMutex_m);
+  runner_m.setSchedule(std::move(pSchedule));
+}
+
+void SerialDevice::setHistoryLimit(size_t samples)
+{
+  history_m.setLimit(samples);
+}
+
+void SerialDevice::setHistoryStorage(const std::vector<ChannelStorage> &storage)
+{
+  history_m.setStorage(storage);
+}
+
+void SerialDevice::setHistoryTimeAxis(const TimeAxisStorage &timeAxis)
+{
+  history_m.setTimeAxis(timeAxis);
+}
+
+void SerialDevice::setHistoryRetention(const HistoryRetention &retention)
+{
+  history_m.setRetention(retention);
+}
+
+void SerialDevice::setHistoryEnabled(bool enabled)
+{
+  std::lock_guard<std::mutex> lock(parserMutex_m);
+  historyEnabled_m = enabled;
+}
+
+void SerialDevice::resetHistory(void)
+{
+  history_m.clear();
+}
+
+void SerialDevice::setFrameCallback(FrameCallback callback)
+{
+  std::lock_guard<std::mutex> lock(callbackMutex_m);
+  frameCallback_m = std::move(callback);
+}
+
+void SerialDevice::prv_addDriverCounters(DriverCounters &total)
+{
+  /* mutex_m held. The source counts from its open, a reset restarts it */
+  DriverCounters counters;
+  if (!pSource_m || !pSource_m->getDriverCounters(counters))
+  {
+    return;
+  }
+  driverCounters_m = true;
+  total.overruns += counters.overruns - sourceDriverBase_m.overruns;
+  total.bufferOverruns
+      += counters.bufferOverruns - sourceDriverBase_m.bufferOverruns;
+  total.framingErrors
+      += counters.framingErrors - sourceDriverBase_m.framingErrors;
+  total.parityErrors += counters.parityErrors - sourceDriverBase_m.parityErrors;
+  total.breaks += counters.breaks - sourceDriverBase_m.breaks;
+}
+
+void SerialDevice::getStatistics(SerialStatistics &statistics)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+  InputStatistics sourceStatistics;
+  if (pSource_m)
+  {
+    pSource_m->getStatistics(sourceStatistics);
+  }
+  std::lock_guard<std::mutex> parserLock(parserMutex_m);
+  const ParserStatistics &parserStatistics = parser_m.getStatistics();
+
+  statistics.bytesReceived
+      = closedStatistics_m.bytesReceived + sourceStatistics.bytesReceived;
+  statistics.readErrors
+      = closedStatistics_m.readErrors + sourceStatistics.readErrors;
+  DriverCounters driverCounters = closedDriverCounters_m;
+  prv_addDriverCounters(driverCounters);
+  statistics.driverCounters = driverCounters_m;
+  statistics.uartOverruns = driverCounters.overruns;
+  statistics.bufferOverruns = driverCounters.bufferOverruns;
+  statistics.framingErrors = driverCounters.framingErrors;
+  statistics.parityErrors = driverCounters.parityErrors;
+
+  statistics.framesReceived = parserStatistics.framesReceived;
+  statistics.framesDropped = parserStatistics.framesDropped;
+  statistics.invalidBytes = parserStatistics.invalidBytes;
+  statistics.parseErrors = parserStatistics.parseErrors;
+}
+
+void SerialDevice::resetStatistics(void)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+  if (pSource_m)
+  {
+    pSource_m->resetStatistics();
+  }
+  closedStatistics_m = InputStatistics();
+  closedDriverCounters_m = DriverCounters();
+  driverCounters_m = false;
+  sourceDriverBase_m = DriverCounters();
+  if (pSource_m)
+  {
+    pSource_m->getDriverCounters(sourceDriverBase_m);
+  }
+  std::lock_guard<std::mutex> parserLock(parserMutex_m);
+  parser_m.resetStatistics();
+}
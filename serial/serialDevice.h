@@ -0,0 +1,269 @@
+/** @file      serialDevice.h
+ *  @brief     Header file for the serial device reader.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/03
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef SERIAL_DEVICE_H
+#define SERIAL_DEVICE_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <mutex>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include "../Libraries/lib.h"
+#include "inputSource.h"
+#include "frameParser.h"
+#include "historyStore.h"
+#include "../processing/processingSchedule.h"
+
+/**
+ * @brief Counters describing what happened to the bytes read from the port,
+ * combining the InputStatistics of the source and the ParserStatistics.
+ */
+struct SerialStatistics
+{
+  uint64_t bytesReceived = 0;  /* Bytes returned by read() */
+  uint64_t framesReceived = 0; /* Messages with the configured channel count */
+  uint64_t framesDropped = 0;  /* Messages with a wrong number of values */
+  uint64_t invalidBytes = 0;   /* Non-ASCII bytes discarded */
+  uint64_t parseErrors = 0;    /* Values that could not be converted */
+  uint64_t readErrors = 0;     /* Failed read() calls */
+
+  /* UART driver counters (TIOCGICOUNT), lost before read() */
+  bool driverCounters = false; /* Whether the port reports them */
+  uint64_t uartOverruns = 0;   /* UART FIFO full, port read too late */
+  uint64_t bufferOverruns = 0; /* tty buffer full, port read too late */
+  uint64_t framingErrors = 0;
+  uint64_t parityErrors = 0;
+};
+
+/**
+ * @brief Messages parsed from one read, waiting to be handed to the frame
+ * callback. They are evenly spread over (time - span, time], the last one at
+ * the time the read returned.
+ */
+struct FrameBatch
+{
+  double time = 0.0;
+  double span = 0.0;
+  size_t channels = 0;
+  size_t frames = 0;
+  std::vector<float> values; /* frame * channels + channel */
+};
+
+/**
+ * @brief Gets the shared host time base of all serial devices.
+ *
+ * @return Seconds elapsed since the capture epoch.
+ */
+double getCaptureTime(void);
+
+/**
+ * @brief Restarts the shared host time base at zero.
+ */
+void resetCaptureEpoch(void);
+
+/**
+ * @brief One input source with its own reader, parser and channel group.
+ *
+ * The source is usually a serial port but can be any InputSource. Every read
+ * is parsed as one batch: the complete messages ("\n v1,v2,...\r") it holds
+ * arrived since the previous read, they are timestamped evenly over that
+ * interval on the shared capture time base, the last one at the read time,
+ * appended to the device HistoryStore and handed to the frame callback (used
+ * for recording). Several devices can be read from different threads at
+ * the same time since they share no state.
+ *
+ * read() does all of this on the calling thread. It is also split in steps,
+ * readBytes(), processBytes() and dispatchFrames(), that an
+ * AcquisitionPipeline runs on separate threads. Each step has its own lock,
+ * so a slow consumer never holds up the next read.
+ */
+class SerialDevice
+{
+public:
+  using FrameCallback
+      = std::function<void(double time, const std::vector<float> &values)>;
+
+  SerialDevice(void);
+
+  ~SerialDevice();
+
+  SerialDevice(const SerialDevice &) = delete;
+  SerialDevice &operator=(const SerialDevice &) = delete;
+
+  /**
+   * @brief Opens and configures a serial port.
+   *
+   * @param portName Device name, with or without the "/dev/" prefix
+   * @param baudRate Baud rate, from 9600 up to 2000000
+   * @param stopBits Number of stop bits (1 or 2)
+   * @param parity 0 for none, 1 for even and 2 for odd parity
+   * @return Success, OpenError, PortStateError or WrongBaudRate
+   */
+  OrbCode_t open(const std::string &portName, uint32_t baudRate,
+                 uint8_t stopBits, uint8_t parity);
+
+  /**
+   * @brief Opens any input source and reads from it. A source opened
+   * beforehand, e.g. off the UI thread, is used as it is.
+   * @return Success, PortStateError if a source is already open, or the error
+   *         of InputSource::open().
+   */
+  OrbCode_t open(std::unique_ptr<InputSource> pSource);
+
+  void close(void);
+
+  bool isOpen(void) const { return open_m; }
+
+  /* Name of the current source, kept after it is closed */
+  const std::string &getPortName(void) const { return portName_m; }
+
+  /**
+   * @brief Waits until the port has data to read.
+   *
+   * @return DataReceived, TimeoutError (also when interrupted by a signal),
+   *         ReadError or PortStateError when the port is not open.
+   */
+  OrbCode_t wait(int timeoutMs);
+
+  /**
+   * @brief Reads the available bytes and processes every complete message.
+   *
+   * @return Success, DataReceived, InvalidData, ReadError or EndOfStream
+   *         when a pipe, socket or file source has no more data.
+   */
+  OrbCode_t read(void);
+
+  /**
+   * @brief Reader step, reads the available bytes without parsing them.
+   *
+   * @param pBuffer Destination of the bytes
+   * @param capacity Size of pBuffer
+   * @param received Number of bytes read
+   * @param time Capture time at which the read returned
+   * @return Success, ReadError, EndOfStream or PortStateError.
+   */
+  OrbCode_t readBytes(char *pBuffer, size_t capacity, size_t &received,
+                      double &time);
+
+  /**
+   * @brief Parser step, processes the bytes of one readBytes().
+   *
+   * The complete messages are stored in the history and, when pDeferred is
+   * null, handed to the frame callback. Otherwise they are copied into
+   * pDeferred for a later dispatchFrames(), possibly from another thread.
+   *
+   * @return Success, DataReceived or InvalidData, as read().
+   */
+  OrbCode_t processBytes(const char *pData, size_t length, double time,
+                         FrameBatch *pDeferred = nullptr);
+
+  /**
+   * @brief Consumer step, hands the messages of a batch to the frame callback.
+   */
+  void dispatchFrames(const FrameBatch &batch);
+
+  /* Bytes the reader step should be able to take at once */
+  size_t getReadSize(void) const { return readBuffer_m.size(); }
+
+  void setChannelCount(int channels);
+
+  int getChannelCount(void) const { return parser_m.getChannelCount(); }
+
+  /**
+   * @brief Runs the messages through a compiled processing graph: its display
+   * outputs are stored in the history and its record outputs handed to the
+   * frame callback. Null stores and hands over the messages as received.
+   */
+  void setProcessing(std::shared_ptr<const ProcessingSchedule> pSchedule);
+
+  /* Maximum number of samples kept per channel */
+  void setHistoryLimit(size_t samples);
+
+  /* Type, scale and offset of each history channel, see HistoryStore */
+  void setHistoryStorage(const std::vector<ChannelStorage> &storage);
+
+  /* Timestamp per sample or uniform time, see HistoryStore */
+  void setHistoryTimeAxis(const TimeAxisStorage &timeAxis);
+
+  /* Decimated long-term tiers, see HistoryStore */
+  void setHistoryRetention(const HistoryRetention &retention);
+
+  void setHistoryEnabled(bool enabled);
+
+  void resetHistory(void);
+
+  void setFrameCallback(FrameCallback callback);
+
+  /**
+   * @brief Marks a discontinuity with one all-NaN frame, stored in the history
+   * and handed to the frame callback like a received frame, so that plots and
+   * recordings show a gap instead of joining the data around it. A partially
+   * received message is dropped.
+   *
+   * @param pDeferred Batch receiving the gap frame instead of the callback,
+   *                  see processBytes()
+   */
+  void insertGap(double time, FrameBatch *pDeferred = nullptr);
+
+  /* Capture time of the last stored message, 0 before the first one */
+  double getLastFrameTime(void) const
+  {
+    return lastFrameTime_m.load(std::memory_order_relaxed);
+  }
+
+  void getStatistics(SerialStatistics &statistics);
+
+  void resetStatistics(void);
+
+  /* Channel history, read from other threads through snapshots */
+  const HistoryStore &getHistory(void) const { return history_m; }
+
+private:
+  void prv_addDriverCounters(DriverCounters &total);
+  void prv_storeFrames(double time, double span, size_t frames,
+                       FrameBatch *pDeferred);
+  void prv_dispatch(double time, double span, const float *pValues,
+                    size_t frames, size_t channels);
+
+  HistoryStore history_m;
+
+  /* Source and read buffer */
+  std::mutex mutex_m;
+  std::shared_ptr<InputSource> pSource_m; /* Also held by a pending wait() */
+  std::atomic<bool> open_m;
+  std::atomic<double> lastFrameTime_m;
+  std::string portName_m;
+  InputStatistics closedStatistics_m; /* Of the sources closed since reset */
+  DriverCounters closedDriverCounters_m;
+  DriverCounters sourceDriverBase_m; /* Of the open source at the reset */
+  bool driverCounters_m; /* A source since reset had driver counters */
+  std::vector<char> readBuffer_m;
+
+  /* Parser and the messages of the batch being processed */
+  std::mutex parserMutex_m;
+  bool historyEnabled_m;
+  double previousTime_m; /* Of the last read or gap, NaN after open */
+  FrameParser parser_m;
+  ProcessingRunner runner_m;
+  std::vector<float> frames_m;
+
+  std::mutex callbackMutex_m;
+  FrameCallback frameCallback_m;
+  std::vector<float> frame_m; /* One message handed to the callback */
+};
+
+#endif // SERIAL_DEVICE_H
@@ -0,0 +1,263 @@
+/** @file      serialPortSource.cpp
+ *  @brief     Source file for the serial port input source.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/10
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "serialPortSource.h"
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <set>
+
+// Raspberry Pi (Linux) includes
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+
+SerialPortSource::SerialPortSource(const std::string &portName,
+                                   uint32_t baudRate, uint8_t stopBits,
+                                   uint8_t parity)
+  : FileDescriptorSource(false)
+  , baudRate_m(baudRate)
+  , stopBits_m(stopBits)
+  , parity_m(parity)
+  , driverCounters_m(false)
+  , registered_m(false)
+{
+  name_m = portName;
+}
+
+/* Nodes of the ports open in this process, TIOCEXCL does not stop root */
+static std::mutex openPortsMutex;
+static std::set<std::string> openPorts;
+
+static std::string prv_stripDev(const std::string &name)
+{
+  return (name.compare(0, 5, "/dev/") == 0) ? name.substr(5) : name;
+}
+
+bool isSerialPortOpen(const std::string &name)
+{
+  std::lock_guard<std::mutex> lock(openPortsMutex);
+  return openPorts.count(prv_stripDev(name)) > 0;
+}
+
+SerialPortSource::~SerialPortSource()
+{
+  SerialPortSource::close();
+}
+
+std::string SerialPortSource::prv_nodeName(void) const
+{
+  return prv_stripDev(name_m);
+}
+
+void SerialPortSource::close(void)
+{
+  FileDescriptorSource::close();
+  if (registered_m)
+  {
+    std::lock_guard<std::mutex> lock(openPortsMutex);
+    openPorts.erase(prv_nodeName());
+    registered_m = false;
+  }
+}
+
+OrbCode_t SerialPortSource::open(void)
+{
+  // Ensure the portName is prefixed with /dev/
+  std::string devicePath = name_m;
+  if (devicePath.find("/dev/") != 0)
+  {
+    devicePath = "/dev/" + devicePath;
+  }
+
+  if (fd_m >= 0)
+  {
+    return PortStateError;
+  }
+
+  /* Two readers of one tty would each get part of its bytes */
+  {
+    std::lock_guard<std::mutex> lock(openPortsMutex);
+    if (!openPorts.insert(prv_nodeName()).second)
+    {
+      std::cerr << "Serial port already open: " << name_m << std::endl;
+      return PortStateError;
+    }
+    registered_m = true;
+  }
+
+  // Open the serial port
+  fd_m = ::open(devicePath.c_str(), O_RDWR | O_NOCTTY | O_SYNC);
+  if (fd_m < 0)
+  {
+    std::cerr << "Error opening serial port: " << strerror(errno) << std::endl;
+    close();
+    return OpenError;
+  }
+
+  // Further opens fail with EBUSY, other processes included
+  if (ioctl(fd_m, TIOCEXCL) != 0)
+  {
+    std::cerr << "Error locking serial port: " << strerror(errno) << std::endl;
+    close();
+    return OpenError;
+  }
+
+  // Get current terminal attributes
+  struct termios tty;
+  if (tcgetattr(fd_m, &tty) != 0)
+  {
+    std::cerr << "Error getting serial port attributes: " << strerror(errno)
+              << std::endl;
+    close();
+    return PortStateError;
+  }
+
+  // Clear struct for new port settings
+  memset(&tty, 0, sizeof(tty));
+
+  // Set Baud Rate
+  speed_t speed;
+  switch (baudRate_m)
+  {
+    case 9600:
+      speed = B9600;
+      break;
+    case 19200:
+      speed = B19200;
+      break;
+    case 38400:
+      speed = B38400;
+      break;
+    case 57600:
+      speed = B57600;
+      break;
+    case 115200:
+      speed = B115200;
+      break;
+    case 230400:
+      speed = B230400;
+      break;
+    case 460800:
+      speed = B460800;
+      break;
+    case 500000:
+      speed = B500000;
+      break;
+    case 921600:
+      speed = B921600;
+      break;
+    case 1000000:
+      speed = B1000000;
+      break;
+    case 2000000:
+      speed = B2000000;
+      break;
+    default:
+      std::cerr << "Unsupported baud rate!" << std::endl;
+      close();
+      return WrongBaudRate;
+  }
+  cfsetospeed(&tty, speed);
+  cfsetispeed(&tty, speed);
+
+  // Set the number of data bits
+  tty.c_cflag &= ~CSIZE;
+  tty.c_cflag |= CS8; // 8 data bits
+
+  // Set parity
+  if (parity_m == 0)
+  {
+    tty.c_cflag &= ~PARENB; // No parity
+  }
+  else if (parity_m == 1)
+  {
+    tty.c_cflag |= PARENB;  // Enable parity
+    tty.c_cflag &= ~PARODD; // Even parity
+  }
+  else if (parity_m == 2)
+  {
+    tty.c_cflag |= (PARENB | PARODD); // Odd parity
+  }
+
+  // Set stop bits
+  if (stopBits_m == 1)
+  {
+    tty.c_cflag &= ~CSTOPB; // 1 stop bit
+  }
+  else if (stopBits_m == 2)
+  {
+    tty.c_cflag |= CSTOPB; // 2 stop bits
+  }
+
+  tty.c_cflag
+      |= CREAD | CLOCAL; // Enable receiver and ignore modem control lines
+
+  // Set the timeout options
+  tty.c_cc[VTIME] = 0; // No timeout
+  tty.c_cc[VMIN] = 0;  // Non-blocking read
+
+  // Apply the configuration
+  if (tcsetattr(fd_m, TCSANOW, &tty) != 0)
+  {
+    std::cerr << "Error setting serial port attributes: " << strerror(errno)
+              << std::endl;
+    close();
+    return PortStateError;
+  }
+
+  // The driver counters are cumulative since the UART was registered
+  driverCounters_m = prv_readDriverCounters(baseline_m);
+
+  return Success;
+}
+
+bool SerialPortSource::prv_readDriverCounters(DriverCounters &counters) const
+{
+  struct serial_icounter_struct icount;
+  memset(&icount, 0, sizeof(icount));
+  if (fd_m < 0 || ioctl(fd_m, TIOCGICOUNT, &icount) != 0)
+  {
+    return false;
+  }
+
+  counters.overruns = static_cast<uint32_t>(icount.overrun);
+  counters.bufferOverruns = static_cast<uint32_t>(icount.buf_overrun);
+  counters.framingErrors = static_cast<uint32_t>(icount.frame);
+  counters.parityErrors = static_cast<uint32_t>(icount.parity);
+  counters.breaks = static_cast<uint32_t>(icount.brk);
+  return true;
+}
+
+bool SerialPortSource::getDriverCounters(DriverCounters &counters) const
+{
+  DriverCounters current;
+  if (!driverCounters_m || !prv_readDriverCounters(current))
+  {
+    return false;
+  }
+
+  /* 32-bit driver counters, wrap-safe differences */
+  counters.overruns = static_cast<uint32_t>(current.overruns - baseline_m.overruns);
+  counters.bufferOverruns
+      = static_cast<uint32_t>(current.bufferOverruns - baseline_m.bufferOverruns);
+  counters.framingErrors
+      = static_cast<uint32_t>(current.framingErrors - baseline_m.framingErrors);
+  counters.parityErrors
+      = static_cast<uint32_t>(current.parityErrors - baseline_m.parityErrors);
+  counters.breaks = static_cast<uint32_t>(current.breaks - baseline_m.breaks);
+  return true;
+}
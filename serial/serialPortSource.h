@@ -0,0 +1,67 @@
+/** @file      serialPortSource.h
+ *  @brief     Header file for the serial port input source.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/10
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef SERIAL_PORT_SOURCE_H
+#define SERIAL_PORT_SOURCE_H
+
+#include "inputSource.h"
+
+/**
+ * @brief Serial port configured through termios, read without blocking.
+ */
+class SerialPortSource : public FileDescriptorSource
+{
+public:
+  /**
+   * @param portName Device name, with or without the "/dev/" prefix
+   * @param baudRate Baud rate, from 9600 up to 2000000
+   * @param stopBits Number of stop bits (1 or 2)
+   * @param parity 0 for none, 1 for even and 2 for odd parity
+   */
+  SerialPortSource(const std::string &portName, uint32_t baudRate,
+                   uint8_t stopBits, uint8_t parity);
+
+  ~SerialPortSource() override;
+
+  /**
+   * @brief Opens the port for exclusive use (TIOCEXCL) and configures it.
+   * @return Success, OpenError, PortStateError or WrongBaudRate
+   */
+  OrbCode_t open(void) override;
+
+  void close(void) override;
+
+  /* TIOCGICOUNT counters since open(), pseudo-terminals have none */
+  bool getDriverCounters(DriverCounters &counters) const override;
+
+private:
+  bool prv_readDriverCounters(DriverCounters &counters) const;
+
+  std::string prv_nodeName(void) const;
+
+  uint32_t baudRate_m;
+  uint8_t stopBits_m;
+  uint8_t parity_m;
+  bool driverCounters_m;     /* Whether the driver supports TIOCGICOUNT */
+  DriverCounters baseline_m; /* Counters when the port was opened */
+  bool registered_m;         /* Listed as open in this process */
+};
+
+/**
+ * @brief Whether a serial port is open in this process.
+ * @param name Node name, with or without the "/dev/" prefix
+ */
+bool isSerialPortOpen(const std::string &name);
+
+#endif // SERIAL_PORT_SOURCE_H
@@ -0,0 +1,208 @@
+/** @file      shmPublisher.cpp
+ *  @brief     Source file for the shared-memory publication of live frames.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/17
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "shmPublisher.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static_assert(sizeof(MscopeShmHeader) == MSCOPE_SHM_HEADER_SIZE,
+              "Shared-memory header layout changed");
+static_assert(offsetof(MscopeShmHeader, writeIndex) == 64,
+              "writeIndex must start its own cache line");
+static_assert(sizeof(MscopeShmSlot) == 24, "Slot layout changed");
+
+// Global instance
+ShmPublisher g_shmPublisher;
+
+ShmPublisher::ShmPublisher()
+  : open_m(false)
+  , fd_m(-1)
+  , pBase_m(nullptr)
+  , size_m(0)
+  , pHeader_m(nullptr)
+  , writeIndex_m(0)
+{
+}
+
+ShmPublisher::~ShmPublisher()
+{
+  close();
+}
+
+OrbCode_t ShmPublisher::open(const std::string &name, uint32_t capacity,
+                             uint32_t maxChannels)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+
+  if (fd_m >= 0)
+  {
+    return PortStateError;
+  }
+
+  uint32_t slots = 1;
+  while (slots < capacity)
+  {
+    slots <<= 1;
+  }
+  uint32_t slotSize
+      = (sizeof(MscopeShmSlot) + maxChannels * sizeof(float) + 7) & ~7U;
+  size_t size = MSCOPE_SHM_HEADER_SIZE + static_cast<size_t>(slots) * slotSize;
+
+  fd_m = shm_open(name.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd_m < 0)
+  {
+    std::cerr << "Cannot create shared memory " << name << ": "
+              << strerror(errno) << std::endl;
+    return OpenError;
+  }
+
+  /* Attached readers keep a valid mapping as long as the size is unchanged */
+  struct stat fileStat;
+  if (fstat(fd_m, &fileStat) != 0
+      || (static_cast<size_t>(fileStat.st_size) != size
+          && ftruncate(fd_m, size) != 0))
+  {
+    std::cerr << "Cannot size shared memory " << name << ": "
+              << strerror(errno) << std::endl;
+    ::close(fd_m);
+    fd_m = -1;
+    return OpenError;
+  }
+
+  void *pMapping
+      = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_m, 0);
+  if (pMapping == MAP_FAILED)
+  {
+    ::close(fd_m);
+    fd_m = -1;
+    return OpenError;
+  }
+
+  pBase_m = static_cast<uint8_t *>(pMapping);
+  pHeader_m = reinterpret_cast<MscopeShmHeader *>(pBase_m);
+  size_m = size;
+  name_m = name;
+
+  /* Clear the slot sequences before readers can use the new generation */
+  uint64_t generation = (pHeader_m->magic == MSCOPE_SHM_MAGIC)
+                            ? pHeader_m->generation + 1
+                            : 1;
+  __atomic_store_n(&pHeader_m->writeIndex, 0, __ATOMIC_RELEASE);
+  for (uint32_t i = 0; i < slots; ++i)
+  {
+    MscopeShmSlot *pSlot = reinterpret_cast<MscopeShmSlot *>(
+        pBase_m + MSCOPE_SHM_HEADER_SIZE + static_cast<size_t>(i) * slotSize);
+    __atomic_store_n(&pSlot->sequence, 0, __ATOMIC_RELAXED);
+  }
+
+  pHeader_m->version = MSCOPE_SHM_VERSION;
+  pHeader_m->headerSize = MSCOPE_SHM_HEADER_SIZE;
+  pHeader_m->slotSize = slotSize;
+  pHeader_m->capacity = slots;
+  pHeader_m->maxChannels = maxChannels;
+  __atomic_store_n(&pHeader_m->generation, generation, __ATOMIC_RELEASE);
+  __atomic_store_n(&pHeader_m->magic, MSCOPE_SHM_MAGIC, __ATOMIC_RELEASE);
+
+  writeIndex_m = 0;
+  open_m = true;
+
+  return Success;
+}
+
+void ShmPublisher::close(void)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+
+  open_m = false;
+  if (pBase_m != nullptr)
+  {
+    munmap(pBase_m, size_m);
+    pBase_m = nullptr;
+    pHeader_m = nullptr;
+  }
+  if (fd_m >= 0)
+  {
+    ::close(fd_m);
+    fd_m = -1;
+  }
+}
+
+void ShmPublisher::publish(uint32_t group, double time,
+                           const std::vector<float> &values)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+
+  if (pHeader_m == nullptr)
+  {
+    return;
+  }
+
+  uint64_t index = writeIndex_m.load(std::memory_order_relaxed);
+  uint8_t *pSlotBase = pBase_m + MSCOPE_SHM_HEADER_SIZE
+                       + (index & (pHeader_m->capacity - 1))
+                             * static_cast<size_t>(pHeader_m->slotSize);
+  MscopeShmSlot *pSlot = reinterpret_cast<MscopeShmSlot *>(pSlotBase);
+  uint32_t channels = std::min<size_t>(values.size(), pHeader_m->maxChannels);
+
+  /* Odd sequence while the slot is being written */
+  __atomic_store_n(&pSlot->sequence, 2 * index + 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  pSlot->time = time;
+  pSlot->group = group;
+  pSlot->channels = channels;
+  memcpy(pSlotBase + sizeof(MscopeShmSlot), values.data(),
+         channels * sizeof(float));
+
+  __atomic_store_n(&pSlot->sequence, 2 * index + 2, __ATOMIC_RELEASE);
+  __atomic_store_n(&pHeader_m->writeIndex, index + 1, __ATOMIC_RELEASE);
+  writeIndex_m.store(index + 1, std::memory_order_relaxed);
+}
+
+OrbCode_t startSharedMemoryPublishing(const std::string &name)
+{
+  return g_shmPublisher.open(name, SHM_DEFAULT_CAPACITY,
+                             SHM_DEFAULT_MAX_CHANNELS);
+}
+
+void stopSharedMemoryPublishing(void)
+{
+  g_shmPublisher.close();
+}
+
+bool isSharedMemoryPublishing(void)
+{
+  return g_shmPublisher.isOpen();
+}
+
+void publishSharedMemoryFrame(uint32_t group, double time,
+                              const std::vector<float> &values)
+{
+  if (g_shmPublisher.isOpen())
+  {
+    g_shmPublisher.publish(group, time, values);
+  }
+}
+
+uint64_t getSharedMemoryPublishedFrames(void)
+{
+  return g_shmPublisher.getPublishedFrames();
+}
@@ -0,0 +1,88 @@
+/** @file      shmPublisher.h
+ *  @brief     Header file for the shared-memory publication of live frames.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/17
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef SHM_PUBLISHER_H
+#define SHM_PUBLISHER_H
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include "../Libraries/lib.h"
+#include "../shm/mscopeShm.h"
+
+#define SHM_DEFAULT_CAPACITY (16384)
+#define SHM_DEFAULT_MAX_CHANNELS (16)
+
+/**
+ * @brief Single writer of the shared-memory frame ring described in
+ * mscopeShm.h.
+ *
+ * Publishing a frame is a copy into the mapped slot and two atomic stores,
+ * readers never make it wait. The ring is left in place when publishing stops
+ * so attached readers survive a restart, they see a new generation.
+ */
+class ShmPublisher
+{
+public:
+  ShmPublisher();
+  ~ShmPublisher();
+
+  /**
+   * @brief Creates (or reuses) and maps the ring.
+   * @param name Shared-memory object name, e.g. "/mscope"
+   * @param capacity Number of frames kept, rounded up to a power of two
+   * @param maxChannels Values stored per frame, extra ones are dropped
+   * @return Success, OpenError or PortStateError if already open
+   */
+  OrbCode_t open(const std::string &name, uint32_t capacity,
+                 uint32_t maxChannels);
+
+  void close(void);
+
+  bool isOpen(void) const { return open_m.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Publishes a frame, safe to call from several reader threads.
+   */
+  void publish(uint32_t group, double time, const std::vector<float> &values);
+
+  uint64_t getPublishedFrames(void) const { return writeIndex_m.load(); }
+
+  const std::string &getName(void) const { return name_m; }
+
+private:
+  std::mutex mutex_m;
+  std::atomic<bool> open_m;
+  std::string name_m;
+  int fd_m;
+  uint8_t *pBase_m;
+  size_t size_m;
+  MscopeShmHeader *pHeader_m;
+  std::atomic<uint64_t> writeIndex_m;
+};
+
+// Global instance
+extern ShmPublisher g_shmPublisher;
+
+// Global functions for easy access
+OrbCode_t startSharedMemoryPublishing(const std::string &name);
+void stopSharedMemoryPublishing(void);
+bool isSharedMemoryPublishing(void);
+void publishSharedMemoryFrame(uint32_t group, double time,
+                              const std::vector<float> &values);
+uint64_t getSharedMemoryPublishedFrames(void);
+
+#endif // SHM_PUBLISHER_H
@@ -0,0 +1,150 @@
+/** @file      spscQueue.h
+ *  @brief     Bounded lock-free single-producer single-consumer queue.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/03
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstddef>
+
+/* Keeps the producer and consumer indexes on separate cache lines */
+#define SPSC_CACHE_LINE (64)
+
+/**
+ * @brief Fixed-capacity ring between exactly one producer thread and one
+ * consumer thread.
+ *
+ * push() and pop() never block and never allocate. A consumer that finds the
+ * queue empty can sleep in waitForData(): the mutex is only taken when it is
+ * actually sleeping, so a busy pipeline runs without any lock.
+ */
+template<typename T>
+class SpscQueue
+{
+public:
+  /* The capacity is rounded up to a power of two */
+  explicit SpscQueue(size_t capacity)
+    : head_m(0)
+    , tail_m(0)
+    , sleeping_m(false)
+  {
+    size_t size = 2;
+    while (size < capacity)
+    {
+      size <<= 1;
+    }
+    elements_m.resize(size);
+    mask_m = size - 1;
+  }
+
+  SpscQueue(const SpscQueue &) = delete;
+  SpscQueue &operator=(const SpscQueue &) = delete;
+
+  /* Producer side, false when the queue is full */
+  bool push(const T &element)
+  {
+    size_t head = head_m.load(std::memory_order_relaxed);
+    if (head - tail_m.load(std::memory_order_acquire) > mask_m)
+    {
+      return false;
+    }
+
+    elements_m[head & mask_m] = element;
+    head_m.store(head + 1, std::memory_order_seq_cst);
+
+    /* Ordered after the head store, see waitForData() */
+    if (sleeping_m.load(std::memory_order_seq_cst))
+    {
+      std::lock_guard<std::mutex> lock(mutex_m);
+      condition_m.notify_one();
+    }
+    return true;
+  }
+
+  /* Consumer side, false when the queue is empty */
+  bool pop(T &element)
+  {
+    size_t tail = tail_m.load(std::memory_order_relaxed);
+    if (tail == head_m.load(std::memory_order_acquire))
+    {
+      return false;
+    }
+
+    element = elements_m[tail & mask_m];
+    tail_m.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Consumer side, sleeps until an element is pushed, wake() is called
+   * or the timeout expires.
+   * @return true when the queue is not empty.
+   */
+  bool waitForData(int timeoutMs)
+  {
+    if (!empty())
+    {
+      return true;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_m);
+    /* Set before the emptiness is checked again: a push either sees it and
+     * notifies, or happened before and is seen by the check */
+    sleeping_m.store(true, std::memory_order_seq_cst);
+    condition_m.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                         [this] { return !empty() || woken_m; });
+    sleeping_m.store(false, std::memory_order_relaxed);
+    woken_m = false;
+    return !empty();
+  }
+
+  /* Interrupts a waitForData(), from any thread */
+  void wake(void)
+  {
+    std::lock_guard<std::mutex> lock(mutex_m);
+    woken_m = true;
+    condition_m.notify_one();
+  }
+
+  bool empty(void) const
+  {
+    return head_m.load(std::memory_order_seq_cst)
+           == tail_m.load(std::memory_order_acquire);
+  }
+
+  /* Approximate when called concurrently */
+  size_t size(void) const
+  {
+    return head_m.load(std::memory_order_acquire)
+           - tail_m.load(std::memory_order_acquire);
+  }
+
+  size_t capacity(void) const { return mask_m + 1; }
+
+private:
+  alignas(SPSC_CACHE_LINE) std::atomic<size_t> head_m; /* Next push */
+  alignas(SPSC_CACHE_LINE) std::atomic<size_t> tail_m; /* Next pop */
+  alignas(SPSC_CACHE_LINE) std::atomic<bool> sleeping_m;
+  bool woken_m = false;
+  std::vector<T> elements_m;
+  size_t mask_m;
+  std::mutex mutex_m;
+  std::condition_variable condition_m;
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,159 @@
+/** @file      timeAlignedMerger.cpp
+ *  @brief     Source file for the merge of several channel groups into rows.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/03
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "timeAlignedMerger.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/* A group without frames for this long no longer delays the grid rows */
+#define MERGER_SILENCE_TIMEOUT_S (1.0)
+
+static const float NOT_A_NUMBER = std::numeric_limits<float>::quiet_NaN();
+
+TimeAlignedMerger::TimeAlignedMerger()
+  : columns_m(0)
+  , gridPeriod_m(0.0)
+  , nextGridTime_m(NAN)
+{
+}
+
+void TimeAlignedMerger::configure(const std::vector<int> &groupChannels,
+                                  double gridPeriod, RowCallback callback)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+
+  groups_m.clear();
+  columns_m = 0;
+  for (int channels : groupChannels)
+  {
+    Group group;
+    group.offset = columns_m;
+    group.channels = channels;
+    group.latest = NAN;
+    groups_m.push_back(group);
+    columns_m += channels;
+  }
+
+  gridPeriod_m = gridPeriod > 0.0 ? gridPeriod : 0.0;
+  nextGridTime_m = NAN;
+  callback_m = std::move(callback);
+  row_m.assign(columns_m, NOT_A_NUMBER);
+}
+
+void TimeAlignedMerger::push(size_t group, double time,
+                             const std::vector<float> &values)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+
+  if (group >= groups_m.size() || !callback_m)
+  {
+    return;
+  }
+
+  Group &current = groups_m[group];
+  size_t count = std::min(values.size(), static_cast<size_t>(current.channels));
+
+  if (gridPeriod_m == 0.0)
+  {
+    /* One row per frame, only the columns of the group are set */
+    std::fill(row_m.begin(), row_m.end(), NOT_A_NUMBER);
+    std::copy(values.begin(), values.begin() + count,
+              row_m.begin() + current.offset);
+    callback_m(time, row_m);
+    return;
+  }
+
+  Sample sample;
+  sample.time = time;
+  sample.values.assign(current.channels, NOT_A_NUMBER);
+  std::copy(values.begin(), values.begin() + count, sample.values.begin());
+  current.samples.push_back(std::move(sample));
+  current.latest = time;
+
+  if (std::isnan(nextGridTime_m))
+  {
+    nextGridTime_m = std::ceil(time / gridPeriod_m) * gridPeriod_m;
+  }
+
+  prv_emitGrid(time);
+}
+
+void TimeAlignedMerger::prv_interpolate(const Group &group, double time)
+{
+  const std::deque<Sample> &samples = group.samples;
+
+  /* No extrapolation, a group only covers the span of its own frames */
+  if (samples.empty() || time < samples.front().time
+      || time > samples.back().time)
+  {
+    return;
+  }
+
+  size_t upper = 0;
+  while (upper < samples.size() && samples[upper].time < time)
+  {
+    upper++;
+  }
+
+  const Sample &after = samples[upper];
+  if (after.time == time || upper == 0)
+  {
+    std::copy(after.values.begin(), after.values.end(),
+              row_m.begin() + group.offset);
+    return;
+  }
+
+  const Sample &before = samples[upper - 1];
+  double weight = (time - before.time) / (after.time - before.time);
+  for (int ch = 0; ch < group.channels; ++ch)
+  {
+    row_m[group.offset + ch] = static_cast<float>(
+        before.values[ch] + (after.values[ch] - before.values[ch]) * weight);
+  }
+}
+
+void TimeAlignedMerger::prv_emitGrid(double now)
+{
+  /* Grid rows can be emitted up to the oldest latest frame of live groups */
+  double horizon = now;
+  for (const Group &group : groups_m)
+  {
+    if (!std::isnan(group.latest)
+        && now - group.latest < MERGER_SILENCE_TIMEOUT_S)
+    {
+      horizon = std::min(horizon, group.latest);
+    }
+  }
+
+  while (nextGridTime_m <= horizon)
+  {
+    std::fill(row_m.begin(), row_m.end(), NOT_A_NUMBER);
+    for (const Group &group : groups_m)
+    {
+      prv_interpolate(group, nextGridTime_m);
+    }
+    callback_m(nextGridTime_m, row_m);
+    nextGridTime_m += gridPeriod_m;
+  }
+
+  /* Keep only the frame before the next grid time and the ones after it */
+  for (Group &group : groups_m)
+  {
+    while (group.samples.size() > 1 && group.samples[1].time <= nextGridTime_m)
+    {
+      group.samples.pop_front();
+    }
+  }
+}
@@ -0,0 +1,85 @@
+/** @file      timeAlignedMerger.h
+ *  @brief     Header file for the merge of several channel groups into rows.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/03
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef TIME_ALIGNED_MERGER_H
+#define TIME_ALIGNED_MERGER_H
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <functional>
+
+/**
+ * @brief Merges the frames of several channel groups into single rows.
+ *
+ * Every group owns a fixed range of columns of the merged row. Without a grid
+ * each frame produces one row where only the columns of its group are set and
+ * the others are NaN. With a grid the groups are linearly interpolated at
+ * multiples of the grid period, and a grid row is only emitted once every live
+ * group has produced a frame past it. Groups silent for longer than the
+ * silence timeout stop holding back the others and read as NaN.
+ */
+class TimeAlignedMerger
+{
+public:
+  using RowCallback
+      = std::function<void(double time, const std::vector<float> &row)>;
+
+  TimeAlignedMerger();
+
+  /**
+   * @brief Sets the group layout and resets the merge state.
+   *
+   * @param groupChannels Number of channels of every group, in column order
+   * @param gridPeriod Period of the common grid in seconds, 0 to disable
+   * @param callback Called with every merged row, under the merger lock
+   */
+  void configure(const std::vector<int> &groupChannels, double gridPeriod,
+                 RowCallback callback);
+
+  /**
+   * @brief Adds a frame of a group. Frames of a group must be in time order.
+   */
+  void push(size_t group, double time, const std::vector<float> &values);
+
+  int getColumnCount(void) const { return columns_m; }
+
+private:
+  struct Sample
+  {
+    double time;
+    std::vector<float> values;
+  };
+
+  struct Group
+  {
+    int offset;
+    int channels;
+    double latest; /* Time of the last frame, NaN before the first one */
+    std::deque<Sample> samples;
+  };
+
+  void prv_emitGrid(double now);
+  void prv_interpolate(const Group &group, double time);
+
+  std::mutex mutex_m;
+  std::vector<Group> groups_m;
+  int columns_m;
+  double gridPeriod_m;
+  double nextGridTime_m;
+  RowCallback callback_m;
+  std::vector<float> row_m;
+};
+
+#endif // TIME_ALIGNED_MERGER_H
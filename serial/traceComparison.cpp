@@ -0,0 +1,165 @@
+/** @file      traceComparison.cpp
+ *  @brief     Source file for the comparison of a history with a reference.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/13
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "traceComparison.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/* Rows of one channel of a snapshot in time order, one segment converted at a
+ * time, the repeated first row of each segment skipped */
+class RowReader
+{
+public:
+  RowReader(const HistorySnapshot &history, size_t channel)
+    : history_m(history)
+    , channel_m(channel)
+    , segment_m(0)
+    , row_m(0)
+    , rows_m(0)
+    , pValues_m(nullptr)
+  {
+  }
+
+  bool next(double &time, float &value)
+  {
+    while (row_m >= rows_m)
+    {
+      if (segment_m >= history_m.getSegmentCount())
+      {
+        return false;
+      }
+      prv_load(segment_m++);
+    }
+    time = times_m[row_m];
+    value = pValues_m[row_m];
+    row_m++;
+    return true;
+  }
+
+private:
+  void prv_load(size_t segment)
+  {
+    history_m.getSegmentTimes(segment, times_m);
+    pValues_m = history_m.getSegmentValues(segment, channel_m, values_m);
+    rows_m = history_m.getSegmentRows(segment);
+    row_m = history_m.getSegmentOverlap(segment);
+  }
+
+  const HistorySnapshot &history_m;
+  size_t channel_m;
+  size_t segment_m;
+  size_t row_m;
+  size_t rows_m;
+  const float *pValues_m;
+  std::vector<double> times_m;
+  std::vector<float> values_m;
+};
+
+void compareTraces(const HistorySnapshot &history,
+                   const HistorySnapshot &reference, double shift,
+                   size_t channel, TraceDifference &difference,
+                   std::vector<double> *pTimes, std::vector<float> *pValues)
+{
+  difference = TraceDifference();
+  if (pTimes != nullptr)
+  {
+    pTimes->clear();
+  }
+  if (pValues != nullptr)
+  {
+    pValues->clear();
+  }
+  if (channel >= history.getChannelCount()
+      || channel >= reference.getChannelCount())
+  {
+    return;
+  }
+
+  RowReader rows(history, channel);
+  RowReader references(reference, channel);
+  double nextTime = 0.0;
+  float nextValue = 0.0f;
+  if (!references.next(nextTime, nextValue))
+  {
+    return;
+  }
+  nextTime += shift;
+  double previousTime = nextTime;
+  float previousValue = nextValue;
+  double firstTime = nextTime;
+  double lastTime = reference.getLastTime() + shift;
+
+  const float notANumber = std::numeric_limits<float>::quiet_NaN();
+  double sumSquares = 0.0;
+  double time = 0.0;
+  float value = 0.0f;
+  while (rows.next(time, value))
+  {
+    if (time < firstTime)
+    {
+      continue;
+    }
+    if (time > lastTime)
+    {
+      break;
+    }
+
+    /* Reference rows on both sides of the time */
+    bool ended = false;
+    while (nextTime < time && !ended)
+    {
+      previousTime = nextTime;
+      previousValue = nextValue;
+      ended = !references.next(nextTime, nextValue);
+      nextTime += shift;
+    }
+    if (ended)
+    {
+      break;
+    }
+
+    float expected = nextValue;
+    if (nextTime > time)
+    {
+      double fraction = (time - previousTime) / (nextTime - previousTime);
+      expected = previousValue
+                 + static_cast<float>(fraction) * (nextValue - previousValue);
+    }
+
+    float delta = value - expected;
+    if (pTimes != nullptr)
+    {
+      pTimes->push_back(time);
+    }
+    if (pValues != nullptr)
+    {
+      pValues->push_back(std::isnan(delta) ? notANumber : delta);
+    }
+    if (std::isnan(delta))
+    {
+      continue;
+    }
+    difference.maxDifference
+        = std::max(difference.maxDifference, std::fabs(delta));
+    sumSquares += static_cast<double>(delta) * delta;
+    difference.count++;
+  }
+
+  if (difference.count > 0)
+  {
+    difference.rmsDifference
+        = static_cast<float>(std::sqrt(sumSquares / difference.count));
+  }
+}
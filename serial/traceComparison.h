@@ -0,0 +1,51 @@
+/** @file      traceComparison.h
+ *  @brief     Header file for the comparison of a history with a reference.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/13
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef TRACE_COMPARISON_H
+#define TRACE_COMPARISON_H
+
+#include <vector>
+#include <cstddef>
+#include "historyStore.h"
+
+/**
+ * @brief Difference between a channel and the same channel of a reference,
+ * over the rows where both have a value.
+ */
+struct TraceDifference
+{
+  float maxDifference = 0.0f; /* Largest absolute difference */
+  float rmsDifference = 0.0f;
+  size_t count = 0; /* Rows compared */
+};
+
+/**
+ * @brief Compares one channel of a history with a reference trace.
+ *
+ * Every row of the history within the time span of the reference is compared
+ * with the reference linearly interpolated at its time. Both snapshots are
+ * walked once, one segment at a time, without copying them.
+ *
+ * @param shift     Added to the reference times to align them with the history
+ * @param pTimes    When not null, receives the time of every compared row
+ * @param pValues   When not null, receives history minus reference at those
+ *                  times, NaN where either one has a gap
+ */
+void compareTraces(const HistorySnapshot &history,
+                   const HistorySnapshot &reference, double shift,
+                   size_t channel, TraceDifference &difference,
+                   std::vector<double> *pTimes = nullptr,
+                   std::vector<float> *pValues = nullptr);
+
+#endif // TRACE_COMPARISON_H
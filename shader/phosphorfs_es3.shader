@@ -0,0 +1,8 @@
+#version 300 es
+precision mediump float;
+in vec4 color;
+out vec4 FragColor;
+void main()
+{
+    FragColor = color;
+}
@@ -0,0 +1,9 @@
+#version 300 es
+in vec2 pos;
+in vec4 vertexColor;
+out vec4 color;
+void main()
+{
+    color = vertexColor;
+    gl_Position = vec4(pos.x, pos.y, 0.0, 1.0);
+}
@@ -0,0 +1,6 @@
+#version 100
+attribute vec2 pos;
+void main()
+{
+    gl_Position = vec4(pos.x, pos.y, 0.0, 1.0);
+}
@@ -112,6 +112,17 @@ void Shader::set_vec3(const glm::vec3 &vec3, const std::string &name)
   glProgramUniform3fv(ulGetProgramId(), myLoc, 1, glm::value_ptr(vec3));
 #endif
 }
+
+void Shader::set_vec4(const glm::vec4 &vec4, const std::string &name)
+{
+  GLint myLoc = glGetUniformLocation(ulGetProgramId(), name.c_str());
+#ifdef PLATFORM_RASPBERRY_PI
+  glUseProgram(ulGetProgramId());
+  glUniform4fv(myLoc, 1, glm::value_ptr(vec4));
+#else
+  glProgramUniform4fv(ulGetProgramId(), myLoc, 1, glm::value_ptr(vec4));
+#endif
+}
 } // namespace nshaders
 /* -------------------------------------------------------------------------------------------
  */
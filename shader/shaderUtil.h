@@ -42,6 +42,8 @@ public:
 
   void set_vec3(const glm::vec3 &vec3, const std::string &name);
 
+  void set_vec4(const glm::vec4 &vec4, const std::string &name);
+
 private:
   uint32_t getCompiledShader(uint32_t shaderType,
                              const std::string &shaderSource);
@@ -0,0 +1,67 @@
+/** @file      mscopeShmDump.c
+ *  @brief     Example reader printing the frames published by mscope.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/17
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ *
+ *  Usage: mscope_shm_dump [name] [frames]
+ *  Prints one CSV line per frame ("index,time,group,v1,v2,..."). Stops after
+ *  the given number of frames, never when it is 0 or omitted.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "../mscopeShm.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+int main(int argc, char *argv[])
+{
+  const char *name = (argc > 1) ? argv[1] : NULL;
+  unsigned long long limit = (argc > 2) ? strtoull(argv[2], NULL, 10) : 0;
+  unsigned long long count = 0;
+  struct timespec idle = {0, 1000000}; /* 1 ms */
+  MscopeShmFrame frame;
+
+  MscopeShmReader *pReader = mscope_shm_attach(name);
+  if (pReader == NULL)
+  {
+    fprintf(stderr, "Cannot attach to %s: %s\n",
+            name != NULL ? name : MSCOPE_SHM_DEFAULT_NAME, strerror(errno));
+    return 1;
+  }
+
+  while (limit == 0 || count < limit)
+  {
+    if (!mscope_shm_next(pReader, &frame))
+    {
+      /* The ring is polled, the writer never waits for readers */
+      nanosleep(&idle, NULL);
+      continue;
+    }
+
+    printf("%llu,%.6f,%u", (unsigned long long)frame.index, frame.time,
+           frame.group);
+    for (uint32_t i = 0; i < frame.channels; ++i)
+    {
+      printf(",%g", frame.values[i]);
+    }
+    printf("\n");
+    count++;
+  }
+
+  fprintf(stderr, "%llu frames read, %llu lost\n", count,
+          (unsigned long long)mscope_shm_lost(pReader));
+  mscope_shm_detach(pReader);
+  return 0;
+}
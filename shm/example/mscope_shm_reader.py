@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+# @file      mscope_shm_reader.py
+# @brief     Example Python reader of the mscope shared-memory frame ring.
+# @author    arturodlrios
+# @date      Created on 2025/02/17
+#
+# This software is the exclusive property of Cortx and is provided
+# under strict confidentiality. It is intended for use solely by authorized
+# personnel of Cortx and is protected by intellectual property laws.
+# Unauthorized use, reproduction, or distribution in whole or in part is
+# strictly prohibited.
+#
+# COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+#
+# Follows the protocol documented in mscopeShm.h. Python cannot issue memory
+# fences, the sequence double-check still rejects every frame overwritten
+# while it was copied, which is enough for test scripts. Use the C library
+# when every frame matters.
+
+import mmap
+import struct
+import sys
+import time
+
+MAGIC = 0x4D48534D
+VERSION = 1
+HEADER = struct.Struct("<6IQ")       # magic .. generation
+WRITE_INDEX_OFFSET = 64
+SLOT = struct.Struct("<QdII")        # sequence, time, group, channels
+
+
+class MscopeShmReader:
+    def __init__(self, name="/mscope"):
+        path = "/dev/shm/" + name.lstrip("/")
+        with open(path, "rb") as shm_file:
+            self.map = mmap.mmap(shm_file.fileno(), 0, prot=mmap.PROT_READ)
+        (magic, version, self.header_size, self.slot_size, self.capacity,
+         self.max_channels, _) = HEADER.unpack_from(self.map, 0)
+        if magic != MAGIC or version != VERSION:
+            raise RuntimeError("not a supported mscope ring")
+        self.lost = 0
+        self._synchronize()
+
+    def _u64(self, offset):
+        return struct.unpack_from("<Q", self.map, offset)[0]
+
+    def _synchronize(self):
+        self.generation = self._u64(24)
+        self.next_index = self._u64(WRITE_INDEX_OFFSET)
+
+    def next(self):
+        """Returns (index, time, group, values) or None when up to date."""
+        if self._u64(24) != self.generation:
+            self._synchronize()
+        while True:
+            write_index = self._u64(WRITE_INDEX_OFFSET)
+            if self.next_index >= write_index:
+                return None
+            if write_index - self.next_index > self.capacity:
+                self.lost += write_index - self.capacity - self.next_index
+                self.next_index = write_index - self.capacity
+            index = self.next_index
+            offset = (self.header_size
+                      + (index & (self.capacity - 1)) * self.slot_size)
+            expected = 2 * index + 2
+            before, frame_time, group, channels = SLOT.unpack_from(
+                self.map, offset)
+            if before < expected:
+                return None
+            channels = min(channels, self.max_channels)
+            values = struct.unpack_from("<%df" % channels, self.map,
+                                        offset + SLOT.size)
+            after = self._u64(offset)
+            self.next_index += 1
+            if before != expected or after != expected:
+                self.lost += 1
+                continue
+            return index, frame_time, group, values
+
+
+if __name__ == "__main__":
+    reader = MscopeShmReader(sys.argv[1] if len(sys.argv) > 1 else "/mscope")
+    while True:
+        frame = reader.next()
+        if frame is None:
+            time.sleep(0.001)
+            continue
+        print(frame)
@@ -0,0 +1,117 @@
+/** @file      mscopeShm.h
+ *  @brief     Layout of the mscope shared-memory frame ring and C reader API.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/17
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef MSCOPE_SHM_H
+#define MSCOPE_SHM_H
+
+/*
+ * mscope publishes every acquired frame into a POSIX shared-memory object
+ * (shm_open, "/mscope" by default) laid out as:
+ *
+ *   MscopeShmHeader                       (MSCOPE_SHM_HEADER_SIZE bytes)
+ *   slot[0] .. slot[capacity - 1]         (slotSize bytes each)
+ *
+ * Every slot holds a MscopeShmSlot followed by maxChannels float values.
+ * Frame n is stored in slot n % capacity. There is a single writer and any
+ * number of readers, which never block it:
+ *
+ *   writer: slot.sequence = 2n + 1   (odd: being written)
+ *           write time, group, channel count and values
+ *           slot.sequence = 2n + 2   (release: frame n complete)
+ *           header.writeIndex = n + 1 (release)
+ *
+ *   reader: s1 = slot.sequence (acquire), copy the slot, acquire fence,
+ *           s2 = slot.sequence. The copy is frame n only if s1 == s2 == 2n+2,
+ *           otherwise the writer lapped the reader and the frame is lost.
+ *
+ * All integers are little-endian (native on the Raspberry Pi). Readers must
+ * check magic and version, and restart from writeIndex when generation
+ * changes (the writer was restarted or reconfigured).
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MSCOPE_SHM_MAGIC (0x4D48534DU) /* "MSHM" in memory */
+#define MSCOPE_SHM_VERSION (1U)
+#define MSCOPE_SHM_DEFAULT_NAME "/mscope"
+#define MSCOPE_SHM_HEADER_SIZE (128U)
+
+typedef struct
+{
+  uint32_t magic;       /* MSCOPE_SHM_MAGIC */
+  uint32_t version;     /* MSCOPE_SHM_VERSION */
+  uint32_t headerSize;  /* MSCOPE_SHM_HEADER_SIZE, offset of slot 0 */
+  uint32_t slotSize;    /* Bytes per slot, multiple of 8 */
+  uint32_t capacity;    /* Number of slots, power of two */
+  uint32_t maxChannels; /* Values per slot */
+  uint64_t generation;  /* Changed every time the writer starts */
+  uint8_t reserved0[32];
+  /* Own cache line, the only header field written per frame */
+  uint64_t writeIndex;  /* Number of frames written, atomic */
+  uint8_t reserved1[56];
+} MscopeShmHeader;
+
+typedef struct
+{
+  uint64_t sequence; /* 2n + 2 once frame n is complete, atomic */
+  double time;       /* Seconds on the mscope capture time base */
+  uint32_t group;    /* Channel group, 0 for the primary input */
+  uint32_t channels; /* Valid values, at most maxChannels */
+  /* float values[maxChannels] follow */
+} MscopeShmSlot;
+
+/* Reader API, implemented by mscopeShmReader.c --------------------------- */
+
+typedef struct MscopeShmReader MscopeShmReader;
+
+typedef struct
+{
+  uint64_t index;  /* Frame number */
+  double time;
+  uint32_t group;
+  uint32_t channels;
+  const float *values; /* Valid until the next call on the reader */
+} MscopeShmFrame;
+
+/**
+ * @brief Attaches to a published ring, read-only.
+ * @param name Shared-memory object name, NULL for MSCOPE_SHM_DEFAULT_NAME
+ * @return The reader positioned at the newest frame, or NULL (errno set,
+ *         EPROTO for a layout that is not a supported mscope ring).
+ */
+MscopeShmReader *mscope_shm_attach(const char *name);
+
+void mscope_shm_detach(MscopeShmReader *pReader);
+
+/**
+ * @brief Reads the next frame without blocking.
+ * @return 1 when a frame was read, 0 when no new frame is available.
+ */
+int mscope_shm_next(MscopeShmReader *pReader, MscopeShmFrame *pFrame);
+
+/**
+ * @brief Number of frames overwritten by the writer before they were read.
+ */
+uint64_t mscope_shm_lost(const MscopeShmReader *pReader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MSCOPE_SHM_H */
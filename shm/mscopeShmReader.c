@@ -0,0 +1,198 @@
+/** @file      mscopeShmReader.c
+ *  @brief     C reader library of the mscope shared-memory frame ring.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/17
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "mscopeShm.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+struct MscopeShmReader
+{
+  int fd;
+  const uint8_t *pBase;
+  size_t size;
+  const MscopeShmHeader *pHeader;
+  uint64_t generation;
+  uint64_t nextIndex;
+  uint64_t lost;
+  float *pValues; /* maxChannels values of the last frame */
+};
+
+static uint64_t prv_loadAcquire(const uint64_t *pValue)
+{
+  return __atomic_load_n(pValue, __ATOMIC_ACQUIRE);
+}
+
+static void prv_synchronize(MscopeShmReader *pReader)
+{
+  pReader->generation = prv_loadAcquire(&pReader->pHeader->generation);
+  pReader->nextIndex = prv_loadAcquire(&pReader->pHeader->writeIndex);
+}
+
+MscopeShmReader *mscope_shm_attach(const char *name)
+{
+  struct stat fileStat;
+  MscopeShmReader *pReader = calloc(1, sizeof(MscopeShmReader));
+  if (pReader == NULL)
+  {
+    return NULL;
+  }
+
+  pReader->fd = shm_open(name != NULL ? name : MSCOPE_SHM_DEFAULT_NAME,
+                         O_RDONLY, 0);
+  if (pReader->fd < 0 || fstat(pReader->fd, &fileStat) != 0
+      || (size_t)fileStat.st_size < sizeof(MscopeShmHeader))
+  {
+    goto fail;
+  }
+
+  pReader->size = (size_t)fileStat.st_size;
+  pReader->pBase
+      = mmap(NULL, pReader->size, PROT_READ, MAP_SHARED, pReader->fd, 0);
+  if (pReader->pBase == MAP_FAILED)
+  {
+    pReader->pBase = NULL;
+    goto fail;
+  }
+  pReader->pHeader = (const MscopeShmHeader *)pReader->pBase;
+
+  /* Only a complete ring of a supported version is read */
+  const MscopeShmHeader *pHeader = pReader->pHeader;
+  if (pHeader->magic != MSCOPE_SHM_MAGIC
+      || pHeader->version != MSCOPE_SHM_VERSION
+      || pHeader->headerSize < sizeof(MscopeShmHeader)
+      || pHeader->capacity == 0
+      || (pHeader->capacity & (pHeader->capacity - 1)) != 0
+      || pHeader->slotSize
+             < sizeof(MscopeShmSlot) + pHeader->maxChannels * sizeof(float)
+      || pHeader->headerSize + (uint64_t)pHeader->capacity * pHeader->slotSize
+             > pReader->size)
+  {
+    errno = EPROTO;
+    goto fail;
+  }
+
+  pReader->pValues = calloc(pHeader->maxChannels + 1, sizeof(float));
+  if (pReader->pValues == NULL)
+  {
+    goto fail;
+  }
+
+  prv_synchronize(pReader);
+  return pReader;
+
+fail:
+  mscope_shm_detach(pReader);
+  return NULL;
+}
+
+void mscope_shm_detach(MscopeShmReader *pReader)
+{
+  if (pReader == NULL)
+  {
+    return;
+  }
+
+  int savedErrno = errno;
+  if (pReader->pBase != NULL)
+  {
+    munmap((void *)pReader->pBase, pReader->size);
+  }
+  if (pReader->fd >= 0)
+  {
+    close(pReader->fd);
+  }
+  free(pReader->pValues);
+  free(pReader);
+  errno = savedErrno;
+}
+
+int mscope_shm_next(MscopeShmReader *pReader, MscopeShmFrame *pFrame)
+{
+  const MscopeShmHeader *pHeader = pReader->pHeader;
+  uint64_t capacity = pHeader->capacity;
+
+  /* The writer restarted, continue from its current position */
+  if (prv_loadAcquire(&pHeader->generation) != pReader->generation)
+  {
+    prv_synchronize(pReader);
+  }
+
+  for (;;)
+  {
+    uint64_t writeIndex = prv_loadAcquire(&pHeader->writeIndex);
+    if (pReader->nextIndex >= writeIndex)
+    {
+      return 0;
+    }
+
+    /* Skip what the writer already overwrote */
+    if (writeIndex - pReader->nextIndex > capacity)
+    {
+      pReader->lost += writeIndex - capacity - pReader->nextIndex;
+      pReader->nextIndex = writeIndex - capacity;
+    }
+
+    uint64_t index = pReader->nextIndex;
+    const uint8_t *pSlotBase = pReader->pBase + pHeader->headerSize
+                               + (index & (capacity - 1)) * pHeader->slotSize;
+    const MscopeShmSlot *pSlot = (const MscopeShmSlot *)pSlotBase;
+    uint64_t expected = 2 * index + 2;
+
+    uint64_t before = prv_loadAcquire(&pSlot->sequence);
+    if (before < expected)
+    {
+      /* Counted in writeIndex but still being written */
+      return 0;
+    }
+
+    uint32_t channels = pSlot->channels;
+    if (channels > pHeader->maxChannels)
+    {
+      channels = pHeader->maxChannels;
+    }
+    pFrame->time = pSlot->time;
+    pFrame->group = pSlot->group;
+    memcpy(pReader->pValues, pSlotBase + sizeof(MscopeShmSlot),
+           channels * sizeof(float));
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    uint64_t after = __atomic_load_n(&pSlot->sequence, __ATOMIC_RELAXED);
+
+    pReader->nextIndex++;
+    if (before != expected || after != expected)
+    {
+      /* Lapped by the writer while copying */
+      pReader->lost++;
+      continue;
+    }
+
+    pFrame->index = index;
+    pFrame->channels = channels;
+    pFrame->values = pReader->pValues;
+    return 1;
+  }
+}
+
+uint64_t mscope_shm_lost(const MscopeShmReader *pReader)
+{
+  return pReader->lost;
+}
@@ -14,17 +14,46 @@
 
 #include "../pch/pch.h"
 #include "../app/application.h"
+#include "../app/headlessCapture.h"
+#include "../kernels/numericKernels.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <thread>
 #include "../serial/serialComms.h"
+#include "../serial/deviceRegistry.h"
 #include "../ui/visualizer.h"
 /* Entry Point
  * -------------------------------------------------------------------------------
  */
 
-int main(void)
+int main(int argc, char *argv[])
 {
+  /* Checks the vectorized kernels of this CPU against the scalar ones */
+  if (argc == 2 && strcmp(argv[1], "--verify-kernels") == 0)
+  {
+    std::string report;
+    bool passed = verifyNumericKernels(report);
+    printf("%sSelected kernels: %s\n", report.c_str(),
+           getNumericKernels().pName);
+    return passed ? 0 : 1;
+  }
+
+  /* Headless capture never creates the GLFW window nor the ImGui contexts */
+  if (isHeadlessRequested(argc, argv))
+  {
+    HeadlessConfig config;
+    if (parseHeadlessArguments(argc, argv, config) != Success)
+    {
+      printHeadlessUsage(argv[0]);
+      return 1;
+    }
+    return runHeadlessCapture(config);
+  }
+
+  /* The settings read the port list from here instead of scanning /dev */
+  startSerialDeviceRegistry();
+
   std::thread serialThread(startSerialThread);
 
   auto pApp = std::make_unique<Application>("μscope");
@@ -38,5 +67,7 @@ int main(void)
     serialThread.join();
   }
 
+  stopSerialDeviceRegistry();
+
   return 0;
 }
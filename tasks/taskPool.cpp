@@ -0,0 +1,272 @@
+/** @file      taskPool.cpp
+ *  @brief     Source file for the work-stealing task pool.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/05
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "taskPool.h"
+#include <iostream>
+#include <exception>
+#include <pthread.h>
+
+/* Threads of the application that are busy on their own: UI and reader */
+#define TASK_POOL_RESERVED_CORES (2)
+
+/* Pool and deque index of the current thread, if it is a worker */
+static thread_local TaskPool *pCurrentPool = nullptr;
+static thread_local size_t currentWorker = 0;
+
+void runTaskState(const std::shared_ptr<TaskState> &pState)
+{
+  bool expected = false;
+  if (!pState->claimed.compare_exchange_strong(expected, true))
+  {
+    return;
+  }
+
+  try
+  {
+    pState->function();
+  }
+  catch (const std::exception &exception)
+  {
+    std::cerr << "Task failed: " << exception.what() << std::endl;
+  }
+  /* Release what the function captured as soon as it has run */
+  pState->function = nullptr;
+
+  std::vector<std::shared_ptr<TaskState>> continuations;
+  {
+    std::lock_guard<std::mutex> lock(pState->mutex);
+    pState->done = true;
+    continuations.swap(pState->continuations);
+  }
+  pState->finished.notify_all();
+
+  for (std::shared_ptr<TaskState> &pContinuation : continuations)
+  {
+    pContinuation->pPool->schedule(std::move(pContinuation));
+  }
+}
+
+bool Task::isDone(void) const
+{
+  return !pState_m || pState_m->done.load();
+}
+
+void Task::wait(void) const
+{
+  if (!pState_m)
+  {
+    return;
+  }
+
+  /* A continuation only runs after the task it follows */
+  if (pState_m->queued)
+  {
+    runTaskState(pState_m);
+  }
+
+  std::unique_lock<std::mutex> lock(pState_m->mutex);
+  pState_m->finished.wait(lock, [this] { return pState_m->done.load(); });
+}
+
+Task Task::then(std::function<void()> continuation) const
+{
+  auto pNext = std::make_shared<TaskState>();
+  pNext->function = std::move(continuation);
+  pNext->pPool = pState_m ? pState_m->pPool : &getTaskPool();
+
+  if (pState_m)
+  {
+    std::lock_guard<std::mutex> lock(pState_m->mutex);
+    if (!pState_m->done)
+    {
+      pState_m->continuations.push_back(pNext);
+      return Task(pNext);
+    }
+  }
+
+  pNext->pPool->schedule(pNext);
+  return Task(pNext);
+}
+
+TaskPool::TaskPool(size_t workers)
+  : nextWorker_m(0)
+  , pending_m(0)
+  , stop_m(false)
+{
+  if (workers == 0)
+  {
+    size_t cores = std::thread::hardware_concurrency();
+    workers = (cores > TASK_POOL_RESERVED_CORES + 1)
+                  ? cores - TASK_POOL_RESERVED_CORES
+                  : 1;
+  }
+
+  for (size_t index = 0; index < workers; ++index)
+  {
+    workers_m.push_back(std::make_unique<Worker>());
+  }
+  /* Started once every deque exists, they steal from each other */
+  for (size_t index = 0; index < workers; ++index)
+  {
+    workers_m[index]->thread
+        = std::thread(&TaskPool::prv_workerThread, this, index);
+  }
+}
+
+TaskPool::~TaskPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex_m);
+    stop_m = true;
+  }
+  wake_m.notify_all();
+
+  for (std::unique_ptr<Worker> &pWorker : workers_m)
+  {
+    pWorker->thread.join();
+  }
+}
+
+Task TaskPool::submit(std::function<void()> function)
+{
+  auto pState = std::make_shared<TaskState>();
+  pState->function = std::move(function);
+  pState->pPool = this;
+  schedule(pState);
+  return Task(pState);
+}
+
+void TaskPool::schedule(std::shared_ptr<TaskState> pState)
+{
+  /* A worker keeps what it spawns, the others steal it if they are idle */
+  size_t index = (pCurrentPool == this)
+                     ? currentWorker
+                     : nextWorker_m.fetch_add(1) % workers_m.size();
+  pState->queued = true;
+  {
+    std::lock_guard<std::mutex> lock(workers_m[index]->mutex);
+    workers_m[index]->tasks.push_back(std::move(pState));
+  }
+  pending_m++;
+
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex_m);
+  }
+  wake_m.notify_one();
+}
+
+std::shared_ptr<TaskState> TaskPool::prv_takeTask(size_t index)
+{
+  std::shared_ptr<TaskState> pState;
+
+  /* Newest of its own tasks first */
+  {
+    Worker &worker = *workers_m[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.tasks.empty())
+    {
+      pState = std::move(worker.tasks.back());
+      worker.tasks.pop_back();
+    }
+  }
+
+  /* Then the oldest task of another worker */
+  for (size_t offset = 1; !pState && offset < workers_m.size(); ++offset)
+  {
+    Worker &victim = *workers_m[(index + offset) % workers_m.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty())
+    {
+      pState = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+    }
+  }
+
+  if (pState)
+  {
+    pending_m--;
+  }
+  return pState;
+}
+
+void TaskPool::prv_workerThread(size_t index)
+{
+  pCurrentPool = this;
+  currentWorker = index;
+  pthread_setname_np(pthread_self(), "mscope-task");
+
+  while (true)
+  {
+    std::shared_ptr<TaskState> pState = prv_takeTask(index);
+    if (pState)
+    {
+      /* Skipped when a waiter already ran it */
+      runTaskState(pState);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleepMutex_m);
+    wake_m.wait(lock, [this] { return stop_m || pending_m > 0; });
+    if (stop_m && pending_m == 0)
+    {
+      break;
+    }
+  }
+}
+
+TaskGroup::TaskGroup(TaskPool &pool)
+  : pool_m(pool)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+  wait();
+}
+
+void TaskGroup::run(std::function<void()> function)
+{
+  auto pState = std::make_shared<TaskState>();
+  pState->function = std::move(function);
+  pState->pPool = &pool_m;
+  states_m.push_back(pState);
+  pool_m.schedule(std::move(pState));
+}
+
+void TaskGroup::wait(void)
+{
+  /* Newest first: the workers take the oldest ones */
+  for (auto it = states_m.rbegin(); it != states_m.rend(); ++it)
+  {
+    runTaskState(*it);
+  }
+
+  for (const std::shared_ptr<TaskState> &pState : states_m)
+  {
+    std::unique_lock<std::mutex> lock(pState->mutex);
+    pState->finished.wait(lock, [&pState] { return pState->done.load(); });
+  }
+  states_m.clear();
+}
+
+TaskPool &getTaskPool(void)
+{
+  static TaskPool pool;
+  return pool;
+}
+
+Task runTask(std::function<void()> function)
+{
+  return getTaskPool().submit(std::move(function));
+}
@@ -0,0 +1,176 @@
+/** @file      taskPool.h
+ *  @brief     Header file for the work-stealing task pool.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/05
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+
+class TaskPool;
+
+/* Shared between a Task handle, its pool and its continuations */
+struct TaskState
+{
+  std::function<void()> function;
+  std::atomic<bool> queued{false};  /* Runnable, not waiting on another task */
+  std::atomic<bool> claimed{false}; /* Taken by a worker or a waiter */
+  std::atomic<bool> done{false};
+  std::mutex mutex;
+  std::condition_variable finished;
+  std::vector<std::shared_ptr<TaskState>> continuations;
+  TaskPool *pPool = nullptr;
+};
+
+/**
+ * @brief Handle of a function submitted to a TaskPool.
+ *
+ * Copies refer to the same task. A default-constructed Task is empty and
+ * counts as done.
+ */
+class Task
+{
+public:
+  Task(void) = default;
+
+  explicit Task(std::shared_ptr<TaskState> pState)
+    : pState_m(std::move(pState))
+  {
+  }
+
+  bool isValid(void) const { return pState_m != nullptr; }
+
+  /* Never blocks, for the UI thread to poll once per frame */
+  bool isDone(void) const;
+
+  /**
+   * @brief Waits until the task has run. A queued task no worker has started
+   * yet is run by the caller.
+   */
+  void wait(void) const;
+
+  /**
+   * @brief Schedules a function on the same pool once this task is done.
+   * @return The continuation task, which can be chained in turn.
+   */
+  Task then(std::function<void()> continuation) const;
+
+private:
+  std::shared_ptr<TaskState> pState_m;
+};
+
+/**
+ * @brief Fixed set of worker threads, each with its own task deque.
+ *
+ * A worker runs the newest task of its own deque first (the data it just
+ * produced is still in its cache) and, when it has none, steals the oldest
+ * task of another worker. Tasks submitted from outside the pool are spread
+ * over the workers. Idle workers sleep until a task is submitted.
+ *
+ * Tasks must not block on I/O for long stretches if the pool is shared with
+ * per-frame work; file opens and exports are fine, they only delay the
+ * tasks queued behind them on the same worker until another one steals them.
+ */
+class TaskPool
+{
+public:
+  /* 0 workers: one per core left after the UI and acquisition threads */
+  explicit TaskPool(size_t workers = 0);
+
+  /* Runs the queued tasks, then stops the workers */
+  ~TaskPool();
+
+  TaskPool(const TaskPool &) = delete;
+  TaskPool &operator=(const TaskPool &) = delete;
+
+  /**
+   * @brief Queues a function to run on one of the workers.
+   */
+  Task submit(std::function<void()> function);
+
+  size_t getWorkerCount(void) const { return workers_m.size(); }
+
+  /* Also used by Task::then() when the task is already done */
+  void schedule(std::shared_ptr<TaskState> pState);
+
+private:
+  struct Worker
+  {
+    std::mutex mutex;
+    std::deque<std::shared_ptr<TaskState>> tasks;
+    std::thread thread;
+  };
+
+  void prv_workerThread(size_t index);
+  std::shared_ptr<TaskState> prv_takeTask(size_t index);
+
+  std::vector<std::unique_ptr<Worker>> workers_m;
+  std::atomic<size_t> nextWorker_m; /* Round robin of outside submissions */
+  std::atomic<size_t> pending_m;    /* Tasks queued in any deque */
+  std::mutex sleepMutex_m;
+  std::condition_variable wake_m;
+  bool stop_m;
+};
+
+/**
+ * @brief Runs a function on a task, marks it done and schedules its
+ * continuations. Does nothing if the task was already claimed.
+ */
+void runTaskState(const std::shared_ptr<TaskState> &pState);
+
+/**
+ * @brief Fan-out/join of short tasks, e.g. one per channel every frame.
+ *
+ * wait() runs the tasks of the group that no worker has started yet on the
+ * calling thread, then waits for the others. It never runs unrelated pool
+ * tasks, so a long file operation queued on the pool never delays a frame.
+ */
+class TaskGroup
+{
+public:
+  explicit TaskGroup(TaskPool &pool);
+
+  /* Waits for the tasks still running */
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+
+  void run(std::function<void()> function);
+
+  void wait(void);
+
+private:
+  TaskPool &pool_m;
+  std::vector<std::shared_ptr<TaskState>> states_m;
+};
+
+/**
+ * @brief Gets the application-wide pool, started on first use.
+ */
+TaskPool &getTaskPool(void);
+
+/**
+ * @brief Runs a function on the application-wide pool.
+ */
+Task runTask(std::function<void()> function);
+
+#endif // TASK_POOL_H
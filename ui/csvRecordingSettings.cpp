@@ -20,7 +20,10 @@
 #include "../pch/pch.h"
 #include "../serial/csvStorage.h"
 #include "../serial/serialComms.h"
+#include "../serial/multiPortCapture.h"
 #include "dataReceptionSettings.h"
+#include "../tasks/taskPool.h"
+#include <atomic>
 #include <chrono>
 #include <iomanip>
 #include <sstream>
@@ -32,6 +35,13 @@ static char channelNames[3][64] = {
 };
 static bool showChannelNames = false;
 static bool useTimestampedFilename = true;
+static bool resampleToGrid = false;
+static float gridPeriodMs = 1.0f;
+
+/* The file is created and closed on the task pool, the UI only polls */
+static Task recordingFileTask;
+static bool recordingStarting = false;
+static std::atomic<bool> recordingStartSucceeded{false};
 
 std::string getCSVFilename(void)
 {
@@ -42,8 +52,20 @@ std::string getCSVFilename(void)
     return std::string(csvFilename);
 }
 
+bool isCSVRecordingLocked(void)
+{
+    return isCSVRecording() || recordingFileTask.isValid();
+}
+
 std::vector<std::string> getChannelNames(void)
 {
+    // Processed channels are named by the record outputs of the graph
+    std::shared_ptr<const ProcessingSchedule> pSchedule = getProcessingSchedule();
+    if (pSchedule)
+    {
+        return pSchedule->recordLabels;
+    }
+
     std::vector<std::string> names;
     int numChannels = getNumberOfChannels();
     
@@ -101,12 +123,40 @@ void csvRecordingSettings(void)
                               "Set number of channels in Data Reception Settings first");
         }
         
+        // Common time grid for the primary and the additional ports
+        bool locked = isCSVRecordingLocked();
+        ImGui::BeginDisabled(locked);
+        ImGui::Checkbox("Resample to common grid", &resampleToGrid);
+        if (resampleToGrid)
+        {
+            ImGui::InputFloat("Grid period (ms)", &gridPeriodMs, 0.1f, 1.0f, "%.3f");
+            gridPeriodMs = std::max(gridPeriodMs, 0.01f);
+        }
+        ImGui::EndDisabled();
+        if (!locked)
+        {
+            setCaptureResampling(resampleToGrid, gridPeriodMs / 1000.0);
+        }
+        
         ImGui::Separator();
         
         // Recording controls
         bool isRecording = isCSVRecording();
         
-        if (!isRecording)
+        if (recordingFileTask.isValid())
+        {
+            ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
+                              recordingStarting ? "Creating recording file..." : "Closing recording file...");
+            if (recordingFileTask.isDone())
+            {
+                recordingFileTask = Task();
+                if (recordingStarting)
+                {
+                    ImGui::OpenPopup(recordingStartSucceeded ? "Recording Started" : "Recording Failed");
+                }
+            }
+        }
+        else if (!isRecording)
         {
             if (ImGui::Button("Start CSV Recording", ImVec2(150, 30)))
             {
@@ -115,14 +165,10 @@ void csvRecordingSettings(void)
                     std::string filename = getCSVFilename();
                     std::vector<std::string> names = getChannelNames();
                     
-                    if (startCSVRecording(filename, names))
-                    {
-                        ImGui::OpenPopup("Recording Started");
-                    }
-                    else
-                    {
-                        ImGui::OpenPopup("Recording Failed");
-                    }
+                    recordingStarting = true;
+                    recordingFileTask = runTask(
+                        [filename, names]
+                        { recordingStartSucceeded = startCaptureRecording(filename, names); });
                 }
             }
         }
@@ -130,7 +176,9 @@ void csvRecordingSettings(void)
         {
             if (ImGui::Button("Stop CSV Recording", ImVec2(150, 30)))
             {
-                stopCSVRecording();
+                /* Flushing a large buffer to an SD card can take a while */
+                recordingStarting = false;
+                recordingFileTask = runTask([] { stopCaptureRecording(); });
             }
         }
         
@@ -37,4 +37,11 @@ std::string getCSVFilename(void);
  * @brief Gets the channel names for CSV headers
  * @return Vector of channel names
  */
-std::vector<std::string> getChannelNames(void); 
\ No newline at end of file
+std::vector<std::string> getChannelNames(void);
+
+/**
+ * @brief Checks whether the recording layout must not change: a recording is
+ * running, or being created or closed on the task pool.
+ * @return true while ports must not be added or removed
+ */
+bool isCSVRecordingLocked(void); 
\ No newline at end of file
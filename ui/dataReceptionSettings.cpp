@@ -44,6 +44,11 @@ int getNumberOfChannels(void)
   return numChannels;
 }
 
+void setNumberOfChannels(int channels)
+{
+  numChannels = (channels > 0) ? channels : 0;
+}
+
 void dataReceptionSettings(void)
 {
   if (ImGui::CollapsingHeader("Data Reception Settings",
@@ -15,4 +15,14 @@
 
 int getNumberOfChannels(void);
 
+/**
+ * @brief Sets the number of channels expected in each received message.
+ *
+ * Used when the channel count comes from the command line instead of the
+ * Data Reception Settings panel (headless capture).
+ *
+ * @param channels Number of channels, negative values are treated as 0
+ */
+void setNumberOfChannels(int channels);
+
 void dataReceptionSettings(void);
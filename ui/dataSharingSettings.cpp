@@ -0,0 +1,105 @@
+/** @file      dataSharingSettings.cpp
+ *  @brief     Source file for the live data sharing settings functions.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/17
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "dataSharingSettings.h"
+#include <algorithm>
+#include "../backends/imgui.h"
+#include "../serial/shmPublisher.h"
+#include "../web/webServer.h"
+
+static void prv_sharedMemorySettings(void)
+{
+  static char shmName[64] = MSCOPE_SHM_DEFAULT_NAME;
+  static OrbCode_t openCode = Success;
+  bool publishing = isSharedMemoryPublishing();
+
+  ImGui::Text("Shared Memory Ring:");
+
+  ImGui::BeginDisabled(publishing);
+  ImGui::InputText("Name##Shm", shmName, sizeof(shmName));
+  ImGui::EndDisabled();
+
+  if (!publishing)
+  {
+    if (ImGui::Button("Start Publishing"))
+    {
+      openCode = startSharedMemoryPublishing(shmName);
+    }
+    if (openCode != Success)
+    {
+      ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f),
+                         "Failed to create the shared memory ring");
+    }
+  }
+  else
+  {
+    if (ImGui::Button("Stop Publishing"))
+    {
+      stopSharedMemoryPublishing();
+    }
+    ImGui::Text("Frames published: %llu",
+                static_cast<unsigned long long>(getSharedMemoryPublishedFrames()));
+    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
+                       "Read it with shm/mscopeShm.h or mscope_shm_dump");
+  }
+}
+
+static void prv_webServerSettings(void)
+{
+  static char address[64] = WEB_DEFAULT_ADDRESS;
+  static int port = WEB_DEFAULT_PORT;
+  static OrbCode_t startCode = Success;
+  bool running = isWebServerRunning();
+
+  ImGui::Text("Web Viewer:");
+
+  ImGui::BeginDisabled(running);
+  ImGui::InputText("Address##Web", address, sizeof(address));
+  ImGui::InputInt("Port##Web", &port);
+  port = std::clamp(port, 1, 65535);
+  ImGui::EndDisabled();
+
+  if (!running)
+  {
+    if (ImGui::Button("Start Web Server"))
+    {
+      startCode = startWebServer(address, static_cast<uint16_t>(port));
+    }
+    if (startCode != Success)
+    {
+      ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f),
+                         "Failed to listen on this address");
+    }
+  }
+  else
+  {
+    if (ImGui::Button("Stop Web Server"))
+    {
+      stopWebServer();
+    }
+    ImGui::Text("Connected viewers: %zu", getWebServerClientCount());
+    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Open http://%s:%d/",
+                       address, port);
+  }
+}
+
+void dataSharingSettings(void)
+{
+  if (ImGui::CollapsingHeader("Live Data Sharing"))
+  {
+    prv_sharedMemorySettings();
+    ImGui::Separator();
+    prv_webServerSettings();
+  }
+}
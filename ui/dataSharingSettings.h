@@ -0,0 +1,19 @@
+#pragma once
+/** @file      dataSharingSettings.h
+ *  @brief     Header file for the live data sharing settings functions.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/17
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+/**
+ * @brief Renders the settings publishing the live frames to local processes.
+ */
+void dataSharingSettings(void);
@@ -19,6 +19,9 @@
 #include "../backends/imguiCustomThemes.h"
 
 bool isThemeDark = true;
+/* Off by default: a cached plot can't be dragged by its tick labels and can
+ * be a frame out of place when a zoom changes their width */
+bool plotLayerCacheEnabled = false;
 
 void prv_themeSelection(void)
 {
@@ -57,11 +60,24 @@ bool isThemeDarkSelected(void)
   return isThemeDark;
 }
 
+bool isPlotLayerCacheEnabled(void)
+{
+  return plotLayerCacheEnabled;
+}
+
 void generalSettings(void)
 {
   if (ImGui::CollapsingHeader("General Settings",
                               ImGuiTreeNodeFlags_DefaultOpen))
   {
     prv_themeSelection();
+
+    ImGui::Checkbox("Cache plot layers", &plotLayerCacheEnabled);
+    if (ImGui::IsItemHovered())
+    {
+      ImGui::SetTooltip("Keeps the axes and the grid of the plots, and the "
+                        "whole plot while frozen, in a texture drawn again "
+                        "only on zoom, resize or theme change");
+    }
   }
 }
@@ -15,4 +15,10 @@
 
 bool isThemeDarkSelected(void);
 
+/**
+ * @brief Tells if the plots keep their frame, axes and grid in a texture
+ * drawn again only when they change, see PlotLayerCache.
+ */
+bool isPlotLayerCacheEnabled(void);
+
 void generalSettings(void);
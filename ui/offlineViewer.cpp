@@ -0,0 +1,211 @@
+/** @file      offlineViewer.cpp
+ *  @brief     Source file for the offline recording viewer functions.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/01/20
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "offlineViewer.h"
+#include "../Libraries/lib.h"
+#include "../backends/imgui.h"
+#include "../backends/implot.h"
+#include "../pch/pch.h"
+#include "../serial/offlineRecording.h"
+#include "generalSettings.h"
+#include "../tasks/taskPool.h"
+#include <atomic>
+
+static std::unique_ptr<OfflineRecording> pOfflineRecording;
+static char offlineFilename[256] = "mscope.csv";
+static OrbCode_t openRecordingCode = Success;
+static bool fitRecordingOnNextFrame = false;
+
+/* Opened on the task pool, only used by the UI once the task is done */
+static std::unique_ptr<OfflineRecording> pOpeningRecording;
+static Task openRecordingTask;
+static std::atomic<OrbCode_t> openTaskCode{Success};
+
+/* Reused every frame so that pan/zoom does not allocate */
+static OfflineView offlineView;
+
+static void prv_openRecording(void)
+{
+  pOpeningRecording = std::make_unique<OfflineRecording>();
+
+  OfflineRecording *pRecording = pOpeningRecording.get();
+  std::string filename = offlineFilename;
+  openRecordingTask = runTask([pRecording, filename]
+                              { openTaskCode = pRecording->open(filename); });
+}
+
+static void prv_finishOpeningRecording(void)
+{
+  if (!openRecordingTask.isValid() || !openRecordingTask.isDone())
+  {
+    return;
+  }
+  openRecordingTask = Task();
+
+  openRecordingCode = openTaskCode;
+  if (openRecordingCode == Success)
+  {
+    pOfflineRecording = std::move(pOpeningRecording);
+    fitRecordingOnNextFrame = true;
+  }
+  pOpeningRecording.reset();
+}
+
+static void prv_closeRecording(void)
+{
+  /* Stopping the indexing thread can take a moment on a large file */
+  std::shared_ptr<OfflineRecording> pClosing = std::move(pOfflineRecording);
+  runTask([pClosing] { pClosing->close(); });
+  offlineView.channels.clear();
+}
+
+static void prv_recordingInformation(void)
+{
+  ImGui::TextWrapped("File: %s", pOfflineRecording->getFilename().c_str());
+  ImGui::Text("Size: %.1f MB",
+              pOfflineRecording->getFileSize() / (1024.0 * 1024.0));
+  ImGui::Text("Channels: %zu", pOfflineRecording->getChannelNames().size());
+
+  if (pOfflineRecording->isIndexReady())
+  {
+    ImGui::Text("Rows: %llu", static_cast<unsigned long long>(
+                                  pOfflineRecording->getRowCount()));
+    ImGui::Text("Duration: %.3f s", pOfflineRecording->getEndTime()
+                                        - pOfflineRecording->getStartTime());
+  }
+  else
+  {
+    ImGui::Text("Indexing recording...");
+    ImGui::ProgressBar(pOfflineRecording->getIndexProgress());
+  }
+}
+
+void offlineViewerSettings(void)
+{
+  prv_finishOpeningRecording();
+
+  if (ImGui::CollapsingHeader("Offline Viewer Settings"))
+  {
+    if (openRecordingTask.isValid())
+    {
+      ImGui::Text("Opening %s...", offlineFilename);
+    }
+    else if (!pOfflineRecording)
+    {
+      ImGui::Text("Recording file:");
+      ImGui::InputText("##OfflineFilename", offlineFilename,
+                       sizeof(offlineFilename));
+
+      if (ImGui::Button("Open Recording", ImVec2(150, 30)))
+      {
+        prv_openRecording();
+      }
+
+      if (openRecordingCode == OpenError)
+      {
+        ImGui::Text("Failed to open recording");
+      }
+      else if (openRecordingCode == InvalidData)
+      {
+        ImGui::Text("File is not an mscope CSV recording");
+      }
+    }
+    else
+    {
+      prv_recordingInformation();
+
+      if (ImGui::Button("Close Recording", ImVec2(150, 30)))
+      {
+        prv_closeRecording();
+      }
+    }
+  }
+}
+
+void offlineViewer(void)
+{
+  if (!pOfflineRecording)
+  {
+    return;
+  }
+
+  // Get the main dockspace ID
+  ImGuiID dockspaceId = ImGui::GetID("InvisibleWindowDockSpace");
+
+  // Set the Offline View window to dock into the main dockspace
+  ImGui::SetNextWindowDockID(dockspaceId, ImGuiCond_FirstUseEver);
+  ImGui::SetNextWindowSize(ImVec2(600, 400), ImGuiCond_FirstUseEver);
+
+  ImGui::Begin("Offline View");
+
+  if (!pOfflineRecording->isIndexReady())
+  {
+    ImGui::Text("Indexing %s...", pOfflineRecording->getFilename().c_str());
+    ImGui::ProgressBar(pOfflineRecording->getIndexProgress());
+    ImGui::End();
+    return;
+  }
+
+  const std::vector<std::string> &names
+      = pOfflineRecording->getChannelNames();
+
+  ImVec2 plotSize = ImGui::GetContentRegionAvail();
+  plotSize.y -= ImGui::GetTextLineHeightWithSpacing();
+
+  if (ImPlot::BeginPlot("Recording", plotSize))
+  {
+    if (isThemeDarkSelected())
+    {
+      ImPlot::StyleColorsDark();
+    }
+    else
+    {
+      ImPlot::StyleColorsLight();
+    }
+
+    ImPlot::SetupAxes("Time (s)", "Value", ImPlotAxisFlags_None,
+                      ImPlotAxisFlags_AutoFit);
+
+    if (fitRecordingOnNextFrame)
+    {
+      ImPlot::SetupAxisLimits(ImAxis_X1, pOfflineRecording->getStartTime(),
+                              pOfflineRecording->getEndTime(),
+                              ImPlotCond_Always);
+      fitRecordingOnNextFrame = false;
+    }
+
+    /* Only the visible range, decimated to the plot width, is requested */
+    ImPlotRect limits = ImPlot::GetPlotLimits();
+    int pixelWidth = static_cast<int>(ImPlot::GetPlotSize().x);
+    pOfflineRecording->query(limits.X.Min, limits.X.Max, pixelWidth,
+                             offlineView);
+
+    for (size_t ch = 0; ch < offlineView.channels.size() && ch < names.size();
+         ++ch)
+    {
+      const OfflineTrace &trace = offlineView.channels[ch];
+      ImPlot::PlotLine(names[ch].c_str(), trace.time.data(),
+                       trace.value.data(), static_cast<int>(trace.time.size()),
+                       ImPlotLineFlags_SkipNaN);
+    }
+
+    ImPlot::EndPlot();
+  }
+
+  ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "%s",
+                     offlineView.detailed ? "Showing raw samples"
+                                          : "Showing min/max summary");
+
+  ImGui::End();
+}
@@ -0,0 +1,33 @@
+#pragma once
+/** @file      offlineViewer.h
+ *  @brief     Header file for the offline recording viewer functions.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/01/20
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+/**
+ * @brief Renders the offline viewer settings UI
+ *
+ * This function displays controls for:
+ * - Selecting the recording to open
+ * - Opening/closing the recording
+ * - Displaying the indexing progress and recording information
+ */
+void offlineViewerSettings(void);
+
+/**
+ * @brief Renders the "Offline View" window of the opened recording.
+ *
+ * Only the decimated data of the visible time range is requested from the
+ * recording each frame, so pan and zoom cost does not depend on the file size.
+ * Nothing is drawn when no recording is open.
+ */
+void offlineViewer(void);
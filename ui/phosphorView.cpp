@@ -0,0 +1,394 @@
+/** @file      phosphorView.cpp
+ *  @brief     Source file for the persistent (phosphor) view of the channels.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/14
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "phosphorView.h"
+#include "../render/phosphorDisplay.h"
+#include "../backends/imgui.h"
+#include "../backends/implot.h"
+#include "../serial/serialComms.h"
+#include "serialSettings.h"
+#include "serialTerminal.h"
+#include "viewerSettings.h"
+#include "generalSettings.h"
+#include "visualizer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/* Most sweeps added to the texture per frame: when more are available, only
+ * the newest ones are drawn */
+#define PHOSPHOR_SWEEPS_PER_FRAME (64)
+
+typedef enum
+{
+  TRIGGER_FREE_RUN = 0, /* Back-to-back sweeps */
+  TRIGGER_RISING = 1,
+  TRIGGER_FALLING = 2,
+  TRIGGER_MODE_COUNT
+} TriggerMode_t;
+
+static const char *triggerModeNames[TRIGGER_MODE_COUNT]
+    = {"Free run", "Rising edge", "Falling edge"};
+
+static bool phosphorShown = false;
+static float sweepMilliseconds = 20.0f;
+static float persistence = 0.9f; /* Kept from one frame to the next */
+static float intensity = 0.25f;  /* Added by one sweep */
+static float minValue = -1.0f;
+static float maxValue = 1.0f;
+static int shownChannel = -1; /* -1 for all the channels */
+static int triggerMode = TRIGGER_FREE_RUN;
+static int triggerChannel = 0;
+static float triggerLevel = 0.0f;
+
+/* Created on first use, once the GL context is current */
+static std::unique_ptr<nrender::PhosphorDisplay> pPhosphor;
+static bool phosphorChanged = true; /* Clear the texture, fit the axes */
+static double nextSweepTime = std::numeric_limits<double>::quiet_NaN();
+
+/* Rows of the history from a time on, every channel */
+struct SweepRows
+{
+  std::vector<double> times;
+  std::vector<std::vector<float>> values;
+};
+static SweepRows sweepRows;
+static std::vector<double> sweepStarts;
+static std::vector<float> sweepPoints;
+
+static void prv_gatherRows(const HistorySnapshot &history, double from,
+                           SweepRows &rows)
+{
+  static std::vector<double> times;
+  static std::vector<float> converted;
+
+  size_t channels = history.getChannelCount();
+  rows.times.clear();
+  rows.values.resize(channels);
+  for (std::vector<float> &values : rows.values)
+  {
+    values.clear();
+  }
+
+  for (size_t segment = 0; segment < history.getSegmentCount(); ++segment)
+  {
+    if (history.getSegmentEnd(segment) < from)
+    {
+      continue;
+    }
+    history.getSegmentTimes(segment, times);
+    size_t first = std::lower_bound(times.begin(), times.end(), from)
+                   - times.begin();
+    first = std::max(first, history.getSegmentOverlap(segment));
+    if (first >= times.size())
+    {
+      continue;
+    }
+
+    rows.times.insert(rows.times.end(), times.begin() + first, times.end());
+    for (size_t channel = 0; channel < channels; ++channel)
+    {
+      const float *pValues
+          = history.getSegmentValues(segment, channel, converted);
+      rows.values[channel].insert(rows.values[channel].end(), pValues + first,
+                                  pValues + times.size());
+    }
+  }
+}
+
+/**
+ * @brief Finds the next trigger crossing at or after a time, interpolated
+ * between the two rows around it so that the sweeps line up below a sample.
+ * @return false when the rows hold no crossing, lastRow is then the index
+ *         to search from once more rows are there.
+ */
+static bool prv_findTrigger(const SweepRows &rows, double from, double &time,
+                            size_t &lastRow)
+{
+  const std::vector<float> &values = rows.values[triggerChannel];
+  /* Both rows of the crossing at or after the time */
+  size_t row = std::lower_bound(rows.times.begin(), rows.times.end(), from)
+               - rows.times.begin() + 1;
+  for (; row < rows.times.size(); ++row)
+  {
+    float before = values[row - 1];
+    float after = values[row];
+    bool crossed = (triggerMode == TRIGGER_RISING)
+                       ? (before < triggerLevel && after >= triggerLevel)
+                       : (before > triggerLevel && after <= triggerLevel);
+    if (!crossed)
+    {
+      continue;
+    }
+    double fraction = (triggerLevel - before) / (after - before);
+    time = rows.times[row - 1]
+           + fraction * (rows.times[row] - rows.times[row - 1]);
+    lastRow = row - 1;
+    return true;
+  }
+  lastRow = rows.times.empty() ? 0 : rows.times.size() - 1;
+  return false;
+}
+
+/* Start times of the sweeps completed since the previous frame */
+static void prv_findSweeps(const HistorySnapshot &history, double sweep)
+{
+  sweepStarts.clear();
+  double lastTime = history.getLastTime();
+
+  /* Too far behind (first frame, frozen, history cleared): newest sweeps */
+  double backlog = sweep * PHOSPHOR_SWEEPS_PER_FRAME;
+  if (std::isnan(nextSweepTime) || nextSweepTime > lastTime
+      || lastTime - nextSweepTime > backlog)
+  {
+    nextSweepTime = std::max(history.getFirstTime(), lastTime - backlog);
+  }
+
+  prv_gatherRows(history, nextSweepTime, sweepRows);
+  bool triggered
+      = triggerMode != TRIGGER_FREE_RUN
+        && triggerChannel < static_cast<int>(sweepRows.values.size());
+  while (sweepStarts.size() < PHOSPHOR_SWEEPS_PER_FRAME)
+  {
+    double start = nextSweepTime;
+    size_t lastRow = 0;
+    if (triggered
+        && !prv_findTrigger(sweepRows, nextSweepTime, start, lastRow))
+    {
+      /* The crossing can start on the last row known */
+      if (!sweepRows.times.empty())
+      {
+        nextSweepTime = sweepRows.times[lastRow];
+      }
+      return;
+    }
+    if (start + sweep > lastTime)
+    {
+      /* Found again, completed, on a following frame */
+      if (triggered)
+      {
+        nextSweepTime = sweepRows.times[lastRow];
+      }
+      return;
+    }
+    sweepStarts.push_back(start);
+    nextSweepTime = start + sweep;
+  }
+}
+
+/* Adds a channel of a sweep to the texture, a line per run of values */
+static void prv_drawSweep(double start, double sweep, size_t channel,
+                          const glm::vec4 &color)
+{
+  const std::vector<double> &times = sweepRows.times;
+  const std::vector<float> &values = sweepRows.values[channel];
+  float range = maxValue - minValue;
+
+  size_t row = std::lower_bound(times.begin(), times.end(), start)
+               - times.begin();
+  sweepPoints.clear();
+  for (; row < times.size() && times[row] <= start + sweep; ++row)
+  {
+    if (std::isnan(values[row]))
+    {
+      pPhosphor->drawSweep(sweepPoints.data(), sweepPoints.size() / 2, color);
+      sweepPoints.clear();
+      continue;
+    }
+    sweepPoints.push_back(static_cast<float>((times[row] - start) / sweep)
+                              * 2.0f
+                          - 1.0f);
+    sweepPoints.push_back((values[row] - minValue) / range * 2.0f - 1.0f);
+  }
+  pPhosphor->drawSweep(sweepPoints.data(), sweepPoints.size() / 2, color);
+}
+
+static void prv_updatePhosphor(int width, int height)
+{
+  if (!pPhosphor)
+  {
+    pPhosphor = std::make_unique<nrender::PhosphorDisplay>();
+  }
+  pPhosphor->resize(width, height);
+  if (phosphorChanged)
+  {
+    pPhosphor->clear();
+    nextSweepTime = std::numeric_limits<double>::quiet_NaN();
+  }
+
+  /* Frozen: the screen keeps its last image */
+  HistorySnapshot history = getChannelHistory();
+  if (isDisplayFrozen() || history.empty())
+  {
+    return;
+  }
+
+  double sweep = sweepMilliseconds / 1000.0;
+  prv_findSweeps(history, sweep);
+
+  pPhosphor->begin();
+  if (persistence < 1.0f)
+  {
+    pPhosphor->decay(persistence);
+  }
+  for (double start : sweepStarts)
+  {
+    for (size_t channel = 0; channel < sweepRows.values.size(); ++channel)
+    {
+      if (shownChannel >= 0 && static_cast<int>(channel) != shownChannel)
+      {
+        continue;
+      }
+      ImVec4 color = getChannelColor(static_cast<int>(channel));
+      prv_drawSweep(start, sweep, channel,
+                    glm::vec4(color.x * intensity, color.y * intensity,
+                              color.z * intensity, 1.0f));
+    }
+  }
+  pPhosphor->end();
+}
+
+static bool prv_channelCombo(const char *label, int &channel, bool allowAll)
+{
+  std::vector<std::string> labels;
+  getDataLabels(labels);
+
+  std::string preview = (channel < 0) ? "All channels"
+                        : (channel < static_cast<int>(labels.size()))
+                            ? labels[channel]
+                            : "Channel " + std::to_string(channel + 1);
+  bool changed = false;
+  if (ImGui::BeginCombo(label, preview.c_str()))
+  {
+    if (allowAll && ImGui::Selectable("All channels", channel < 0))
+    {
+      channel = -1;
+      changed = true;
+    }
+    for (int index = 0; index < static_cast<int>(labels.size()); ++index)
+    {
+      ImGui::PushID(index);
+      if (ImGui::Selectable(labels[index].c_str(), channel == index))
+      {
+        channel = index;
+        changed = true;
+      }
+      ImGui::PopID();
+    }
+    ImGui::EndCombo();
+  }
+  return changed;
+}
+
+void phosphorViewSettings(void)
+{
+  if (!ImGui::CollapsingHeader("Phosphor View Settings"))
+  {
+    return;
+  }
+
+  ImGui::Checkbox("Show phosphor view", &phosphorShown);
+  if (!phosphorShown)
+  {
+    return;
+  }
+
+  bool changed = false;
+  if (ImGui::InputFloat("Sweep (ms)", &sweepMilliseconds, 1.0f, 10.0f,
+                        "%.3f"))
+  {
+    sweepMilliseconds = std::max(sweepMilliseconds, 0.001f);
+    changed = true;
+  }
+  changed |= prv_channelCombo("Channels", shownChannel, true);
+  changed |= ImGui::InputFloat("Minimum", &minValue);
+  changed |= ImGui::InputFloat("Maximum", &maxValue);
+  if (maxValue <= minValue)
+  {
+    maxValue = minValue + 1.0f;
+  }
+
+  changed |= ImGui::Combo("Trigger", &triggerMode, triggerModeNames,
+                          TRIGGER_MODE_COUNT);
+  if (triggerMode != TRIGGER_FREE_RUN)
+  {
+    changed |= prv_channelCombo("Trigger channel", triggerChannel, false);
+    changed |= ImGui::InputFloat("Trigger level", &triggerLevel);
+  }
+
+  ImGui::SliderFloat("Persistence", &persistence, 0.5f, 1.0f, "%.3f");
+  if (ImGui::IsItemHovered())
+  {
+    ImGui::SetTooltip("Share of the brightness kept from one frame to the "
+                      "next, 1 keeps every sweep until cleared");
+  }
+  ImGui::SliderFloat("Intensity", &intensity, 0.01f, 1.0f, "%.2f");
+  if (ImGui::Button("Clear"))
+  {
+    changed = true;
+  }
+  phosphorChanged |= changed;
+}
+
+void phosphorView(void)
+{
+  if (!phosphorShown || !isSerialPortOpened())
+  {
+    return;
+  }
+
+  ImGuiID dockspaceId = ImGui::GetID("InvisibleWindowDockSpace");
+  ImGui::SetNextWindowDockID(dockspaceId, ImGuiCond_FirstUseEver);
+  ImGui::SetNextWindowSize(ImVec2(600, 400), ImGuiCond_FirstUseEver);
+
+  if (ImGui::Begin("Phosphor View", &phosphorShown))
+  {
+    ImVec2 plotSize = ImGui::GetContentRegionAvail();
+    if (ImPlot::BeginPlot("##Phosphor", plotSize))
+    {
+      if (isThemeDarkSelected())
+      {
+        ImPlot::StyleColorsDark();
+      }
+      else
+      {
+        ImPlot::StyleColorsLight();
+      }
+
+      double sweep = sweepMilliseconds / 1000.0;
+      ImPlot::SetupAxes("Time in sweep (s)", "Value");
+      ImPlot::SetupAxesLimits(0.0, sweep, minValue, maxValue,
+                              phosphorChanged ? ImPlotCond_Always
+                                              : ImPlotCond_Once);
+
+      /* One texel per pixel of the plot area */
+      ImVec2 pixels = ImPlot::GetPlotSize();
+      if (pixels.x >= 1.0f && pixels.y >= 1.0f)
+      {
+        prv_updatePhosphor(static_cast<int>(pixels.x),
+                           static_cast<int>(pixels.y));
+        phosphorChanged = false;
+
+        /* The framebuffer rows go upwards */
+        ImPlot::PlotImage("##Sweeps",
+                          (ImTextureID)(intptr_t)pPhosphor->getTexture(),
+                          ImPlotPoint(0.0, minValue),
+                          ImPlotPoint(sweep, maxValue), ImVec2(0, 1),
+                          ImVec2(1, 0));
+      }
+      ImPlot::EndPlot();
+    }
+  }
+  ImGui::End();
+}
@@ -0,0 +1,35 @@
+#pragma once
+/** @file      phosphorView.h
+ *  @brief     Header file for the persistent (phosphor) view of the channels.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/14
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+/**
+ * @brief Renders the phosphor view settings UI
+ *
+ * This function displays controls for:
+ * - Showing the phosphor view
+ * - The sweep length, the trigger and the vertical range
+ * - The persistence and the intensity of the sweeps
+ */
+void phosphorViewSettings(void);
+
+/**
+ * @brief Renders the "Phosphor View" window.
+ *
+ * The history is cut into sweeps, free-running or started by a trigger, and
+ * each sweep completed since the previous frame is added to a texture that
+ * fades every frame, like the screen of an analog scope: jitter and eye
+ * diagrams build up from thousands of sweeps while only the newest ones are
+ * drawn. Nothing is drawn when the view is hidden or no port is open.
+ */
+void phosphorView(void);
@@ -0,0 +1,288 @@
+/** @file      plotLayerCache.cpp
+ *  @brief     Source file for the plots drawn over a cached static layer.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/14
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "plotLayerCache.h"
+#include "../backends/imgui_internal.h"
+#include "../backends/implot_internal.h"
+#include "generalSettings.h"
+#include <cstdio>
+
+static bool prv_sameLimits(const ImPlotRect &a, const ImPlotRect &b)
+{
+  return a.X.Min == b.X.Min && a.X.Max == b.X.Max && a.Y.Min == b.Y.Min
+         && a.Y.Max == b.Y.Max;
+}
+
+static bool prv_sameSize(const ImVec2 &a, const ImVec2 &b)
+{
+  return a.x == b.x && a.y == b.y;
+}
+
+/* Size of the layer of a plot, in pixels */
+static void prv_layerSize(const ImVec2 &size, int32_t &width, int32_t &height)
+{
+  const ImGuiIO &io = ImGui::GetIO();
+  width = static_cast<int32_t>(ImCeil(size.x * io.DisplayFramebufferScale.x));
+  height = static_cast<int32_t>(ImCeil(size.y * io.DisplayFramebufferScale.y));
+}
+
+PlotLayerCache::~PlotLayerCache()
+{
+  frameBuffer_m.deleteBuffers();
+}
+
+void PlotLayerCache::plot(const std::string &title, const char *xLabel,
+                          const char *yLabel, const ImVec2 &size, bool frozen,
+                          uint64_t content,
+                          const std::function<void(void)> &drawItems)
+{
+  LayerInputs inputs;
+  inputs.title = title;
+  inputs.xLabel = xLabel;
+  inputs.yLabel = yLabel;
+  inputs.size = size;
+  inputs.dark = isThemeDarkSelected();
+  inputs.frozen = frozen;
+  inputs.content = frozen ? content : 0;
+
+  if (inputs.dark)
+  {
+    ImPlot::StyleColorsDark();
+  }
+  else
+  {
+    ImPlot::StyleColorsLight();
+  }
+
+  if (!isPlotLayerCacheEnabled() || !prv_layerFits(size))
+  {
+    layerValid_m = false;
+    frameBuffer_m.deleteBuffers();
+    prv_plotFull(inputs, drawItems);
+    return;
+  }
+
+  /* A layer of another size would misplace the plot area: the plot is drawn
+   * in full for the frame the layer is rendered again */
+  int32_t width = 0;
+  int32_t height = 0;
+  prv_layerSize(size, width, height);
+  bool layerShown = layerValid_m && prv_sameSize(layer_m.size, size)
+                    && frameBuffer_m.getWidth() == width
+                    && frameBuffer_m.getHeight() == height;
+
+  bool drawn = layerShown ? prv_plotOverLayer(inputs, drawItems)
+                          : prv_plotFull(inputs, drawItems);
+  if (!drawn)
+  {
+    return;
+  }
+
+  inputs.limits = limits_m;
+  if (!layerShown || !prv_sameLimits(layer_m.limits, inputs.limits)
+      || layer_m.title != inputs.title || layer_m.xLabel != inputs.xLabel
+      || layer_m.yLabel != inputs.yLabel || layer_m.dark != inputs.dark
+      || layer_m.frozen != inputs.frozen || layer_m.content != inputs.content)
+  {
+    prv_renderLayer(inputs, drawItems);
+  }
+}
+
+bool PlotLayerCache::prv_layerFits(const ImVec2 &size) const
+{
+  const ImGuiViewport *pViewport = ImGui::GetMainViewport();
+  return size.x >= 1.0f && size.y >= 1.0f && size.x <= pViewport->Size.x
+         && size.y <= pViewport->Size.y;
+}
+
+bool PlotLayerCache::prv_plotFull(const LayerInputs &inputs,
+                                  const std::function<void(void)> &drawItems)
+{
+  /* Shares its ID with the plot drawn over the layer, see "###" in ImGui */
+  std::string label = inputs.title + "###" + inputs.title;
+  if (!ImPlot::BeginPlot(label.c_str(), inputs.size))
+  {
+    return false;
+  }
+
+  ImPlot::SetupAxes(inputs.xLabel.c_str(), inputs.yLabel.c_str());
+  drawItems();
+  limits_m = ImPlot::GetPlotLimits();
+  ImPlot::EndPlot();
+  return true;
+}
+
+bool PlotLayerCache::prv_plotOverLayer(
+    const LayerInputs &inputs, const std::function<void(void)> &drawItems)
+{
+  ImVec2 origin = ImGui::GetCursorScreenPos();
+  ImVec2 corner(origin.x + inputs.size.x, origin.y + inputs.size.y);
+
+  /* The layer is the bottom left part of the texture, upside down, the
+   * texture being rounded up to whole pixels */
+  const ImGuiIO &io = ImGui::GetIO();
+  float u = inputs.size.x * io.DisplayFramebufferScale.x
+            / static_cast<float>(frameBuffer_m.getWidth());
+  float v = inputs.size.y * io.DisplayFramebufferScale.y
+            / static_cast<float>(frameBuffer_m.getHeight());
+  ImGui::GetWindowDrawList()->AddImage(
+      (ImTextureID)(intptr_t)frameBuffer_m.getTexture(), origin, corner,
+      ImVec2(0.0f, v), ImVec2(u, 0.0f));
+
+  /* Only the plot area, transparent, the legend unless it is in the layer */
+  ImGui::SetCursorScreenPos(
+      ImVec2(origin.x + plotOffset_m.x, origin.y + plotOffset_m.y));
+  ImPlot::PushStyleVar(ImPlotStyleVar_PlotPadding, ImVec2(0.0f, 0.0f));
+  ImPlot::PushStyleColor(ImPlotCol_PlotBg, ImVec4(0.0f, 0.0f, 0.0f, 0.0f));
+  ImPlot::PushStyleColor(ImPlotCol_PlotBorder,
+                         ImVec4(0.0f, 0.0f, 0.0f, 0.0f));
+
+  ImPlotFlags flags = ImPlotFlags_NoTitle | ImPlotFlags_NoFrame;
+  if (inputs.frozen)
+  {
+    flags |= ImPlotFlags_NoLegend;
+  }
+  std::string label = "###" + inputs.title;
+  bool drawn = ImPlot::BeginPlot(label.c_str(), plotSize_m, flags);
+  if (drawn)
+  {
+    ImPlot::SetupAxes(nullptr, nullptr, ImPlotAxisFlags_NoDecorations,
+                      ImPlotAxisFlags_NoDecorations);
+
+    /* Frozen items are in the layer, but the axes only fit plotted items */
+    ImPlot::SetupFinish();
+    if (!inputs.frozen || ImPlot::GetCurrentPlot()->FitThisFrame)
+    {
+      drawItems();
+    }
+    limits_m = ImPlot::GetPlotLimits();
+    ImPlot::EndPlot();
+  }
+
+  ImPlot::PopStyleColor(2);
+  ImPlot::PopStyleVar();
+
+  /* The window lays out the whole plot */
+  ImGui::SetCursorScreenPos(origin);
+  ImGui::Dummy(inputs.size);
+  return drawn;
+}
+
+void PlotLayerCache::prv_renderLayer(
+    const LayerInputs &inputs, const std::function<void(void)> &drawItems)
+{
+  int32_t width = 0;
+  int32_t height = 0;
+  prv_layerSize(inputs.size, width, height);
+  if (frameBuffer_m.getTexture() == 0 || frameBuffer_m.getWidth() != width
+      || frameBuffer_m.getHeight() != height)
+  {
+    /* Only colors, ImGui draws without depth or stencil tests */
+    frameBuffer_m.createBuffers(width, height, false);
+  }
+
+  /* At the bottom left corner, where the framebuffer coordinates of OpenGL
+   * start: the layer lands in the texture with the projection and the
+   * clipping of the main viewport */
+  ImGuiViewport *pViewport = ImGui::GetMainViewport();
+  ImGui::SetNextWindowViewport(pViewport->ID);
+  ImGui::SetNextWindowPos(ImVec2(
+      pViewport->Pos.x, pViewport->Pos.y + pViewport->Size.y - inputs.size.y));
+  ImGui::SetNextWindowSize(inputs.size);
+  ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0.0f, 0.0f));
+  ImGui::PushStyleVar(ImGuiStyleVar_WindowBorderSize, 0.0f);
+
+  ImGuiWindowFlags windowFlags
+      = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs
+        | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoSavedSettings
+        | ImGuiWindowFlags_NoDocking | ImGuiWindowFlags_NoFocusOnAppearing
+        | ImGuiWindowFlags_NoBringToFrontOnFocus
+        | ImGuiWindowFlags_NoBackground;
+  char name[64];
+  snprintf(name, sizeof(name), "##PlotLayer%p", static_cast<void *>(this));
+  ImGui::Begin(name, nullptr, windowFlags);
+  ImGui::PopStyleVar(2);
+
+  /* Rendered first, the texture is ready for the windows drawing it */
+  ImGui::BringWindowToDisplayBack(ImGui::GetCurrentWindow());
+  background_m = ImGui::GetStyleColorVec4(ImGuiCol_WindowBg);
+
+  ImDrawList *pDrawList = ImGui::GetWindowDrawList();
+  pDrawList->AddCallback(prv_beginLayer, this);
+
+  ImPlotFlags flags = ImPlotFlags_NoInputs;
+  if (!inputs.frozen)
+  {
+    flags |= ImPlotFlags_NoLegend;
+  }
+  ImVec2 origin = ImGui::GetCursorScreenPos();
+  if (ImPlot::BeginPlot(inputs.title.c_str(), inputs.size, flags))
+  {
+    ImPlot::SetupAxes(inputs.xLabel.c_str(), inputs.yLabel.c_str());
+    const ImPlotRect &limits = inputs.limits;
+    ImPlot::SetupAxesLimits(limits.X.Min, limits.X.Max, limits.Y.Min,
+                            limits.Y.Max, ImPlotCond_Always);
+    if (inputs.frozen)
+    {
+      drawItems();
+    }
+
+    ImVec2 plotPos = ImPlot::GetPlotPos();
+    plotOffset_m = ImVec2(plotPos.x - origin.x, plotPos.y - origin.y);
+    plotSize_m = ImPlot::GetPlotSize();
+    ImPlot::EndPlot();
+  }
+
+  pDrawList->AddCallback(prv_endLayer, this);
+  pDrawList->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+  ImGui::End();
+
+  layer_m = inputs;
+  layerValid_m = true;
+}
+
+void PlotLayerCache::prv_beginLayer(const ImDrawList *pList,
+                                    const ImDrawCmd *pCmd)
+{
+  (void)pList;
+  PlotLayerCache *pCache
+      = static_cast<PlotLayerCache *>(pCmd->UserCallbackData);
+
+  /* The viewport of the renderer is kept, the texture holds its bottom left
+   * corner: the projection and the clipping stay valid */
+  GLint viewport[4];
+  glGetIntegerv(GL_VIEWPORT, viewport);
+  GLfloat clearColor[4];
+  glGetFloatv(GL_COLOR_CLEAR_VALUE, clearColor);
+  GLboolean scissor = glIsEnabled(GL_SCISSOR_TEST);
+  const ImVec4 &background = pCache->background_m;
+  glClearColor(background.x, background.y, background.z, 1.0f);
+  glDisable(GL_SCISSOR_TEST);
+  pCache->frameBuffer_m.bind();
+  if (scissor)
+  {
+    glEnable(GL_SCISSOR_TEST);
+  }
+  glClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+  glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+}
+
+void PlotLayerCache::prv_endLayer(const ImDrawList *pList,
+                                  const ImDrawCmd *pCmd)
+{
+  (void)pList;
+  PlotLayerCache *pCache
+      = static_cast<PlotLayerCache *>(pCmd->UserCallbackData);
+  pCache->frameBuffer_m.unbind();
+}
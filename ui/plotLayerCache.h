@@ -0,0 +1,102 @@
+#pragma once
+/** @file      plotLayerCache.h
+ *  @brief     Header file for the plots drawn over a cached static layer.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/14
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "../backends/imgui.h"
+#include "../backends/implot.h"
+#include "../render/openglBufferManagement.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/**
+ * @brief Plot whose frame, title, axes, grid and tick labels are kept in a
+ * texture.
+ *
+ * The static layer is rendered into an OpenGLFrameBuffer only when the size,
+ * the axis limits, the labels or the theme change; every other frame the
+ * texture is drawn and a plot without decorations, placed over its plot area,
+ * draws the items and handles the mouse. When the items are frozen they are
+ * cached too, and the plot costs one textured quad until it is zoomed, moved
+ * or resized.
+ *
+ * The layer is drawn by an offscreen window at the bottom left corner of the
+ * main viewport, rendered before every other window so that the texture is
+ * up to date within the frame; the texture has the size of the plot and,
+ * OpenGL framebuffers starting at the bottom left, the clipping of the UI
+ * applies unchanged. The plot is drawn in full when caching is disabled in
+ * the general settings or the plot doesn't fit in the main viewport.
+ */
+class PlotLayerCache
+{
+public:
+  PlotLayerCache() = default;
+
+  ~PlotLayerCache();
+
+  PlotLayerCache(const PlotLayerCache &) = delete;
+
+  PlotLayerCache &operator=(const PlotLayerCache &) = delete;
+
+  /**
+   * @brief Draws the plot at the cursor, like ImPlot::BeginPlot/EndPlot.
+   * @param title Shown above the plot, identifies it within the window
+   * @param xLabel Label of the x axis
+   * @param yLabel Label of the y axis
+   * @param size Size of the whole plot
+   * @param frozen The items only change with content, they are cached too
+   * @param content Identifies the items drawn while frozen
+   * @param drawItems Plots the items, called between BeginPlot and EndPlot
+   */
+  void plot(const std::string &title, const char *xLabel, const char *yLabel,
+            const ImVec2 &size, bool frozen, uint64_t content,
+            const std::function<void(void)> &drawItems);
+
+private:
+  /* Everything the static layer depends on */
+  struct LayerInputs
+  {
+    std::string title;
+    std::string xLabel;
+    std::string yLabel;
+    ImVec2 size;
+    ImPlotRect limits;
+    bool dark = false;
+    bool frozen = false;
+    uint64_t content = 0;
+  };
+
+  bool prv_layerFits(const ImVec2 &size) const;
+
+  bool prv_plotFull(const LayerInputs &inputs,
+                    const std::function<void(void)> &drawItems);
+
+  bool prv_plotOverLayer(const LayerInputs &inputs,
+                         const std::function<void(void)> &drawItems);
+
+  void prv_renderLayer(const LayerInputs &inputs,
+                       const std::function<void(void)> &drawItems);
+
+  static void prv_beginLayer(const ImDrawList *pList, const ImDrawCmd *pCmd);
+
+  static void prv_endLayer(const ImDrawList *pList, const ImDrawCmd *pCmd);
+
+  nrender::OpenGLFrameBuffer frameBuffer_m;
+  LayerInputs layer_m;     /* Of the texture */
+  bool layerValid_m = false;
+  ImVec2 plotOffset_m;     /* Plot area within the layer, in UI units */
+  ImVec2 plotSize_m;
+  ImPlotRect limits_m;     /* Of the plot drawn this frame */
+  ImVec4 background_m;     /* The texture is cleared with it */
+};
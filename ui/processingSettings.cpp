@@ -0,0 +1,326 @@
+/** @file      processingSettings.cpp
+ *  @brief     Source file for the processing graph settings functions.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/07
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "processingSettings.h"
+#include <algorithm>
+#include <cstring>
+#include "../backends/imgui.h"
+#include "../processing/processingGraph.h"
+#include "../processing/processingSchedule.h"
+#include "../serial/serialComms.h"
+#include "csvRecordingSettings.h"
+#include "dataReceptionSettings.h"
+
+static ProcessingGraph graph;
+static bool graphCreated = false;
+static char profilePath[256] = "mscope_profile.txt";
+static int newNodeType = NODE_SCALE;
+static std::string statusText;
+static bool statusIsError = false;
+
+static void prv_setStatus(const std::string &text, bool isError)
+{
+  statusText = text;
+  statusIsError = isError;
+}
+
+static std::string prv_nodeTitle(const ProcessingNode &node)
+{
+  return "#" + std::to_string(node.id) + " "
+         + getProcessingNodeTypeName(node.type) + ": " + node.name;
+}
+
+// Combo of the nodes that can feed another one, outputs excluded
+static void prv_inputCombo(const char *label, ProcessingNode &node,
+                           size_t input)
+{
+  const ProcessingNode *pCurrent = nullptr;
+  for (const ProcessingNode &candidate : graph.getNodes())
+  {
+    if (candidate.id == node.inputs[input])
+    {
+      pCurrent = &candidate;
+    }
+  }
+
+  std::string preview = pCurrent ? prv_nodeTitle(*pCurrent) : "(unconnected)";
+  if (ImGui::BeginCombo(label, preview.c_str()))
+  {
+    for (const ProcessingNode &candidate : graph.getNodes())
+    {
+      if (candidate.id == node.id || candidate.type == NODE_DISPLAY
+          || candidate.type == NODE_RECORD)
+      {
+        continue;
+      }
+      if (ImGui::Selectable(prv_nodeTitle(candidate).c_str(),
+                            candidate.id == node.inputs[input]))
+      {
+        node.inputs[input] = candidate.id;
+      }
+    }
+    ImGui::EndCombo();
+  }
+}
+
+static void prv_nodeParameters(ProcessingNode &node)
+{
+  char name[64];
+  strncpy(name, node.name.c_str(), sizeof(name) - 1);
+  name[sizeof(name) - 1] = '\0';
+  if (ImGui::InputText("Name", name, sizeof(name)))
+  {
+    node.name = name;
+  }
+
+  for (size_t input = 0; input < node.inputs.size(); ++input)
+  {
+    std::string label = "Input " + std::to_string(input + 1);
+    prv_inputCombo(label.c_str(), node, input);
+  }
+
+  switch (node.type)
+  {
+  case NODE_INPUT:
+    ImGui::InputInt("Channel", &node.channel);
+    node.channel = std::max(node.channel, 0);
+    ImGui::TextDisabled("0 is the first value of a message");
+    break;
+  case NODE_SCALE:
+  {
+    ImGui::InputFloat("Gain", &node.gain, 0.0f, 0.0f, "%.6g");
+    ImGui::InputFloat("Offset", &node.offset, 0.0f, 0.0f, "%.6g");
+    char unit[32];
+    strncpy(unit, node.unit.c_str(), sizeof(unit) - 1);
+    unit[sizeof(unit) - 1] = '\0';
+    if (ImGui::InputText("Unit", unit, sizeof(unit)))
+    {
+      node.unit = unit;
+    }
+    break;
+  }
+  case NODE_UNIT:
+  {
+    size_t count = 0;
+    const UnitConversion *pConversions = getUnitConversions(count);
+    node.conversion = std::clamp(node.conversion, 0, static_cast<int>(count) - 1);
+    if (ImGui::BeginCombo("Conversion", pConversions[node.conversion].pName))
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        if (ImGui::Selectable(pConversions[i].pName,
+                              static_cast<int>(i) == node.conversion))
+        {
+          node.conversion = static_cast<int>(i);
+        }
+      }
+      ImGui::EndCombo();
+    }
+    break;
+  }
+  case NODE_FILTER:
+  {
+    int filter = node.filter;
+    const char *filterNames[FILTER_TYPE_COUNT];
+    for (int i = 0; i < FILTER_TYPE_COUNT; ++i)
+    {
+      filterNames[i] = getFilterTypeName(static_cast<FilterType_t>(i));
+    }
+    if (ImGui::Combo("Filter", &filter, filterNames, FILTER_TYPE_COUNT))
+    {
+      node.filter = static_cast<FilterType_t>(filter);
+    }
+    if (node.filter == FILTER_MOVING_AVERAGE)
+    {
+      ImGui::InputInt("Window (samples)", &node.window);
+      node.window = std::clamp(node.window, 1, 4096);
+    }
+    else
+    {
+      ImGui::SliderFloat("Alpha", &node.alpha, 0.001f, 1.0f, "%.3f",
+                         ImGuiSliderFlags_Logarithmic);
+    }
+    break;
+  }
+  case NODE_DECIMATE:
+    ImGui::InputInt("Factor", &node.factor);
+    node.factor = std::clamp(node.factor, 1, 100000);
+    break;
+  case NODE_MATH:
+  {
+    int operation = node.operation;
+    const char *operationNames[MATH_OPERATION_COUNT];
+    for (int i = 0; i < MATH_OPERATION_COUNT; ++i)
+    {
+      operationNames[i] = getMathOperationName(static_cast<MathOperation_t>(i));
+    }
+    if (ImGui::Combo("Operation", &operation, operationNames,
+                     MATH_OPERATION_COUNT))
+    {
+      node.operation = static_cast<MathOperation_t>(operation);
+    }
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+static void prv_nodeList(void)
+{
+  uint32_t removedId = 0;
+
+  /* Copied ids: the parameters are edited through findNode() */
+  std::vector<uint32_t> ids;
+  for (const ProcessingNode &node : graph.getNodes())
+  {
+    ids.push_back(node.id);
+  }
+
+  for (uint32_t id : ids)
+  {
+    ProcessingNode *pNode = graph.findNode(id);
+    ImGui::PushID(static_cast<int>(id));
+    if (ImGui::TreeNode("##Node", "%s", prv_nodeTitle(*pNode).c_str()))
+    {
+      prv_nodeParameters(*pNode);
+      if (ImGui::Button("Remove Node"))
+      {
+        removedId = id;
+      }
+      ImGui::TreePop();
+    }
+    ImGui::PopID();
+  }
+
+  if (removedId != 0)
+  {
+    graph.removeNode(removedId);
+  }
+
+  const char *typeNames[NODE_TYPE_COUNT];
+  for (int i = 0; i < NODE_TYPE_COUNT; ++i)
+  {
+    typeNames[i] = getProcessingNodeTypeName(static_cast<ProcessingNodeType_t>(i));
+  }
+  ImGui::Combo("##NewNodeType", &newNodeType, typeNames, NODE_TYPE_COUNT);
+  ImGui::SameLine();
+  if (ImGui::Button("Add Node"))
+  {
+    graph.addNode(static_cast<ProcessingNodeType_t>(newNodeType));
+  }
+}
+
+static void prv_applyButtons(void)
+{
+  if (ImGui::Button("Apply"))
+  {
+    std::string error;
+    std::shared_ptr<const ProcessingSchedule> pSchedule = graph.compile(error);
+    if (pSchedule)
+    {
+      setProcessingSchedule(pSchedule);
+      prv_setStatus("Applied: " + std::to_string(pSchedule->steps.size())
+                        + " steps",
+                    false);
+    }
+    else
+    {
+      prv_setStatus(error, true);
+    }
+  }
+  ImGui::SameLine();
+  if (ImGui::Button("Turn Off"))
+  {
+    setProcessingSchedule(nullptr);
+    prv_setStatus("Processing turned off", false);
+  }
+  ImGui::SameLine();
+  if (ImGui::Button("Default Graph"))
+  {
+    graph = ProcessingGraph::makeDefault(getNumberOfChannels());
+  }
+}
+
+static void prv_profileFile(void)
+{
+  ImGui::InputText("Profile", profilePath, sizeof(profilePath));
+  if (ImGui::Button("Save Profile"))
+  {
+    OrbCode_t saveCode = graph.save(profilePath);
+    prv_setStatus(saveCode == Success ? "Profile saved"
+                                      : "Failed to write the profile",
+                  saveCode != Success);
+  }
+  ImGui::SameLine();
+  if (ImGui::Button("Load Profile"))
+  {
+    OrbCode_t loadCode = graph.load(profilePath);
+    if (loadCode == Success)
+    {
+      prv_setStatus("Profile loaded, apply it to use it", false);
+    }
+    else
+    {
+      prv_setStatus(loadCode == OpenError ? "Failed to open the profile"
+                                          : "Invalid profile",
+                    true);
+    }
+  }
+}
+
+void processingSettings(void)
+{
+  if (ImGui::CollapsingHeader("Processing Graph"))
+  {
+    if (!graphCreated)
+    {
+      graph = ProcessingGraph::makeDefault(getNumberOfChannels());
+      graphCreated = true;
+    }
+
+    std::shared_ptr<const ProcessingSchedule> pApplied = getProcessingSchedule();
+    if (pApplied)
+    {
+      ImGui::Text("Active: %zu display, %zu record outputs",
+                  pApplied->displayBuffers.size(),
+                  pApplied->recordBuffers.size());
+    }
+    else
+    {
+      ImGui::Text("Inactive: channels are shown and recorded as received");
+    }
+
+    // The recorded columns must not change during a recording
+    bool locked = isCSVRecordingLocked();
+    ImGui::BeginDisabled(locked);
+    prv_nodeList();
+    ImGui::Separator();
+    prv_applyButtons();
+    prv_profileFile();
+    ImGui::EndDisabled();
+
+    if (locked)
+    {
+      ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
+                         "Stop the recording to change the processing");
+    }
+    if (!statusText.empty())
+    {
+      ImGui::TextColored(statusIsError ? ImVec4(1.0f, 0.5f, 0.0f, 1.0f)
+                                       : ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
+                         "%s", statusText.c_str());
+    }
+  }
+}
@@ -0,0 +1,20 @@
+#pragma once
+/** @file      processingSettings.h
+ *  @brief     Header file for the processing graph settings functions.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/07
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+/**
+ * @brief Renders the editor of the processing graph applied to the primary
+ * port: nodes, profile files and applying the graph to the acquisition.
+ */
+void processingSettings(void);
@@ -0,0 +1,296 @@
+/** @file      referenceTraces.cpp
+ *  @brief     Source file for the reference traces overlaid on the live view.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/13
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "referenceTraces.h"
+#include "../backends/imgui.h"
+#include "viewerSettings.h"
+#include "../serial/csvStorage.h"
+#include "../tasks/taskPool.h"
+#include <atomic>
+#include <cstdio>
+#include <string>
+
+static std::vector<ReferenceTrace> references;
+static bool captureRequested = false;
+static size_t capturedCount = 0;
+
+/* The differences are computed again when the live history or a reference
+ * setting changes, not every frame */
+static bool comparisonChanged = false;
+static size_t comparedRows = 0;
+static double comparedTime = 0.0;
+
+/* One export at a time, from a copy of the snapshot */
+static Task exportTask;
+static std::string exportFilename;
+static std::atomic<bool> exportSucceeded{false};
+static bool exportFinished = false;
+
+static void prv_captureReference(const HistorySnapshot &live)
+{
+  ReferenceTrace reference;
+  capturedCount++;
+  snprintf(reference.name, sizeof(reference.name), "Reference %zu",
+           capturedCount);
+  reference.history = live;
+  references.push_back(std::move(reference));
+  comparisonChanged = true;
+}
+
+static void prv_compareReferences(const HistorySnapshot &live)
+{
+  TaskGroup group(getTaskPool());
+  for (ReferenceTrace &reference : references)
+  {
+    size_t channels = reference.visible ? live.getChannelCount() : 0;
+    reference.differences.assign(channels, TraceDifference());
+    reference.differenceTimes.resize(channels);
+    reference.differenceValues.resize(channels);
+
+    for (size_t channel = 0; channel < channels; ++channel)
+    {
+      ReferenceTrace *pReference = &reference;
+      group.run(
+          [pReference, &live, channel]
+          {
+            bool plotted = pReference->showDifference;
+            compareTraces(
+                live, pReference->history, pReference->shift, channel,
+                pReference->differences[channel],
+                plotted ? &pReference->differenceTimes[channel] : nullptr,
+                plotted ? &pReference->differenceValues[channel] : nullptr);
+            if (!plotted)
+            {
+              pReference->differenceTimes[channel].clear();
+              pReference->differenceValues[channel].clear();
+            }
+          });
+    }
+  }
+  group.wait();
+}
+
+void updateReferenceTraces(const HistorySnapshot &live)
+{
+  if (captureRequested && !live.empty())
+  {
+    prv_captureReference(live);
+  }
+  captureRequested = false;
+
+  for (ReferenceTrace &reference : references)
+  {
+    if (reference.alignToLive && !live.empty())
+    {
+      reference.shift = live.getLastTime() - reference.history.getLastTime();
+    }
+  }
+
+  double liveTime = live.empty() ? 0.0 : live.getLastTime();
+  if (!comparisonChanged && live.getRowCount() == comparedRows
+      && liveTime == comparedTime)
+  {
+    return;
+  }
+  comparisonChanged = false;
+  comparedRows = live.getRowCount();
+  comparedTime = liveTime;
+
+  prv_compareReferences(live);
+}
+
+size_t getReferenceTraceCount(void)
+{
+  return references.size();
+}
+
+const ReferenceTrace &getReferenceTrace(size_t index)
+{
+  return references[index];
+}
+
+static void prv_exportReference(const ReferenceTrace &reference)
+{
+  std::vector<std::string> labels;
+  getDataLabels(labels);
+  labels.resize(reference.history.getChannelCount());
+  for (size_t channel = 0; channel < labels.size(); ++channel)
+  {
+    if (labels[channel].empty())
+    {
+      labels[channel] = "Channel_" + std::to_string(channel + 1);
+    }
+  }
+
+  /* The copy shares the chunks, the reference can be deleted meanwhile */
+  HistorySnapshot history = reference.history;
+  std::string filename = generateTimestampedFilename("mscope_reference");
+  exportFilename = filename;
+  exportFinished = false;
+  exportTask = runTask(
+      [history, labels, filename]
+      { exportSucceeded = exportHistoryCSV(filename, labels, history); });
+}
+
+static void prv_exportStatus(void)
+{
+  if (exportTask.isValid())
+  {
+    if (!exportTask.isDone())
+    {
+      ImGui::Text("Exporting %s...", exportFilename.c_str());
+      return;
+    }
+    exportTask = Task();
+    exportFinished = true;
+  }
+  if (exportFinished)
+  {
+    ImGui::TextWrapped("%s %s",
+                       exportSucceeded ? "Exported" : "Failed to export",
+                       exportFilename.c_str());
+  }
+}
+
+static void prv_differenceTable(const ReferenceTrace &reference)
+{
+  if (reference.differences.empty())
+  {
+    return;
+  }
+
+  std::vector<std::string> labels;
+  getDataLabels(labels);
+
+  ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg
+                          | ImGuiTableFlags_SizingFixedFit;
+  if (ImGui::BeginTable("Differences", 4, flags))
+  {
+    ImGui::TableSetupColumn("Channel");
+    ImGui::TableSetupColumn("Max |diff|");
+    ImGui::TableSetupColumn("RMS");
+    ImGui::TableSetupColumn("Samples");
+    ImGui::TableHeadersRow();
+
+    for (size_t channel = 0; channel < reference.differences.size();
+         ++channel)
+    {
+      const TraceDifference &difference = reference.differences[channel];
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      if (channel < labels.size() && !labels[channel].empty())
+      {
+        ImGui::Text("%s", labels[channel].c_str());
+      }
+      else
+      {
+        ImGui::Text("Channel %zu", channel + 1);
+      }
+
+      if (difference.count == 0)
+      {
+        ImGui::TableNextColumn();
+        ImGui::TextDisabled("no overlap");
+        continue;
+      }
+      ImGui::TableNextColumn();
+      ImGui::Text("%.6f", difference.maxDifference);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.6f", difference.rmsDifference);
+      ImGui::TableNextColumn();
+      ImGui::Text("%zu", difference.count);
+    }
+    ImGui::EndTable();
+  }
+}
+
+/**
+ * @brief Displays the settings of one reference.
+ * @return false when the reference is to be deleted.
+ */
+static bool prv_referenceWidget(ReferenceTrace &reference)
+{
+  bool kept = true;
+
+  comparisonChanged |= ImGui::Checkbox("##Visible", &reference.visible);
+  ImGui::SameLine();
+  ImGui::InputText("##Name", reference.name, sizeof(reference.name));
+
+  const HistorySnapshot &history = reference.history;
+  ImGui::Text("%zu samples, %.3f s", history.getRowCount(),
+              history.getLastTime() - history.getFirstTime());
+
+  comparisonChanged
+      |= ImGui::Checkbox("Align end with live data", &reference.alignToLive);
+  if (!reference.alignToLive)
+  {
+    comparisonChanged |= ImGui::InputDouble("Time shift (s)", &reference.shift,
+                                            0.1, 1.0, "%.3f");
+  }
+  comparisonChanged
+      |= ImGui::Checkbox("Plot difference", &reference.showDifference);
+
+  ImGui::BeginDisabled(exportTask.isValid());
+  if (ImGui::Button("Export CSV"))
+  {
+    prv_exportReference(reference);
+  }
+  ImGui::EndDisabled();
+  ImGui::SameLine();
+  if (ImGui::Button("Delete"))
+  {
+    kept = false;
+  }
+
+  if (reference.visible)
+  {
+    prv_differenceTable(reference);
+  }
+  return kept;
+}
+
+void referenceTraceSettings(void)
+{
+  if (!ImGui::CollapsingHeader("Reference Traces"))
+  {
+    return;
+  }
+
+  if (ImGui::Button("Capture Reference", ImVec2(150, 30)))
+  {
+    captureRequested = true;
+  }
+  if (ImGui::IsItemHovered())
+  {
+    ImGui::SetTooltip("Keeps the displayed history, frozen or live, to "
+                      "overlay it on the data received afterwards");
+  }
+
+  for (size_t index = 0; index < references.size();)
+  {
+    ImGui::Separator();
+    ImGui::PushID(static_cast<int>(index));
+    bool kept = prv_referenceWidget(references[index]);
+    ImGui::PopID();
+    if (kept)
+    {
+      index++;
+      continue;
+    }
+    references.erase(references.begin() + index);
+    comparisonChanged = true;
+  }
+
+  prv_exportStatus();
+}
@@ -0,0 +1,64 @@
+#pragma once
+/** @file      referenceTraces.h
+ *  @brief     Header file for the reference traces overlaid on the live view.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/13
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include <cstddef>
+#include <vector>
+#include "../serial/historyStore.h"
+#include "../serial/traceComparison.h"
+
+/**
+ * @brief Named snapshot of the live history kept to be compared with the
+ * data received afterwards ("golden" trace).
+ *
+ * The snapshot shares the chunks of the history: capturing one copies no
+ * samples, and the chunks stay alive after the history drops them for as long
+ * as the reference is kept.
+ */
+struct ReferenceTrace
+{
+  char name[64];
+  HistorySnapshot history;
+  bool visible = true;
+  bool alignToLive = true; /* The reference ends where the live data ends */
+  double shift = 0.0;      /* Added to the reference times when displayed */
+  bool showDifference = false;
+
+  /* Per channel, live minus reference, updated with the live history */
+  std::vector<TraceDifference> differences;
+  std::vector<std::vector<double>> differenceTimes;
+  std::vector<std::vector<float>> differenceValues;
+};
+
+/**
+ * @brief Renders the reference traces settings UI
+ *
+ * This function displays controls for:
+ * - Capturing the displayed history as a new reference
+ * - Naming, aligning, showing and deleting each reference
+ * - The difference of each channel with the live data, and its CSV export
+ */
+void referenceTraceSettings(void);
+
+/**
+ * @brief Takes the requested captures from the displayed history and
+ * compares every visible reference with it, one task per channel.
+ *
+ * Called by the visualizer once the history to display this frame is known.
+ */
+void updateReferenceTraces(const HistorySnapshot &live);
+
+size_t getReferenceTraceCount(void);
+
+const ReferenceTrace &getReferenceTrace(size_t index);
@@ -15,12 +15,16 @@
 #include "sceneView.h"
 #include "visualizer.h"
 #include "settings.h"
+#include "offlineViewer.h"
+#include "phosphorView.h"
 
 namespace nui
 {
 void SceneView::render(void)
 {
   plot();
+  phosphorView();
+  offlineViewer();
   settings();
 }
 
@@ -17,16 +17,22 @@
 #include <vector>
 #include <string>
 #include "../serial/serialComms.h"
+#include "../serial/multiPortCapture.h"
+#include "../serial/csvStorage.h"
+#include "../serial/inputSource.h"
+#include "../serial/deviceRegistry.h"
 #include "../pch/pch.h"
 #include "dataReceptionSettings.h"
+#include "csvRecordingSettings.h"
+#include "../tasks/taskPool.h"
+#include <atomic>
 
 // Raspberry Pi (Linux) includes
 #include <termios.h>
 #include <fcntl.h>
 #include <unistd.h>
-#include <sys/stat.h> // For S_ISCHR
-#include <dirent.h>   // For opendir, readdir, closedir
 #include <cstring>
+#include <cstdint>
 
 typedef enum
 {
@@ -64,66 +70,112 @@ typedef enum
 
 #define MAX_COM_PORT_NUM (256)
 
+typedef enum
+{
+  INPUT_SERIAL = 0,
+  INPUT_TCP = 1,
+  INPUT_UDP = 2
+} InputMode_t;
+
+static int inputMode = INPUT_SERIAL;
+
 /* Flag to track if port has been opened */
 bool portOpened = false;
 bool errorInSerialReadings = false;
 
-static std::vector<std::string> prv_getAvailableCOMPorts(void)
+/**
+ * @brief Combo entries built from the device registry, rebuilt only when the
+ * registry publishes a new list.
+ */
+struct PortChoices
 {
-  std::vector<std::string> comPorts;
-
-  // Define the base directory where serial ports are located
-  const std::string devDir = "/dev";
-  const std::string prefix = "tty";
+  uint64_t generation = UINT64_MAX;
+  std::shared_ptr<const SerialDeviceList> pDevices;
+  std::vector<std::string> labels;
+  std::vector<const char *> labelPointers;
+  int selectedIndex = 0;
+};
+
+/* USB identity of the last serial device opened, selected again on replug */
+static std::string preferredUsbIdentity;
+
+static int prv_findPortIndex(const SerialDeviceList &devices,
+                             const std::string &name)
+{
+  for (size_t i = 0; i < devices.size(); ++i)
+  {
+    if (devices[i].name == name)
+    {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
 
-  // Open the /dev directory
-  DIR *dir = opendir(devDir.c_str());
-  if (dir == nullptr)
+static void prv_refreshPortChoices(PortChoices &choices)
+{
+  uint64_t generation = getSerialDeviceGeneration();
+  if (generation == choices.generation)
   {
-    std::cerr << "Error opening directory: " << devDir << std::endl;
-    return comPorts;
+    return;
   }
 
-  struct dirent *entry;
-  while ((entry = readdir(dir)) != nullptr)
+  std::string previousName;
+  if (choices.pDevices && choices.selectedIndex >= 0
+      && choices.selectedIndex < static_cast<int>(choices.pDevices->size()))
   {
-    std::string filename = entry->d_name;
+    previousName = (*choices.pDevices)[choices.selectedIndex].name;
+  }
 
-    // Check if the file is a serial port
-    if (filename.compare(0, prefix.size(), prefix) == 0)
+  choices.generation = generation;
+  choices.pDevices = getSerialDevices();
+  choices.labels.clear();
+  choices.labelPointers.clear();
+  for (const SerialDeviceInfo &info : *choices.pDevices)
+  {
+    std::string label = info.name;
+    if (info.isUsb())
     {
-      std::string fullPath = devDir + "/" + filename;
-
-      // Check if it's a character device
-      struct stat fileStat;
-      if (stat(fullPath.c_str(), &fileStat) == 0 && S_ISCHR(fileStat.st_mode))
+      label += " [" + info.vendorId + ":" + info.productId + "]";
+      if (!info.description.empty())
       {
-        comPorts.push_back(filename);
+        label += " " + info.description;
       }
     }
+    choices.labels.push_back(label);
+  }
+  for (const std::string &label : choices.labels)
+  {
+    choices.labelPointers.push_back(label.c_str());
   }
 
-  closedir(dir);
-
-  return comPorts;
+  /* A known device wins over the previous name, which may now be another
+   * device after a replug */
+  std::string preferredName = previousName;
+  int index = -1;
+  if (!preferredUsbIdentity.empty()
+      && findSerialDeviceByUsbIdentity(preferredUsbIdentity, preferredName))
+  {
+    index = prv_findPortIndex(*choices.pDevices, preferredName);
+  }
+  if (index < 0)
+  {
+    index = prv_findPortIndex(*choices.pDevices, previousName);
+  }
+  choices.selectedIndex = std::max(index, 0);
 }
 
 static OrbCode_t prv_selectPortNumber(std::string *pComPort)
 {
   /* Drop-down menu for available COM ports */
-  std::vector<std::string> comPorts = prv_getAvailableCOMPorts();
-  static int selectedComPortIndex = 0;
-  if (!comPorts.empty())
+  static PortChoices choices;
+  prv_refreshPortChoices(choices);
+  if (!choices.pDevices->empty())
   {
-    std::vector<const char *> comPortNames;
-    for (const auto &port : comPorts)
-    {
-      comPortNames.push_back(port.c_str());
-    }
-
-    ImGui::Combo("COM Port", &selectedComPortIndex, comPortNames.data(),
-                 static_cast<int>(comPortNames.size()));
-    *pComPort = comPorts[selectedComPortIndex];
+    ImGui::Combo("COM Port", &choices.selectedIndex,
+                 choices.labelPointers.data(),
+                 static_cast<int>(choices.labelPointers.size()));
+    *pComPort = (*choices.pDevices)[choices.selectedIndex].name;
   }
   else
   {
@@ -220,6 +272,127 @@ static void prv_selectStopBits(uint8_t *pStopBits)
   }
 }
 
+static void prv_selectInputMode(void)
+{
+  const char *inputModes[] = {"Serial Port", "TCP Client", "UDP Listener"};
+
+  ImGui::Combo("Input", &inputMode, inputModes, IM_ARRAYSIZE(inputModes));
+}
+
+static OrbCode_t prv_configureNetwork(std::string *pSpec)
+{
+  static char tcpHost[128] = "127.0.0.1";
+  static char udpAddress[128] = "";
+  static int networkPort = 4000;
+
+  if (inputMode == INPUT_TCP)
+  {
+    ImGui::InputText("Host", tcpHost, sizeof(tcpHost));
+  }
+  else
+  {
+    ImGui::InputText("Bind Address", udpAddress, sizeof(udpAddress));
+    ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f),
+                       "Leave empty to listen on all interfaces");
+  }
+  ImGui::InputInt("Port", &networkPort);
+  networkPort = std::clamp(networkPort, 1, 65535);
+
+  if (inputMode == INPUT_TCP)
+  {
+    *pSpec = std::string("tcp:") + tcpHost + ":" + std::to_string(networkPort);
+  }
+  else if (udpAddress[0] != '\0')
+  {
+    *pSpec = std::string("udp:") + udpAddress + ":" + std::to_string(networkPort);
+  }
+  else
+  {
+    *pSpec = "udp:" + std::to_string(networkPort);
+  }
+
+  return Success;
+}
+
+static OrbCode_t prv_openSerialPort(const std::string &comPort,
+                                    uint32_t baudRate, uint8_t stopBits,
+                                    uint8_t parity)
+{
+  OrbCode_t orbCode = openCOMPort(comPort, baudRate, stopBits, parity);
+  if (orbCode == Success)
+  {
+    auto pDevices = getSerialDevices();
+    int index = prv_findPortIndex(*pDevices, comPort);
+    if (index >= 0 && (*pDevices)[index].isUsb())
+    {
+      preferredUsbIdentity = (*pDevices)[index].getUsbIdentity();
+    }
+  }
+  return orbCode;
+}
+
+/* Resolving and connecting can take seconds, other sources are opened on the
+ * task pool and only handed to the device by the UI once the task is done */
+static std::unique_ptr<InputSource> pOpeningSource;
+static Task openSourceTask;
+static std::atomic<OrbCode_t> openSourceCode{Success};
+
+static OrbCode_t prv_startOpeningSource(const std::string &spec)
+{
+  pOpeningSource = createInputSource(spec);
+  if (!pOpeningSource)
+  {
+    return ConfigError;
+  }
+
+  InputSource *pSource = pOpeningSource.get();
+  openSourceTask = runTask([pSource] { openSourceCode = pSource->open(); });
+  return Success;
+}
+
+/* The result of the source opened on the task pool, once it is done */
+static bool prv_finishOpeningSource(OrbCode_t *pOrbCode)
+{
+  if (!openSourceTask.isValid() || !openSourceTask.isDone())
+  {
+    return false;
+  }
+  openSourceTask = Task();
+
+  *pOrbCode = openSourceCode;
+  if (*pOrbCode == Success)
+  {
+    *pOrbCode = openInputSource(std::move(pOpeningSource));
+  }
+  pOpeningSource.reset();
+  return true;
+}
+
+static void prv_selectReconnect(void)
+{
+  ReconnectPolicy policy = getSerialReconnectPolicy();
+  bool changed = ImGui::Checkbox("Reconnect automatically", &policy.enabled);
+
+  ImGui::BeginDisabled(!policy.enabled);
+  float stallTimeout = static_cast<float>(policy.stallTimeout);
+  if (ImGui::InputFloat("Stall timeout (s)", &stallTimeout, 1.0f, 5.0f, "%.1f"))
+  {
+    policy.stallTimeout = std::max(0.0f, stallTimeout);
+    changed = true;
+  }
+  if (ImGui::IsItemHovered())
+  {
+    ImGui::SetTooltip("Reopen the port after this long without a message, "
+                      "0 disables");
+  }
+  ImGui::EndDisabled();
+
+  if (changed)
+  {
+    setSerialReconnectPolicy(policy);
+  }
+}
+
 OrbCode_t prv_configurePort(std::string *pComPort, uint32_t *pBaudRate,
                             uint8_t *pStopBits, uint8_t *pParity)
 {
@@ -230,6 +403,7 @@ OrbCode_t prv_configurePort(std::string *pComPort, uint32_t *pBaudRate,
   prv_selectBaudRate(pBaudRate);
   prv_selectStopBits(pStopBits);
   prv_selectParity(pParity);
+  prv_selectReconnect();
 
   return portNumCode;
 }
@@ -240,9 +414,45 @@ void prv_managePort(std::string *pComPort, uint32_t *pBaudRate,
 {
   static OrbCode_t openComCode = Success;
 
-  if (portOpened)
+  static bool connectionLost = false;
+  const char *closeLabel
+      = (inputMode == INPUT_SERIAL) ? "Close COM Port" : "Disconnect";
+  const char *openLabel
+      = (inputMode == INPUT_SERIAL) ? "Open COM Port" : "Connect";
+
+  /* Network and local sources close themselves when their writer is gone,
+   * a lost serial port is being reopened and stays open for the user */
+  if (portOpened && !isCOMPortOpen() && !isCOMPortReconnecting())
+  {
+    portOpened = false;
+    connectionLost = true;
+  }
+
+  if (prv_finishOpeningSource(&openComCode) && openComCode == Success)
   {
-    if (ImGui::Button("Close COM Port"))
+    portOpened = true;
+    errorInSerialReadings = false;
+    connectionLost = false;
+  }
+
+  if (openSourceTask.isValid())
+  {
+    ImGui::Text("Connecting to %s...", pOpeningSource->getName().c_str());
+  }
+  else if (portOpened)
+  {
+    if (isCOMPortReconnecting())
+    {
+      ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f),
+                         "Connection lost, reconnecting (attempt %u)...",
+                         getCOMPortReconnectAttempts());
+    }
+    else if (getCOMPortReconnectCount() > 0)
+    {
+      ImGui::Text("Reconnected %u time(s)", getCOMPortReconnectCount());
+    }
+
+    if (ImGui::Button(closeLabel))
     {
       portOpened = false;
       closeCOMPort();
@@ -261,6 +471,10 @@ void prv_managePort(std::string *pComPort, uint32_t *pBaudRate,
       {
         ImGui::Text("Error while trying to read.");
       }
+      if (connectionLost)
+      {
+        ImGui::Text("Input closed by the remote end.");
+      }
       // Check if channels are configured before allowing port opening
       int numChannels = getNumberOfChannels();
       if (numChannels <= 0)
@@ -268,34 +482,288 @@ void prv_managePort(std::string *pComPort, uint32_t *pBaudRate,
         ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), 
                           "Please configure number of channels in 'Data Reception Settings' first");
         ImGui::BeginDisabled();
-        ImGui::Button("Open COM Port");
+        ImGui::Button(openLabel);
         ImGui::EndDisabled();
       }
       else
       {
-      if (ImGui::Button("Open COM Port"))
+      if (ImGui::Button(openLabel))
       {
-        openComCode = openCOMPort(*pComPort, *pBaudRate, *pStopBits, *pParity);
-        if (openComCode == Success)
+        if (inputMode != INPUT_SERIAL)
         {
-          portOpened = true;
-          errorInSerialReadings = false;
+          openComCode = prv_startOpeningSource(*pComPort);
+        }
+        else
+        {
+          openComCode = prv_openSerialPort(*pComPort, *pBaudRate, *pStopBits,
+                                           *pParity);
+          if (openComCode == Success)
+          {
+            portOpened = true;
+            errorInSerialReadings = false;
+            connectionLost = false;
+          }
         }
       }
         
         if (openComCode == OpenError)
       {
-        ImGui::Text("Failed to open serial port");
+        ImGui::Text(inputMode == INPUT_SERIAL ? "Failed to open serial port"
+                                              : "Failed to open network input");
       }
       else if (openComCode == PortStateError)
       {
         ImGui::Text("Error setting serial port state");
         }
+        else if (openComCode == WrongBaudRate)
+        {
+          ImGui::Text("Unsupported baud rate");
+        }
+        else if (openComCode == ConfigError)
+        {
+          ImGui::Text("Invalid network address");
+        }
       }
     }
   }
 }
 
+static void prv_additionalPorts(void)
+{
+  static PortChoices portChoices;
+  static int baudRateIndex = 0;
+  static int channels = 1;
+  static OrbCode_t addCode = Success;
+  const char *baudRates[] = {"9600", "19200", "38400", "57600", "115200"};
+  const uint32_t baudRateValues[] = {BR_9600, BR_19200, BR_38400, BR_57600,
+                                     BR_115200};
+
+  if (!ImGui::TreeNode("Additional Ports"))
+  {
+    return;
+  }
+
+  /* The recording columns are fixed when it starts */
+  bool recording = isCSVRecordingLocked();
+
+  for (size_t i = 0; i < getCapturePortCount(); ++i)
+  {
+    SerialDevice *pDevice = getCapturePort(i);
+    SerialStatistics statistics;
+    pDevice->getStatistics(statistics);
+
+    ImGui::PushID(static_cast<int>(i));
+    ConnectionState_t state = getCapturePortState(i);
+    ImGui::Text("%s (group %d, %d channels)%s",
+                pDevice->getPortName().c_str(), getCapturePortGroup(i),
+                pDevice->getChannelCount(),
+                (state == CONNECTION_CONNECTED)      ? ""
+                : (state == CONNECTION_RECONNECTING) ? " - reconnecting"
+                                                     : " - disconnected");
+    ImGui::Text("  frames %llu, dropped %llu, parse errors %llu",
+                static_cast<unsigned long long>(statistics.framesReceived),
+                static_cast<unsigned long long>(statistics.framesDropped),
+                static_cast<unsigned long long>(statistics.parseErrors));
+    ImGui::SameLine();
+    ImGui::BeginDisabled(recording);
+    if (ImGui::SmallButton("Remove"))
+    {
+      removeCapturePort(i);
+    }
+    ImGui::EndDisabled();
+    ImGui::PopID();
+  }
+
+  prv_refreshPortChoices(portChoices);
+  if (portChoices.pDevices->empty())
+  {
+    ImGui::Text("No COM ports available.");
+    ImGui::TreePop();
+    return;
+  }
+
+  ImGui::Combo("Port##Additional", &portChoices.selectedIndex,
+               portChoices.labelPointers.data(),
+               static_cast<int>(portChoices.labelPointers.size()));
+  ImGui::Combo("Baud Rate##Additional", &baudRateIndex, baudRates,
+               IM_ARRAYSIZE(baudRates));
+  ImGui::InputInt("Channels##Additional", &channels);
+  channels = std::max(1, channels);
+
+  ImGui::BeginDisabled(recording);
+  if (ImGui::Button("Add Port"))
+  {
+    const SerialDeviceInfo &device
+        = (*portChoices.pDevices)[portChoices.selectedIndex];
+    addCode = addCapturePort(device.name, baudRateValues[baudRateIndex],
+                             ONE_SB, NO_PARITY, channels);
+  }
+  ImGui::EndDisabled();
+
+  if (addCode == NotAvailable)
+  {
+    ImGui::Text("Port is already captured");
+  }
+  else if (addCode == OpenError)
+  {
+    ImGui::Text("Failed to open serial port");
+  }
+  else if (addCode == PortStateError)
+  {
+    ImGui::Text("Error setting serial port state");
+  }
+
+  ImGui::TreePop();
+}
+
+static void prv_acquisitionThreads(void)
+{
+  if (!ImGui::TreeNode("Acquisition Threads"))
+  {
+    return;
+  }
+
+  AcquisitionOptions options = getAcquisitionOptions();
+  bool changed = ImGui::Checkbox("Pipelined acquisition", &options.pipelined);
+  if (ImGui::IsItemHovered())
+  {
+    ImGui::SetTooltip("Parse and record on separate threads, the reader only "
+                      "empties the port");
+  }
+
+  bool realtime = options.realtimePriority > 0;
+  if (ImGui::Checkbox("Real-time reader (SCHED_FIFO)", &realtime))
+  {
+    options.realtimePriority = realtime ? 50 : 0;
+    changed = true;
+  }
+  ImGui::BeginDisabled(!realtime);
+  changed |= ImGui::SliderInt("Priority", &options.realtimePriority, 1, 99);
+  ImGui::EndDisabled();
+
+  int cpuCount = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+  if (ImGui::InputInt("Reader CPU", &options.readerCpu))
+  {
+    options.readerCpu = std::clamp(options.readerCpu, -1, cpuCount - 1);
+    changed = true;
+  }
+  if (ImGui::IsItemHovered())
+  {
+    ImGui::SetTooltip("-1 for any CPU. The other capture threads avoid the "
+                      "reader CPU, boot with isolcpus to reserve it");
+  }
+
+  changed |= ImGui::Checkbox("Lock memory (mlockall)", &options.lockMemory);
+
+  /* Only the policies the reader implements */
+  const char *overloadChoices[] = {"Block the reader", "Drop new data"};
+  int overloadIndex = (options.overloadPolicy == OVERLOAD_DROP_NEWEST) ? 1 : 0;
+  if (ImGui::Combo("When queues are full", &overloadIndex, overloadChoices,
+                   IM_ARRAYSIZE(overloadChoices)))
+  {
+    options.overloadPolicy
+        = (overloadIndex == 1) ? OVERLOAD_DROP_NEWEST : OVERLOAD_BLOCK;
+    changed = true;
+  }
+  if (ImGui::IsItemHovered())
+  {
+    ImGui::SetTooltip("Blocking leaves the bytes in the port, where the "
+                      "driver loses them if it overflows. Dropping reads and "
+                      "counts them, and marks a gap");
+  }
+
+  if (changed)
+  {
+    setAcquisitionOptions(options);
+  }
+
+  if (isAcquisitionPipelineRunning())
+  {
+    PipelineStatistics statistics;
+    getAcquisitionPipelineStatistics(statistics);
+    ImGui::Text("Queue peaks: parse %zu/%zu, record %zu/%zu",
+                statistics.parseQueuePeak, statistics.slots,
+                statistics.recordQueuePeak, statistics.slots);
+    ImGui::Text("Reader stalls: %llu",
+                static_cast<unsigned long long>(statistics.readerStalls));
+  }
+
+  ImGui::TreePop();
+}
+
+static void prv_dataLoss(void)
+{
+  if (!ImGui::TreeNode("Data Loss"))
+  {
+    return;
+  }
+
+  std::vector<StageStatistics> stages;
+  getAcquisitionStages(stages);
+
+  ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg
+                          | ImGuiTableFlags_SizingFixedFit;
+  if (ImGui::BeginTable("Stages", 6, flags))
+  {
+    ImGui::TableSetupColumn("Stage");
+    ImGui::TableSetupColumn("Policy");
+    ImGui::TableSetupColumn("In");
+    ImGui::TableSetupColumn("Out");
+    ImGui::TableSetupColumn("Dropped");
+    ImGui::TableSetupColumn("Queue");
+    ImGui::TableHeadersRow();
+
+    for (const StageStatistics &stage : stages)
+    {
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::Text("%s", stage.name.c_str());
+      ImGui::TableNextColumn();
+      ImGui::Text("%s", getOverloadPolicyName(stage.policy));
+
+      if (!stage.available)
+      {
+        ImGui::TableNextColumn();
+        ImGui::TextDisabled("n/a");
+        continue;
+      }
+
+      ImGui::TableNextColumn();
+      ImGui::Text("%llu %s", static_cast<unsigned long long>(stage.in),
+                  stage.pUnit);
+      ImGui::TableNextColumn();
+      ImGui::Text("%llu", static_cast<unsigned long long>(stage.out));
+      ImGui::TableNextColumn();
+      if (stage.dropped > 0 && stage.policy != OVERLOAD_DROP_OLDEST)
+      {
+        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "%llu",
+                           static_cast<unsigned long long>(stage.dropped));
+      }
+      else
+      {
+        ImGui::Text("%llu", static_cast<unsigned long long>(stage.dropped));
+      }
+      if (stage.errors > 0)
+      {
+        ImGui::SameLine();
+        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "+%llu events",
+                           static_cast<unsigned long long>(stage.errors));
+      }
+      ImGui::TableNextColumn();
+      if (stage.capacity > 0)
+      {
+        ImGui::Text("%zu/%zu", stage.depth, stage.capacity);
+      }
+    }
+    ImGui::EndTable();
+  }
+
+  ImGui::TextDisabled("Driver counts need a UART driver with TIOCGICOUNT. "
+                      "The history drops its oldest rows by design.");
+
+  ImGui::TreePop();
+}
+
 void serialReadingsError(void)
 {
   errorInSerialReadings = true;
@@ -321,8 +789,23 @@ void serialComSettings(void)
                               ImGuiTreeNodeFlags_DefaultOpen))
   {
     if (!portOpened)
-      portNumCode = prv_configurePort(&comPort, &baudRate, &stopBits, &parity);
+    {
+      prv_selectInputMode();
+      if (inputMode == INPUT_SERIAL)
+      {
+        portNumCode
+            = prv_configurePort(&comPort, &baudRate, &stopBits, &parity);
+      }
+      else
+      {
+        portNumCode = prv_configureNetwork(&comPort);
+      }
+    }
 
     prv_managePort(&comPort, &baudRate, &stopBits, &parity, &portNumCode);
+
+    prv_additionalPorts();
+    prv_acquisitionThreads();
+    prv_dataLoss();
   }
 }
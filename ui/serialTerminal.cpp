@@ -28,7 +28,7 @@ static std::stringstream
     serialDataBufferStream; /* Using stringstream for efficient string
                                operations */
 const size_t maxSerialDataBufferSize = 20000; /* Example size limit */
-bool pauseIncomingData = false;
+static bool displayFrozen = false;
 
 /**
  * @brief Trims the serial data buffer stream if its size exceeds the maximum
@@ -100,7 +100,13 @@ void prv_trimSerialDataBufferIfNeeded(void)
 
 void prv_LogFloatDataWithImGui(void)
 {
-  const int numChannels = channelsData.size();
+  /* The log is part of the display, it does not move while frozen */
+  std::vector<float> lastValues;
+  if (displayFrozen || !getChannelHistory().getLastValues(lastValues))
+  {
+    return;
+  }
+  const int numChannels = lastValues.size();
 
   serialDataBufferStream
       << std::fixed
@@ -111,12 +117,7 @@ void prv_LogFloatDataWithImGui(void)
   {
     for (int i = 0; i < numChannels; ++i)
     {
-      // Check if the current channel data is not empty
-      if (i < channelsData.size() && !channelsData[i].empty())
-      {
-
-        serialDataBufferStream << channelsData[i].back() << " ";
-      }
+      serialDataBufferStream << lastValues[i] << " ";
     }
 
     serialDataBufferStream << std::endl;
@@ -146,16 +147,17 @@ void prv_imGuiSerialTerminal(void)
 
   ImGui::BeginGroup();
 
-  if (ImGui::Button(ICON_FA_PLAY " Play", ImVec2(buttonWidth, 0)))
+  if (ImGui::Button(ICON_FA_PLAY " Live", ImVec2(buttonWidth, 0)))
   {
-    pauseIncomingData = false;
+    displayFrozen = false;
   }
 
   ImGui::SameLine(0, extraSpace);
 
-  if (ImGui::Button(ICON_FA_STOP " Stop", ImVec2(buttonWidth, 0)))
+  /* Only the display stops, acquisition and recording keep running */
+  if (ImGui::Button(ICON_FA_PAUSE " Freeze", ImVec2(buttonWidth, 0)))
   {
-    pauseIncomingData = true;
+    displayFrozen = true;
   }
 
   ImGui::EndGroup();
@@ -178,9 +180,9 @@ void prv_imGuiSerialTerminal(void)
   ImGui::End();
 }
 
-bool isDataReceptionPaused(void)
+bool isDisplayFrozen(void)
 {
-  return pauseIncomingData;
+  return displayFrozen;
 }
 
 void serialTerminal(void)
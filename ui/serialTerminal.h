@@ -30,11 +30,12 @@
 void serialTerminal(void);
 
 /**
- * @brief Checks whether data reception is currently paused.
+ * @brief Checks whether the display is frozen.
  *
- * This function returns the current status of data reception. If the data
- * reception is paused, it returns true; otherwise, it returns false.
+ * While frozen the plots keep showing a snapshot of the history that can be
+ * zoomed and inspected; the data keeps being received, recorded and stored,
+ * and is shown when the display goes back to live.
  *
- * @return true if data reception is paused, false otherwise.
+ * @return true if the display is frozen, false otherwise.
  */
-bool isDataReceptionPaused(void);
+bool isDisplayFrozen(void);
@@ -23,6 +23,11 @@
 #include "dataReceptionSettings.h"
 #include "generalSettings.h"
 #include "csvRecordingSettings.h"
+#include "offlineViewer.h"
+#include "referenceTraces.h"
+#include "phosphorView.h"
+#include "dataSharingSettings.h"
+#include "processingSettings.h"
 
 void settings(void)
 {
@@ -50,10 +55,30 @@ void settings(void)
 
   ImGui::Separator();
 
+  processingSettings();
+
+  ImGui::Separator();
+
   csvRecordingSettings();
 
   ImGui::Separator();
 
+  dataSharingSettings();
+
+  ImGui::Separator();
+
+  offlineViewerSettings();
+
+  ImGui::Separator();
+
+  referenceTraceSettings();
+
+  ImGui::Separator();
+
+  phosphorViewSettings();
+
+  ImGui::Separator();
+
   viewerSettings();
 
   ImGui::Separator();
@@ -0,0 +1,369 @@
+/** @file      traceGeometry.cpp
+ *  @brief     Source file for the trace lines generated on the task pool.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/14
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "traceGeometry.h"
+#include "../backends/imgui_internal.h"
+#include "../backends/implot_internal.h"
+#include "../tasks/taskPool.h"
+#include <cmath>
+
+#if defined __SSE__ || defined __x86_64__ || defined _M_X64
+#include <immintrin.h>
+#endif
+
+/* Batches of lines per thread of the pool, to even out their lengths */
+#define TRACE_BATCHES_PER_THREAD (2)
+
+/* Same inverse square root as ImPlot, for the same quads */
+static inline float prv_invSqrt(float x)
+{
+#if defined __SSE__ || defined __x86_64__ || defined _M_X64
+  return _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+#else
+  return 1.0f / sqrtf(x);
+#endif
+}
+
+/**
+ * @brief Runs function(line) for the queued lines on the task pool, in
+ * contiguous batches of about the same number of rows.
+ */
+template<typename Line, typename Function>
+static void prv_runBatches(std::vector<Line> &lines, size_t count,
+                           Function function);
+
+bool TraceGeometry::begin(void)
+{
+  lineCount_m = 0;
+  nextLine_m = 0;
+
+  /* The axes are final once the setup is locked */
+  ImPlot::SetupLock();
+  const ImPlotPlot &plot = *ImPlot::GetCurrentPlot();
+  const ImPlotAxis &xAxis = plot.Axes[plot.CurrentX];
+  const ImPlotAxis &yAxis = plot.Axes[plot.CurrentY];
+  enabled_m = !plot.FitThisFrame && xAxis.TransformForward == nullptr
+              && yAxis.TransformForward == nullptr;
+  if (!enabled_m)
+  {
+    return false;
+  }
+  plotId_m = plot.ID;
+
+  pixelMinX_m = xAxis.PixelMin;
+  rangeMinX_m = xAxis.Range.Min;
+  scaleX_m = xAxis.ScaleToPixel;
+  pixelMinY_m = yAxis.PixelMin;
+  rangeMinY_m = yAxis.Range.Min;
+  scaleY_m = yAxis.ScaleToPixel;
+  cullMin_m = plot.PlotRect.Min;
+  cullMax_m = plot.PlotRect.Max;
+
+  pDrawList_m = ImPlot::GetPlotDrawList();
+  texturedLines_m
+      = (pDrawList_m->Flags & ImDrawListFlags_AntiAliasedLines)
+        && (pDrawList_m->Flags & ImDrawListFlags_AntiAliasedLinesUseTex);
+  pTexUvLines_m = pDrawList_m->_Data->TexUvLines;
+  texUvWhitePixel_m = pDrawList_m->_Data->TexUvWhitePixel;
+  return true;
+}
+
+void TraceGeometry::addLine(const char *label, const HistorySnapshot &history,
+                            size_t segment, size_t channel, double shift)
+{
+  if (!enabled_m)
+  {
+    return;
+  }
+  if (lineCount_m == lines_m.size())
+  {
+    lines_m.emplace_back();
+  }
+  Line &line = lines_m[lineCount_m++];
+  line.label = label;
+  line.pHistory = &history;
+  line.segment = segment;
+  line.channel = channel;
+  line.shift = shift;
+  line.rows = static_cast<int>(history.getSegmentRows(segment));
+  line.counted = false;
+  line.reservations.clear();
+}
+
+void TraceGeometry::prepare(void)
+{
+  if (enabled_m)
+  {
+    prv_runBatches(lines_m, lineCount_m,
+                   [this](Line &line) { prv_count(line); });
+  }
+}
+
+bool TraceGeometry::plotLine(const char *label,
+                             const HistorySnapshot &history, size_t segment,
+                             size_t channel, double shift)
+{
+  if (!enabled_m || nextLine_m >= lineCount_m
+      || ImPlot::GetCurrentPlot()->ID != plotId_m)
+  {
+    return false;
+  }
+  Line &line = lines_m[nextLine_m];
+  if (line.pHistory != &history || line.segment != segment
+      || line.channel != channel || line.shift != shift || line.label != label)
+  {
+    return false;
+  }
+  nextLine_m++;
+
+  if (!ImPlot::BeginItem(label, ImPlotItemFlags_None, ImPlotCol_Line))
+  {
+    return true;
+  }
+
+  const ImPlotNextItemData &style = ImPlot::GetItemData();
+  if (line.rows > 1 && style.RenderLine)
+  {
+    if (!line.counted)
+    {
+      prv_count(line);
+    }
+    line.color = ImGui::GetColorU32(style.Colors[ImPlotCol_Line]);
+    line.halfWeight = ImMax(1.0f, style.LineWeight) * 0.5f;
+
+    /* Reserved like RenderPrimitivesEx(): up to the limit of 16-bit
+     * indices, in a new draw command when too few quads fit in the current
+     * one */
+    ImDrawList &drawList = *pDrawList_m;
+    const unsigned int maxIndex
+        = sizeof(ImDrawIdx) == 2 ? 0xFFFFu : 0xFFFFFFFFu;
+    unsigned int quads = line.quads;
+    while (quads > 0)
+    {
+      unsigned int count
+          = ImMin(quads, (maxIndex - drawList._VtxCurrentIdx) / 4);
+      if (count < ImMin(64u, quads))
+      {
+        count = ImMin(quads, maxIndex / 4);
+      }
+      drawList.PrimReserve(count * 6, count * 4);
+
+      Reservation reservation;
+      reservation.vertexOffset = static_cast<unsigned int>(
+          drawList._VtxWritePtr - drawList.VtxBuffer.Data);
+      reservation.indexOffset = static_cast<unsigned int>(
+          drawList._IdxWritePtr - drawList.IdxBuffer.Data);
+      reservation.firstIndex = drawList._VtxCurrentIdx;
+      reservation.quads = count;
+      line.reservations.push_back(reservation);
+
+      drawList._VtxWritePtr += count * 4;
+      drawList._IdxWritePtr += count * 6;
+      drawList._VtxCurrentIdx += count * 4;
+      quads -= count;
+    }
+  }
+  ImPlot::EndItem();
+  return true;
+}
+
+void TraceGeometry::end(void)
+{
+  if (enabled_m)
+  {
+    prv_runBatches(lines_m, nextLine_m,
+                   [this](Line &line)
+                   {
+                     if (!line.reservations.empty())
+                     {
+                       prv_fill(line);
+                     }
+                   });
+  }
+  enabled_m = false;
+}
+
+template<typename Line, typename Function>
+static void prv_runBatches(std::vector<Line> &lines, size_t count,
+                           Function function)
+{
+  size_t totalRows = 0;
+  for (size_t index = 0; index < count; ++index)
+  {
+    totalRows += lines[index].rows;
+  }
+
+  TaskPool &pool = getTaskPool();
+  size_t batches = (pool.getWorkerCount() + 1) * TRACE_BATCHES_PER_THREAD;
+  size_t batchRows = totalRows / batches + 1;
+
+  TaskGroup group(pool);
+  size_t first = 0;
+  while (first < count)
+  {
+    size_t last = first;
+    size_t rows = 0;
+    while (last < count && rows < batchRows)
+    {
+      rows += lines[last++].rows;
+    }
+    group.run(
+        [&lines, &function, first, last]
+        {
+          for (size_t index = first; index < last; ++index)
+          {
+            function(lines[index]);
+          }
+        });
+    first = last;
+  }
+  group.wait();
+}
+
+/**
+ * @brief Calls visit(p1, p2) for each segment of the line that ImPlot's
+ * RendererLineStrip keeps after culling, in pixels.
+ */
+template<typename Visit>
+void TraceGeometry::prv_forEachQuad(const Line &line, Visit visit) const
+{
+  const HistorySnapshot &history = *line.pHistory;
+  const float *pValues = line.pValues;
+  const float *pOffsets = line.pOffsets;
+  double step = history.getSegmentStep(line.segment);
+  double start = history.getSegmentStart(line.segment) + line.shift;
+  double origin = history.getSegmentOrigin(line.segment) + line.shift;
+
+  /* The points of PlotLine() for uniform segments, of the segment getter of
+   * the visualizer otherwise */
+  auto transform = [&](int index)
+  {
+    double x = pOffsets == nullptr ? step * index + start
+                                   : origin + pOffsets[index];
+    double y = static_cast<double>(pValues[index]);
+    float pixelX
+        = static_cast<float>(pixelMinX_m + scaleX_m * (x - rangeMinX_m));
+    float pixelY
+        = static_cast<float>(pixelMinY_m + scaleY_m * (y - rangeMinY_m));
+    return ImVec2(pixelX, pixelY);
+  };
+
+  ImRect cullRect(cullMin_m, cullMax_m);
+  ImVec2 p1 = transform(0);
+  for (int row = 1; row < line.rows; ++row)
+  {
+    ImVec2 p2 = transform(row);
+    if (cullRect.Overlaps(ImRect(ImMin(p1, p2), ImMax(p1, p2))))
+    {
+      visit(p1, p2);
+    }
+    p1 = p2;
+  }
+}
+
+void TraceGeometry::prv_count(Line &line) const
+{
+  line.counted = true;
+  line.quads = 0;
+  if (line.rows < 2)
+  {
+    return;
+  }
+
+  const HistorySnapshot &history = *line.pHistory;
+  line.pValues
+      = history.getSegmentValues(line.segment, line.channel, line.values);
+  line.pOffsets = nullptr;
+  if (!history.isSegmentUniform(line.segment))
+  {
+    line.pOffsets = history.getSegmentOffsets(line.segment, line.offsets);
+  }
+
+  unsigned int quads = 0;
+  prv_forEachQuad(line, [&quads](const ImVec2 &, const ImVec2 &) { quads++; });
+  line.quads = quads;
+}
+
+void TraceGeometry::prv_fill(const Line &line) const
+{
+  /* GetLineRenderProps() */
+  float halfWeight = line.halfWeight;
+  ImVec2 uv0 = texUvWhitePixel_m;
+  ImVec2 uv1 = texUvWhitePixel_m;
+  if (texturedLines_m)
+  {
+    ImVec4 uvs = pTexUvLines_m[static_cast<int>(halfWeight * 2)];
+    uv0 = ImVec2(uvs.x, uvs.y);
+    uv1 = ImVec2(uvs.z, uvs.w);
+    halfWeight += 1;
+  }
+  ImU32 color = line.color;
+
+  const Reservation *pReservation = line.reservations.data();
+  ImDrawVert *pVertex = pDrawList_m->VtxBuffer.Data + pReservation->vertexOffset;
+  ImDrawIdx *pIndex = pDrawList_m->IdxBuffer.Data + pReservation->indexOffset;
+  unsigned int vertex = pReservation->firstIndex;
+  unsigned int left = pReservation->quads;
+
+  /* PrimLine() */
+  prv_forEachQuad(
+      line,
+      [&](const ImVec2 &p1, const ImVec2 &p2)
+      {
+        if (left == 0)
+        {
+          pReservation++;
+          pVertex = pDrawList_m->VtxBuffer.Data + pReservation->vertexOffset;
+          pIndex = pDrawList_m->IdxBuffer.Data + pReservation->indexOffset;
+          vertex = pReservation->firstIndex;
+          left = pReservation->quads;
+        }
+        left--;
+
+        float dx = p2.x - p1.x;
+        float dy = p2.y - p1.y;
+        float d2 = dx * dx + dy * dy;
+        if (d2 > 0.0f)
+        {
+          float invLength = prv_invSqrt(d2);
+          dx *= invLength;
+          dy *= invLength;
+        }
+        dx *= halfWeight;
+        dy *= halfWeight;
+
+        pVertex[0].pos = ImVec2(p1.x + dy, p1.y - dx);
+        pVertex[0].uv = uv0;
+        pVertex[0].col = color;
+        pVertex[1].pos = ImVec2(p2.x + dy, p2.y - dx);
+        pVertex[1].uv = uv0;
+        pVertex[1].col = color;
+        pVertex[2].pos = ImVec2(p2.x - dy, p2.y + dx);
+        pVertex[2].uv = uv1;
+        pVertex[2].col = color;
+        pVertex[3].pos = ImVec2(p1.x - dy, p1.y + dx);
+        pVertex[3].uv = uv1;
+        pVertex[3].col = color;
+        pVertex += 4;
+
+        pIndex[0] = static_cast<ImDrawIdx>(vertex);
+        pIndex[1] = static_cast<ImDrawIdx>(vertex + 1);
+        pIndex[2] = static_cast<ImDrawIdx>(vertex + 2);
+        pIndex[3] = static_cast<ImDrawIdx>(vertex);
+        pIndex[4] = static_cast<ImDrawIdx>(vertex + 2);
+        pIndex[5] = static_cast<ImDrawIdx>(vertex + 3);
+        pIndex += 6;
+        vertex += 4;
+      });
+}
@@ -0,0 +1,126 @@
+#pragma once
+/** @file      traceGeometry.h
+ *  @brief     Header file for the trace lines generated on the task pool.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/03/14
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "../backends/imgui.h"
+#include "../backends/implot.h"
+#include "../serial/historyStore.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Vertices of the history lines of a plot, generated in parallel.
+ *
+ * ImPlot::PlotLine turns every segment into draw list vertices on the UI
+ * thread. Here the lines of a plot are queued, then read (unpacking
+ * compressed chunks), transformed and culled on the task pool to count their
+ * quads. When the plot reaches a line, it is registered as an ImPlot item and
+ * its quads are only reserved in the draw list, in the order ImPlot would have
+ * drawn them; end() fills the reserved vertices and indices on the task pool.
+ * The quads are the ones ImPlot's line strip renderer makes, so the output is
+ * the same.
+ *
+ * Used on the UI thread, between BeginPlot and EndPlot: begin(), addLine()
+ * for each line, prepare(), then plotLine() where ImPlot::PlotLine was called
+ * and end() once all are plotted. Lines are left to ImPlot while the axes are
+ * fitted, since they are then needed to extend the axes, and when an axis is
+ * not linear.
+ */
+class TraceGeometry
+{
+public:
+  /**
+   * @brief Starts the lines of the current plot, dropping the previous ones.
+   * @return false when ImPlot has to plot the lines itself this frame.
+   */
+  bool begin(void);
+
+  /* Queues the line of one segment of a history channel */
+  void addLine(const char *label, const HistorySnapshot &history,
+               size_t segment, size_t channel, double shift = 0.0);
+
+  /* Counts the quads of the queued lines, returns once all are counted */
+  void prepare(void);
+
+  /**
+   * @brief Plots the line of a segment if it is the next one queued.
+   * @return false when it was not queued, for ImPlot to plot it.
+   */
+  bool plotLine(const char *label, const HistorySnapshot &history,
+                size_t segment, size_t channel, double shift = 0.0);
+
+  /* Fills the quads reserved by plotLine(), returns once all are filled */
+  void end(void);
+
+private:
+  /* Quads of a line within one draw command */
+  struct Reservation
+  {
+    unsigned int vertexOffset; /* In the vertex buffer of the draw list */
+    unsigned int indexOffset;  /* In its index buffer */
+    unsigned int firstIndex;   /* Index of the first vertex */
+    unsigned int quads;
+  };
+
+  struct Line
+  {
+    std::string label;
+    const HistorySnapshot *pHistory = nullptr;
+    size_t segment = 0;
+    size_t channel = 0;
+    double shift = 0.0;
+    int rows = 0;
+
+    const float *pValues = nullptr;  /* Points to values or the history */
+    const float *pOffsets = nullptr; /* Null for a uniform segment */
+    std::vector<float> values;       /* Converted or unpacked values */
+    std::vector<float> offsets;      /* Unpacked times */
+    bool counted = false;
+    unsigned int quads = 0;
+
+    /* Style of the item, known when it is plotted */
+    ImU32 color = 0;
+    float halfWeight = 0.5f;
+    std::vector<Reservation> reservations;
+  };
+
+  template<typename Visit>
+  void prv_forEachQuad(const Line &line, Visit visit) const;
+
+  void prv_count(Line &line) const;
+
+  void prv_fill(const Line &line) const;
+
+  std::vector<Line> lines_m; /* Kept from one plot to the next */
+  size_t lineCount_m = 0;
+  size_t nextLine_m = 0;
+  bool enabled_m = false;
+  ImGuiID plotId_m = 0;
+  ImDrawList *pDrawList_m = nullptr;
+
+  /* Plot to pixels, as ImPlot's transformer for linear axes */
+  double pixelMinX_m = 0.0;
+  double rangeMinX_m = 0.0;
+  double scaleX_m = 0.0;
+  double pixelMinY_m = 0.0;
+  double rangeMinY_m = 0.0;
+  double scaleY_m = 0.0;
+  ImVec2 cullMin_m;
+  ImVec2 cullMax_m;
+
+  /* Texture coordinates of the lines, from the shared data of the draw list */
+  bool texturedLines_m = false;
+  const ImVec4 *pTexUvLines_m = nullptr;
+  ImVec2 texUvWhitePixel_m;
+};
@@ -19,10 +19,18 @@
 #include "../Libraries/lib.h"
 #include <algorithm>
 #include "dataReceptionSettings.h"
+#include "../serial/serialComms.h"
 #include <cstring>
+#include <mutex>
 
 static int bufferDataSize = 1000; // Default to 1000 elements
 
+/* Edited by the UI, read by the reader thread */
+static std::mutex storageMutex;
+static std::vector<ChannelStorage> channelStorage;
+static TimeAxisStorage timeAxis;
+static HistoryRetention retention;
+
 static std::vector<std::string> dataLabels;
 static bool channelVisibility[3] = {false, false, false}; // Track which channels are visible for individual plots (Lite version: 3 channels)
 
@@ -57,6 +65,143 @@ void prv_imGuiSetDataSizeWidget(void)
   bufferDataSize = std::clamp(bufferDataSize, min, max);
 }
 
+/**
+ * @brief Displays the storage of one history channel: the type its received
+ * values are kept as, and the scale and offset that turn them into the
+ * displayed values (e.g. ADC counts kept as int16, displayed in volts).
+ */
+static void prv_channelStorageWidget(int channel)
+{
+  std::lock_guard<std::mutex> lock(storageMutex);
+  if (channelStorage.size() <= static_cast<size_t>(channel))
+  {
+    channelStorage.resize(channel + 1);
+  }
+  ChannelStorage &storage = channelStorage[channel];
+  std::string suffix = "##Storage" + std::to_string(channel);
+
+  const char *typeChoices[STORAGE_TYPE_COUNT];
+  for (int type = 0; type < STORAGE_TYPE_COUNT; ++type)
+  {
+    typeChoices[type] = getStorageTypeName(static_cast<StorageType_t>(type));
+  }
+  int typeIndex = storage.type;
+  if (ImGui::Combo(("History type" + suffix).c_str(), &typeIndex, typeChoices,
+                   STORAGE_TYPE_COUNT))
+  {
+    storage.type = static_cast<StorageType_t>(typeIndex);
+  }
+  if (ImGui::IsItemHovered())
+  {
+    ImGui::SetTooltip("Integer types round the received values and use less "
+                      "memory: int16 keeps twice the history of float32. "
+                      "Changing the type clears the history");
+  }
+
+  ImGui::InputFloat(("Scale" + suffix).c_str(), &storage.scale, 0.0f, 0.0f,
+                    "%.6g");
+  ImGui::InputFloat(("Offset" + suffix).c_str(), &storage.offset, 0.0f, 0.0f,
+                    "%.6g");
+  if (storage.scale == 0.0f)
+  {
+    storage.scale = 1.0f;
+  }
+}
+
+void getChannelStorage(std::vector<ChannelStorage> &storage)
+{
+  std::lock_guard<std::mutex> lock(storageMutex);
+  storage = channelStorage;
+}
+
+/**
+ * @brief Displays how the history keeps the time of the samples: one
+ * timestamp each, or a start and a period per chunk measured from the
+ * arrivals or given by the sample rate of the device.
+ */
+static void prv_timeAxisWidget(void)
+{
+  std::lock_guard<std::mutex> lock(storageMutex);
+
+  const char *modeChoices[TIME_AXIS_MODE_COUNT];
+  for (int mode = 0; mode < TIME_AXIS_MODE_COUNT; ++mode)
+  {
+    modeChoices[mode] = getTimeAxisModeName(static_cast<TimeAxisMode_t>(mode));
+  }
+  int modeIndex = timeAxis.mode;
+  if (ImGui::Combo("Time axis", &modeIndex, modeChoices, TIME_AXIS_MODE_COUNT))
+  {
+    timeAxis.mode = static_cast<TimeAxisMode_t>(modeIndex);
+  }
+  if (ImGui::IsItemHovered())
+  {
+    ImGui::SetTooltip("Uniform modes keep no time per sample, for devices "
+                      "sampling at a steady rate. A pause or a reconnection "
+                      "starts a new segment. Changing the mode clears the "
+                      "history");
+  }
+
+  if (timeAxis.mode == TIME_AXIS_FIXED_RATE)
+  {
+    ImGui::InputDouble("Sample rate (Hz)", &timeAxis.sampleRate, 0.0, 0.0,
+                       "%.6g");
+    if (timeAxis.sampleRate <= 0.0)
+    {
+      timeAxis.sampleRate = 1000.0;
+    }
+  }
+}
+
+void getTimeAxis(TimeAxisStorage &storage)
+{
+  std::lock_guard<std::mutex> lock(storageMutex);
+  storage = timeAxis;
+}
+
+/**
+ * @brief Displays the long-term history: the samples leaving the data size
+ * window are kept as min/max/mean tiers within a memory budget, and the
+ * compression of the stored blocks.
+ */
+static void prv_retentionWidget(void)
+{
+  std::lock_guard<std::mutex> lock(storageMutex);
+
+  ImGui::Checkbox("Long-term history", &retention.enabled);
+  if (ImGui::IsItemHovered())
+  {
+    ImGui::SetTooltip("Samples older than the data size are kept as the "
+                      "min, max and mean of every 10, then every 100 "
+                      "samples, and plotted as a band");
+  }
+  ImGui::Checkbox("Compress history", &retention.compress);
+  if (ImGui::IsItemHovered())
+  {
+    ImGui::SetTooltip("Full blocks of samples are packed losslessly, several "
+                      "times smaller for slowly varying signals (int16 "
+                      "storage packs best); applies to the blocks filled from "
+                      "then on");
+  }
+  if (!retention.enabled)
+  {
+    return;
+  }
+
+  int budgetMegabytes = static_cast<int>(retention.budgetBytes >> 20);
+  if (ImGui::InputInt("Memory budget (MB)", &budgetMegabytes))
+  {
+    budgetMegabytes = std::clamp(budgetMegabytes, 1, 4096);
+    retention.budgetBytes = static_cast<size_t>(budgetMegabytes) << 20;
+  }
+  ImGui::Checkbox("Shrink when system memory is low", &retention.watchMemory);
+}
+
+void getHistoryRetention(HistoryRetention &storage)
+{
+  std::lock_guard<std::mutex> lock(storageMutex);
+  storage = retention;
+}
+
 void prv_dataLabels(void)
 {
   ImGui::Text("Channel Configuration:");
@@ -107,6 +252,8 @@ void prv_dataLabels(void)
         dataLabels[i] = "Channel " + std::to_string(i + 1);
       }
     }
+
+    prv_channelStorageWidget(i);
     
     ImGui::EndGroup();
     
@@ -120,6 +267,14 @@ void prv_dataLabels(void)
 
 void getDataLabels(std::vector<std::string> &labels)
 {
+  // Processed channels are named by the display outputs of the graph
+  std::shared_ptr<const ProcessingSchedule> pSchedule = getProcessingSchedule();
+  if (pSchedule)
+  {
+    labels = pSchedule->displayLabels;
+    return;
+  }
+
   labels = dataLabels;
   
   // Ensure no empty labels are returned - provide defaults if needed
@@ -161,6 +316,10 @@ void viewerSettings(void)
   {
     prv_imGuiSetDataSizeWidget();
 
+    prv_timeAxisWidget();
+
+    prv_retentionWidget();
+
     prv_dataLabels();
   }
 }
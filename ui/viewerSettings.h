@@ -15,6 +15,7 @@
 
 #include <string>
 #include <vector>
+#include "../serial/channelStorage.h"
 
 /**
  * @brief Displays viewer settings using ImGui, including live view settings.
@@ -56,6 +57,23 @@ int viewerDataSize(void);
  */
 void getDataLabels(std::vector<std::string> &labels);
 
+/**
+ * @brief Gets the history storage set for each channel.
+ * @param storage One entry per channel configured so far, the others are
+ * stored as float32
+ */
+void getChannelStorage(std::vector<ChannelStorage> &storage);
+
+/**
+ * @brief Gets how the history keeps the time of the samples.
+ */
+void getTimeAxis(TimeAxisStorage &storage);
+
+/**
+ * @brief Gets the long-term tiers of the history.
+ */
+void getHistoryRetention(HistoryRetention &storage);
+
 /**
  * @brief Gets the visibility status of channels for individual plots
  * @param visibility Vector to store the visibility status of each channel
@@ -14,6 +14,7 @@
 
 #include "visualizer.h"
 #include "../serial/serialComms.h"
+#include "../serial/multiPortCapture.h"
 #include "../backends/imgui.h"
 #include "../backends/implot.h"
 #include "serialSettings.h"
@@ -22,66 +23,428 @@
 #include "viewerSettings.h"
 #include "generalSettings.h"
 #include "dataReceptionSettings.h"
+#include "referenceTraces.h"
+#include "plotLayerCache.h"
+#include "traceGeometry.h"
+#include "../tasks/taskPool.h"
 #include <iostream> // For std::cerr and std::endl
+#include <cmath>
+#include <memory>
 /* Mutex for floatData */
 std::mutex dataMutex;
 
 // Static variables for plot view management
 static int currentPlotView = 0; // 0 = combined view, 1+ = individual channels
 
-// Function to render a single channel plot
-void renderChannelPlot(int channelIndex, const std::string& channelName, const ImVec4& color)
+/* History shown by the plots, replaced every frame unless the display is
+ * frozen */
+struct PortHistory
+{
+    std::string name;
+    HistorySnapshot history;
+};
+/* Statistics of one channel of the displayed history, gap markers (NaN)
+ * excluded */
+struct ChannelStatistics
+{
+    float minValue = 0.0f;
+    float maxValue = 0.0f;
+    float average = 0.0f;
+    size_t count = 0;
+};
+static HistorySnapshot displayHistory;
+static HistorySnapshot displayTiers[HISTORY_TIER_COUNT]; /* Finest first */
+static std::vector<ChannelStatistics> displayStatistics;
+static std::vector<PortHistory> displayPortHistory;
+static bool displayFrozen = false;
+static bool fitAfterResume = false;
+
+/* Static layers of the plots, see PlotLayerCache */
+static PlotLayerCache combinedPlotCache;
+static std::vector<std::unique_ptr<PlotLayerCache>> channelPlotCaches;
+
+/* Lines of the displayed channels, generated on the task pool */
+static TraceGeometry traceGeometry;
+
+/* Colors of the channels, shared by every view */
+static const ImVec4 channelColors[] = {
+    ImVec4(1.0f, 0.400f, 0.400f, 1.0f), // Red
+    ImVec4(0.0f, 0.600f, 0.200f, 1.0f), // Green
+    ImVec4(0.0f, 0.541f, 0.902f, 1.0f), // Blue
+    ImVec4(1.0f, 0.843f, 0.0f, 1.0f),   // Yellow
+    ImVec4(0.580f, 0.0f, 0.827f, 1.0f), // Purple
+    ImVec4(1.0f, 0.647f, 0.0f, 1.0f),   // Orange
+    ImVec4(0.0f, 0.808f, 0.820f, 1.0f), // Cyan
+    ImVec4(0.5f, 0.0f, 0.5f, 1.0f),     // Magenta
+    ImVec4(0.722f, 0.525f, 0.043f, 1.0f), // Brown
+    ImVec4(0.5f, 0.5f, 0.5f, 1.0f),     // Gray
+};
+
+// Function to compute the statistics of one channel of a history
+static ChannelStatistics prv_channelStatistics(const HistorySnapshot &history,
+                                               size_t channel)
+{
+    ChannelStatistics statistics;
+
+    /* Computed on the stored type of the channel, then scaled */
+    SpanStatistics span;
+    history.getChannelStatistics(channel, span);
+    if (span.count > 0)
+    {
+        statistics.minValue = span.minValue;
+        statistics.maxValue = span.maxValue;
+        statistics.average = static_cast<float>(span.sum / span.count);
+        statistics.count = span.count;
+    }
+    return statistics;
+}
+
+// Function to compute the statistics of every channel, one task per channel
+// on the task pool, all joined before anything is drawn
+static void prv_updateDisplayStatistics(void)
+{
+    displayStatistics.assign(displayHistory.getChannelCount(), ChannelStatistics());
+
+    TaskGroup group(getTaskPool());
+    for (size_t channel = 0; channel < displayStatistics.size(); ++channel)
+    {
+        group.run([channel]
+                  { displayStatistics[channel] = prv_channelStatistics(displayHistory, channel); });
+    }
+    group.wait();
+}
+
+// Function to take the histories to display this frame
+static void prv_updateDisplayHistory(void)
+{
+    bool frozen = isDisplayFrozen();
+
+    /* Frozen: keep the snapshots, acquisition and recording go on */
+    if (frozen && displayFrozen)
+    {
+        return;
+    }
+    if (!frozen && displayFrozen)
+    {
+        fitAfterResume = true;
+    }
+    displayFrozen = frozen;
+
+    displayHistory = getChannelHistory();
+    for (size_t level = 0; level < HISTORY_TIER_COUNT; ++level)
+    {
+        displayTiers[level] = getChannelHistoryTier(level + 1);
+    }
+    displayPortHistory.resize(getCapturePortCount());
+    for (size_t port = 0; port < displayPortHistory.size(); ++port)
+    {
+        SerialDevice *pDevice = getCapturePort(port);
+        displayPortHistory[port].name = pDevice->getPortName();
+        displayPortHistory[port].history = pDevice->getHistory().snapshot();
+    }
+
+    prv_updateDisplayStatistics();
+}
+
+// Function to identify what the plots draw while the display is frozen, the
+// cached plots are drawn again when it changes
+static uint64_t prv_frozenContentKey(void)
+{
+    std::hash<std::string> hashString;
+    std::hash<double> hashDouble;
+    uint64_t key = 14695981039346656037ULL;
+    auto combine = [&key](uint64_t value) { key = (key ^ value) * 1099511628211ULL; };
+
+    combine(displayHistory.getRowCount());
+    combine(hashDouble(displayHistory.empty() ? 0.0 : displayHistory.getLastTime()));
+    for (const PortHistory& port : displayPortHistory)
+    {
+        combine(port.history.getRowCount());
+    }
+
+    std::vector<std::string> labels;
+    getDataLabels(labels);
+    for (const std::string& label : labels)
+    {
+        combine(hashString(label));
+    }
+
+    for (size_t index = 0; index < getReferenceTraceCount(); ++index)
+    {
+        const ReferenceTrace& reference = getReferenceTrace(index);
+        combine(hashString(reference.name));
+        combine(reference.visible);
+        combine(reference.showDifference);
+        combine(hashDouble(reference.shift));
+    }
+    return key;
+}
+
+// Rows of a timestamped segment, placed at origin + offset in double
+struct SegmentPoints
+{
+    double origin;
+    const float *pOffsets;
+    const float *pValues;
+};
+
+static ImPlotPoint prv_segmentPoint(int index, void *pData)
+{
+    const SegmentPoints *pPoints = static_cast<const SegmentPoints *>(pData);
+    return ImPlotPoint(pPoints->origin + pPoints->pOffsets[index],
+                       pPoints->pValues[index]);
+}
+
+// Segments narrower than this on screen are drawn as their range of values,
+// from the statistics kept with compressed chunks
+#define PLOT_LOD_PIXELS (2.0)
+
+static bool prv_isSegmentTiny(const HistorySnapshot &history, size_t segment)
+{
+    double span = ImPlot::GetPlotLimits().X.Size();
+    if (span <= 0.0)
+    {
+        return false;
+    }
+    double pixels = (history.getSegmentEnd(segment) - history.getSegmentStart(segment))
+                    * ImPlot::GetPlotSize().x / span;
+    return pixels < PLOT_LOD_PIXELS;
+}
+
+static void prv_plotSegmentRange(const char *label, const HistorySnapshot &history,
+                                 size_t segment, float low, float high, double shift = 0.0)
+{
+    if (std::isnan(low) || std::isnan(high))
+    {
+        return;
+    }
+    double xs[2] = {history.getSegmentStart(segment) + shift,
+                    history.getSegmentEnd(segment) + shift};
+    double lows[2] = {low, low};
+    double highs[2] = {high, high};
+    ImPlot::PlotShaded(label, xs, lows, highs, 2);
+}
+
+// Function to plot one channel of a history, one line per stored chunk,
+// shift seconds later than recorded
+static void prv_plotHistoryChannel(const char *label, const HistorySnapshot &history,
+                                   size_t channel, const ImVec4& color, double shift = 0.0)
+{
+    if (channel >= history.getChannelCount())
+    {
+        return;
+    }
+
+    /* Integer and scaled channels are converted one segment at a time */
+    static std::vector<float> converted;
+    static std::vector<float> offsets;
+
+    ImPlot::PushStyleColor(ImPlotCol_Line, color);
+    ImPlot::PushStyleColor(ImPlotCol_Fill, color);
+    for (size_t segment = 0; segment < history.getSegmentCount(); ++segment)
+    {
+        if (prv_isSegmentTiny(history, segment))
+        {
+            SpanStatistics range;
+            history.getSegmentStatistics(segment, channel, range);
+            prv_plotSegmentRange(label, history, segment, range.minValue, range.maxValue,
+                                 shift);
+            continue;
+        }
+
+        /* Counted beforehand when queued, see prv_queueHistoryLines() */
+        if (traceGeometry.plotLine(label, history, segment, channel, shift))
+        {
+            continue;
+        }
+
+        const float *pValues = history.getSegmentValues(segment, channel, converted);
+        int rows = static_cast<int>(history.getSegmentRows(segment));
+
+        /* Uniform segments are placed by ImPlot from their start and step */
+        if (history.isSegmentUniform(segment))
+        {
+            ImPlot::PlotLine(label, pValues, rows, history.getSegmentStep(segment),
+                             history.getSegmentStart(segment) + shift);
+        }
+        else
+        {
+            SegmentPoints points = {history.getSegmentOrigin(segment) + shift,
+                                    history.getSegmentOffsets(segment, offsets), pValues};
+            ImPlot::PlotLineG(label, prv_segmentPoint, &points, rows);
+        }
+    }
+    ImPlot::PopStyleColor(2);
+}
+
+// Function to queue the lines prv_plotHistoryChannel() draws for one channel,
+// to count them on the task pool before plotting
+static void prv_queueHistoryLines(const char *label, const HistorySnapshot &history,
+                                  size_t channel)
+{
+    if (channel >= history.getChannelCount())
+    {
+        return;
+    }
+
+    for (size_t segment = 0; segment < history.getSegmentCount(); ++segment)
+    {
+        if (!prv_isSegmentTiny(history, segment))
+        {
+            traceGeometry.addLine(label, history, segment, channel);
+        }
+    }
+}
+
+// Function to plot one channel of a long-term tier: the min/max band and the
+// mean, under the same label as the full-rate line
+static void prv_plotTierChannel(const char *label, const HistorySnapshot &tier,
+                                size_t channel, const ImVec4& color)
+{
+    size_t channels = tier.getChannelCount() / 3;
+    if (channel >= channels)
+    {
+        return;
+    }
+
+    static std::vector<float> minValues;
+    static std::vector<float> maxValues;
+    static std::vector<float> meanValues;
+    static std::vector<float> offsets;
+
+    ImVec4 bandColor = color;
+    bandColor.w *= 0.25f;
+    ImPlot::PushStyleColor(ImPlotCol_Line, color);
+    ImPlot::PushStyleColor(ImPlotCol_Fill, bandColor);
+    for (size_t segment = 0; segment < tier.getSegmentCount(); ++segment)
+    {
+        if (prv_isSegmentTiny(tier, segment))
+        {
+            SpanStatistics low;
+            SpanStatistics high;
+            tier.getSegmentStatistics(segment, channel, low);
+            tier.getSegmentStatistics(segment, channels + channel, high);
+            prv_plotSegmentRange(label, tier, segment, low.minValue, high.maxValue);
+            continue;
+        }
+
+        int rows = static_cast<int>(tier.getSegmentRows(segment));
+        double origin = tier.getSegmentOrigin(segment);
+        const float *pOffsets = tier.getSegmentOffsets(segment, offsets);
+        SegmentPoints low = {origin, pOffsets,
+                             tier.getSegmentValues(segment, channel, minValues)};
+        SegmentPoints high = {origin, pOffsets,
+                              tier.getSegmentValues(segment, channels + channel, maxValues)};
+        SegmentPoints mean = {origin, pOffsets,
+                              tier.getSegmentValues(segment, 2 * channels + channel, meanValues)};
+        ImPlot::PlotShadedG(label, prv_segmentPoint, &low, prv_segmentPoint, &high, rows);
+        ImPlot::PlotLineG(label, prv_segmentPoint, &mean, rows);
+    }
+    ImPlot::PopStyleColor(2);
+}
+
+// Times and values of a difference with a reference
+struct DifferencePoints
+{
+    const double *pTimes;
+    const float *pValues;
+};
+
+static ImPlotPoint prv_differencePoint(int index, void *pData)
+{
+    const DifferencePoints *pPoints = static_cast<const DifferencePoints *>(pData);
+    return ImPlotPoint(pPoints->pTimes[index], pPoints->pValues[index]);
+}
+
+// Function to plot one channel of the visible reference traces, fainter than
+// the live data, and its difference with the live data when requested
+static void prv_plotReferenceChannels(size_t channel, const std::string& channelName,
+                                      const ImVec4& color)
 {
-    if (channelIndex < channelsData.size() && !channelsData[channelIndex].empty())
+    ImVec4 referenceColor = color;
+    referenceColor.w *= 0.45f;
+
+    for (size_t index = 0; index < getReferenceTraceCount(); ++index)
     {
-        if (channelsData[channelIndex].size() == xValues.size())
+        const ReferenceTrace& reference = getReferenceTrace(index);
+        if (!reference.visible)
+        {
+            continue;
+        }
+
+        std::string label = std::string(reference.name) + ":" + channelName;
+        prv_plotHistoryChannel(label.c_str(), reference.history, channel,
+                               referenceColor, reference.shift);
+
+        if (!reference.showDifference || channel >= reference.differenceTimes.size())
         {
-            ImPlot::PushStyleColor(ImPlotCol_Line, color);
-            ImPlot::PlotLine(channelName.c_str(), xValues.data(),
-                             channelsData[channelIndex].data(),
-                             static_cast<int>(xValues.size()));
-            ImPlot::PopStyleColor();
+            continue;
         }
+        DifferencePoints points = {reference.differenceTimes[channel].data(),
+                                   reference.differenceValues[channel].data()};
+        std::string differenceLabel = label + " difference";
+        ImPlot::PushStyleColor(ImPlotCol_Line, color);
+        ImPlot::PushStyleVar(ImPlotStyleVar_LineWeight, 2.0f);
+        ImPlot::PlotLineG(differenceLabel.c_str(), prv_differencePoint, &points,
+                          static_cast<int>(reference.differenceTimes[channel].size()));
+        ImPlot::PopStyleVar();
+        ImPlot::PopStyleColor();
+    }
+}
+
+// Function to render a single channel plot, the oldest data first
+void renderChannelPlot(int channelIndex, const std::string& channelName, const ImVec4& color)
+{
+    for (size_t level = HISTORY_TIER_COUNT; level > 0; --level)
+    {
+        prv_plotTierChannel(channelName.c_str(), displayTiers[level - 1], channelIndex, color);
     }
+    prv_plotReferenceChannels(channelIndex, channelName, color);
+    prv_plotHistoryChannel(channelName.c_str(), displayHistory, channelIndex, color);
 }
 
 // Function to render statistics for a channel
 void renderChannelStatistics(int channelIndex)
 {
-    if (channelIndex < channelsData.size() && !channelsData[channelIndex].empty())
+    const HistorySnapshot& history = displayHistory;
+    if (channelIndex >= static_cast<int>(displayStatistics.size()) || history.empty())
+    {
+        return;
+    }
+
+    ImGui::Separator();
+    ImGui::Text("Channel Statistics:");
+
+    // Computed for all channels when the displayed history changes, see
+    // prv_updateDisplayStatistics()
+    const ChannelStatistics& statistics = displayStatistics[channelIndex];
+    float minVal = statistics.minValue;
+    float maxVal = statistics.maxValue;
+    float avg = statistics.average;
+
+    // Display statistics
+    ImGui::Text("Min: %.6f", minVal);
+    ImGui::Text("Max: %.6f", maxVal);
+    ImGui::Text("Avg: %.6f", avg);
+    ImGui::Text("Range: %.6f", maxVal - minVal);
+    ImGui::Text("Data Points: %zu", history.getRowCount());
+
+    double timeSpan = history.getLastTime() - history.getFirstTime();
+    ImGui::Text("Time Span: %.3f s", timeSpan);
+}
+
+// Function to render the channels of the additional capture ports
+void renderCapturePortPlots(const ImVec4 *colors, int colorCount, int firstColor)
+{
+    int colorIndex = firstColor;
+
+    for (const PortHistory& port : displayPortHistory)
     {
-        const std::vector<float>& channelData = channelsData[channelIndex];
-        
-        if (channelData.size() == xValues.size())
+        for (size_t ch = 0; ch < port.history.getChannelCount(); ++ch)
         {
-            ImGui::Separator();
-            ImGui::Text("Channel Statistics:");
-            
-            // Calculate statistics
-            float minVal = channelData[0], maxVal = channelData[0];
-            float sum = 0.0f;
-            
-            for (size_t i = 0; i < channelData.size(); ++i)
-            {
-                if (channelData[i] < minVal) minVal = channelData[i];
-                if (channelData[i] > maxVal) maxVal = channelData[i];
-                sum += channelData[i];
-            }
-            
-            float avg = sum / channelData.size();
-            
-            // Display statistics
-            ImGui::Text("Min: %.6f", minVal);
-            ImGui::Text("Max: %.6f", maxVal);
-            ImGui::Text("Avg: %.6f", avg);
-            ImGui::Text("Range: %.6f", maxVal - minVal);
-            ImGui::Text("Data Points: %zu", channelData.size());
-            
-            if (!xValues.empty())
-            {
-                float timeSpan = xValues.back() - xValues.front();
-                ImGui::Text("Time Span: %.3f s", timeSpan);
-            }
+            std::string label = port.name + ":Channel_" + std::to_string(ch + 1);
+            prv_plotHistoryChannel(label.c_str(), port.history, ch,
+                                   colors[colorIndex++ % colorCount]);
         }
     }
 }
@@ -99,6 +462,8 @@ void plot(void)
 
   if (isSerialPortOpened())
   {
+    prv_updateDisplayHistory();
+    updateReferenceTraces(displayHistory);
     serialTerminal();
 
     // Get the main dockspace ID
@@ -112,55 +477,55 @@ void plot(void)
     
     // Plot area for combined view only
     ImVec2 plotSize = ImGui::GetContentRegionAvail();
-    std::string plotTitle = "Combined View";
+    std::string plotTitle = displayFrozen ? "Combined View (frozen)" : "Combined View";
 
-    if (ImPlot::BeginPlot(plotTitle.c_str(), plotSize))
+    /* Back to live: show the data acquired while frozen */
+    if (fitAfterResume)
     {
-      if (isThemeDarkSelected())
-      {
-        ImPlot::StyleColorsDark();
-      }
-      else
-      {
-        ImPlot::StyleColorsLight();
-      }
-
-      // Set up axes
-      ImPlot::SetupAxes("Time (s)", "Value");
+      ImPlot::SetNextAxesToFit();
+      fitAfterResume = false;
+    }
 
-      const int numChannels = channelsData.size();
+    // Identifies the frozen data, the whole plot is cached meanwhile
+    uint64_t frozenContent = displayFrozen ? prv_frozenContentKey() : 0;
+    combinedPlotCache.plot(plotTitle, "Time (s)", "Value", plotSize,
+                           displayFrozen, frozenContent, []
+    {
+      const int numChannels = static_cast<int>(displayHistory.getChannelCount());
       std::vector<std::string> labels;
       getDataLabels(labels);
 
-      const ImVec4 colors[] = {
-          ImVec4(1.0f, 0.400f, 0.400f, 1.0f), // Red
-          ImVec4(0.0f, 0.600f, 0.200f, 1.0f), // Green
-          ImVec4(0.0f, 0.541f, 0.902f, 1.0f), // Blue
-          ImVec4(1.0f, 0.843f, 0.0f, 1.0f),   // Yellow
-          ImVec4(0.580f, 0.0f, 0.827f, 1.0f), // Purple
-          ImVec4(1.0f, 0.647f, 0.0f, 1.0f),   // Orange
-          ImVec4(0.0f, 0.808f, 0.820f, 1.0f), // Cyan
-          ImVec4(0.5f, 0.0f, 0.5f, 1.0f),     // Magenta
-          ImVec4(0.722f, 0.525f, 0.043f, 1.0f), // Brown
-          ImVec4(0.5f, 0.5f, 0.5f, 1.0f),     // Gray
-      };
-
-      // Check if xValues is not empty
-      if (!xValues.empty())
+      const auto &colors = channelColors;
+
+      // Check if there is data to plot
+      if (!displayHistory.empty())
       {
+        // Lines of all the channels counted in parallel, plotted in order
+        if (traceGeometry.begin())
+        {
+          for (int i = 0; i < numChannels && i < static_cast<int>(labels.size()); ++i)
+          {
+            prv_queueHistoryLines(labels[i].c_str(), displayHistory, i);
+          }
+          traceGeometry.prepare();
+        }
+
         // Combined view - plot all channels
         for (int i = 0; i < numChannels && i < labels.size(); ++i)
         {
           renderChannelPlot(i, labels[i], colors[i % (sizeof(colors) / sizeof(colors[0]))]);
         }
+        traceGeometry.end();
       }
       else
       {
         std::cerr << "No x-axis data available" << std::endl;
       }
 
-      ImPlot::EndPlot();
-    }
+      // Additional ports share the time axis of the primary port
+      const int colorCount = sizeof(colors) / sizeof(colors[0]);
+      renderCapturePortPlots(colors, colorCount, numChannels);
+    });
 
     ImGui::End();
     
@@ -169,6 +534,12 @@ void plot(void)
   }
 }
 
+ImVec4 getChannelColor(int channelIndex)
+{
+    const int colorCount = sizeof(channelColors) / sizeof(channelColors[0]);
+    return channelColors[channelIndex % colorCount];
+}
+
 int getCurrentPlotView(void)
 {
     return currentPlotView;
@@ -215,22 +586,17 @@ void renderIndividualPlotWindows(void)
     std::vector<std::string> labels;
     getDataLabels(labels);
     
-    const ImVec4 colors[] = {
-        ImVec4(1.0f, 0.400f, 0.400f, 1.0f), // Red
-        ImVec4(0.0f, 0.600f, 0.200f, 1.0f), // Green
-        ImVec4(0.0f, 0.541f, 0.902f, 1.0f), // Blue
-        ImVec4(1.0f, 0.843f, 0.0f, 1.0f),   // Yellow
-        ImVec4(0.580f, 0.0f, 0.827f, 1.0f), // Purple
-        ImVec4(1.0f, 0.647f, 0.0f, 1.0f),   // Orange
-        ImVec4(0.0f, 0.808f, 0.820f, 1.0f), // Cyan
-        ImVec4(0.5f, 0.0f, 0.5f, 1.0f),     // Magenta
-        ImVec4(0.722f, 0.525f, 0.043f, 1.0f), // Brown
-        ImVec4(0.5f, 0.5f, 0.5f, 1.0f),     // Gray
-    };
+    const auto &colors = channelColors;
     
     // Get the main dockspace ID
     ImGuiID dockspaceId = ImGui::GetID("InvisibleWindowDockSpace");
     
+    // Identifies the frozen data, the same for every window
+    uint64_t frozenContent = displayFrozen ? prv_frozenContentKey() : 0;
+
+    // Caches of the windows not drawn this frame are freed after the loop
+    std::vector<bool> cacheUsed(channelPlotCaches.size(), false);
+
     // Render individual windows for visible channels only
     for (int i = 0; i < channelVisibility.size() && i < labels.size(); ++i)
     {
@@ -255,26 +621,32 @@ void renderIndividualPlotWindows(void)
             {
                 ImVec2 plotSize = ImGui::GetContentRegionAvail();
                 
-                if (ImPlot::BeginPlot(safeLabel.c_str(), plotSize))
+                if (i >= static_cast<int>(channelPlotCaches.size()))
                 {
-                    if (isThemeDarkSelected())
-                    {
-                        ImPlot::StyleColorsDark();
-                    }
-                    else
-                    {
-                        ImPlot::StyleColorsLight();
-                    }
-                    
-                    ImPlot::SetupAxes("Time (s)", safeLabel.c_str());
-                    
-                    if (!xValues.empty())
+                    channelPlotCaches.resize(i + 1);
+                    cacheUsed.resize(i + 1, false);
+                }
+                if (!channelPlotCaches[i])
+                {
+                    channelPlotCaches[i] = std::make_unique<PlotLayerCache>();
+                }
+                cacheUsed[i] = true;
+
+                channelPlotCaches[i]->plot(safeLabel, "Time (s)", safeLabel.c_str(), plotSize,
+                                           displayFrozen, frozenContent,
+                                           [i, &safeLabel, &colors]
+                {
+                    if (!displayHistory.empty())
                     {
+                        if (traceGeometry.begin())
+                        {
+                            prv_queueHistoryLines(safeLabel.c_str(), displayHistory, i);
+                            traceGeometry.prepare();
+                        }
                         renderChannelPlot(i, safeLabel, colors[i % (sizeof(colors) / sizeof(colors[0]))]);
+                        traceGeometry.end();
                     }
-                    
-                    ImPlot::EndPlot();
-                }
+                });
                 
                 // Display statistics for this channel
                 renderChannelStatistics(i);
@@ -282,6 +654,19 @@ void renderIndividualPlotWindows(void)
             ImGui::End();
         }
     }
+
+    /* Hidden, collapsed or removed windows give their textures back */
+    for (size_t i = 0; i < channelPlotCaches.size(); ++i)
+    {
+        if (!cacheUsed[i])
+        {
+            channelPlotCaches[i].reset();
+        }
+    }
+    while (!channelPlotCaches.empty() && !channelPlotCaches.back())
+    {
+        channelPlotCaches.pop_back();
+    }
 }
 
 int getNumberOfVisiblePlotViews(void)
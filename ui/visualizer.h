@@ -15,6 +15,7 @@
 
 #include <string>
 #include <vector>
+#include "../backends/imgui.h"
 
 /**
  * @brief Retrieves serial communication data and plots it in a viewer.
@@ -27,6 +28,13 @@
  */
 void plot(void);
 
+/**
+ * @brief Gets the color a channel is plotted with in every view
+ * @param channelIndex Index of the channel, wraps around the palette
+ * @return Color of the channel
+ */
+ImVec4 getChannelColor(int channelIndex);
+
 /**
  * @brief Gets the currently selected plot view mode
  * @return 0 for combined view, 1+ for individual channel views
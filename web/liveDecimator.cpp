@@ -0,0 +1,136 @@
+/** @file      liveDecimator.cpp
+ *  @brief     Source file for the min/max decimation shared by web clients.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/24
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "liveDecimator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#define LIVE_MESSAGE_HEADER_SIZE (16)
+
+LiveDecimator::LiveDecimator(double bucketPeriod, size_t capacity)
+  : bucketPeriod_m(bucketPeriod)
+  , capacity_m(capacity)
+  , channels_m(0)
+  , times_m(capacity)
+  , completed_m(0)
+  , firstValid_m(0)
+  , hasOpen_m(false)
+  , openTime_m(0.0)
+{
+}
+
+void LiveDecimator::prv_closeBucket(void)
+{
+  size_t slot = completed_m % capacity_m;
+  times_m[slot] = openTime_m;
+  std::copy(openMinMax_m.begin(), openMinMax_m.end(),
+            minMax_m.begin() + slot * channels_m * 2);
+  completed_m++;
+  hasOpen_m = false;
+}
+
+void LiveDecimator::push(double time, const std::vector<float> &values)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+
+  if (values.size() != channels_m)
+  {
+    channels_m = values.size();
+    minMax_m.assign(capacity_m * channels_m * 2, 0.0f);
+    openMinMax_m.assign(channels_m * 2, 0.0f);
+    firstValid_m = completed_m;
+    hasOpen_m = false;
+  }
+
+  if (hasOpen_m && time >= openTime_m + bucketPeriod_m)
+  {
+    prv_closeBucket();
+  }
+
+  if (!hasOpen_m)
+  {
+    hasOpen_m = true;
+    openTime_m = std::floor(time / bucketPeriod_m) * bucketPeriod_m;
+    for (size_t ch = 0; ch < channels_m; ++ch)
+    {
+      openMinMax_m[ch * 2] = values[ch];
+      openMinMax_m[ch * 2 + 1] = values[ch];
+    }
+    return;
+  }
+
+  for (size_t ch = 0; ch < channels_m; ++ch)
+  {
+    openMinMax_m[ch * 2] = std::min(openMinMax_m[ch * 2], values[ch]);
+    openMinMax_m[ch * 2 + 1] = std::max(openMinMax_m[ch * 2 + 1], values[ch]);
+  }
+}
+
+uint64_t LiveDecimator::collect(uint64_t cursor, size_t maxPoints,
+                                std::vector<uint8_t> &message)
+{
+  std::lock_guard<std::mutex> lock(mutex_m);
+
+  message.clear();
+
+  uint64_t oldest = completed_m > capacity_m ? completed_m - capacity_m : 0;
+  uint64_t first = std::max({cursor, oldest, firstValid_m});
+  if (first >= completed_m || channels_m == 0 || maxPoints == 0)
+  {
+    return std::min(cursor, completed_m);
+  }
+
+  /* Merge consecutive buckets when there are more than the client wants */
+  uint64_t available = completed_m - first;
+  uint64_t merge = (available + maxPoints - 1) / maxPoints;
+  uint32_t points = static_cast<uint32_t>((available + merge - 1) / merge);
+  uint16_t channels = static_cast<uint16_t>(channels_m);
+
+  size_t pointSize = sizeof(double) + channels_m * 2 * sizeof(float);
+  message.resize(LIVE_MESSAGE_HEADER_SIZE + points * pointSize);
+  uint8_t *pOut = message.data();
+
+  pOut[0] = 1;
+  pOut[1] = 0;
+  memcpy(pOut + 2, &channels, sizeof(channels));
+  memcpy(pOut + 4, &points, sizeof(points));
+  memcpy(pOut + 8, &bucketPeriod_m, sizeof(bucketPeriod_m));
+  pOut += LIVE_MESSAGE_HEADER_SIZE;
+
+  std::vector<float> merged(channels_m * 2);
+  for (uint64_t start = first; start < completed_m; start += merge)
+  {
+    uint64_t end = std::min(start + merge, completed_m);
+    const float *pFirst = &minMax_m[(start % capacity_m) * channels_m * 2];
+    std::copy(pFirst, pFirst + channels_m * 2, merged.begin());
+
+    for (uint64_t bucket = start + 1; bucket < end; ++bucket)
+    {
+      const float *pBucket = &minMax_m[(bucket % capacity_m) * channels_m * 2];
+      for (size_t ch = 0; ch < channels_m; ++ch)
+      {
+        merged[ch * 2] = std::min(merged[ch * 2], pBucket[ch * 2]);
+        merged[ch * 2 + 1] = std::max(merged[ch * 2 + 1], pBucket[ch * 2 + 1]);
+      }
+    }
+
+    double time = times_m[start % capacity_m];
+    memcpy(pOut, &time, sizeof(time));
+    memcpy(pOut + sizeof(time), merged.data(), merged.size() * sizeof(float));
+    pOut += pointSize;
+  }
+
+  return completed_m;
+}
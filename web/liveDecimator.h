@@ -0,0 +1,86 @@
+/** @file      liveDecimator.h
+ *  @brief     Header file for the min/max decimation shared by web clients.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/24
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef LIVE_DECIMATOR_H
+#define LIVE_DECIMATOR_H
+
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Reduces the live frames to min/max buckets of a fixed period, once
+ * for all clients.
+ *
+ * Every sample is only compared against the open bucket. Clients then read
+ * the completed buckets from a ring at their own rate, merging them further
+ * when they ask for fewer points, so their cost depends on the number of
+ * buckets and not on the sample rate.
+ *
+ * Message layout (little-endian), built by collect():
+ *   uint8  type       (1: min/max buckets)
+ *   uint8  reserved
+ *   uint16 channels
+ *   uint32 points
+ *   float64 bucketPeriod (seconds, before merging)
+ *   points x { float64 time; channels x { float32 min; float32 max } }
+ */
+class LiveDecimator
+{
+public:
+  /**
+   * @param bucketPeriod Duration of a bucket in seconds
+   * @param capacity Number of completed buckets kept for the clients
+   */
+  LiveDecimator(double bucketPeriod, size_t capacity);
+
+  /**
+   * @brief Adds a frame. A change of channel count restarts the history.
+   */
+  void push(double time, const std::vector<float> &values);
+
+  /**
+   * @brief Builds the message of the buckets completed since a cursor.
+   *
+   * @param cursor Value returned by the previous call, 0 for a new client
+   *        (which then receives the whole kept history)
+   * @param maxPoints Maximum number of points of the message
+   * @param message Output message, empty when there is nothing new
+   * @return The cursor of the next call
+   */
+  uint64_t collect(uint64_t cursor, size_t maxPoints,
+                   std::vector<uint8_t> &message);
+
+private:
+  void prv_closeBucket(void);
+
+  std::mutex mutex_m;
+  double bucketPeriod_m;
+  size_t capacity_m;
+  size_t channels_m;
+
+  /* Ring of completed buckets, bucket n is at n % capacity_m */
+  std::vector<double> times_m;
+  std::vector<float> minMax_m; /* bucket * channels * 2 + channel * 2 */
+  uint64_t completed_m;
+  uint64_t firstValid_m; /* First bucket of the current channel count */
+
+  /* Open bucket */
+  bool hasOpen_m;
+  double openTime_m;
+  std::vector<float> openMinMax_m;
+};
+
+#endif // LIVE_DECIMATOR_H
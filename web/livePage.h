@@ -0,0 +1,84 @@
+/** @file      livePage.h
+ *  @brief     Page served by the embedded web server.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/24
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef LIVE_PAGE_H
+#define LIVE_PAGE_H
+
+/* Self-contained so that it works without any network access */
+static const char LIVE_PAGE_HTML[] = R"html(<!DOCTYPE html>
+<html><head><meta charset="utf-8"><title>mscope live</title>
+<style>
+body{margin:0;background:#1e1e1e;color:#ddd;font:14px sans-serif}
+#bar{padding:6px}canvas{display:block;width:100vw;height:calc(100vh - 40px)}
+</style></head><body>
+<div id="bar">mscope live &mdash; <span id="state">connecting</span>
+&nbsp; window <select id="span"><option>2</option><option selected>10</option>
+<option>30</option><option>60</option></select> s
+&nbsp; rate <select id="rate"><option>5</option><option selected>20</option>
+<option>30</option><option>60</option></select> Hz</div>
+<canvas id="plot"></canvas>
+<script>
+const colors=["#ff6666","#009933","#008ae6","#ffd700","#9400d3","#ffa500",
+"#00ced1","#800080","#b8860b","#808080"];
+const canvas=document.getElementById("plot"),ctx=canvas.getContext("2d");
+let points=[],channels=0;
+function send(ws){ws.send("rate="+document.getElementById("rate").value);
+ws.send("points="+canvas.width);}
+function connect(){
+ const ws=new WebSocket("ws://"+location.host+"/ws");
+ ws.binaryType="arraybuffer";
+ ws.onopen=()=>{document.getElementById("state").textContent="live";send(ws);};
+ ws.onclose=()=>{document.getElementById("state").textContent="disconnected";
+  setTimeout(connect,1000);};
+ document.getElementById("rate").onchange=()=>send(ws);
+ ws.onmessage=(event)=>{
+  const view=new DataView(event.data);
+  if(view.getUint8(0)!==1)return;
+  const count=view.getUint16(2,true),n=view.getUint32(4,true);
+  if(count!==channels){channels=count;points=[];}
+  let offset=16;
+  for(let i=0;i<n;i++){
+   const p={t:view.getFloat64(offset,true),v:[]};offset+=8;
+   for(let c=0;c<count;c++){p.v.push([view.getFloat32(offset,true),
+    view.getFloat32(offset+4,true)]);offset+=8;}
+   points.push(p);}
+ };
+}
+function draw(){
+ canvas.width=canvas.clientWidth;canvas.height=canvas.clientHeight;
+ const span=+document.getElementById("span").value;
+ if(points.length){
+  const end=points[points.length-1].t,start=end-span;
+  while(points.length&&points[0].t<start-span)points.shift();
+  let lo=Infinity,hi=-Infinity;
+  for(const p of points)if(p.t>=start)for(const v of p.v){
+   lo=Math.min(lo,v[0]);hi=Math.max(hi,v[1]);}
+  if(hi===lo){hi+=1;lo-=1;}
+  ctx.fillStyle="#1e1e1e";ctx.fillRect(0,0,canvas.width,canvas.height);
+  const x=t=>(t-start)/span*canvas.width,
+   y=v=>canvas.height-(v-lo)/(hi-lo)*(canvas.height-20)-10;
+  for(let c=0;c<channels;c++){
+   ctx.strokeStyle=colors[c%colors.length];ctx.beginPath();
+   for(const p of points)if(p.t>=start){
+    ctx.moveTo(x(p.t),y(p.v[c][0]));ctx.lineTo(x(p.t),y(p.v[c][1])+0.5);}
+   ctx.stroke();}
+  ctx.fillStyle="#ddd";ctx.fillText(hi.toPrecision(5),4,12);
+  ctx.fillText(lo.toPrecision(5),4,canvas.height-4);}
+ requestAnimationFrame(draw);
+}
+connect();requestAnimationFrame(draw);
+</script></body></html>
+)html";
+
+#endif // LIVE_PAGE_H
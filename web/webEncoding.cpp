@@ -0,0 +1,157 @@
+/** @file      webEncoding.cpp
+ *  @brief     Source file for the SHA-1 and base64 helpers of the web server.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/24
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "webEncoding.h"
+#include <cstring>
+
+/* Appended to the client key by RFC 6455 */
+#define WEBSOCKET_GUID "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+static uint32_t prv_rotateLeft(uint32_t value, int bits)
+{
+  return (value << bits) | (value >> (32 - bits));
+}
+
+static void prv_sha1Block(uint32_t state[5], const uint8_t block[64])
+{
+  uint32_t words[80];
+
+  for (int i = 0; i < 16; ++i)
+  {
+    words[i] = (uint32_t)block[i * 4] << 24 | (uint32_t)block[i * 4 + 1] << 16
+               | (uint32_t)block[i * 4 + 2] << 8 | block[i * 4 + 3];
+  }
+  for (int i = 16; i < 80; ++i)
+  {
+    words[i] = prv_rotateLeft(
+        words[i - 3] ^ words[i - 8] ^ words[i - 14] ^ words[i - 16], 1);
+  }
+
+  uint32_t a = state[0], b = state[1], c = state[2], d = state[3],
+           e = state[4];
+
+  for (int i = 0; i < 80; ++i)
+  {
+    uint32_t f, k;
+    if (i < 20)
+    {
+      f = (b & c) | (~b & d);
+      k = 0x5A827999;
+    }
+    else if (i < 40)
+    {
+      f = b ^ c ^ d;
+      k = 0x6ED9EBA1;
+    }
+    else if (i < 60)
+    {
+      f = (b & c) | (b & d) | (c & d);
+      k = 0x8F1BBCDC;
+    }
+    else
+    {
+      f = b ^ c ^ d;
+      k = 0xCA62C1D6;
+    }
+
+    uint32_t temp = prv_rotateLeft(a, 5) + f + e + k + words[i];
+    e = d;
+    d = c;
+    c = prv_rotateLeft(b, 30);
+    b = a;
+    a = temp;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+}
+
+void computeSha1(const uint8_t *pData, size_t length, uint8_t digest[20])
+{
+  uint32_t state[5]
+      = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+  uint8_t block[64];
+  size_t offset = 0;
+
+  for (; offset + 64 <= length; offset += 64)
+  {
+    prv_sha1Block(state, pData + offset);
+  }
+
+  /* Padding: 0x80, zeros, then the message length in bits */
+  size_t remaining = length - offset;
+  memset(block, 0, sizeof(block));
+  memcpy(block, pData + offset, remaining);
+  block[remaining] = 0x80;
+  if (remaining >= 56)
+  {
+    prv_sha1Block(state, block);
+    memset(block, 0, sizeof(block));
+  }
+
+  uint64_t bits = static_cast<uint64_t>(length) * 8;
+  for (int i = 0; i < 8; ++i)
+  {
+    block[63 - i] = static_cast<uint8_t>(bits >> (i * 8));
+  }
+  prv_sha1Block(state, block);
+
+  for (int i = 0; i < 5; ++i)
+  {
+    digest[i * 4] = static_cast<uint8_t>(state[i] >> 24);
+    digest[i * 4 + 1] = static_cast<uint8_t>(state[i] >> 16);
+    digest[i * 4 + 2] = static_cast<uint8_t>(state[i] >> 8);
+    digest[i * 4 + 3] = static_cast<uint8_t>(state[i]);
+  }
+}
+
+std::string encodeBase64(const uint8_t *pData, size_t length)
+{
+  static const char alphabet[]
+      = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string encoded;
+  encoded.reserve((length + 2) / 3 * 4);
+
+  for (size_t i = 0; i < length; i += 3)
+  {
+    uint32_t group = static_cast<uint32_t>(pData[i]) << 16;
+    if (i + 1 < length)
+    {
+      group |= static_cast<uint32_t>(pData[i + 1]) << 8;
+    }
+    if (i + 2 < length)
+    {
+      group |= pData[i + 2];
+    }
+
+    encoded += alphabet[(group >> 18) & 0x3F];
+    encoded += alphabet[(group >> 12) & 0x3F];
+    encoded += (i + 1 < length) ? alphabet[(group >> 6) & 0x3F] : '=';
+    encoded += (i + 2 < length) ? alphabet[group & 0x3F] : '=';
+  }
+
+  return encoded;
+}
+
+std::string computeWebSocketAccept(const std::string &key)
+{
+  std::string text = key + WEBSOCKET_GUID;
+  uint8_t digest[20];
+  computeSha1(reinterpret_cast<const uint8_t *>(text.data()), text.size(),
+              digest);
+  return encodeBase64(digest, sizeof(digest));
+}
@@ -0,0 +1,39 @@
+/** @file      webEncoding.h
+ *  @brief     Header file for the SHA-1 and base64 helpers of the web server.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/24
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef WEB_ENCODING_H
+#define WEB_ENCODING_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Computes the SHA-1 digest of a buffer (RFC 3174).
+ *
+ * Only used for the WebSocket handshake, not for anything security related.
+ */
+void computeSha1(const uint8_t *pData, size_t length, uint8_t digest[20]);
+
+/**
+ * @brief Encodes a buffer in base64 with padding (RFC 4648).
+ */
+std::string encodeBase64(const uint8_t *pData, size_t length);
+
+/**
+ * @brief Computes the Sec-WebSocket-Accept value of a Sec-WebSocket-Key.
+ */
+std::string computeWebSocketAccept(const std::string &key);
+
+#endif // WEB_ENCODING_H
@@ -0,0 +1,678 @@
+/** @file      webServer.cpp
+ *  @brief     Source file for the embedded HTTP/WebSocket live data server.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/24
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#include "webServer.h"
+#include "webEncoding.h"
+#include "livePage.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cctype>
+#include <iostream>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#define WEB_BUCKET_PERIOD (0.005)      /* 5 ms buckets, 200 per second */
+#define WEB_BUCKET_CAPACITY (12000)    /* One minute of buckets */
+#define WEB_MAX_CLIENTS (16)            /* WebSocket viewers */
+#define WEB_MAX_PENDING (64)            /* Connections not upgraded yet */
+#define WEB_REQUEST_TIMEOUT (5.0)       /* Seconds to send a request */
+#define WEB_MAX_REQUEST (8192)         /* Bytes of HTTP request headers */
+#define WEB_MAX_CLIENT_MESSAGE (4096)  /* Bytes of a WebSocket message */
+#define WEB_DEFAULT_RATE (20)          /* Updates per second */
+#define WEB_MAX_RATE (60)
+#define WEB_DEFAULT_POINTS (2000)
+#define WEB_MAX_POINTS (20000)
+#define WEB_POLL_INTERVAL_MS (5)
+
+enum WebSocketOpcode : uint8_t
+{
+  WsContinuation = 0x0,
+  WsText = 0x1,
+  WsBinary = 0x2,
+  WsClose = 0x8,
+  WsPing = 0x9,
+  WsPong = 0xA
+};
+
+struct WebServer::Client
+{
+  int fd = -1;
+  bool webSocket = false;
+  bool closing = false; /* Close once the output is flushed */
+  double deadline = 0.0; /* Dropped then unless upgraded */
+  std::string input;
+  std::vector<uint8_t> output;
+  size_t outputOffset = 0;
+  uint64_t cursor = 0;
+  size_t maxPoints = WEB_DEFAULT_POINTS;
+  double interval = 1.0 / WEB_DEFAULT_RATE;
+  double nextUpdate = 0.0;
+};
+
+// Global instance
+WebServer g_webServer;
+
+static double prv_now(void)
+{
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static void prv_appendFrame(std::vector<uint8_t> &output, uint8_t opcode,
+                            const uint8_t *pPayload, size_t length)
+{
+  output.push_back(0x80 | opcode);
+  if (length < 126)
+  {
+    output.push_back(static_cast<uint8_t>(length));
+  }
+  else if (length <= 0xFFFF)
+  {
+    output.push_back(126);
+    output.push_back(static_cast<uint8_t>(length >> 8));
+    output.push_back(static_cast<uint8_t>(length));
+  }
+  else
+  {
+    output.push_back(127);
+    for (int shift = 56; shift >= 0; shift -= 8)
+    {
+      output.push_back(static_cast<uint8_t>(static_cast<uint64_t>(length)
+                                            >> shift));
+    }
+  }
+  output.insert(output.end(), pPayload, pPayload + length);
+}
+
+static void prv_appendText(std::vector<uint8_t> &output, const char *pText)
+{
+  output.insert(output.end(), pText, pText + strlen(pText));
+}
+
+/* Value of a header, matched without case, or an empty string */
+static std::string prv_headerValue(const std::string &request,
+                                   const char *pName)
+{
+  size_t nameLength = strlen(pName);
+  size_t lineStart = request.find("\r\n");
+  while (lineStart != std::string::npos)
+  {
+    lineStart += 2;
+    size_t lineEnd = request.find("\r\n", lineStart);
+    if (lineEnd == std::string::npos || lineEnd == lineStart)
+    {
+      break;
+    }
+    if (lineEnd - lineStart > nameLength
+        && request[lineStart + nameLength] == ':'
+        && strncasecmp(request.c_str() + lineStart, pName, nameLength) == 0)
+    {
+      size_t valueStart = lineStart + nameLength + 1;
+      while (valueStart < lineEnd
+             && (request[valueStart] == ' ' || request[valueStart] == '\t'))
+      {
+        ++valueStart;
+      }
+      size_t valueEnd = lineEnd;
+      while (valueEnd > valueStart
+             && (request[valueEnd - 1] == ' ' || request[valueEnd - 1] == '\t'))
+      {
+        --valueEnd;
+      }
+      return request.substr(valueStart, valueEnd - valueStart);
+    }
+    lineStart = lineEnd;
+  }
+  return std::string();
+}
+
+static bool prv_containsToken(std::string value, const char *pToken)
+{
+  std::transform(value.begin(), value.end(), value.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return value.find(pToken) != std::string::npos;
+}
+
+/* Whether the page asking for the stream was served by this server: any page
+ * of the network could otherwise read it from a browser. Clients that are not
+ * browsers send no Origin. */
+static bool prv_sameOrigin(const std::string &request)
+{
+  std::string origin = prv_headerValue(request, "Origin");
+  if (origin.empty())
+  {
+    return true;
+  }
+  size_t hostStart = origin.find("://");
+  if (hostStart == std::string::npos)
+  {
+    return false;
+  }
+  std::string host = prv_headerValue(request, "Host");
+  return !host.empty()
+         && strcasecmp(origin.c_str() + hostStart + 3, host.c_str()) == 0;
+}
+
+WebServer::WebServer()
+  : listenFd_m(-1)
+  , running_m(false)
+  , clientCount_m(0)
+  , publishedFrames_m(0)
+  , decimator_m(WEB_BUCKET_PERIOD, WEB_BUCKET_CAPACITY)
+{
+}
+
+WebServer::~WebServer()
+{
+  stop();
+}
+
+OrbCode_t WebServer::start(const std::string &address, uint16_t port)
+{
+  if (running_m)
+  {
+    return PortStateError;
+  }
+
+  /* Releases a server thread that stopped on its own */
+  stop();
+
+  struct addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_PASSIVE | AI_NUMERICSERV;
+  struct addrinfo *pResults = nullptr;
+  std::string service = std::to_string(port);
+  int status = getaddrinfo(address.empty() ? nullptr : address.c_str(),
+                           service.c_str(), &hints, &pResults);
+  if (status != 0)
+  {
+    std::cerr << "Cannot resolve " << address << ": " << gai_strerror(status)
+              << std::endl;
+    return OpenError;
+  }
+
+  int fd = -1;
+  for (struct addrinfo *pInfo = pResults; pInfo != nullptr;
+       pInfo = pInfo->ai_next)
+  {
+    fd = socket(pInfo->ai_family,
+                pInfo->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                pInfo->ai_protocol);
+    if (fd < 0)
+    {
+      continue;
+    }
+    int enable = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    if (bind(fd, pInfo->ai_addr, pInfo->ai_addrlen) == 0
+        && listen(fd, WEB_MAX_CLIENTS) == 0)
+    {
+      break;
+    }
+    ::close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(pResults);
+
+  if (fd < 0)
+  {
+    std::cerr << "Cannot listen on " << address << ":" << port << ": "
+              << strerror(errno) << std::endl;
+    return OpenError;
+  }
+
+  listenFd_m = fd;
+  running_m = true;
+  thread_m = std::thread(&WebServer::prv_serverThread, this);
+
+  return Success;
+}
+
+void WebServer::stop(void)
+{
+  running_m = false;
+  if (thread_m.joinable())
+  {
+    thread_m.join();
+  }
+  if (listenFd_m >= 0)
+  {
+    ::close(listenFd_m);
+    listenFd_m = -1;
+  }
+}
+
+void WebServer::publish(double time, const std::vector<float> &values)
+{
+  decimator_m.push(time, values);
+  publishedFrames_m.fetch_add(1, std::memory_order_relaxed);
+}
+
+void WebServer::prv_serverThread(void)
+{
+  std::vector<Client> clients;
+  std::vector<struct pollfd> descriptors;
+
+  while (running_m)
+  {
+    descriptors.clear();
+    descriptors.push_back({listenFd_m, POLLIN, 0});
+    for (const Client &client : clients)
+    {
+      short events = POLLIN;
+      if (client.outputOffset < client.output.size())
+      {
+        events |= POLLOUT;
+      }
+      descriptors.push_back({client.fd, events, 0});
+    }
+
+    /* The timeout also paces the updates, all rates are far below 200 Hz */
+    if (poll(descriptors.data(), descriptors.size(), WEB_POLL_INTERVAL_MS) < 0
+        && errno != EINTR)
+    {
+      break;
+    }
+
+    double now = prv_now();
+    for (size_t i = 0; i < clients.size(); ++i)
+    {
+      short revents = descriptors[i + 1].revents;
+      bool keep = true;
+      if ((revents & (POLLERR | POLLNVAL))
+          || (!clients[i].webSocket && now > clients[i].deadline))
+      {
+        keep = false;
+      }
+      if (keep && (revents & (POLLIN | POLLHUP)))
+      {
+        keep = prv_readClient(clients[i]);
+      }
+      if (keep && (revents & POLLOUT))
+      {
+        keep = prv_flushClient(clients[i]);
+      }
+      if (!keep)
+      {
+        ::close(clients[i].fd);
+        clients[i].fd = -1;
+      }
+    }
+    clients.erase(std::remove_if(clients.begin(), clients.end(),
+                                 [](const Client &client)
+                                 { return client.fd < 0; }),
+                  clients.end());
+
+    if (descriptors[0].revents & POLLIN)
+    {
+      prv_acceptClients(clients);
+    }
+
+    prv_sendUpdates(clients);
+
+    clientCount_m = std::count_if(clients.begin(), clients.end(),
+                                  [](const Client &client)
+                                  { return client.webSocket; });
+  }
+
+  for (Client &client : clients)
+  {
+    ::close(client.fd);
+  }
+  clientCount_m = 0;
+  running_m = false;
+}
+
+void WebServer::prv_acceptClients(std::vector<Client> &clients)
+{
+  while (true)
+  {
+    int fd = accept4(listenFd_m, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0)
+    {
+      return;
+    }
+    /* Idle connections only hold a slot until their deadline, viewers are
+     * limited when they upgrade */
+    size_t pending = std::count_if(clients.begin(), clients.end(),
+                                   [](const Client &client)
+                                   { return !client.webSocket; });
+    if (pending >= WEB_MAX_PENDING)
+    {
+      ::close(fd);
+      continue;
+    }
+
+    /* Updates are small and latency matters more than packet count */
+    int enable = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+    Client client;
+    client.fd = fd;
+    client.deadline = prv_now() + WEB_REQUEST_TIMEOUT;
+    clients.push_back(std::move(client));
+  }
+}
+
+bool WebServer::prv_readClient(Client &client)
+{
+  char buffer[4096];
+  while (true)
+  {
+    ssize_t received = ::read(client.fd, buffer, sizeof(buffer));
+    if (received > 0)
+    {
+      client.input.append(buffer, received);
+      continue;
+    }
+    if (received == 0)
+    {
+      return false;
+    }
+    if (errno == EINTR)
+    {
+      continue;
+    }
+    if (errno != EAGAIN && errno != EWOULDBLOCK)
+    {
+      return false;
+    }
+    break;
+  }
+
+  if (client.closing)
+  {
+    client.input.clear();
+    return true;
+  }
+
+  return client.webSocket ? prv_handleWebSocketData(client)
+                          : prv_handleRequest(client);
+}
+
+bool WebServer::prv_handleRequest(Client &client)
+{
+  size_t headerEnd = client.input.find("\r\n\r\n");
+  if (headerEnd == std::string::npos)
+  {
+    return client.input.size() < WEB_MAX_REQUEST;
+  }
+
+  std::string request = client.input.substr(0, headerEnd + 2);
+  client.input.erase(0, headerEnd + 4);
+
+  size_t methodEnd = request.find(' ');
+  size_t pathEnd = (methodEnd == std::string::npos)
+                       ? std::string::npos
+                       : request.find(' ', methodEnd + 1);
+  if (pathEnd == std::string::npos || request.compare(0, methodEnd, "GET") != 0)
+  {
+    prv_appendText(client.output, "HTTP/1.1 405 Method Not Allowed\r\n"
+                                  "Content-Length: 0\r\n"
+                                  "Connection: close\r\n\r\n");
+    client.closing = true;
+    return prv_flushClient(client);
+  }
+
+  std::string path = request.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+  std::string key = prv_headerValue(request, "Sec-WebSocket-Key");
+
+  if (path == "/ws" && !key.empty()
+      && prv_containsToken(prv_headerValue(request, "Upgrade"), "websocket"))
+  {
+    if (!prv_sameOrigin(request))
+    {
+      prv_appendText(client.output, "HTTP/1.1 403 Forbidden\r\n"
+                                    "Content-Length: 0\r\n"
+                                    "Connection: close\r\n\r\n");
+      client.closing = true;
+      return prv_flushClient(client);
+    }
+    if (clientCount_m >= WEB_MAX_CLIENTS)
+    {
+      prv_appendText(client.output, "HTTP/1.1 503 Service Unavailable\r\n"
+                                    "Content-Length: 0\r\n"
+                                    "Connection: close\r\n\r\n");
+      client.closing = true;
+      return prv_flushClient(client);
+    }
+
+    std::string response = "HTTP/1.1 101 Switching Protocols\r\n"
+                           "Upgrade: websocket\r\n"
+                           "Connection: Upgrade\r\n"
+                           "Sec-WebSocket-Accept: "
+                           + computeWebSocketAccept(key) + "\r\n\r\n";
+    prv_appendText(client.output, response.c_str());
+    client.webSocket = true;
+    clientCount_m++;
+    client.nextUpdate = prv_now();
+    return prv_flushClient(client) && prv_handleWebSocketData(client);
+  }
+
+  if (path == "/" || path == "/index.html")
+  {
+    std::string header = "HTTP/1.1 200 OK\r\n"
+                         "Content-Type: text/html; charset=utf-8\r\n"
+                         "Cache-Control: no-cache\r\n"
+                         "Content-Length: "
+                         + std::to_string(sizeof(LIVE_PAGE_HTML) - 1)
+                         + "\r\nConnection: close\r\n\r\n";
+    prv_appendText(client.output, header.c_str());
+    prv_appendText(client.output, LIVE_PAGE_HTML);
+  }
+  else
+  {
+    prv_appendText(client.output, "HTTP/1.1 404 Not Found\r\n"
+                                  "Content-Length: 0\r\n"
+                                  "Connection: close\r\n\r\n");
+  }
+  client.closing = true;
+  return prv_flushClient(client);
+}
+
+bool WebServer::prv_handleWebSocketData(Client &client)
+{
+  while (client.input.size() >= 2)
+  {
+    const uint8_t *pData
+        = reinterpret_cast<const uint8_t *>(client.input.data());
+    uint8_t opcode = pData[0] & 0x0F;
+    bool masked = (pData[1] & 0x80) != 0;
+    uint64_t length = pData[1] & 0x7F;
+    size_t headerLength = 2;
+
+    if (length == 126)
+    {
+      if (client.input.size() < 4)
+      {
+        return true;
+      }
+      length = (static_cast<uint64_t>(pData[2]) << 8) | pData[3];
+      headerLength = 4;
+    }
+    else if (length == 127)
+    {
+      if (client.input.size() < 10)
+      {
+        return true;
+      }
+      length = 0;
+      for (int i = 2; i < 10; ++i)
+      {
+        length = (length << 8) | pData[i];
+      }
+      headerLength = 10;
+    }
+
+    /* Browsers always mask, and nothing they send here needs to be large */
+    if (!masked || length > WEB_MAX_CLIENT_MESSAGE)
+    {
+      return false;
+    }
+    if (client.input.size() < headerLength + 4 + length)
+    {
+      return true;
+    }
+
+    const uint8_t *pMask = pData + headerLength;
+    std::string payload(length, '\0');
+    for (size_t i = 0; i < length; ++i)
+    {
+      payload[i] = static_cast<char>(pData[headerLength + 4 + i] ^ pMask[i & 3]);
+    }
+    client.input.erase(0, headerLength + 4 + length);
+
+    switch (opcode)
+    {
+    case WsText:
+      if (payload.compare(0, 5, "rate=") == 0)
+      {
+        int rate = std::clamp(atoi(payload.c_str() + 5), 1, WEB_MAX_RATE);
+        client.interval = 1.0 / rate;
+      }
+      else if (payload.compare(0, 7, "points=") == 0)
+      {
+        client.maxPoints = std::clamp(atoi(payload.c_str() + 7), 2,
+                                      WEB_MAX_POINTS);
+      }
+      break;
+    case WsPing:
+      prv_appendFrame(client.output, WsPong,
+                      reinterpret_cast<const uint8_t *>(payload.data()),
+                      payload.size());
+      break;
+    case WsClose:
+      prv_appendFrame(client.output, WsClose, nullptr, 0);
+      client.closing = true;
+      client.input.clear();
+      return prv_flushClient(client);
+    default:
+      /* Binary, continuation and pong messages are ignored */
+      break;
+    }
+  }
+
+  return prv_flushClient(client);
+}
+
+bool WebServer::prv_flushClient(Client &client)
+{
+  while (client.outputOffset < client.output.size())
+  {
+    ssize_t sent = send(client.fd, client.output.data() + client.outputOffset,
+                        client.output.size() - client.outputOffset,
+                        MSG_NOSIGNAL);
+    if (sent > 0)
+    {
+      client.outputOffset += sent;
+      continue;
+    }
+    if (sent < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+    {
+      return true;
+    }
+    return false;
+  }
+
+  client.output.clear();
+  client.outputOffset = 0;
+
+  return !client.closing;
+}
+
+void WebServer::prv_sendUpdates(std::vector<Client> &clients)
+{
+  std::vector<uint8_t> message;
+  double now = prv_now();
+
+  for (Client &client : clients)
+  {
+    /* A client still sending the previous update keeps its cursor and gets
+     * the skipped buckets merged into its next update instead */
+    if (!client.webSocket || client.closing || now < client.nextUpdate
+        || !client.output.empty())
+    {
+      continue;
+    }
+
+    client.nextUpdate = std::max(client.nextUpdate + client.interval, now);
+    client.cursor = decimator_m.collect(client.cursor, client.maxPoints,
+                                        message);
+    if (message.empty())
+    {
+      continue;
+    }
+
+    prv_appendFrame(client.output, WsBinary, message.data(), message.size());
+    if (!prv_flushClient(client))
+    {
+      ::close(client.fd);
+      client.fd = -1;
+    }
+  }
+
+  clients.erase(std::remove_if(clients.begin(), clients.end(),
+                               [](const Client &client)
+                               { return client.fd < 0; }),
+                clients.end());
+}
+
+OrbCode_t startWebServer(const std::string &address, uint16_t port)
+{
+  return g_webServer.start(address, port);
+}
+
+void stopWebServer(void)
+{
+  g_webServer.stop();
+}
+
+bool isWebServerRunning(void)
+{
+  return g_webServer.isRunning();
+}
+
+size_t getWebServerClientCount(void)
+{
+  return g_webServer.getClientCount();
+}
+
+uint64_t getWebPublishedFrames(void)
+{
+  return g_webServer.getPublishedFrames();
+}
+
+void publishWebFrame(uint32_t group, double time,
+                     const std::vector<float> &values)
+{
+  /* Only the primary input is streamed */
+  if (group == 0 && g_webServer.isRunning())
+  {
+    g_webServer.publish(time, values);
+  }
+}
@@ -0,0 +1,95 @@
+/** @file      webServer.h
+ *  @brief     Header file for the embedded HTTP/WebSocket live data server.
+ *  @author    arturodlrios
+ *  @date      Created on 2025/02/24
+ *
+ *  This software is the exclusive property of Cortx and is provided
+ *  under strict confidentiality. It is intended for use solely by authorized
+ *  personnel of Cortx and is protected by intellectual property laws.
+ *  Unauthorized use, reproduction, or distribution in whole or in part is
+ *  strictly prohibited.
+ *
+ *  COPYRIGHT NOTICE: 2025 Cortx, Montreal, QC. All rights reserved.
+ */
+
+#ifndef WEB_SERVER_H
+#define WEB_SERVER_H
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include "../Libraries/lib.h"
+#include "liveDecimator.h"
+
+#define WEB_DEFAULT_ADDRESS "127.0.0.1"
+#define WEB_DEFAULT_PORT (8080)
+
+/**
+ * @brief Serves a minimal live page and streams the primary input to it.
+ *
+ * "GET /" returns the page, "GET /ws" upgrades to a WebSocket. Every client
+ * receives binary min/max messages (see LiveDecimator) at the rate it asks
+ * for with a "rate=<Hz>" or "points=<count>" text message. Everything runs on
+ * one server thread with non-blocking sockets. A client that cannot keep up
+ * skips updates and then gets coarser ones, the acquisition never waits.
+ * Only WebSockets opened by a page of the same origin are accepted, and a
+ * connection that is not upgraded is closed after a few seconds.
+ */
+class WebServer
+{
+public:
+  WebServer();
+  ~WebServer();
+
+  /**
+   * @brief Binds the address and starts the server thread.
+   * @return Success, OpenError when the address cannot be bound or
+   *         PortStateError when already running.
+   */
+  OrbCode_t start(const std::string &address, uint16_t port);
+
+  void stop(void);
+
+  bool isRunning(void) const { return running_m; }
+
+  /* Adds a frame of the primary input to the shared decimation */
+  void publish(double time, const std::vector<float> &values);
+
+  size_t getClientCount(void) const { return clientCount_m; }
+
+  /* Frames reduced into buckets, a slow browser gets coarser updates */
+  uint64_t getPublishedFrames(void) const { return publishedFrames_m; }
+
+private:
+  struct Client;
+
+  void prv_serverThread(void);
+  void prv_acceptClients(std::vector<Client> &clients);
+  bool prv_readClient(Client &client);
+  bool prv_handleRequest(Client &client);
+  bool prv_handleWebSocketData(Client &client);
+  bool prv_flushClient(Client &client);
+  void prv_sendUpdates(std::vector<Client> &clients);
+
+  int listenFd_m;
+  std::thread thread_m;
+  std::atomic<bool> running_m;
+  std::atomic<size_t> clientCount_m;
+  std::atomic<uint64_t> publishedFrames_m;
+  LiveDecimator decimator_m;
+};
+
+// Global instance
+extern WebServer g_webServer;
+
+// Global functions for easy access
+OrbCode_t startWebServer(const std::string &address, uint16_t port);
+void stopWebServer(void);
+bool isWebServerRunning(void);
+size_t getWebServerClientCount(void);
+uint64_t getWebPublishedFrames(void);
+void publishWebFrame(uint32_t group, double time, const std::vector<float> &values);
+
+#endif // WEB_SERVER_H